@@ -13,7 +13,7 @@ GENERATED_DIR = ../../generated
 # Use common project definitions
 include(../../common.pri)
 
-QT += core widgets network xml sql printsupport opengl
+QT += core widgets network xml sql printsupport opengl concurrent
 
 LIBS += \
     -L$${DESTDIR} \
@@ -13,7 +13,7 @@ GENERATED_DIR = ../../generated
 # Use common project definitions
 include(../../common.pri)
 
-QT += core widgets xml sql network
+QT += core widgets xml sql network concurrent
 
 LIBS += \
     -L$${DESTDIR} \
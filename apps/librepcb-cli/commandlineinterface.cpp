@@ -0,0 +1,588 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "commandlineinterface.h"
+#include <librepcb/common/application.h>
+#include <librepcb/common/cam/camrasterizer.h>
+#include <librepcb/common/cam/excellonparser.h>
+#include <librepcb/common/cam/gerberparser.h>
+#include <librepcb/common/debug.h>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/library/cmp/component.h>
+#include <librepcb/library/cmp/componentsignal.h>
+#include <librepcb/library/dev/device.h>
+#include <librepcb/library/pkg/package.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardgerberexport.h>
+#include <librepcb/project/boards/items/bi_device.h>
+#include <librepcb/project/circuit/circuit.h>
+#include <librepcb/project/circuit/componentinstance.h>
+#include <librepcb/project/circuit/componentsignalinstance.h>
+#include <librepcb/project/circuit/netsignal.h>
+#include <librepcb/project/metadata/projectmetadata.h>
+#include <librepcb/project/project.h>
+#include <librepcb/project/settings/projectsettings.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace cli {
+
+using namespace project;
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+CommandLineInterface::CommandLineInterface() noexcept :
+    mOptions{false, false, false, QString(), 1, false, QString(), Length(10000), 1, 1,
+             Length(2000000), Length(0)}
+{
+}
+
+CommandLineInterface::~CommandLineInterface() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+int CommandLineInterface::execute() noexcept
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription(tr("Export LibrePCB projects without graphical user "
+                                        "interface."));
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption gerberOption("export-gerber",
+        tr("Export Gerber and Excellon files of all boards."));
+    QCommandLineOption bomOption("export-bom",
+        tr("Export the bill of materials of all boards as CSV files."));
+    QCommandLineOption netlistOption("export-netlist",
+        tr("Export the netlist of the circuit as CSV file."));
+    QCommandLineOption outputDirOption(QStringList{"o", "output-dir"},
+        tr("Write the files into subdirectories of <dir> instead of the \"output\" "
+           "directories of the projects."), tr("dir"));
+    QCommandLineOption jobsOption(QStringList{"j", "jobs"},
+        tr("Export up to <n> projects in parallel processes (default: %1).")
+        .arg(QThread::idealThreadCount()), tr("n"),
+        QString::number(QThread::idealThreadCount()));
+    QCommandLineOption jsonOption("json",
+        tr("Print a summary with the timings of all steps in JSON format to stdout."));
+    QCommandLineOption panelOption("panel",
+        tr("Export the Gerber and Excellon files as panels with <columns>x<rows> copies "
+           "of each board."), tr("columns>x<rows"));
+    QCommandLineOption panelSpacingOption("panel-spacing",
+        tr("Spacing between the boards of a panel in millimeters (default: 2)."),
+        tr("mm"), "2");
+    QCommandLineOption panelRailsOption("panel-rails",
+        tr("Width of the rails at the top and bottom of a panel in millimeters "
+           "(default: 0, no rails)."), tr("mm"), "0");
+    QCommandLineOption compareOption("compare-with",
+        tr("Compare the exported Gerber and Excellon files with the files in <dir>, "
+           "which must have the same layout as the directory of \"--output-dir\"."),
+        tr("dir"));
+    QCommandLineOption diffResolutionOption("diff-resolution",
+        tr("Pixel size in micrometers used to compare files (default: 10)."), tr("um"),
+        "10");
+    QCommandLineOption verboseOption(QStringList{"v", "verbose"},
+        tr("Print debug messages to stderr."));
+    parser.addOptions({gerberOption, bomOption, netlistOption, outputDirOption,
+                       jobsOption, jsonOption, panelOption, panelSpacingOption,
+                       panelRailsOption, compareOption, diffResolutionOption,
+                       verboseOption});
+    parser.addPositionalArgument("projects", tr("Project files (*.lpp) to export."),
+                                 tr("<project>..."));
+    parser.process(Application::arguments()); // exits on errors and for --help/--version
+
+    bool jobsValid = false;
+    bool diffResolutionValid = false;
+    mOptions.exportGerber = parser.isSet(gerberOption);
+    mOptions.exportBom = parser.isSet(bomOption);
+    mOptions.exportNetlist = parser.isSet(netlistOption);
+    mOptions.outputDir = parser.value(outputDirOption);
+    mOptions.jobs = parser.value(jobsOption).toInt(&jobsValid);
+    mOptions.json = parser.isSet(jsonOption);
+    mOptions.compareWith = parser.value(compareOption);
+    qreal diffResolutionUm = parser.value(diffResolutionOption).toDouble(&diffResolutionValid);
+    diffResolutionValid = diffResolutionValid && (diffResolutionUm >= 0.001) &&
+                          (diffResolutionUm <= 1000000);
+    if (diffResolutionValid) {
+        mOptions.diffResolution = Length(qRound64(diffResolutionUm * 1000));
+    }
+    QStringList projectFiles = parser.positionalArguments();
+
+    Debug::instance()->setDebugLevelStderr(parser.isSet(verboseOption) ?
+        Debug::DebugLevel_t::All : Debug::DebugLevel_t::Warning);
+
+    QTextStream err(stderr);
+    if ((!jobsValid) || (mOptions.jobs < 1)) {
+        err << tr("Invalid count of jobs: %1").arg(parser.value(jobsOption)) << endl;
+        return 1;
+    }
+    if (parser.isSet(panelOption)) {
+        QStringList panel = parser.value(panelOption).split('x');
+        bool columnsValid = false, rowsValid = false;
+        mOptions.panelColumns = panel.value(0).toInt(&columnsValid);
+        mOptions.panelRows = panel.value(1).toInt(&rowsValid);
+        if ((panel.count() != 2) || (!columnsValid) || (!rowsValid) ||
+            (mOptions.panelColumns < 1) || (mOptions.panelRows < 1)) {
+            err << tr("Invalid panel size: %1").arg(parser.value(panelOption)) << endl;
+            return 1;
+        }
+    }
+    if ((!parseMillimeters(parser.value(panelSpacingOption), mOptions.panelSpacing)) ||
+        (!parseMillimeters(parser.value(panelRailsOption), mOptions.panelRailWidth))) {
+        err << tr("Invalid panel spacing or rail width.") << endl;
+        return 1;
+    }
+    if (!diffResolutionValid) {
+        err << tr("Invalid diff resolution: %1").arg(parser.value(diffResolutionOption))
+            << endl;
+        return 1;
+    }
+    if ((!mOptions.compareWith.isEmpty()) && (!mOptions.exportGerber)) {
+        err << tr("Files can only be compared with \"--export-gerber\".") << endl;
+        return 1;
+    }
+    if (projectFiles.isEmpty()) {
+        err << tr("No project files specified.") << endl;
+        return 1;
+    }
+    if (!(mOptions.exportGerber || mOptions.exportBom || mOptions.exportNetlist)) {
+        err << tr("Nothing to export, the projects are only opened.") << endl;
+    }
+
+    // export all projects
+    QElapsedTimer timer;
+    timer.start();
+    QJsonArray projectsJson;
+    if ((mOptions.jobs > 1) && (projectFiles.count() > 1)) {
+        projectsJson = exportProjectsInChildProcesses(projectFiles);
+    } else {
+        foreach (const QString& projectFile, projectFiles) {
+            projectsJson.append(exportProject(projectFile));
+        }
+    }
+    qint64 totalTime = timer.elapsed();
+
+    // print the summary
+    int failedCount = 0;
+    QTextStream out(stdout);
+    foreach (const QJsonValue& value, projectsJson) {
+        QJsonObject projectJson = value.toObject();
+        if (projectJson.value("success").toBool()) {
+            if (!mOptions.json) {
+                out << QString("OK      %1 ms  %2").arg(projectJson.value("total_ms").toInt())
+                       .arg(projectJson.value("file").toString()) << endl;
+            }
+        } else {
+            ++failedCount;
+            if (!mOptions.json) {
+                out << QString("FAILED  %1: %2").arg(projectJson.value("file").toString(),
+                       projectJson.value("error").toString()) << endl;
+            }
+        }
+    }
+    if (mOptions.json) {
+        QJsonObject summaryJson;
+        summaryJson.insert("projects", projectsJson);
+        summaryJson.insert("jobs", mOptions.jobs);
+        summaryJson.insert("failed", failedCount);
+        summaryJson.insert("total_ms", totalTime);
+        out << QJsonDocument(summaryJson).toJson(QJsonDocument::Indented);
+    } else {
+        out << tr("Exported %1 projects in %2 ms (%3 failed).").arg(projectsJson.count())
+               .arg(totalTime).arg(failedCount) << endl;
+    }
+    return (failedCount > 0) ? 1 : 0;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+QJsonArray CommandLineInterface::exportProjectsInChildProcesses(
+        const QStringList& projectFiles) const noexcept
+{
+    // every child exports exactly one project and prints its result as JSON
+    QStringList commonArgs = QStringList{"--json", "--jobs", "1"};
+    if (mOptions.exportGerber) commonArgs << "--export-gerber";
+    if (mOptions.exportBom) commonArgs << "--export-bom";
+    if (mOptions.exportNetlist) commonArgs << "--export-netlist";
+    if (!mOptions.outputDir.isEmpty()) commonArgs << "--output-dir" << mOptions.outputDir;
+    commonArgs << "--panel" << QString("%1x%2").arg(mOptions.panelColumns)
+                                               .arg(mOptions.panelRows)
+               << "--panel-spacing" << mOptions.panelSpacing.toMmString()
+               << "--panel-rails" << mOptions.panelRailWidth.toMmString();
+    if (!mOptions.compareWith.isEmpty()) {
+        commonArgs << "--compare-with" << mOptions.compareWith << "--diff-resolution"
+                   << QString::number(mOptions.diffResolution.toMm() * 1000);
+    }
+    if (Debug::instance()->getDebugLevelStderr() == Debug::DebugLevel_t::All) {
+        commonArgs << "--verbose";
+    }
+
+    QVector<QJsonObject> results(projectFiles.count());
+    QVector<QByteArray> outputs(projectFiles.count());
+    QEventLoop loop;
+    int nextIndex = 0;
+    int runningCount = 0;
+    std::function<void()> startProcesses = [&]() {
+        while ((runningCount < mOptions.jobs) && (nextIndex < projectFiles.count())) {
+            int index = nextIndex++;
+            QProcess* process = new QProcess(&loop);
+            process->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+            QObject::connect(process, &QProcess::readyReadStandardOutput,
+                             [&outputs, process, index]() {
+                outputs[index].append(process->readAllStandardOutput());
+            });
+            QObject::connect(process, static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(
+                             &QProcess::finished), [&, process, index](int exitCode,
+                                                                    QProcess::ExitStatus status) {
+                outputs[index].append(process->readAllStandardOutput());
+                QJsonArray array = QJsonDocument::fromJson(outputs[index]).object()
+                                   .value("projects").toArray();
+                if ((status == QProcess::NormalExit) && (array.count() == 1)) {
+                    results[index] = array.first().toObject();
+                } else {
+                    results[index] = createErrorJson(projectFiles.at(index),
+                        tr("The export process crashed (exit code %1).").arg(exitCode));
+                }
+                process->deleteLater();
+                --runningCount;
+                startProcesses();
+                if (runningCount == 0) {
+                    loop.quit();
+                }
+            });
+            process->start(Application::applicationFilePath(),
+                           QStringList(commonArgs) << projectFiles.at(index));
+            if (process->waitForStarted()) {
+                ++runningCount;
+            } else {
+                results[index] = createErrorJson(projectFiles.at(index),
+                    tr("Failed to start the export process: %1").arg(process->errorString()));
+                delete process;
+            }
+        }
+    };
+    startProcesses();
+    if (runningCount > 0) {
+        loop.exec();
+    }
+
+    QJsonArray array;
+    foreach (const QJsonObject& result, results) {
+        array.append(result);
+    }
+    return array;
+}
+
+QJsonObject CommandLineInterface::exportProject(const QString& projectFile) const noexcept
+{
+    QJsonObject json;
+    json.insert("file", projectFile);
+    QElapsedTimer totalTimer;
+    totalTimer.start();
+    QElapsedTimer timer;
+    try {
+        // open the project in read-only mode, so it is neither locked nor modified
+        timer.start();
+        FilePath filepath(QFileInfo(projectFile).absoluteFilePath());
+        Project project(filepath, true); // can throw
+        json.insert("name", project.getMetadata().getName());
+        json.insert("open_ms", timer.elapsed());
+        FilePath outputDir = getOutputDirectory(project);
+        json.insert("output_dir", outputDir.toNative());
+
+        if (mOptions.exportNetlist) {
+            timer.restart();
+            exportNetlist(project, outputDir.getPathTo("netlist.csv")); // can throw
+            json.insert("netlist_ms", timer.elapsed());
+        }
+
+        // bill of materials and plane fragments of all boards
+        QList<Board*> boards = project.getBoards();
+        QVector<QJsonObject> boardsJson(boards.count());
+        QStringList boardDirNames;
+        for (int i = 0; i < boards.count(); ++i) {
+            Board& board = *boards.at(i);
+            QString dirName = FilePath::cleanFileName(board.getName(),
+                              FilePath::ReplaceSpaces | FilePath::KeepCase);
+            boardDirNames.append(dirName);
+            boardsJson[i].insert("name", board.getName());
+            if (mOptions.exportBom) {
+                timer.restart();
+                exportBom(board, outputDir.getPathTo("bom/" % dirName % ".csv")); // can throw
+                boardsJson[i].insert("bom_ms", timer.elapsed());
+            }
+            if (mOptions.exportGerber) {
+                timer.restart();
+                board.rebuildAllPlanes(); // only refills planes which are outdated
+                boardsJson[i].insert("planes_ms", timer.elapsed());
+            }
+        }
+
+        // the Gerber files of all boards are generated concurrently
+        if (mOptions.exportGerber) {
+            timer.restart();
+            QVector<QSharedPointer<BoardGerberExport>> exports;
+            QVector<QFuture<void>> futures;
+            for (int i = 0; i < boards.count(); ++i) {
+                FilePath gerberDir = outputDir.getPathTo("gerber");
+                if (boards.count() > 1) {
+                    gerberDir = gerberDir.getPathTo(boardDirNames.at(i));
+                }
+                QSharedPointer<BoardGerberExport> grbExport(
+                    new BoardGerberExport(*boards.at(i), gerberDir));
+                grbExport->setPanelSettings(BoardGerberExport::PanelSettings{
+                    mOptions.panelColumns, mOptions.panelRows, mOptions.panelSpacing,
+                    mOptions.panelRailWidth});
+                futures.append(grbExport->startExport()); // can throw
+                exports.append(grbExport);
+            }
+            QString error;
+            for (int i = 0; i < futures.count(); ++i) {
+                try {
+                    futures[i].waitForFinished(); // can throw
+                } catch (const Exception& e) {
+                    boardsJson[i].insert("error", e.getMsg());
+                    if (error.isEmpty()) error = e.getMsg();
+                }
+                // time until the files of this board were written (not exclusive)
+                boardsJson[i].insert("gerber_ms", timer.elapsed());
+                BoardGerberExport::DrillStatistics drills = exports.at(i)->getDrillStatistics();
+                QJsonObject drillsJson;
+                drillsJson.insert("holes", drills.holeCount);
+                drillsJson.insert("unoptimized_path_mm", drills.unoptimizedPathLength.toMm());
+                drillsJson.insert("optimized_path_mm", drills.optimizedPathLength.toMm());
+                drillsJson.insert("optimization_ms", drills.optimizationTimeMs);
+                boardsJson[i].insert("drills", drillsJson);
+            }
+            if (!error.isEmpty()) {
+                throw RuntimeError(__FILE__, __LINE__, error);
+            }
+        }
+
+        QJsonArray boardsArray;
+        foreach (const QJsonObject& boardJson, boardsJson) {
+            boardsArray.append(boardJson);
+        }
+        json.insert("boards", boardsArray);
+
+        if (!mOptions.compareWith.isEmpty()) {
+            timer.restart();
+            QJsonArray comparisons = compareOutputFiles(outputDir);
+            json.insert("comparisons", comparisons);
+            json.insert("compare_ms", timer.elapsed());
+            foreach (const QJsonValue& value, comparisons) {
+                if (!value.toObject().value("equal").toBool()) {
+                    throw RuntimeError(__FILE__, __LINE__, QString(tr("The file \"%1\" "
+                        "differs from the reference.")).arg(value.toObject()
+                        .value("file").toString()));
+                }
+            }
+        }
+        json.insert("success", true);
+    } catch (const Exception& e) {
+        json.insert("success", false);
+        json.insert("error", e.getMsg());
+    }
+    json.insert("total_ms", totalTimer.elapsed());
+    return json;
+}
+
+FilePath CommandLineInterface::getOutputDirectory(const Project& project) const noexcept
+{
+    if (mOptions.outputDir.isEmpty()) {
+        QString version = FilePath::cleanFileName(project.getMetadata().getVersion(),
+                          FilePath::ReplaceSpaces | FilePath::KeepCase);
+        return project.getPath().getPathTo(QString("output/%1").arg(version));
+    } else {
+        // the project directory name is unique even if several projects have the same name
+        FilePath dir(QFileInfo(mOptions.outputDir).absoluteFilePath());
+        return dir.getPathTo(project.getPath().getFilename());
+    }
+}
+
+QJsonArray CommandLineInterface::compareOutputFiles(const FilePath& outputDir) const noexcept
+{
+    FilePath referenceDir(QFileInfo(mOptions.compareWith).absoluteFilePath());
+    referenceDir = referenceDir.getPathTo(outputDir.getFilename());
+    QJsonArray comparisons;
+    QDirIterator it(outputDir.getPathTo("gerber").toStr(), QStringList{"*.gbr", "*.drl"},
+                    QDir::Files, QDirIterator::Subdirectories);
+    QStringList relativePaths;
+    while (it.hasNext()) {
+        relativePaths.append(FilePath(it.next()).toRelative(outputDir));
+    }
+    relativePaths.sort();
+    foreach (const QString& relativePath, relativePaths) {
+        QJsonObject json;
+        try {
+            json = compareFile(outputDir.getPathTo(relativePath),
+                               referenceDir.getPathTo(relativePath)); // can throw
+        } catch (const Exception& e) {
+            json.insert("equal", false);
+            json.insert("error", e.getMsg());
+        }
+        json.insert("file", relativePath);
+        comparisons.append(json);
+    }
+    return comparisons;
+}
+
+QJsonObject CommandLineInterface::compareFile(const FilePath& filepath,
+                                              const FilePath& referenceFilepath) const
+{
+    QElapsedTimer timer;
+    timer.start();
+    QByteArray content = FileUtils::readFile(filepath); // can throw
+    QByteArray referenceContent = FileUtils::readFile(referenceFilepath); // can throw
+
+    // a quarter pixel is accurate enough for the approximation of arcs
+    QVector<CamRasterizer::Object> objects, referenceObjects;
+    Length tolerance = std::max(mOptions.diffResolution / 4, Length(1));
+    if (filepath.getSuffix() == "drl") {
+        objects = ExcellonParser(tolerance).parse(content); // can throw
+        referenceObjects = ExcellonParser(tolerance).parse(referenceContent); // can throw
+    } else {
+        objects = GerberParser(tolerance).parse(content); // can throw
+        referenceObjects = GerberParser(tolerance).parse(referenceContent); // can throw
+    }
+
+    // rasterize both files with the same grid (covering both images)
+    Point bottomLeft, topRight;
+    if (!CamRasterizer::calcBoundingRect(objects + referenceObjects, bottomLeft, topRight)) {
+        bottomLeft = topRight = Point(); // both files are empty
+    }
+    const Length& res = mOptions.diffResolution;
+    bottomLeft -= Point(res, res);
+    topRight += Point(res, res);
+    int width = static_cast<int>(std::min((topRight.getX() - bottomLeft.getX()).toNm() /
+                                          res.toNm() + 1, qint64(INT_MAX)));
+    int height = static_cast<int>(std::min((topRight.getY() - bottomLeft.getY()).toNm() /
+                                           res.toNm() + 1, qint64(INT_MAX)));
+    CamRasterizer image(bottomLeft, res, width, height); // can throw
+    CamRasterizer referenceImage(bottomLeft, res, width, height); // can throw
+    image.draw(objects);
+    referenceImage.draw(referenceObjects);
+    qint64 differentPixels = image.getDifferentPixelCount(referenceImage); // can throw
+
+    QJsonObject json;
+    json.insert("equal", differentPixels == 0);
+    json.insert("different_pixels", differentPixels);
+    json.insert("dark_pixels", image.getDarkPixelCount());
+    json.insert("reference_dark_pixels", referenceImage.getDarkPixelCount());
+    json.insert("size", content.size());
+    json.insert("reference_size", referenceContent.size());
+    if (differentPixels > 0) {
+        // red: only in the new file, blue: only in the reference
+        QString diffFilepath = filepath.toStr() % ".diff.png";
+        if (image.createDiffImage(referenceImage).save(diffFilepath)) {
+            json.insert("diff_image", QDir::toNativeSeparators(diffFilepath));
+        }
+    }
+    json.insert("compare_ms", timer.elapsed());
+    return json;
+}
+
+void CommandLineInterface::exportBom(const Board& board, const FilePath& filepath)
+{
+    const QStringList& localeOrder = board.getProject().getSettings().getLocaleOrder();
+    QMap<QString, QString> rows; // sorted by designator
+    foreach (const BI_Device* device, board.getDeviceInstances()) {
+        const ComponentInstance& component = device->getComponentInstance();
+        rows.insertMulti(component.getName(), toCsvRow(QStringList{
+            component.getName(),
+            component.getValue(true),
+            device->getLibDevice().getNames().value(localeOrder),
+            device->getLibPackage().getNames().value(localeOrder)}));
+    }
+    QString content = toCsvRow(QStringList{"Designator", "Value", "Device", "Package"});
+    foreach (const QString& row, rows) {
+        content.append(row);
+    }
+    FileUtils::writeFile(filepath, content.toUtf8()); // can throw
+}
+
+void CommandLineInterface::exportNetlist(const Project& project, const FilePath& filepath)
+{
+    QMap<QString, QString> rows; // sorted by net name and designator
+    foreach (const NetSignal* netsignal, project.getCircuit().getNetSignals()) {
+        foreach (const ComponentSignalInstance* signal, netsignal->getComponentSignals()) {
+            const QString& designator = signal->getComponentInstance().getName();
+            rows.insertMulti(netsignal->getName() % '\t' % designator, toCsvRow(QStringList{
+                netsignal->getName(), designator, signal->getCompSignal().getName()}));
+        }
+    }
+    QString content = toCsvRow(QStringList{"Net", "Designator", "Signal"});
+    foreach (const QString& row, rows) {
+        content.append(row);
+    }
+    FileUtils::writeFile(filepath, content.toUtf8()); // can throw
+}
+
+bool CommandLineInterface::parseMillimeters(const QString& value, Length& length) noexcept
+{
+    try {
+        length = Length::fromMm(value); // can throw
+        return length >= 0;
+    } catch (const Exception&) {
+        return false;
+    }
+}
+
+QString CommandLineInterface::toCsvRow(const QStringList& fields) noexcept
+{
+    QStringList escaped;
+    foreach (QString field, fields) {
+        if (field.contains(',') || field.contains('"') || field.contains('\n')) {
+            field = '"' % field.replace('"', "\"\"") % '"';
+        }
+        escaped.append(field);
+    }
+    return escaped.join(',') % '\n';
+}
+
+QJsonObject CommandLineInterface::createErrorJson(const QString& projectFile,
+                                                  const QString& error) noexcept
+{
+    QJsonObject json;
+    json.insert("file", projectFile);
+    json.insert("success", false);
+    json.insert("error", error);
+    return json;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace cli
+} // namespace librepcb
@@ -0,0 +1,140 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CLI_COMMANDLINEINTERFACE_H
+#define LIBREPCB_CLI_COMMANDLINEINTERFACE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/units/all_length_units.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class FilePath;
+
+namespace project {
+class Board;
+class Project;
+}
+
+namespace cli {
+
+/*****************************************************************************************
+ *  Class CommandLineInterface
+ ****************************************************************************************/
+
+/**
+ * @brief The CommandLineInterface class implements the headless "librepcb-cli" tool
+ *
+ * All projects passed on the command line are opened in read-only mode (so they can
+ * even be exported while opened in the editor) and the requested outputs (Gerber/Excellon
+ * files, BOM and netlist) are generated without showing any window or message box.
+ *
+ * If several projects are passed and more than one job is allowed (see "--jobs"), every
+ * project is exported by a separate child process of this tool. This isolates the
+ * projects from each other (the project classes are not thread-safe) and scales across
+ * all cores. Within one process, the Gerber exports of all boards run concurrently.
+ *
+ * With "--panel", the Gerber/Excellon files contain a panel of several copies of each
+ * board (see librepcb::project::BoardGerberExport::setPanelSettings()).
+ *
+ * With "--json", a machine-readable summary with the timings of all steps is printed
+ * to stdout (log messages are always printed to stderr).
+ *
+ * With "--compare-with", every generated Gerber/Excellon file is compared with the file
+ * at the same path in a reference output directory (e.g. exported by an older version
+ * with "--output-dir"). Both files are parsed and rasterized (see
+ * librepcb::CamRasterizer) and the count of different pixels is reported together with
+ * the file sizes, so optimizations of the generators can be verified to not change the
+ * resulting image. For files with differences, a diff image is written next to them.
+ */
+class CommandLineInterface final
+{
+        Q_DECLARE_TR_FUNCTIONS(CommandLineInterface)
+
+    public:
+
+        // Constructors / Destructor
+        CommandLineInterface() noexcept;
+        CommandLineInterface(const CommandLineInterface& other) = delete;
+        ~CommandLineInterface() noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Parse the command line arguments of the application and run all exports
+         *
+         * @return The exit code of the application (0 if all exports succeeded)
+         */
+        int execute() noexcept;
+
+        // Operator Overloadings
+        CommandLineInterface& operator=(const CommandLineInterface& rhs) = delete;
+
+
+    private:
+
+        // Types
+        struct Options {
+            bool exportGerber;
+            bool exportBom;
+            bool exportNetlist;
+            QString outputDir;  ///< empty to export into the project directories
+            int jobs;           ///< max. count of concurrently exported projects
+            bool json;
+            QString compareWith; ///< reference output directory, empty to not compare
+            Length diffResolution;
+            int panelColumns;
+            int panelRows;
+            Length panelSpacing;
+            Length panelRailWidth;
+        };
+
+        // Private Methods
+        QJsonArray exportProjectsInChildProcesses(const QStringList& projectFiles) const noexcept;
+        QJsonObject exportProject(const QString& projectFile) const noexcept;
+        FilePath getOutputDirectory(const project::Project& project) const noexcept;
+        QJsonArray compareOutputFiles(const FilePath& outputDir) const noexcept;
+        QJsonObject compareFile(const FilePath& filepath,
+                                const FilePath& referenceFilepath) const;
+        static void exportBom(const project::Board& board, const FilePath& filepath);
+        static void exportNetlist(const project::Project& project, const FilePath& filepath);
+        static bool parseMillimeters(const QString& value, Length& length) noexcept;
+        static QString toCsvRow(const QStringList& fields) noexcept;
+        static QJsonObject createErrorJson(const QString& projectFile,
+                                           const QString& error) noexcept;
+
+
+        // Attributes
+        Options mOptions;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace cli
+} // namespace librepcb
+
+#endif // LIBREPCB_CLI_COMMANDLINEINTERFACE_H
@@ -16,7 +16,7 @@ include(../../common.pri)
 # Set preprocessor defines
 exists(../../.git):DEFINES += GIT_BRANCH=\\\"master\\\"
 
-QT += core widgets opengl network xml printsupport sql
+QT += core widgets opengl network xml printsupport sql concurrent svg
 
 win32 {
     # Windows-specific configurations
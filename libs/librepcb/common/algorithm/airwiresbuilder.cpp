@@ -0,0 +1,510 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <algorithm>
+#include <limits>
+#include "airwiresbuilder.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class DelaunayTriangulation
+ ****************************************************************************************/
+
+namespace {
+
+/**
+ * @brief Sweep-hull Delaunay triangulation (based on the "delaunator" algorithm)
+ *
+ * Points are inserted in the order of their distance to the center of a seed triangle,
+ * always connected to the visible part of the convex hull, and then legalized with
+ * edge flips. Points at identical coordinates are skipped. If all points are collinear,
+ * #isValid() returns false.
+ */
+class DelaunayTriangulation final
+{
+    public:
+
+        explicit DelaunayTriangulation(const QVector<qreal>& coords) noexcept :
+            mCoords(coords), mHullStart(-1), mHashSize(0), mCenterX(0), mCenterY(0)
+        {
+            triangulate();
+        }
+
+        bool isValid() const noexcept {return !mTriangles.isEmpty();}
+        const QVector<int>& getTriangles() const noexcept {return mTriangles;}
+        const QVector<int>& getHalfEdges() const noexcept {return mHalfEdges;}
+
+    private:
+
+        qreal x(int i) const noexcept {return mCoords[2 * i];}
+        qreal y(int i) const noexcept {return mCoords[2 * i + 1];}
+
+        static qreal dist(qreal ax, qreal ay, qreal bx, qreal by) noexcept {
+            qreal dx = ax - bx;
+            qreal dy = ay - by;
+            return dx * dx + dy * dy;
+        }
+
+        static qreal circumradius(qreal ax, qreal ay, qreal bx, qreal by,
+                                  qreal cx, qreal cy) noexcept {
+            qreal dx = bx - ax;
+            qreal dy = by - ay;
+            qreal ex = cx - ax;
+            qreal ey = cy - ay;
+            qreal bl = dx * dx + dy * dy;
+            qreal cl = ex * ex + ey * ey;
+            qreal d = dx * ey - dy * ex;
+            if ((bl > 0) && (cl > 0) && (d != 0)) {
+                qreal rx = (ey * bl - dy * cl) * 0.5 / d;
+                qreal ry = (dx * cl - ex * bl) * 0.5 / d;
+                return rx * rx + ry * ry;
+            } else {
+                return std::numeric_limits<qreal>::max();
+            }
+        }
+
+        static bool orient(qreal px, qreal py, qreal qx, qreal qy,
+                           qreal rx, qreal ry) noexcept {
+            return (qy - py) * (rx - qx) - (qx - px) * (ry - qy) < 0;
+        }
+
+        static bool inCircle(qreal ax, qreal ay, qreal bx, qreal by, qreal cx, qreal cy,
+                             qreal px, qreal py) noexcept {
+            qreal dx = ax - px;
+            qreal dy = ay - py;
+            qreal ex = bx - px;
+            qreal ey = by - py;
+            qreal fx = cx - px;
+            qreal fy = cy - py;
+            qreal ap = dx * dx + dy * dy;
+            qreal bp = ex * ex + ey * ey;
+            qreal cp = fx * fx + fy * fy;
+            return (dx * (ey * cp - bp * fy) - dy * (ex * cp - bp * fx) +
+                    ap * (ex * fy - ey * fx)) < 0;
+        }
+
+        static qreal pseudoAngle(qreal dx, qreal dy) noexcept {
+            if ((dx == 0) && (dy == 0)) return 0;
+            qreal p = dx / (qAbs(dx) + qAbs(dy));
+            return ((dy > 0) ? (3 - p) : (1 + p)) / 4; // [0..1]
+        }
+
+        int hashKey(qreal px, qreal py) const noexcept {
+            int key = qFloor(pseudoAngle(px - mCenterX, py - mCenterY) * mHashSize);
+            return qBound(0, key, mHashSize - 1);
+        }
+
+        void triangulate() noexcept {
+            int n = mCoords.count() / 2;
+            if (n < 3) return;
+
+            // find the point closest to the center of the bounding box as seed
+            qreal minX = std::numeric_limits<qreal>::max();
+            qreal minY = std::numeric_limits<qreal>::max();
+            qreal maxX = std::numeric_limits<qreal>::lowest();
+            qreal maxY = std::numeric_limits<qreal>::lowest();
+            for (int i = 0; i < n; ++i) {
+                minX = qMin(minX, x(i)); minY = qMin(minY, y(i));
+                maxX = qMax(maxX, x(i)); maxY = qMax(maxY, y(i));
+            }
+            qreal cx = (minX + maxX) / 2;
+            qreal cy = (minY + maxY) / 2;
+            int i0 = -1, i1 = -1, i2 = -1;
+            qreal minDist = std::numeric_limits<qreal>::max();
+            for (int i = 0; i < n; ++i) {
+                qreal d = dist(cx, cy, x(i), y(i));
+                if (d < minDist) {i0 = i; minDist = d;}
+            }
+
+            // find the point closest to the seed
+            minDist = std::numeric_limits<qreal>::max();
+            for (int i = 0; i < n; ++i) {
+                if (i == i0) continue;
+                qreal d = dist(x(i0), y(i0), x(i), y(i));
+                if ((d < minDist) && (d > 0)) {i1 = i; minDist = d;}
+            }
+            if (i1 < 0) return; // all points are identical
+
+            // find the third point which forms the smallest circumcircle with the first two
+            qreal minRadius = std::numeric_limits<qreal>::max();
+            for (int i = 0; i < n; ++i) {
+                if ((i == i0) || (i == i1)) continue;
+                qreal r = circumradius(x(i0), y(i0), x(i1), y(i1), x(i), y(i));
+                if (r < minRadius) {i2 = i; minRadius = r;}
+            }
+            if (i2 < 0) return; // all points are collinear
+
+            // orient the seed triangle counter-clockwise
+            if (orient(x(i0), y(i0), x(i1), y(i1), x(i2), y(i2))) {
+                std::swap(i1, i2);
+            }
+
+            // calculate the circumcenter of the seed triangle
+            {
+                qreal dx = x(i1) - x(i0);
+                qreal dy = y(i1) - y(i0);
+                qreal ex = x(i2) - x(i0);
+                qreal ey = y(i2) - y(i0);
+                qreal bl = dx * dx + dy * dy;
+                qreal cl = ex * ex + ey * ey;
+                qreal d = dx * ey - dy * ex;
+                mCenterX = x(i0) + (ey * bl - dy * cl) * 0.5 / d;
+                mCenterY = y(i0) + (dx * cl - ex * bl) * 0.5 / d;
+            }
+
+            // sort the points by distance from the seed triangle circumcenter
+            QVector<qreal> dists(n);
+            QVector<int> ids(n);
+            for (int i = 0; i < n; ++i) {
+                ids[i] = i;
+                dists[i] = dist(x(i), y(i), mCenterX, mCenterY);
+            }
+            std::sort(ids.begin(), ids.end(),
+                      [&dists](int a, int b) {return dists[a] < dists[b];});
+
+            // initialize the hull with the seed triangle
+            mHashSize = qCeil(qSqrt(n));
+            mHash.fill(-1, mHashSize);
+            mHullPrev.fill(-1, n);
+            mHullNext.fill(-1, n);
+            mHullTri.fill(-1, n);
+            mHullStart = i0;
+            mHullNext[i0] = mHullPrev[i2] = i1;
+            mHullNext[i1] = mHullPrev[i0] = i2;
+            mHullNext[i2] = mHullPrev[i1] = i0;
+            mHullTri[i0] = 0;
+            mHullTri[i1] = 1;
+            mHullTri[i2] = 2;
+            mHash[hashKey(x(i0), y(i0))] = i0;
+            mHash[hashKey(x(i1), y(i1))] = i1;
+            mHash[hashKey(x(i2), y(i2))] = i2;
+            mTriangles.reserve((2 * n - 5) * 3);
+            mHalfEdges.reserve((2 * n - 5) * 3);
+            addTriangle(i0, i1, i2, -1, -1, -1);
+
+            qreal xp = 0, yp = 0;
+            for (int k = 0; k < n; ++k) {
+                int i = ids[k];
+                qreal px = x(i);
+                qreal py = y(i);
+
+                // skip duplicate points
+                if ((k > 0) && (px == xp) && (py == yp)) continue;
+                xp = px;
+                yp = py;
+
+                // skip seed triangle points
+                if (((px == x(i0)) && (py == y(i0))) || ((px == x(i1)) && (py == y(i1))) ||
+                    ((px == x(i2)) && (py == y(i2)))) {
+                    continue;
+                }
+
+                // find a visible edge on the convex hull using the edge hash
+                int start = -1;
+                int key = hashKey(px, py);
+                for (int j = 0; j < mHashSize; ++j) {
+                    start = mHash[(key + j) % mHashSize];
+                    if ((start >= 0) && (start != mHullNext[start])) break;
+                }
+                start = mHullPrev[start];
+                int e = start;
+                int q = mHullNext[e];
+                while (!orient(px, py, x(e), y(e), x(q), y(q))) {
+                    e = q;
+                    if (e == start) {e = -1; break;}
+                    q = mHullNext[e];
+                }
+                if (e < 0) continue; // likely a near-duplicate point, skip it
+
+                // add the first triangle from the point
+                int t = addTriangle(e, i, mHullNext[e], -1, -1, mHullTri[e]);
+                mHullTri[i] = legalize(t + 2);
+                mHullTri[e] = t;
+
+                // walk forward through the hull, adding more triangles and flipping
+                int next = mHullNext[e];
+                q = mHullNext[next];
+                while (orient(px, py, x(next), y(next), x(q), y(q))) {
+                    t = addTriangle(next, i, q, mHullTri[i], -1, mHullTri[next]);
+                    mHullTri[i] = legalize(t + 2);
+                    mHullNext[next] = next; // mark as removed
+                    next = q;
+                    q = mHullNext[next];
+                }
+
+                // walk backward from the other side, adding more triangles and flipping
+                if (e == start) {
+                    q = mHullPrev[e];
+                    while (orient(px, py, x(q), y(q), x(e), y(e))) {
+                        t = addTriangle(q, i, e, -1, mHullTri[e], mHullTri[q]);
+                        legalize(t + 2);
+                        mHullTri[q] = t;
+                        mHullNext[e] = e; // mark as removed
+                        e = q;
+                        q = mHullPrev[e];
+                    }
+                }
+
+                // update the hull indices
+                mHullStart = mHullPrev[i] = e;
+                mHullNext[e] = mHullPrev[next] = i;
+                mHullNext[i] = next;
+                mHash[hashKey(px, py)] = i;
+                mHash[hashKey(x(e), y(e))] = e;
+            }
+        }
+
+        int addTriangle(int i0, int i1, int i2, int a, int b, int c) noexcept {
+            int t = mTriangles.count();
+            mTriangles.append(i0);
+            mTriangles.append(i1);
+            mTriangles.append(i2);
+            link(t, a);
+            link(t + 1, b);
+            link(t + 2, c);
+            return t;
+        }
+
+        void link(int a, int b) noexcept {
+            Q_ASSERT(a <= mHalfEdges.count());
+            if (a == mHalfEdges.count()) {
+                mHalfEdges.append(b);
+            } else {
+                mHalfEdges[a] = b;
+            }
+            if (b >= 0) {
+                Q_ASSERT(b <= mHalfEdges.count());
+                if (b == mHalfEdges.count()) {
+                    mHalfEdges.append(a);
+                } else {
+                    mHalfEdges[b] = a;
+                }
+            }
+        }
+
+        int legalize(int a) noexcept {
+            int i = 0;
+            int ar = 0;
+            mEdgeStack.clear();
+            while (true) {
+                int b = mHalfEdges[a];
+                int a0 = a - a % 3;
+                ar = a0 + (a + 2) % 3;
+                if (b < 0) {
+                    if (i == 0) break;
+                    a = mEdgeStack[--i];
+                    continue;
+                }
+                int b0 = b - b % 3;
+                int al = a0 + (a + 1) % 3;
+                int bl = b0 + (b + 2) % 3;
+                int p0 = mTriangles[ar];
+                int pr = mTriangles[a];
+                int pl = mTriangles[al];
+                int p1 = mTriangles[bl];
+                if (inCircle(x(p0), y(p0), x(pr), y(pr), x(pl), y(pl), x(p1), y(p1))) {
+                    mTriangles[a] = p1;
+                    mTriangles[b] = p0;
+                    int hbl = mHalfEdges[bl];
+                    if (hbl < 0) {
+                        // edge swapped on the other side of the hull (rare), fix hull link
+                        int e = mHullStart;
+                        do {
+                            if (mHullTri[e] == bl) {mHullTri[e] = a; break;}
+                            e = mHullPrev[e];
+                        } while (e != mHullStart);
+                    }
+                    link(a, hbl);
+                    link(b, mHalfEdges[ar]);
+                    link(ar, bl);
+                    int br = b0 + (b + 1) % 3;
+                    if (i < mEdgeStack.count()) {
+                        mEdgeStack[i] = br;
+                    } else {
+                        mEdgeStack.append(br);
+                    }
+                    ++i;
+                } else {
+                    if (i == 0) break;
+                    a = mEdgeStack[--i];
+                }
+            }
+            return ar;
+        }
+
+        const QVector<qreal>& mCoords;
+        QVector<int> mTriangles;
+        QVector<int> mHalfEdges;
+        QVector<int> mHullPrev;
+        QVector<int> mHullNext;
+        QVector<int> mHullTri;
+        int mHullStart;
+        QVector<int> mHash;
+        int mHashSize;
+        qreal mCenterX;
+        qreal mCenterY;
+        QVector<int> mEdgeStack;
+};
+
+} // namespace
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+AirWiresBuilder::AirWiresBuilder() noexcept
+{
+}
+
+AirWiresBuilder::~AirWiresBuilder() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+int AirWiresBuilder::addPoint(const Point& p) noexcept
+{
+    mPoints.append(p);
+    mParents.append(mPoints.count() - 1);
+    return mPoints.count() - 1;
+}
+
+void AirWiresBuilder::addEdge(int p1, int p2) noexcept
+{
+    Q_ASSERT((p1 >= 0) && (p1 < mPoints.count()));
+    Q_ASSERT((p2 >= 0) && (p2 < mPoints.count()));
+    unite(p1, p2);
+}
+
+AirWiresBuilder::AirWires AirWiresBuilder::buildAirWires() noexcept
+{
+    AirWires airWires;
+
+    // count the copper islands, nothing to do if everything is connected already
+    int islands = 0;
+    for (int i = 0; i < mPoints.count(); ++i) {
+        if (findRoot(i) == i) ++islands;
+    }
+    if (islands < 2) {
+        return airWires;
+    }
+
+    // Kruskal's algorithm on the candidate edges, with the existing connections
+    // already merged into the union-find structure
+    QVector<Edge> edges = getCandidateEdges();
+    std::sort(edges.begin(), edges.end(),
+              [](const Edge& a, const Edge& b) {return a.length < b.length;});
+    foreach (const Edge& edge, edges) {
+        if (unite(edge.p1, edge.p2)) {
+            airWires.append(qMakePair(mPoints.at(edge.p1), mPoints.at(edge.p2)));
+            if (--islands < 2) break;
+        }
+    }
+    return airWires;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+QVector<AirWiresBuilder::Edge> AirWiresBuilder::getCandidateEdges() const noexcept
+{
+    QVector<Edge> edges;
+    auto addEdge = [this, &edges](int p1, int p2) {
+        qreal dx = mPoints.at(p1).getX().toNm() - mPoints.at(p2).getX().toNm();
+        qreal dy = mPoints.at(p1).getY().toNm() - mPoints.at(p2).getY().toNm();
+        edges.append(Edge{p1, p2, dx * dx + dy * dy});
+    };
+
+    // points at identical positions are skipped by the triangulation, so connect
+    // them directly to the first point at the same position
+    QVector<int> sorted(mPoints.count());
+    for (int i = 0; i < sorted.count(); ++i) sorted[i] = i;
+    std::sort(sorted.begin(), sorted.end(), [this](int a, int b) {
+        const Point& pa = mPoints.at(a);
+        const Point& pb = mPoints.at(b);
+        return (pa.getX() != pb.getX()) ? (pa.getX() < pb.getX()) : (pa.getY() < pb.getY());
+    });
+    for (int i = 1; i < sorted.count(); ++i) {
+        if (mPoints.at(sorted.at(i)) == mPoints.at(sorted.at(i - 1))) {
+            addEdge(sorted.at(i - 1), sorted.at(i));
+        }
+    }
+
+    QVector<qreal> coords;
+    coords.reserve(mPoints.count() * 2);
+    foreach (const Point& p, mPoints) {
+        coords.append(p.getX().toMm());
+        coords.append(p.getY().toMm());
+    }
+    DelaunayTriangulation triangulation(coords);
+    if (triangulation.isValid()) {
+        const QVector<int>& triangles = triangulation.getTriangles();
+        const QVector<int>& halfEdges = triangulation.getHalfEdges();
+        for (int e = 0; e < triangles.count(); ++e) {
+            // each inner edge exists twice (once per adjacent triangle), take it once
+            if (e > halfEdges.at(e)) {
+                int next = (e % 3 == 2) ? (e - 2) : (e + 1);
+                addEdge(triangles.at(e), triangles.at(next));
+            }
+        }
+    } else {
+        // all points are collinear, so neighbours in sorted order are the candidates
+        for (int i = 1; i < sorted.count(); ++i) {
+            addEdge(sorted.at(i - 1), sorted.at(i));
+        }
+    }
+    return edges;
+}
+
+int AirWiresBuilder::findRoot(int p) noexcept
+{
+    while (mParents.at(p) != p) {
+        mParents[p] = mParents.at(mParents.at(p)); // path halving
+        p = mParents.at(p);
+    }
+    return p;
+}
+
+bool AirWiresBuilder::unite(int p1, int p2) noexcept
+{
+    int root1 = findRoot(p1);
+    int root2 = findRoot(p2);
+    if (root1 == root2) {
+        return false;
+    }
+    mParents[root2] = root1;
+    return true;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
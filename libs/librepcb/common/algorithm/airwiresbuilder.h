@@ -0,0 +1,97 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_AIRWIRESBUILDER_H
+#define LIBREPCB_AIRWIRESBUILDER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "../units/point.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class AirWiresBuilder
+ ****************************************************************************************/
+
+/**
+ * @brief The AirWiresBuilder class calculates the air wires (ratsnest) of a single net
+ *
+ * All anchors of a net (pads, vias, netpoints, ...) are added as points, and all
+ * existing copper connections between them are added as edges. The builder then
+ * calculates a minimum spanning tree over the resulting copper islands, i.e. the
+ * shortest set of straight connections which would connect all islands together.
+ *
+ * The candidate connections are taken from a Delaunay triangulation of all points,
+ * which is guaranteed to contain the minimum spanning tree. This keeps the runtime
+ * at O(n*log(n)) instead of O(n^2) for a complete graph, which is important because
+ * the air wires are rebuilt while the user drags devices around.
+ */
+class AirWiresBuilder final
+{
+    public:
+
+        // Types
+        typedef QVector<QPair<Point, Point>> AirWires;
+
+        // Constructors / Destructor
+        AirWiresBuilder() noexcept;
+        AirWiresBuilder(const AirWiresBuilder& other) = delete;
+        ~AirWiresBuilder() noexcept;
+
+        // General Methods
+        int addPoint(const Point& p) noexcept;
+        void addEdge(int p1, int p2) noexcept;
+        AirWires buildAirWires() noexcept;
+
+        // Operator Overloadings
+        AirWiresBuilder& operator=(const AirWiresBuilder& rhs) = delete;
+
+
+    private: // Types
+        struct Edge {
+            int p1;
+            int p2;
+            qreal length; ///< squared length in nanometers
+        };
+
+
+    private: // Methods
+        QVector<Edge> getCandidateEdges() const noexcept;
+        int findRoot(int p) noexcept;
+        bool unite(int p1, int p2) noexcept;
+
+
+    private: // Data
+        QVector<Point> mPoints;
+        QVector<int> mParents; ///< union-find parent of each point
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_AIRWIRESBUILDER_H
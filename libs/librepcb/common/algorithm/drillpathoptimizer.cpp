@@ -0,0 +1,291 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <algorithm>
+#include "drillpathoptimizer.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class PointGrid
+ ****************************************************************************************/
+
+namespace {
+
+/**
+ * @brief Uniform grid over a set of points to find the nearest points quickly
+ *
+ * The cell size is chosen to get about one point per cell. Points can be removed from
+ * the grid (e.g. after they were visited), then they are not found anymore.
+ */
+class PointGrid final
+{
+    public:
+
+        explicit PointGrid(const QVector<QPointF>& points) noexcept :
+            mPoints(points), mCount(0)
+        {
+            qreal left = 0, bottom = 0, right = 0, top = 0;
+            for (int i = 0; i < points.count(); ++i) {
+                const QPointF& p = points.at(i);
+                left = (i > 0) ? qMin(left, p.x()) : p.x();
+                bottom = (i > 0) ? qMin(bottom, p.y()) : p.y();
+                right = (i > 0) ? qMax(right, p.x()) : p.x();
+                top = (i > 0) ? qMax(top, p.y()) : p.y();
+            }
+            qreal width = qMax(right - left, qreal(1));
+            qreal height = qMax(top - bottom, qreal(1));
+            int count = qMax(points.count(), 1);
+            // the second term limits the cell count if all points are (almost) on a line
+            mCellSize = qMax(qSqrt(width * height / count), qMax(width, height) / count);
+            mLeft = left;
+            mBottom = bottom;
+            mColumns = static_cast<int>(width / mCellSize) + 1;
+            mRows = static_cast<int>(height / mCellSize) + 1;
+            mCells.resize(mColumns * mRows);
+            for (int i = 0; i < points.count(); ++i) {
+                mCells[cellIndex(column(points.at(i).x()), row(points.at(i).y()))].append(i);
+            }
+            mCount = points.count();
+        }
+
+        void remove(int index) noexcept {
+            const QPointF& p = mPoints.at(index);
+            QVector<int>& cell = mCells[cellIndex(column(p.x()), row(p.y()))];
+            int i = cell.indexOf(index);
+            if (i >= 0) {
+                cell[i] = cell.last();
+                cell.removeLast();
+                --mCount;
+            }
+        }
+
+        /**
+         * @brief Find the nearest points (sorted by distance, excluding one point)
+         */
+        QVector<int> findNearest(const QPointF& p, int count, int exclude) const noexcept {
+            QVector<QPair<qreal, int>> best; // squared distance and index, sorted
+            int col = column(p.x());
+            int rw = row(p.y());
+            int maxRing = qMax(mColumns, mRows);
+            for (int r = 0; (r <= maxRing) && (mCount > 0); ++r) {
+                // all points in this ring are at least (r - 1) cells away
+                qreal minDist = qMax(r - 1, 0) * mCellSize;
+                if ((best.count() >= count) && (best.last().first <= minDist * minDist)) break;
+                for (int y = rw - r; y <= rw + r; ++y) {
+                    if ((y < 0) || (y >= mRows)) continue;
+                    int step = ((y == rw - r) || (y == rw + r)) ? 1 : 2 * r;
+                    for (int x = col - r; x <= col + r; x += step) {
+                        if ((x < 0) || (x >= mColumns)) continue;
+                        for (int i : mCells.at(cellIndex(x, y))) {
+                            if (i == exclude) continue;
+                            qreal dx = mPoints.at(i).x() - p.x();
+                            qreal dy = mPoints.at(i).y() - p.y();
+                            QPair<qreal, int> candidate(dx * dx + dy * dy, i);
+                            if ((best.count() < count) || (candidate < best.last())) {
+                                best.insert(std::upper_bound(best.begin(), best.end(),
+                                                             candidate), candidate);
+                                if (best.count() > count) best.removeLast();
+                            }
+                        }
+                    }
+                }
+            }
+            QVector<int> indices;
+            indices.reserve(best.count());
+            foreach (const auto& item, best) {
+                indices.append(item.second);
+            }
+            return indices;
+        }
+
+    private:
+
+        int column(qreal x) const noexcept {
+            return qBound(0, static_cast<int>((x - mLeft) / mCellSize), mColumns - 1);
+        }
+        int row(qreal y) const noexcept {
+            return qBound(0, static_cast<int>((y - mBottom) / mCellSize), mRows - 1);
+        }
+        int cellIndex(int column, int row) const noexcept {return row * mColumns + column;}
+
+        const QVector<QPointF>& mPoints;
+        QVector<QVector<int>> mCells;
+        qreal mLeft;
+        qreal mBottom;
+        qreal mCellSize;
+        int mColumns;
+        int mRows;
+        int mCount;     ///< count of points in the grid (not removed)
+};
+
+} // namespace
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+DrillPathOptimizer::DrillPathOptimizer(const QVector<Point>& holes, const Point& start) noexcept :
+    mHoles(holes), mPoints(), mStart(holes.count())
+{
+    mPoints.reserve(holes.count() + 1);
+    foreach (const Point& hole, holes) {
+        mPoints.append(QPointF(hole.getX().toNm(), hole.getY().toNm()));
+    }
+    mPoints.append(QPointF(start.getX().toNm(), start.getY().toNm()));
+}
+
+DrillPathOptimizer::~DrillPathOptimizer() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+QVector<Point> DrillPathOptimizer::optimize() const noexcept
+{
+    QVector<int> path = buildNearestNeighborPath();
+    improvePath(path);
+
+    QVector<Point> holes;
+    holes.reserve(mHoles.count());
+    for (int i = 1; i < path.count(); ++i) { // skip the start point
+        holes.append(mHoles.at(path.at(i)));
+    }
+    return holes;
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+qreal DrillPathOptimizer::calcPathLength(const QVector<Point>& path, const Point& start) noexcept
+{
+    qreal length = 0;
+    Point pos = start;
+    foreach (const Point& hole, path) {
+        qreal dx = hole.getX().toNm() - pos.getX().toNm();
+        qreal dy = hole.getY().toNm() - pos.getY().toNm();
+        length += qSqrt(dx * dx + dy * dy);
+        pos = hole;
+    }
+    return length;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+QVector<int> DrillPathOptimizer::buildNearestNeighborPath() const noexcept
+{
+    PointGrid grid(mPoints);
+    QVector<int> path;
+    path.reserve(mPoints.count());
+    path.append(mStart);
+    grid.remove(mStart);
+    for (int i = 0; i < mHoles.count(); ++i) {
+        int next = grid.findNearest(mPoints.at(path.last()), 1, -1).value(0, -1);
+        Q_ASSERT(next >= 0);
+        grid.remove(next);
+        path.append(next);
+    }
+    return path;
+}
+
+void DrillPathOptimizer::improvePath(QVector<int>& path) const noexcept
+{
+    // the path starts with the (fixed) start point, reversing any part after it is a
+    // valid move since the end of the path is free
+    int count = path.count();
+    if (count < 3) return;
+
+    PointGrid grid(mPoints);
+    QVector<QVector<int>> neighbors(mPoints.count());
+    for (int i = 0; i < mPoints.count(); ++i) {
+        neighbors[i] = grid.findNearest(mPoints.at(i), sNeighborCount, i);
+    }
+    QVector<int> positions(mPoints.count());
+    for (int i = 0; i < count; ++i) {
+        positions[path.at(i)] = i;
+    }
+
+    bool improved = true;
+    for (int pass = 0; improved && (pass < sMaxPasses); ++pass) {
+        improved = false;
+        for (int i = 0; i < count - 1; ++i) {
+            int a = path.at(i);
+            int b = path.at(i + 1);
+            qreal ab = distance(a, b);
+            foreach (int c, neighbors.at(a)) {
+                qreal ac = distance(a, c);
+                if (ac >= ab) break; // neighbors are sorted, so no further gain possible
+                int j = positions.at(c);
+                int first, last;
+                qreal gain;
+                if (j > i + 1) {
+                    // a,[b..c],d --> a,[c..b],d
+                    gain = ab - ac;
+                    if (j + 1 < count) {
+                        int d = path.at(j + 1);
+                        gain += distance(c, d) - distance(b, d);
+                    }
+                    first = i + 1;
+                    last = j;
+                } else if (j < i) {
+                    // c,[d..a],b --> c,[a..d],b
+                    int d = path.at(j + 1);
+                    gain = distance(c, d) + ab - ac - distance(d, b);
+                    first = j + 1;
+                    last = i;
+                } else {
+                    continue; // c is b
+                }
+                if (gain > 1) { // at least 1nm, to avoid endless loops due to rounding
+                    std::reverse(path.begin() + first, path.begin() + last + 1);
+                    for (int k = first; k <= last; ++k) {
+                        positions[path.at(k)] = k;
+                    }
+                    improved = true;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+qreal DrillPathOptimizer::distance(int a, int b) const noexcept
+{
+    qreal dx = mPoints.at(a).x() - mPoints.at(b).x();
+    qreal dy = mPoints.at(a).y() - mPoints.at(b).y();
+    return qSqrt(dx * dx + dy * dy);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,104 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_DRILLPATHOPTIMIZER_H
+#define LIBREPCB_DRILLPATHOPTIMIZER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "../units/point.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class DrillPathOptimizer
+ ****************************************************************************************/
+
+/**
+ * @brief The DrillPathOptimizer class orders holes to get a short drilling path
+ *
+ * The path starts at a given position (e.g. the origin or the last hole of the previous
+ * tool) and visits all holes, the end is free. It is first built with the nearest
+ * neighbor heuristic and then improved with 2-opt moves until no move shortens it.
+ *
+ * Both steps only consider the closest holes of each hole (found with a uniform grid),
+ * so the runtime stays roughly linear for boards with many thousands of vias, while the
+ * result is typically within a few percent of the optimal path.
+ */
+class DrillPathOptimizer final
+{
+    public:
+
+        // Constructors / Destructor
+        DrillPathOptimizer() = delete;
+        DrillPathOptimizer(const DrillPathOptimizer& other) = delete;
+        DrillPathOptimizer(const QVector<Point>& holes, const Point& start) noexcept;
+        ~DrillPathOptimizer() noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Calculate the optimized path
+         *
+         * @return All holes in the order they should be drilled
+         */
+        QVector<Point> optimize() const noexcept;
+
+        // Operator Overloadings
+        DrillPathOptimizer& operator=(const DrillPathOptimizer& rhs) = delete;
+
+        // Static Methods
+
+        /**
+         * @brief Calculate the length of a path in nanometers
+         *
+         * @param path      All holes in the order they are drilled
+         * @param start     The position before drilling the first hole
+         */
+        static qreal calcPathLength(const QVector<Point>& path, const Point& start) noexcept;
+
+
+    private: // Methods
+        QVector<int> buildNearestNeighborPath() const noexcept;
+        void improvePath(QVector<int>& path) const noexcept;
+        qreal distance(int a, int b) const noexcept;
+
+
+    private: // Data
+        QVector<Point> mHoles;
+        QVector<QPointF> mPoints; ///< all holes and the start point (last) in nanometers
+        int mStart; ///< index of the start point in #mPoints
+
+        // Static Variables
+        static constexpr int sNeighborCount = 10;   ///< neighbors considered by 2-opt
+        static constexpr int sMaxPasses = 50;       ///< limits the 2-opt runtime
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_DRILLPATHOPTIMIZER_H
@@ -0,0 +1,539 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include "polygonclipper.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Contour Helpers
+ ****************************************************************************************/
+
+namespace {
+
+typedef QVector<Point> Contour;
+typedef QPair<LengthBase_t, LengthBase_t> Interval;
+
+struct DirectedEdge {
+    Point from;
+    Point to;
+};
+
+/// Twice the signed area, positive for counterclockwise contours
+qreal getArea(const Contour& contour) noexcept
+{
+    qreal area = 0;
+    for (int i = 0; i < contour.count(); ++i) {
+        const Point& a = contour.at(i);
+        const Point& b = contour.at((i + 1) % contour.count());
+        area += (qreal)a.getX().toNm() * b.getY().toNm()
+              - (qreal)b.getX().toNm() * a.getY().toNm();
+    }
+    return area;
+}
+
+/// Remove duplicate and collinear vertices
+Contour simplify(const Contour& contour) noexcept
+{
+    Contour result;
+    foreach (const Point& p, contour) {
+        if (result.isEmpty() || (result.last() != p)) result.append(p);
+    }
+    while ((result.count() > 1) && (result.first() == result.last())) result.removeLast();
+    for (int i = 0; (i < result.count()) && (result.count() > 2);) {
+        const Point& a = result.at((i + result.count() - 1) % result.count());
+        const Point& b = result.at(i);
+        const Point& c = result.at((i + 1) % result.count());
+        LengthBase_t cross = (b.getX() - a.getX()).toNm() * (c.getY() - a.getY()).toNm()
+                           - (b.getY() - a.getY()).toNm() * (c.getX() - a.getX()).toNm();
+        bool isReversal = ((b.getX() - a.getX()).toNm() * (c.getX() - b.getX()).toNm()
+                         + (b.getY() - a.getY()).toNm() * (c.getY() - b.getY()).toNm()) < 0;
+        if ((cross == 0) && (!isReversal)) {
+            result.remove(i); // keep cut-ins, which reverse the direction
+            if (i > 0) --i;
+        } else {
+            ++i;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Get the boundary of an island as directed edges (interior on the left side)
+ *
+ * The slanted sides of the trapezoids are always part of the boundary, while their
+ * horizontal edges are only where the area below and above differ.
+ */
+QVector<DirectedEdge> getBoundary(const QVector<PolygonClipper::Trapezoid>& trapezoids) noexcept
+{
+    QVector<DirectedEdge> edges;
+    QMap<LengthBase_t, QVector<Interval>> below; // key: y
+    QMap<LengthBase_t, QVector<Interval>> above; // key: y
+    foreach (const PolygonClipper::Trapezoid& t, trapezoids) {
+        edges.append(DirectedEdge{Point(t.bottomRight, t.bottom), Point(t.topRight, t.top)});
+        edges.append(DirectedEdge{Point(t.topLeft, t.top), Point(t.bottomLeft, t.bottom)});
+        if (t.topLeft < t.topRight) below[t.top].append(Interval(t.topLeft, t.topRight));
+        if (t.bottomLeft < t.bottomRight) above[t.bottom].append(Interval(t.bottomLeft, t.bottomRight));
+    }
+    QList<LengthBase_t> ys = below.keys() + above.keys();
+    std::sort(ys.begin(), ys.end());
+    ys.erase(std::unique(ys.begin(), ys.end()), ys.end());
+    foreach (LengthBase_t y, ys) {
+        QVector<Interval> b = below.value(y);
+        QVector<Interval> a = above.value(y);
+        std::sort(b.begin(), b.end());
+        std::sort(a.begin(), a.end());
+        QVector<LengthBase_t> xs;
+        foreach (const Interval& i, b + a) {
+            xs.append(i.first);
+            xs.append(i.second);
+        }
+        std::sort(xs.begin(), xs.end());
+        xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+
+        // the intervals of each side don't overlap, so a sweep finds all differences
+        int ib = 0, ia = 0;
+        int type = 0; // -1 = only below, 1 = only above
+        LengthBase_t start = 0, end = 0;
+        auto flush = [&]() {
+            if (type < 0) {
+                edges.append(DirectedEdge{Point(end, y), Point(start, y)});
+            } else if (type > 0) {
+                edges.append(DirectedEdge{Point(start, y), Point(end, y)});
+            }
+        };
+        for (int k = 0; k + 1 < xs.count(); ++k) {
+            LengthBase_t x1 = xs.at(k), x2 = xs.at(k + 1);
+            while ((ib < b.count()) && (b.at(ib).second <= x1)) ++ib;
+            while ((ia < a.count()) && (a.at(ia).second <= x1)) ++ia;
+            bool inBelow = (ib < b.count()) && (b.at(ib).first <= x1);
+            bool inAbove = (ia < a.count()) && (a.at(ia).first <= x1);
+            int t = (inBelow == inAbove) ? 0 : (inBelow ? -1 : 1);
+            if ((t == type) && (x1 == end)) {
+                end = x2;
+            } else {
+                flush();
+                type = t;
+                start = x1;
+                end = x2;
+            }
+        }
+        flush();
+    }
+    return edges;
+}
+
+/// Connect the directed boundary edges to closed contours
+QVector<Contour> traceContours(const QVector<DirectedEdge>& edges) noexcept
+{
+    QMultiHash<Interval, int> outgoing; // key: start point
+    for (int i = 0; i < edges.count(); ++i) {
+        const Point& p = edges.at(i).from;
+        outgoing.insert(Interval(p.getX().toNm(), p.getY().toNm()), i);
+    }
+    QVector<bool> used(edges.count(), false);
+    QVector<Contour> contours;
+    for (int i = 0; i < edges.count(); ++i) {
+        Contour contour;
+        for (int e = i; (e >= 0) && (!used.at(e));) {
+            used[e] = true;
+            contour.append(edges.at(e).from);
+            const Point& p = edges.at(e).to;
+            e = -1;
+            foreach (int next, outgoing.values(Interval(p.getX().toNm(), p.getY().toNm()))) {
+                if (!used.at(next)) {
+                    e = next;
+                    break;
+                }
+            }
+        }
+        contour = simplify(contour);
+        if (contour.count() > 2) {
+            contours.append(contour);
+        }
+    }
+    return contours;
+}
+
+/**
+ * @brief Connect a hole to the contour which encloses it with a zero-width cut-in
+ *
+ * A horizontal ray from the rightmost vertex of the hole to the first edge on its
+ * right side can't cross any other edge. As long as the holes are merged in order of
+ * their rightmost vertex, this also applies to holes which are not merged yet.
+ */
+bool mergeHole(QVector<Contour>& outers, const Contour& hole) noexcept
+{
+    int h = 0;
+    for (int i = 1; i < hole.count(); ++i) {
+        if (hole.at(i).getX() > hole.at(h).getX()) h = i;
+    }
+    const Point& start = hole.at(h);
+    qreal y = start.getY().toNm();
+    qreal bestX = std::numeric_limits<qreal>::max();
+    int bestContour = -1, bestEdge = -1;
+    for (int c = 0; c < outers.count(); ++c) {
+        const Contour& contour = outers.at(c);
+        for (int i = 0; i < contour.count(); ++i) {
+            const Point& p = contour.at(i);
+            const Point& q = contour.at((i + 1) % contour.count());
+            qreal y1 = p.getY().toNm(), y2 = q.getY().toNm();
+            if ((y1 == y2) || (y < qMin(y1, y2)) || (y > qMax(y1, y2))) continue;
+            qreal x = p.getX().toNm() + (q.getX() - p.getX()).toNm() * (y - y1) / (y2 - y1);
+            if ((x >= start.getX().toNm()) && (x < bestX)) {
+                bestX = x;
+                bestContour = c;
+                bestEdge = i;
+            }
+        }
+    }
+    if (bestContour < 0) {
+        return false;
+    }
+    const Contour& outer = outers.at(bestContour);
+    Point bridge(qRound64(bestX), start.getY().toNm());
+    Contour merged = outer.mid(0, bestEdge + 1);
+    merged.append(bridge);
+    for (int i = 0; i <= hole.count(); ++i) {
+        merged.append(hole.at((h + i) % hole.count()));
+    }
+    merged.append(bridge);
+    merged += outer.mid(bestEdge + 1);
+    outers[bestContour] = simplify(merged);
+    return true;
+}
+
+} // namespace
+
+/*****************************************************************************************
+ *  Struct Trapezoid
+ ****************************************************************************************/
+
+bool PolygonClipper::Trapezoid::contains(const Point& p) const noexcept
+{
+    LengthBase_t x = p.getX().toNm();
+    LengthBase_t y = p.getY().toNm();
+    if ((y < bottom) || (y > top)) {
+        return false;
+    }
+    qreal t = (qreal)(y - bottom) / (top - bottom);
+    qreal left = bottomLeft + (topLeft - bottomLeft) * t;
+    qreal right = bottomRight + (topRight - bottomRight) * t;
+    return (x >= left) && (x <= right);
+}
+
+QVector<Point> PolygonClipper::Trapezoid::toPolygon() const noexcept
+{
+    QVector<Point> polygon;
+    polygon.append(Point(bottomLeft, bottom));
+    if (bottomRight != bottomLeft) {
+        polygon.append(Point(bottomRight, bottom));
+    }
+    polygon.append(Point(topRight, top));
+    if (topLeft != topRight) {
+        polygon.append(Point(topLeft, top));
+    }
+    return polygon;
+}
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+PolygonClipper::PolygonClipper() noexcept
+{
+}
+
+PolygonClipper::~PolygonClipper() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void PolygonClipper::addPolygon(const QVector<Point>& polygon, int cls) noexcept
+{
+    Q_ASSERT((cls >= 0) && (cls < MaxClasses));
+
+    // normalize the orientation, otherwise overlapping polygons of the same class with
+    // opposite orientations would cancel each other out
+    qreal area = 0;
+    for (int i = 0; i < polygon.count(); ++i) {
+        const Point& a = polygon.at(i);
+        const Point& b = polygon.at((i + 1) % polygon.count());
+        area += (qreal)a.getX().toNm() * b.getY().toNm()
+              - (qreal)b.getX().toNm() * a.getY().toNm();
+    }
+    int winding = (area < 0) ? -1 : 1;
+
+    for (int i = 0; i < polygon.count(); ++i) {
+        const Point& a = polygon.at(i);
+        const Point& b = polygon.at((i + 1) % polygon.count());
+        if (a.getY() == b.getY()) {
+            continue; // horizontal edges do not affect the winding numbers
+        } else if (a.getY() < b.getY()) {
+            mEdges.append(Edge{a.getX().toNm(), a.getY().toNm(), b.getX().toNm(),
+                               b.getY().toNm(), cls, winding});
+        } else {
+            mEdges.append(Edge{b.getX().toNm(), b.getY().toNm(), a.getX().toNm(),
+                               a.getY().toNm(), cls, -winding});
+        }
+    }
+}
+
+QVector<PolygonClipper::Trapezoid> PolygonClipper::execute(const FillRule& rule,
+                                                           int* islandCount) const noexcept
+{
+    bool nothingInside[MaxClasses] = {false};
+    Q_ASSERT(!rule(nothingInside)); // otherwise the result would be infinite
+    Q_UNUSED(nothingInside);
+
+    QVector<Trapezoid> trapezoids;
+    QVector<int> parents; // union-find parent of each trapezoid
+    auto findRoot = [&parents](int i) {
+        while (parents[i] != i) {
+            parents[i] = parents[parents[i]];
+            i = parents[i];
+        }
+        return i;
+    };
+
+    // all edges sorted by their bottom end, and all y coordinates where edges start or end
+    QVector<int> edgesByBottom(mEdges.count());
+    std::iota(edgesByBottom.begin(), edgesByBottom.end(), 0);
+    std::sort(edgesByBottom.begin(), edgesByBottom.end(), [this](int a, int b) {
+        return mEdges.at(a).y1 < mEdges.at(b).y1;
+    });
+    QVector<LengthBase_t> ys;
+    ys.reserve(mEdges.count() * 2);
+    foreach (const Edge& edge, mEdges) {
+        ys.append(edge.y1);
+        ys.append(edge.y2);
+    }
+    std::sort(ys.begin(), ys.end());
+    ys.erase(std::unique(ys.begin(), ys.end()), ys.end());
+
+    // an active edge with its x coordinates at the bottom and top of the current slab
+    struct ActiveEdge {
+        int edge;
+        qreal bottom;
+        qreal top;
+    };
+    // a filled area within a slab, between two edges
+    struct Span {
+        int leftEdge;
+        int rightEdge;
+        qreal bottomLeft;
+        qreal bottomRight;
+        qreal topLeft;
+        qreal topRight;
+        int trapezoid;
+    };
+
+    QVector<ActiveEdge> active;
+    QVector<Span> previousSpans;
+    QVector<Span> spans;
+    int nextEdge = 0;
+    for (int i = 0; i + 1 < ys.count(); ++i) {
+        LengthBase_t y = ys.at(i);
+        LengthBase_t yTop = ys.at(i + 1);
+
+        // update the list of edges crossing this slab
+        active.erase(std::remove_if(active.begin(), active.end(), [&](const ActiveEdge& e) {
+            return mEdges.at(e.edge).y2 <= y;
+        }), active.end());
+        while ((nextEdge < edgesByBottom.count())
+               && (mEdges.at(edgesByBottom.at(nextEdge)).y1 <= y)) {
+            active.append(ActiveEdge{edgesByBottom.at(nextEdge++), 0, 0});
+        }
+
+        // edges may cross each other within the slab, so it is split at each crossing
+        // to get slabs where the order of the edges does not change
+        while (y < yTop) {
+            for (ActiveEdge& e : active) {
+                e.bottom = mEdges.at(e.edge).xAt(y);
+                e.top = mEdges.at(e.edge).xAt(yTop);
+            }
+            // insertion sort, as the order is mostly the same as in the previous slab
+            for (int k = 1; k < active.count(); ++k) {
+                ActiveEdge e = active.at(k);
+                int j = k;
+                while ((j > 0) && ((e.bottom < active.at(j - 1).bottom)
+                       || ((e.bottom == active.at(j - 1).bottom) && (e.top < active.at(j - 1).top)))) {
+                    active[j] = active.at(j - 1);
+                    --j;
+                }
+                active[j] = e;
+            }
+            // the first crossing is always between edges which are adjacent at the bottom
+            LengthBase_t yEnd = yTop;
+            for (int k = 0; k + 1 < active.count(); ++k) {
+                const ActiveEdge& a = active.at(k);
+                const ActiveEdge& b = active.at(k + 1);
+                if (a.top > b.top + 0.5) {
+                    qreal t = (b.bottom - a.bottom) / ((a.top - a.bottom) - (b.top - b.bottom));
+                    LengthBase_t yCross = y + (LengthBase_t)(t * (yTop - y));
+                    yEnd = qMin(yEnd, qMax(yCross, y + 1));
+                }
+            }
+            if (yEnd < yTop) {
+                for (ActiveEdge& e : active) {
+                    e.top = mEdges.at(e.edge).xAt(yEnd);
+                }
+            }
+
+            // sweep from left to right and collect all filled spans
+            int windings[MaxClasses] = {0};
+            bool inside[MaxClasses] = {false};
+            bool filled = false;
+            int left = -1;
+            spans.clear();
+            for (int k = 0; k < active.count(); ++k) {
+                const Edge& edge = mEdges.at(active.at(k).edge);
+                windings[edge.cls] += edge.winding;
+                inside[edge.cls] = (windings[edge.cls] != 0);
+                if ((k + 1 < active.count()) && (active.at(k + 1).bottom == active.at(k).bottom)
+                    && (active.at(k + 1).top == active.at(k).top)) {
+                    continue; // avoid zero-width gaps between coincident edges
+                }
+                bool fill = rule(inside);
+                if (fill && (!filled)) {
+                    left = k;
+                } else if ((!fill) && filled) {
+                    const ActiveEdge& l = active.at(left);
+                    const ActiveEdge& r = active.at(k);
+                    spans.append(Span{l.edge, r.edge, l.bottom, r.bottom, l.top, r.top, -1});
+                }
+                filled = fill;
+            }
+
+            // extend trapezoids of the previous slab which are bounded by the same edges,
+            // create new trapezoids for all others and connect overlapping ones
+            int p = 0;
+            for (Span& span : spans) {
+                // previous spans are sorted too, so only a small window needs to be checked
+                while ((p < previousSpans.count())
+                       && (previousSpans.at(p).topRight <= span.bottomLeft)) {
+                    ++p;
+                }
+                int end = p;
+                while ((end < previousSpans.count())
+                       && (previousSpans.at(end).topLeft < span.bottomRight)) {
+                    const Span& prev = previousSpans.at(end++);
+                    if ((prev.leftEdge == span.leftEdge) && (prev.rightEdge == span.rightEdge)) {
+                        span.trapezoid = prev.trapezoid;
+                    }
+                }
+                if (span.trapezoid >= 0) {
+                    Trapezoid& t = trapezoids[span.trapezoid];
+                    t.top = yEnd;
+                    t.topLeft = qRound64(span.topLeft);
+                    t.topRight = qRound64(span.topRight);
+                } else {
+                    span.trapezoid = trapezoids.count();
+                    trapezoids.append(Trapezoid{y, yEnd, qRound64(span.bottomLeft),
+                                                qRound64(span.bottomRight),
+                                                qRound64(span.topLeft),
+                                                qRound64(span.topRight), -1});
+                    parents.append(span.trapezoid);
+                }
+                for (int k = p; k < end; ++k) {
+                    parents[findRoot(previousSpans.at(k).trapezoid)] = findRoot(span.trapezoid);
+                }
+            }
+            previousSpans.swap(spans);
+            y = yEnd;
+        }
+    }
+
+    // assign island indices and remove degenerated trapezoids
+    QHash<int, int> islands;
+    QVector<Trapezoid> result;
+    result.reserve(trapezoids.count());
+    for (int i = 0; i < trapezoids.count(); ++i) {
+        Trapezoid t = trapezoids.at(i);
+        if ((t.bottomLeft < t.bottomRight) || (t.topLeft < t.topRight)) {
+            int root = findRoot(i);
+            if (!islands.contains(root)) {
+                islands.insert(root, islands.count());
+            }
+            t.island = islands.value(root);
+            result.append(t);
+        }
+    }
+    if (islandCount) {
+        *islandCount = islands.count();
+    }
+    return result;
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+QVector<QVector<Point>> PolygonClipper::mergeTrapezoids(const QVector<Trapezoid>& trapezoids) noexcept
+{
+    QMap<int, QVector<Trapezoid>> islands;
+    foreach (const Trapezoid& t, trapezoids) {
+        islands[t.island].append(t);
+    }
+
+    QVector<QVector<Point>> result;
+    foreach (const QVector<Trapezoid>& island, islands) {
+        QVector<Contour> outers;
+        QVector<Contour> holes;
+        foreach (const Contour& contour, traceContours(getBoundary(island))) {
+            qreal area = getArea(contour);
+            if (area > 0) {
+                outers.append(contour);
+            } else if (area < 0) {
+                holes.append(contour);
+            }
+        }
+        std::sort(holes.begin(), holes.end(), [](const Contour& a, const Contour& b) {
+            auto lessX = [](const Point& p1, const Point& p2) {return p1.getX() < p2.getX();};
+            return std::max_element(a.begin(), a.end(), lessX)->getX()
+                 > std::max_element(b.begin(), b.end(), lessX)->getX();
+        });
+        foreach (const Contour& hole, holes) {
+            if (!mergeHole(outers, hole)) {
+                outers.append(hole); // should not happen, but don't lose the outline
+            }
+        }
+        result += outers;
+    }
+    return result;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,126 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_POLYGONCLIPPER_H
+#define LIBREPCB_POLYGONCLIPPER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <functional>
+#include "../units/point.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class PolygonClipper
+ ****************************************************************************************/
+
+/**
+ * @brief The PolygonClipper class performs boolean operations on integer polygons
+ *
+ * Simple polygons (convex or concave, with any orientation) are added to one of up to
+ * #MaxClasses classes. Then #execute() sweeps a scanline over all edges and evaluates
+ * a fill rule for every area, based on whether the area is inside of any polygon of
+ * each class. This allows to express arbitrary combinations of unions, intersections
+ * and differences in a single pass, e.g. "inside class 0 and not inside class 1".
+ *
+ * The result is returned as a set of non-overlapping trapezoids with horizontal top
+ * and bottom edges. Trapezoids which touch each other along a horizontal line are
+ * assigned to the same island, so disconnected areas can be identified (and removed)
+ * by the caller. All coordinates are integer nanometers; intersections of edges are
+ * rounded to the nearest nanometer.
+ */
+class PolygonClipper final
+{
+    public:
+
+        // Types
+        enum {MaxClasses = 8};
+
+        /// Receives whether an area is inside of each class, returns whether to fill it
+        typedef std::function<bool(const bool* inside)> FillRule;
+
+        struct Trapezoid {
+            LengthBase_t bottom;
+            LengthBase_t top;
+            LengthBase_t bottomLeft;
+            LengthBase_t bottomRight;
+            LengthBase_t topLeft;
+            LengthBase_t topRight;
+            int island; ///< index of the connected area this trapezoid belongs to
+
+            bool contains(const Point& p) const noexcept;
+            QVector<Point> toPolygon() const noexcept;
+        };
+
+        // Constructors / Destructor
+        PolygonClipper() noexcept;
+        PolygonClipper(const PolygonClipper& other) = default;
+        ~PolygonClipper() noexcept;
+
+        // General Methods
+        void addPolygon(const QVector<Point>& polygon, int cls) noexcept;
+        QVector<Trapezoid> execute(const FillRule& rule, int* islandCount = nullptr) const noexcept;
+
+        // Static Methods
+
+        /**
+         * @brief Merge the trapezoids of each island into a single contour
+         *
+         * The outline of each island is traced and its holes are connected to it with
+         * zero-width cut-ins, so every island becomes one polygon in counterclockwise
+         * order (e.g. a single Gerber region without seams between the trapezoids).
+         */
+        static QVector<QVector<Point>> mergeTrapezoids(const QVector<Trapezoid>& trapezoids) noexcept;
+
+        // Operator Overloadings
+        PolygonClipper& operator=(const PolygonClipper& rhs) = default;
+
+
+    private: // Types
+        struct Edge {
+            LengthBase_t x1; ///< x coordinate at the bottom end
+            LengthBase_t y1; ///< y coordinate at the bottom end
+            LengthBase_t x2; ///< x coordinate at the top end
+            LengthBase_t y2; ///< y coordinate at the top end
+            int cls;
+            int winding;     ///< +1 for upwards edges, -1 for downwards edges
+
+            qreal xAt(LengthBase_t y) const noexcept {
+                return x1 + (qreal)(x2 - x1) * (y - y1) / (y2 - y1);
+            }
+        };
+
+
+    private: // Data
+        QVector<Edge> mEdges;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_POLYGONCLIPPER_H
@@ -0,0 +1,211 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_RTREE_H
+#define LIBREPCB_RTREE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <algorithm>
+#include "../units/point.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class RTree
+ ****************************************************************************************/
+
+/**
+ * @brief The RTree class is a static, bulk loaded R-tree for axis aligned boxes
+ *
+ * The tree is built once from all entries with the Sort-Tile-Recursive (STR) algorithm,
+ * which gives well balanced nodes with little overlap. It is meant for spatial queries
+ * on snapshots of geometry (e.g. the broad phase of the design rule check), so entries
+ * can't be added or removed after building it.
+ *
+ * @tparam T    The (cheap to copy) value type stored for each box, e.g. an index.
+ */
+template <typename T>
+class RTree final
+{
+    public:
+
+        /// An axis aligned box in nanometers (all bounds are inclusive)
+        struct Box {
+            LengthBase_t left;
+            LengthBase_t bottom;
+            LengthBase_t right;
+            LengthBase_t top;
+
+            Box() noexcept : left(0), bottom(0), right(-1), top(-1) {}
+            Box(const Point& p1, const Point& p2) noexcept :
+                left(qMin(p1.getX().toNm(), p2.getX().toNm())),
+                bottom(qMin(p1.getY().toNm(), p2.getY().toNm())),
+                right(qMax(p1.getX().toNm(), p2.getX().toNm())),
+                top(qMax(p1.getY().toNm(), p2.getY().toNm())) {}
+
+            bool isValid() const noexcept {return (left <= right) && (bottom <= top);}
+            bool intersects(const Box& other) const noexcept {
+                return (left <= other.right) && (other.left <= right)
+                    && (bottom <= other.top) && (other.bottom <= top);
+            }
+            Box expanded(LengthBase_t offset) const noexcept {
+                Box b(*this);
+                b.left -= offset; b.bottom -= offset; b.right += offset; b.top += offset;
+                return b;
+            }
+            Box united(const Box& other) const noexcept {
+                if (!isValid()) return other;
+                if (!other.isValid()) return *this;
+                Box b;
+                b.left = qMin(left, other.left);
+                b.bottom = qMin(bottom, other.bottom);
+                b.right = qMax(right, other.right);
+                b.top = qMax(top, other.top);
+                return b;
+            }
+        };
+
+        // Constructors / Destructor
+        RTree() noexcept {}
+        RTree(const RTree& other) = default;
+        ~RTree() noexcept {}
+
+        // Getters
+        int getCount() const noexcept {return mEntries.count();}
+        bool isEmpty() const noexcept {return mEntries.isEmpty();}
+
+        /**
+         * @brief Build the tree from all entries (replaces the previous content)
+         *
+         * Entries with invalid boxes are ignored.
+         */
+        void build(const QVector<QPair<Box, T>>& entries) noexcept {
+            mEntries.clear();
+            mLevels.clear();
+            mEntries.reserve(entries.count());
+            foreach (const auto& entry, entries) {
+                if (entry.first.isValid()) {
+                    mEntries.append(Entry{entry.first, entry.second});
+                }
+            }
+            if (mEntries.isEmpty()) return;
+
+            // leaf level: pack the entries themselves
+            QVector<Node> nodes = packLevel(mEntries);
+            mLevels.append(nodes);
+
+            // upper levels: pack the nodes of the level below until one root is left
+            while (mLevels.last().count() > 1) {
+                QVector<Node>& lower = mLevels.last();
+                QVector<Node> upper = packLevel(lower);
+                mLevels.append(upper);
+            }
+        }
+
+        /**
+         * @brief Call a function for each entry whose box intersects the given box
+         *
+         * @param box       The query box
+         * @param callback  Functor which is called as `callback(const T& value)`
+         */
+        template <typename F>
+        void query(const Box& box, F callback) const {
+            if (mLevels.isEmpty()) return;
+            QVarLengthArray<QPair<int, int>, 64> stack; // (level, index)
+            stack.append(qMakePair(mLevels.count() - 1, 0));
+            while (!stack.isEmpty()) {
+                QPair<int, int> item = stack.last();
+                stack.removeLast();
+                const Node& node = mLevels.at(item.first).at(item.second);
+                if (!node.box.intersects(box)) continue;
+                for (int i = node.begin; i < node.end; ++i) {
+                    if (item.first == 0) {
+                        const Entry& entry = mEntries.at(i);
+                        if (entry.box.intersects(box)) callback(entry.value);
+                    } else {
+                        stack.append(qMakePair(item.first - 1, i));
+                    }
+                }
+            }
+        }
+
+        // Operator Overloadings
+        RTree& operator=(const RTree& rhs) = default;
+
+
+    private: // Types
+        struct Entry {
+            Box box;
+            T value;
+        };
+        struct Node {
+            Box box;
+            int begin; ///< index of the first child in the level below (or mEntries)
+            int end;   ///< index after the last child
+        };
+
+
+    private: // Methods
+
+        /// Sort the children in place into STR order and create their parent nodes
+        template <typename Child>
+        static QVector<Node> packLevel(QVector<Child>& children) noexcept {
+            int count = children.count();
+            int nodeCount = (count + sMaxChildren - 1) / sMaxChildren;
+            int sliceCount = qCeil(qSqrt(nodeCount));
+            int sliceSize = sliceCount * sMaxChildren;
+            std::sort(children.begin(), children.end(), [](const Child& a, const Child& b){
+                return (a.box.left + a.box.right) < (b.box.left + b.box.right);});
+            for (int i = 0; i < count; i += sliceSize) {
+                std::sort(children.begin() + i, children.begin() + qMin(i + sliceSize, count),
+                          [](const Child& a, const Child& b){
+                    return (a.box.bottom + a.box.top) < (b.box.bottom + b.box.top);});
+            }
+            QVector<Node> nodes;
+            nodes.reserve(nodeCount);
+            for (int i = 0; i < count; i += sMaxChildren) {
+                Node node{Box(), i, qMin(i + sMaxChildren, count)};
+                for (int k = node.begin; k < node.end; ++k) {
+                    node.box = node.box.united(children.at(k).box);
+                }
+                nodes.append(node);
+            }
+            return nodes;
+        }
+
+
+    private: // Data
+        static constexpr int sMaxChildren = 16;
+        QVector<Entry> mEntries;
+        QVector<QVector<Node>> mLevels; ///< index 0 contains the leaf nodes
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_RTREE_H
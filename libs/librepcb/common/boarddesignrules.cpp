@@ -90,6 +90,22 @@ BoardDesignRules::BoardDesignRules(const SExpression& node) :
     if (const SExpression* e = node.tryGetChildByPath("restring_via_max")) {
         mRestringViaMax = e->getValueOfFirstChild<Length>(true);
     }
+    // design rule check
+    if (const SExpression* e = node.tryGetChildByPath("drc_min_copper_clearance")) {
+        mMinCopperClearance = e->getValueOfFirstChild<Length>(true);
+    }
+    if (const SExpression* e = node.tryGetChildByPath("drc_min_copper_width")) {
+        mMinCopperWidth = e->getValueOfFirstChild<Length>(true);
+    }
+    if (const SExpression* e = node.tryGetChildByPath("drc_min_annular_ring")) {
+        mMinAnnularRing = e->getValueOfFirstChild<Length>(true);
+    }
+    if (const SExpression* e = node.tryGetChildByPath("drc_min_drill_diameter")) {
+        mMinDrillDiameter = e->getValueOfFirstChild<Length>(true);
+    }
+    if (const SExpression* e = node.tryGetChildByPath("drc_min_outline_clearance")) {
+        mMinOutlineClearance = e->getValueOfFirstChild<Length>(true);
+    }
 }
 
 BoardDesignRules::~BoardDesignRules() noexcept
@@ -121,6 +137,12 @@ void BoardDesignRules::restoreDefaults() noexcept
     mRestringViaRatio = Ratio(250000);              // 25%
     mRestringViaMin = Length(200000);               // 0.2mm
     mRestringViaMax = Length(2000000);              // 2.0mm
+    // design rule check
+    mMinCopperClearance = Length(200000);           // 0.2mm
+    mMinCopperWidth = Length(200000);               // 0.2mm
+    mMinAnnularRing = Length(150000);               // 0.15mm
+    mMinDrillDiameter = Length(300000);             // 0.3mm
+    mMinOutlineClearance = Length(300000);          // 0.3mm
 }
 
 void BoardDesignRules::serialize(SExpression& root) const
@@ -146,6 +168,12 @@ void BoardDesignRules::serialize(SExpression& root) const
     root.appendTokenChild("restring_via_ratio",                  mRestringViaRatio, true);
     root.appendTokenChild("restring_via_min",                    mRestringViaMin, true);
     root.appendTokenChild("restring_via_max",                    mRestringViaMax, true);
+    // design rule check
+    root.appendTokenChild("drc_min_copper_clearance",            mMinCopperClearance, true);
+    root.appendTokenChild("drc_min_copper_width",                mMinCopperWidth, true);
+    root.appendTokenChild("drc_min_annular_ring",                mMinAnnularRing, true);
+    root.appendTokenChild("drc_min_drill_diameter",              mMinDrillDiameter, true);
+    root.appendTokenChild("drc_min_outline_clearance",           mMinOutlineClearance, true);
 }
 
 /*****************************************************************************************
@@ -210,6 +238,12 @@ BoardDesignRules& BoardDesignRules::operator=(const BoardDesignRules& rhs) noexc
     mRestringViaRatio               = rhs.mRestringViaRatio;
     mRestringViaMin                 = rhs.mRestringViaMin;
     mRestringViaMax                 = rhs.mRestringViaMax;
+    // design rule check
+    mMinCopperClearance             = rhs.mMinCopperClearance;
+    mMinCopperWidth                 = rhs.mMinCopperWidth;
+    mMinAnnularRing                 = rhs.mMinAnnularRing;
+    mMinDrillDiameter               = rhs.mMinDrillDiameter;
+    mMinOutlineClearance            = rhs.mMinOutlineClearance;
     return *this;
 }
 
@@ -237,6 +271,12 @@ bool BoardDesignRules::checkAttributesValidity() const noexcept
     if (mRestringViaRatio < 0)                              return false;
     if (mRestringViaMin < 0)                                return false;
     if (mRestringViaMax < mRestringViaMin)                  return false;
+    // design rule check
+    if (mMinCopperClearance < 0)                            return false;
+    if (mMinCopperWidth < 0)                                return false;
+    if (mMinAnnularRing < 0)                                return false;
+    if (mMinDrillDiameter < 0)                              return false;
+    if (mMinOutlineClearance < 0)                           return false;
     return true;
 }
 
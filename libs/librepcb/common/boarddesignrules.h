@@ -78,6 +78,13 @@ class BoardDesignRules final : public SerializableObject
         const Length& getRestringViaMin() const noexcept {return mRestringViaMin;}
         const Length& getRestringViaMax() const noexcept {return mRestringViaMax;}
 
+        // Getters: Design Rule Check
+        const Length& getMinCopperClearance() const noexcept {return mMinCopperClearance;}
+        const Length& getMinCopperWidth() const noexcept {return mMinCopperWidth;}
+        const Length& getMinAnnularRing() const noexcept {return mMinAnnularRing;}
+        const Length& getMinDrillDiameter() const noexcept {return mMinDrillDiameter;}
+        const Length& getMinOutlineClearance() const noexcept {return mMinOutlineClearance;}
+
 
         // Setters: General Attributes
         void setName(const QString& name) noexcept {if (!name.isEmpty()) mName = name;}
@@ -102,6 +109,13 @@ class BoardDesignRules final : public SerializableObject
         void setRestringViaMin(const Length& min) noexcept {if (min >= 0) mRestringViaMin = min;}
         void setRestringViaMax(const Length& max) noexcept {if (max >= 0) mRestringViaMax = max;}
 
+        // Setters: Design Rule Check
+        void setMinCopperClearance(const Length& min) noexcept {if (min >= 0) mMinCopperClearance = min;}
+        void setMinCopperWidth(const Length& min) noexcept {if (min >= 0) mMinCopperWidth = min;}
+        void setMinAnnularRing(const Length& min) noexcept {if (min >= 0) mMinAnnularRing = min;}
+        void setMinDrillDiameter(const Length& min) noexcept {if (min >= 0) mMinDrillDiameter = min;}
+        void setMinOutlineClearance(const Length& min) noexcept {if (min >= 0) mMinOutlineClearance = min;}
+
         // General Methods
         void restoreDefaults() noexcept;
 
@@ -145,6 +159,13 @@ class BoardDesignRules final : public SerializableObject
         Ratio mRestringViaRatio;
         Length mRestringViaMin;
         Length mRestringViaMax;
+
+        // Design Rule Check
+        Length mMinCopperClearance;
+        Length mMinCopperWidth;
+        Length mMinAnnularRing;
+        Length mMinDrillDiameter;
+        Length mMinOutlineClearance;
 };
 
 /*****************************************************************************************
@@ -0,0 +1,348 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "camrasterizer.h"
+#include "../exceptions.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+CamRasterizer::CamRasterizer(const Point& origin, const Length& resolution, int width,
+                             int height) :
+    mOrigin(origin), mResolution(resolution), mWidth(width), mHeight(height),
+    mWordsPerRow((width + 63) / 64)
+{
+    if (resolution <= 0) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Invalid resolution: %1 mm"))
+                           .arg(resolution.toMmString()));
+    }
+    if ((width <= 0) || (height <= 0) || (qint64(width) * height > sMaxPixelCount)) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Invalid bitmap size: %1x%2 "
+                           "pixels")).arg(width).arg(height));
+    }
+    mBits.fill(0, mWordsPerRow * height);
+}
+
+CamRasterizer::~CamRasterizer() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+bool CamRasterizer::isDark(int x, int y) const noexcept
+{
+    if ((x < 0) || (x >= mWidth) || (y < 0) || (y >= mHeight)) {
+        return false;
+    }
+    return (mBits.at(y * mWordsPerRow + x / 64) >> (x % 64)) & 1;
+}
+
+qint64 CamRasterizer::getDarkPixelCount() const noexcept
+{
+    qint64 count = 0;
+    foreach (quint64 word, mBits) {
+        count += qPopulationCount(word);
+    }
+    return count;
+}
+
+qint64 CamRasterizer::getDifferentPixelCount(const CamRasterizer& other) const
+{
+    if ((other.mWidth != mWidth) || (other.mHeight != mHeight)) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Cannot compare bitmaps of "
+            "different sizes (%1x%2 and %3x%4 pixels).")).arg(mWidth).arg(mHeight)
+            .arg(other.mWidth).arg(other.mHeight));
+    }
+    qint64 count = 0;
+    for (int i = 0; i < mBits.count(); ++i) {
+        count += qPopulationCount(mBits.at(i) ^ other.mBits.at(i));
+    }
+    return count;
+}
+
+QImage CamRasterizer::createDiffImage(const CamRasterizer& other) const
+{
+    getDifferentPixelCount(other); // throws if the sizes are different
+    QImage image(mWidth, mHeight, QImage::Format_RGB32);
+    for (int y = 0; y < mHeight; ++y) {
+        QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(mHeight - 1 - y));
+        for (int x = 0; x < mWidth; ++x) {
+            bool a = isDark(x, y);
+            bool b = other.isDark(x, y);
+            if (a && b) {
+                line[x] = qRgb(160, 160, 160);
+            } else if (a) {
+                line[x] = qRgb(255, 0, 0);
+            } else if (b) {
+                line[x] = qRgb(0, 0, 255);
+            } else {
+                line[x] = qRgb(255, 255, 255);
+            }
+        }
+    }
+    return image;
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void CamRasterizer::draw(const Object& object) noexcept
+{
+    if ((object.contours.count() == 1) && object.contours.first().dark) {
+        // fast path for simple objects: no mask required
+        forEachSpan(object.contours.first().vertices, [&](int row, int first, int end) {
+            setSpan(row, first, end, object.dark);
+        });
+    } else {
+        drawMasked(object);
+    }
+}
+
+void CamRasterizer::draw(const QVector<Object>& objects) noexcept
+{
+    foreach (const Object& object, objects) {
+        draw(object);
+    }
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+QVector<Point> CamRasterizer::createCircle(const Point& center, const Length& diameter,
+                                           const Length& tolerance) noexcept
+{
+    QVector<Point> vertices;
+    qreal radius = diameter.toNm() / qreal(2);
+    if (radius <= 0) {
+        return vertices;
+    }
+    // the sagitta of each segment must not exceed the tolerance
+    qreal ratio = qBound(qreal(-1), 1 - qMax(tolerance.toNm(), LengthBase_t(1)) / radius,
+                         qreal(1));
+    int count = qBound(8, qCeil(M_PI / qAcos(ratio)), 10000);
+    count = ((count + 3) / 4) * 4; // vertices on both axes keep the extents exact
+    vertices.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        qreal angle = 2 * M_PI * i / count;
+        vertices.append(center + Point(Length(qRound64(radius * qCos(angle))),
+                                       Length(qRound64(radius * qSin(angle)))));
+    }
+    return vertices;
+}
+
+bool CamRasterizer::calcBoundingRect(const QVector<Object>& objects, Point& bottomLeft,
+                                     Point& topRight) noexcept
+{
+    bool valid = false;
+    LengthBase_t minX = 0, minY = 0, maxX = 0, maxY = 0;
+    foreach (const Object& object, objects) {
+        foreach (const Contour& contour, object.contours) {
+            foreach (const Point& vertex, contour.vertices) {
+                LengthBase_t x = vertex.getX().toNm();
+                LengthBase_t y = vertex.getY().toNm();
+                minX = valid ? qMin(minX, x) : x;
+                minY = valid ? qMin(minY, y) : y;
+                maxX = valid ? qMax(maxX, x) : x;
+                maxY = valid ? qMax(maxY, y) : y;
+                valid = true;
+            }
+        }
+    }
+    bottomLeft = Point(minX, minY);
+    topRight = Point(maxX, maxY);
+    return valid;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+template <typename Function>
+void CamRasterizer::forEachSpan(const QVector<Point>& vertices,
+                                Function callback) const noexcept
+{
+    // A scanline algorithm with an active edge list. The scanline of a row goes through
+    // the centers of its pixels, edges are half-open (the upper end is excluded) so
+    // vertices on the scanline are counted only once.
+    struct Edge {
+        qint64 x1, y1, x2, y2;  ///< relative to the origin, y1 < y2
+        int direction;          ///< +1 for upwards, -1 for downwards edges
+        int firstRow;
+        int endRow;             ///< exclusive
+    };
+    const qint64 res = mResolution.toNm();
+    const qint64 half = res / 2;
+    const qint64 ox = mOrigin.getX().toNm();
+    const qint64 oy = mOrigin.getY().toNm();
+    QVector<Edge> edges;
+    edges.reserve(vertices.count());
+    for (int i = 0; i < vertices.count(); ++i) {
+        const Point& a = vertices.at(i);
+        const Point& b = vertices.at((i + 1) % vertices.count());
+        qint64 ax = a.getX().toNm() - ox, ay = a.getY().toNm() - oy;
+        qint64 bx = b.getX().toNm() - ox, by = b.getY().toNm() - oy;
+        if (ay == by) continue; // horizontal edges never cross a scanline
+        Edge edge = (ay < by) ? Edge{ax, ay, bx, by, 1, 0, 0} : Edge{bx, by, ax, ay, -1, 0, 0};
+        edge.firstRow = qMax(qint64(0), ceilDiv(edge.y1 - half, res));
+        edge.endRow = qMin(qint64(mHeight), ceilDiv(edge.y2 - half, res));
+        if (edge.firstRow < edge.endRow) {
+            edges.append(edge);
+        }
+    }
+    if (edges.isEmpty()) return;
+    std::sort(edges.begin(), edges.end(), [](const Edge& a, const Edge& b) {
+        return a.firstRow < b.firstRow;
+    });
+
+    QVector<int> active;
+    QVector<QPair<qint64, int>> crossings;
+    int next = 0;
+    for (int row = edges.first().firstRow; ; ++row) {
+        while ((next < edges.count()) && (edges.at(next).firstRow <= row)) {
+            active.append(next++);
+        }
+        for (int i = active.count() - 1; i >= 0; --i) {
+            if (edges.at(active.at(i)).endRow <= row) {
+                active.remove(i);
+            }
+        }
+        if (active.isEmpty()) {
+            if (next >= edges.count()) break;
+            row = edges.at(next).firstRow - 1; // skip empty rows
+            continue;
+        }
+        qint64 y = row * res + half;
+        crossings.clear();
+        foreach (int index, active) {
+            const Edge& e = edges.at(index);
+            qint64 x = e.x1 + floorDiv((y - e.y1) * (e.x2 - e.x1), e.y2 - e.y1);
+            crossings.append(qMakePair(x, e.direction));
+        }
+        std::sort(crossings.begin(), crossings.end());
+        int winding = 0;
+        qint64 spanStart = 0;
+        foreach (const auto& crossing, crossings) {
+            int previousWinding = winding;
+            winding += crossing.second;
+            if ((previousWinding == 0) && (winding != 0)) {
+                spanStart = crossing.first;
+            } else if ((previousWinding != 0) && (winding == 0)) {
+                // all pixels whose center is within [spanStart, crossing.first)
+                int first = qMax(qint64(0), ceilDiv(spanStart - half, res));
+                int end = qMin(qint64(mWidth), ceilDiv(crossing.first - half, res));
+                if (first < end) {
+                    callback(row, first, end);
+                }
+            }
+        }
+    }
+}
+
+void CamRasterizer::setSpan(int row, int firstColumn, int endColumn, bool dark) noexcept
+{
+    Q_ASSERT((row >= 0) && (row < mHeight));
+    Q_ASSERT((firstColumn >= 0) && (firstColumn < endColumn) && (endColumn <= mWidth));
+    quint64* words = mBits.data() + row * mWordsPerRow;
+    int firstWord = firstColumn / 64;
+    int lastWord = (endColumn - 1) / 64;
+    quint64 firstMask = ~quint64(0) << (firstColumn % 64);
+    quint64 lastMask = ~quint64(0) >> (63 - ((endColumn - 1) % 64));
+    for (int i = firstWord; i <= lastWord; ++i) {
+        quint64 mask = ~quint64(0);
+        if (i == firstWord) mask &= firstMask;
+        if (i == lastWord) mask &= lastMask;
+        if (dark) {
+            words[i] |= mask;
+        } else {
+            words[i] &= ~mask;
+        }
+    }
+}
+
+void CamRasterizer::drawMasked(const Object& object) noexcept
+{
+    Point bottomLeft, topRight;
+    if (!calcBoundingRect(QVector<Object>{object}, bottomLeft, topRight)) return;
+    const qint64 res = mResolution.toNm();
+    Point min = bottomLeft - mOrigin;
+    Point max = topRight - mOrigin;
+    int firstColumn = qMax(qint64(0), floorDiv(min.getX().toNm(), res));
+    int endColumn = qMin(qint64(mWidth), floorDiv(max.getX().toNm(), res) + 1);
+    int firstRow = qMax(qint64(0), floorDiv(min.getY().toNm(), res));
+    int endRow = qMin(qint64(mHeight), floorDiv(max.getY().toNm(), res) + 1);
+    if ((firstColumn >= endColumn) || (firstRow >= endRow)) return;
+
+    // draw all contours into a mask of the bounding rectangle
+    int maskWidth = endColumn - firstColumn;
+    QVector<bool> mask(maskWidth * (endRow - firstRow), false);
+    foreach (const Contour& contour, object.contours) {
+        forEachSpan(contour.vertices, [&](int row, int first, int end) {
+            bool* line = mask.data() + (row - firstRow) * maskWidth;
+            std::fill(line + qMax(first, firstColumn) - firstColumn,
+                      line + qMin(end, endColumn) - firstColumn, contour.dark);
+        });
+    }
+
+    // draw the mask with the polarity of the object
+    for (int row = firstRow; row < endRow; ++row) {
+        const bool* line = mask.constData() + (row - firstRow) * maskWidth;
+        int i = 0;
+        while (i < maskWidth) {
+            if (line[i]) {
+                int first = i;
+                while ((i < maskWidth) && line[i]) ++i;
+                setSpan(row, firstColumn + first, firstColumn + i, object.dark);
+            } else {
+                ++i;
+            }
+        }
+    }
+}
+
+qint64 CamRasterizer::floorDiv(qint64 a, qint64 b) noexcept
+{
+    Q_ASSERT(b > 0);
+    return (a >= 0) ? (a / b) : -((-a + b - 1) / b);
+}
+
+qint64 CamRasterizer::ceilDiv(qint64 a, qint64 b) noexcept
+{
+    Q_ASSERT(b > 0);
+    return (a >= 0) ? ((a + b - 1) / b) : -((-a) / b);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,176 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CAMRASTERIZER_H
+#define LIBREPCB_CAMRASTERIZER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include "../units/all_length_units.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class CamRasterizer
+ ****************************************************************************************/
+
+/**
+ * @brief The CamRasterizer class renders parsed CAM files into a monochrome bitmap
+ *
+ * It is used to compare Gerber and Excellon files geometrically (see
+ * librepcb::GerberParser and librepcb::ExcellonParser): two files generate the same
+ * image if their bitmaps rendered with the same origin and resolution don't differ.
+ *
+ * The rasterizer works only with integer arithmetic on the nanometer coordinates, so the
+ * result is exactly reproducible. A pixel is dark if its center is inside an object
+ * (nonzero winding rule per contour), objects are drawn in their order with their
+ * polarity. The pixels are stored as bits (one 64 bit word per 64 pixels of a row).
+ */
+class CamRasterizer final
+{
+        Q_DECLARE_TR_FUNCTIONS(CamRasterizer)
+
+    public:
+
+        // Types
+
+        /**
+         * @brief A closed polygon (the last vertex is connected to the first one)
+         */
+        struct Contour {
+            QVector<Point> vertices;
+            bool dark;  ///< false clears the contour area within its object
+        };
+
+        /**
+         * @brief A graphical object of a CAM file (e.g. a flash, a stroke or a region)
+         *
+         * The contours are drawn in their order into a mask of the object (this allows
+         * apertures with holes), the mask is then drawn with the object's polarity.
+         */
+        struct Object {
+            QVector<Contour> contours;
+            bool dark;  ///< false for clear polarity
+        };
+
+        // Constructors / Destructor
+        CamRasterizer() = delete;
+        CamRasterizer(const CamRasterizer& other) = delete;
+
+        /**
+         * @brief Constructor
+         *
+         * @param origin        Position of the bottom left corner of the bitmap
+         * @param resolution    Width and height of a pixel
+         * @param width         Count of pixel columns
+         * @param height        Count of pixel rows
+         *
+         * @throw Exception If the resolution or size is invalid or too large
+         */
+        CamRasterizer(const Point& origin, const Length& resolution, int width, int height);
+        ~CamRasterizer() noexcept;
+
+        // Getters
+        const Point& getOrigin() const noexcept {return mOrigin;}
+        const Length& getResolution() const noexcept {return mResolution;}
+        int getWidth() const noexcept {return mWidth;}
+        int getHeight() const noexcept {return mHeight;}
+        bool isDark(int x, int y) const noexcept;
+        qint64 getDarkPixelCount() const noexcept;
+
+        /**
+         * @brief Count the pixels which differ from another bitmap (XOR)
+         *
+         * @throw Exception If the bitmaps don't have the same size
+         */
+        qint64 getDifferentPixelCount(const CamRasterizer& other) const;
+
+        /**
+         * @brief Create an image which visualizes the differences to another bitmap
+         *
+         * Pixels which are only dark in this bitmap are red, pixels which are only dark
+         * in @p other are blue and pixels which are dark in both are gray.
+         *
+         * @throw Exception If the bitmaps don't have the same size
+         */
+        QImage createDiffImage(const CamRasterizer& other) const;
+
+        // General Methods
+        void draw(const Object& object) noexcept;
+        void draw(const QVector<Object>& objects) noexcept;
+
+        // Static Methods
+
+        /**
+         * @brief Create the polygon of a circle with a maximum deviation of @p tolerance
+         *
+         * The vertex count is a multiple of four, so the polygon touches the circle at
+         * its leftmost, rightmost, bottommost and topmost points.
+         */
+        static QVector<Point> createCircle(const Point& center, const Length& diameter,
+                                           const Length& tolerance) noexcept;
+
+        /**
+         * @brief Calculate the bounding rectangle of objects
+         *
+         * @return False if there is no vertex at all
+         */
+        static bool calcBoundingRect(const QVector<Object>& objects, Point& bottomLeft,
+                                     Point& topRight) noexcept;
+
+        // Operator Overloadings
+        CamRasterizer& operator=(const CamRasterizer& rhs) = delete;
+
+
+    private:
+
+        // Private Methods
+        template <typename Function>
+        void forEachSpan(const QVector<Point>& vertices, Function callback) const noexcept;
+        void setSpan(int row, int firstColumn, int endColumn, bool dark) noexcept;
+        void drawMasked(const Object& object) noexcept;
+        static qint64 floorDiv(qint64 a, qint64 b) noexcept;
+        static qint64 ceilDiv(qint64 a, qint64 b) noexcept;
+
+
+        // Attributes
+        Point mOrigin;
+        Length mResolution;
+        int mWidth;
+        int mHeight;
+        int mWordsPerRow;
+        QVector<quint64> mBits;
+
+        // Static Variables
+        static constexpr qint64 sMaxPixelCount = 2000000000; ///< 250MB of bits
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_CAMRASTERIZER_H
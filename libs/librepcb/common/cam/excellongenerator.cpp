@@ -22,6 +22,7 @@
  ****************************************************************************************/
 #include <QtCore>
 #include "excellongenerator.h"
+#include "../algorithm/drillpathoptimizer.h"
 #include "../fileio/smarttextfile.h"
 #include "../application.h"
 
@@ -35,7 +36,8 @@ namespace librepcb {
  ****************************************************************************************/
 
 ExcellonGenerator::ExcellonGenerator() noexcept :
-    mOutput()
+    mOutput(), mUnoptimizedPathLength(0), mOptimizedPathLength(0), mOptimizationTimeMs(0),
+    mStepAndRepeatColumns(1), mStepAndRepeatRows(1), mStepAndRepeatDistance()
 {
 }
 
@@ -43,18 +45,51 @@ ExcellonGenerator::~ExcellonGenerator() noexcept
 {
 }
 
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+int ExcellonGenerator::getHoleCount() const noexcept
+{
+    int count = 0;
+    foreach (const QVector<Point>& holes, mDrillList) {
+        count += holes.count();
+    }
+    return count;
+}
+
+Length ExcellonGenerator::getUnoptimizedPathLength() const noexcept
+{
+    return Length(qRound64(mUnoptimizedPathLength));
+}
+
+Length ExcellonGenerator::getOptimizedPathLength() const noexcept
+{
+    return Length(qRound64(mOptimizedPathLength));
+}
+
 /*****************************************************************************************
  *  General Methods
  ****************************************************************************************/
 
 void ExcellonGenerator::drill(const Point& pos, const Length& dia) noexcept
 {
-    mDrillList.insert(dia, pos);
+    mDrillList[dia].append(pos);
+    mOptimizedDrillList.clear(); // needs to be optimized again
+}
+
+void ExcellonGenerator::setStepAndRepeat(int columns, int rows, const Point& distance) noexcept
+{
+    Q_ASSERT((columns >= 1) && (rows >= 1));
+    mStepAndRepeatColumns = columns;
+    mStepAndRepeatRows = rows;
+    mStepAndRepeatDistance = distance;
 }
 
 void ExcellonGenerator::generate()
 {
     mOutput.clear();
+    optimizeDrillPaths();
     printHeader();
     printDrills();
     printFooter();
@@ -71,12 +106,41 @@ void ExcellonGenerator::reset() noexcept
 {
     mOutput.clear();
     mDrillList.clear();
+    mOptimizedDrillList.clear();
+    mUnoptimizedPathLength = 0;
+    mOptimizedPathLength = 0;
+    mOptimizationTimeMs = 0;
+    mStepAndRepeatColumns = 1;
+    mStepAndRepeatRows = 1;
+    mStepAndRepeatDistance = Point();
 }
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
+void ExcellonGenerator::optimizeDrillPaths() noexcept
+{
+    if (mOptimizedDrillList.count() == mDrillList.count()) {
+        return; // nothing added since the last optimization
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    mUnoptimizedPathLength = 0;
+    mOptimizedPathLength = 0;
+    Point unoptimizedPos, optimizedPos; // each tool starts at the last hole of the previous
+    for (auto it = mDrillList.constBegin(); it != mDrillList.constEnd(); ++it) {
+        mUnoptimizedPathLength += DrillPathOptimizer::calcPathLength(*it, unoptimizedPos);
+        unoptimizedPos = it->last();
+        QVector<Point> holes = DrillPathOptimizer(*it, optimizedPos).optimize();
+        mOptimizedPathLength += DrillPathOptimizer::calcPathLength(holes, optimizedPos);
+        optimizedPos = holes.last();
+        mOptimizedDrillList.insert(it.key(), holes);
+    }
+    mOptimizationTimeMs = timer.elapsed();
+}
+
 void ExcellonGenerator::printHeader() noexcept
 {
     mOutput.append("M48\n");        // Beginning of Part Program Header
@@ -85,6 +149,9 @@ void ExcellonGenerator::printHeader() noexcept
     mOutput.append(";DRILL FILE\n");
     mOutput.append(QString(";Generated by LibrePCB %1\n").arg(qApp->getAppVersion().toPrettyStr(3)));
     mOutput.append(QString(";Creation Date: %1\n").arg(QDateTime::currentDateTime().toString(Qt::ISODate)));
+    mOutput.append(QString(";Drill Path Length: %1mm (unoptimized: %2mm)\n")
+                   .arg(getOptimizedPathLength().toMmString(),
+                        getUnoptimizedPathLength().toMmString()));
     mOutput.append("FMAT,2\n");     // Use Format 2 commands
     mOutput.append("METRIC,TZ\n");  // Metric Format, Trailing Zeros Mode
 
@@ -98,21 +165,45 @@ void ExcellonGenerator::printHeader() noexcept
 
 void ExcellonGenerator::printToolList() noexcept
 {
-    for (int i = 0; i < mDrillList.uniqueKeys().count(); ++i) {
-        Length dia = mDrillList.uniqueKeys().value(i);
-        mOutput.append(QString("T%1C%2\n").arg(i+1).arg(dia.toMmString()));
+    int tool = 1;
+    foreach (const Length& dia, mDrillList.keys()) {
+        mOutput.append(QString("T%1C%2\n").arg(tool++).arg(dia.toMmString()));
     }
 }
 
 void ExcellonGenerator::printDrills() noexcept
 {
-    for (int i = 0; i < mDrillList.uniqueKeys().count(); ++i) {
-        mOutput.append(QString("T%1\n").arg(i+1)); // Select Tool
-        Length dia = mDrillList.uniqueKeys().value(i);
-        foreach (const Point& pos, mDrillList.values(dia)) {
+    bool repeat = (mStepAndRepeatColumns > 1) || (mStepAndRepeatRows > 1);
+    int tool = 1;
+    for (auto it = mOptimizedDrillList.constBegin(); it != mOptimizedDrillList.constEnd(); ++it) {
+        mOutput.append(QString("T%1\n").arg(tool++)); // Select Tool
+        if (repeat) mOutput.append("M25\n");         // Beginning of Pattern
+        foreach (const Point& pos, it.value()) {
             mOutput.append(QString("X%1Y%2\n").arg(pos.getX().toMmString(),
                                                    pos.getY().toMmString()));
         }
+        if (repeat) {
+            mOutput.append("M01\n");                 // End of Pattern
+            printPatternRepeats();
+            mOutput.append("M08\n");                 // End of Step and Repeat
+        }
+    }
+}
+
+void ExcellonGenerator::printPatternRepeats() noexcept
+{
+    // the offsets are relative to the pattern, the copies are visited row by row in
+    // alternating directions to keep the travel distance short
+    for (int row = 0; row < mStepAndRepeatRows; ++row) {
+        for (int i = 0; i < mStepAndRepeatColumns; ++i) {
+            int column = (row % 2 == 0) ? i : (mStepAndRepeatColumns - 1 - i);
+            if ((row == 0) && (column == 0)) {
+                continue; // the pattern itself
+            }
+            Length x = mStepAndRepeatDistance.getX() * column;
+            Length y = mStepAndRepeatDistance.getY() * row;
+            mOutput.append(QString("M02X%1Y%2\n").arg(x.toMmString(), y.toMmString()));
+        }
     }
 }
 
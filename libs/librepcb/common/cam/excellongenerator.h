@@ -40,6 +40,13 @@ namespace librepcb {
 /**
  * @brief The ExcellonGenerator class
  *
+ * The holes are grouped per tool (sorted by diameter) and the holes of each tool are
+ * ordered with librepcb::DrillPathOptimizer to reduce the machine travel distance.
+ *
+ * For panels (see #setStepAndRepeat()), the holes of each tool are written only once as
+ * a pattern (M25 ... M01) which is then repeated for every other copy of the board with
+ * M02 commands, so the file size doesn't grow with the number of copies.
+ *
  * @author ubruhin
  * @date 2016-03-31
  */
@@ -58,6 +65,32 @@ class ExcellonGenerator final
         // Getters
         const QString& toStr() const noexcept {return mOutput;}
 
+        /**
+         * @brief Get the count of holes of a single copy of the board
+         */
+        int getHoleCount() const noexcept;
+
+        /**
+         * @brief Get the travel distance of the holes in the order they were added
+         *
+         * Like the optimized path length and the optimization time, it is determined
+         * by the first #generate() after adding holes.
+         */
+        Length getUnoptimizedPathLength() const noexcept;
+        Length getOptimizedPathLength() const noexcept;
+        qint64 getOptimizationTimeMs() const noexcept {return mOptimizationTimeMs;}
+
+        // Setters
+
+        /**
+         * @brief Repeat all drills in a grid of @p columns times @p rows copies
+         *
+         * @param columns   Count of copies in X direction (at least 1)
+         * @param rows      Count of copies in Y direction (at least 1)
+         * @param distance  Step distance between the copies
+         */
+        void setStepAndRepeat(int columns, int rows, const Point& distance) noexcept;
+
         // General Methods
         void drill(const Point& pos, const Length& dia) noexcept;
         void generate();
@@ -70,15 +103,26 @@ class ExcellonGenerator final
 
     private:
 
+        void optimizeDrillPaths() noexcept;
         void printHeader() noexcept;
         void printToolList() noexcept;
         void printDrills() noexcept;
+        void printPatternRepeats() noexcept;
         void printFooter() noexcept;
 
 
         // Excellon Data
         QString mOutput;
-        QMultiMap<Length, Point> mDrillList;
+        QMap<Length, QVector<Point>> mDrillList; ///< key: diameter; value: holes (as added)
+        QMap<Length, QVector<Point>> mOptimizedDrillList; ///< like #mDrillList, drill order
+        qreal mUnoptimizedPathLength;   ///< in nanometers
+        qreal mOptimizedPathLength;     ///< in nanometers
+        qint64 mOptimizationTimeMs;
+
+        // Step and Repeat
+        int mStepAndRepeatColumns;
+        int mStepAndRepeatRows;
+        Point mStepAndRepeatDistance;
 };
 
 /*****************************************************************************************
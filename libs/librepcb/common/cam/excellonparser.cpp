@@ -0,0 +1,257 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "excellonparser.h"
+#include "../exceptions.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+ExcellonParser::ExcellonParser(const Length& arcTolerance) noexcept :
+    mArcTolerance(arcTolerance), mInHeader(false), mEndOfFile(false), mInch(false),
+    mLeadingZerosOmitted(true), mIntegerDigits(3), mDecimalDigits(3), mCurrentTool(0),
+    mPatternStart(-1)
+{
+}
+
+ExcellonParser::~ExcellonParser() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+QVector<CamRasterizer::Object> ExcellonParser::parse(const QByteArray& content)
+{
+    mInHeader = false;
+    mEndOfFile = false;
+    mInch = false;
+    mLeadingZerosOmitted = true;
+    mIntegerDigits = 3;
+    mDecimalDigits = 3;
+    mTools.clear();
+    mCurrentTool = 0;
+    mCurrentPosition = Point(0, 0);
+    mObjects.clear();
+    mPatternStart = -1;
+    mPattern.clear();
+
+    foreach (const QString& line, QString::fromLatin1(content).split('\n')) {
+        QString trimmed = line.trimmed();
+        if (!trimmed.isEmpty()) {
+            parseLine(trimmed); // can throw
+        }
+        if (mEndOfFile) break;
+    }
+    if (!mEndOfFile) {
+        throw RuntimeError(__FILE__, __LINE__, tr("Excellon file has no end of program "
+                                                  "command."));
+    }
+    if (mPatternStart >= 0) {
+        throw RuntimeError(__FILE__, __LINE__, tr("Excellon file has an unterminated "
+                                                  "pattern."));
+    }
+    QVector<CamRasterizer::Object> objects = mObjects;
+    mObjects.clear();
+    mPattern.clear();
+    return objects;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void ExcellonParser::parseLine(const QString& line)
+{
+    if (line.startsWith(';')) {
+        // comment
+    } else if (line == "M48") {
+        mInHeader = true;
+    } else if ((line == "%") || (line == "M95")) {
+        mInHeader = false;
+    } else if (line.startsWith("METRIC") || line.startsWith("INCH")) {
+        parseUnit(line); // can throw
+    } else if (line == "M71") {
+        mInch = false;
+    } else if (line == "M72") {
+        mInch = true;
+    } else if ((line == "M30") || (line == "M00")) {
+        mEndOfFile = true;
+    } else if (line.startsWith("FMAT") || line.startsWith("VER") || (line == "G90") ||
+               (line == "G05") || (line == "ICI,OFF")) {
+        // format version, absolute mode, drill mode: nothing to do
+    } else if (line == "M25") {
+        mPatternStart = mObjects.count(); // beginning of pattern
+    } else if ((line == "M01") && (mPatternStart >= 0)) {
+        mPattern = mObjects.mid(mPatternStart); // end of pattern
+        mPatternStart = -1;
+    } else if (line.startsWith("M02")) {
+        repeatPattern(line); // can throw
+    } else if (line == "M08") {
+        mPattern.clear(); // end of step and repeat
+    } else if (line.startsWith('T')) {
+        parseToolCommand(line); // can throw
+    } else if (line.startsWith('X') || line.startsWith('Y')) {
+        parseCoordinates(line); // can throw
+    } else {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Unsupported Excellon command: "
+                                                          "\"%1\"")).arg(line));
+    }
+}
+
+void ExcellonParser::parseUnit(const QString& line)
+{
+    QStringList parts = line.split(',');
+    mInch = (parts.first() == "INCH");
+    mIntegerDigits = mInch ? 2 : 3;
+    mDecimalDigits = mInch ? 4 : 3;
+    for (int i = 1; i < parts.count(); ++i) {
+        const QString& part = parts.at(i);
+        if (part == "TZ") {
+            mLeadingZerosOmitted = true; // trailing zeros are included
+        } else if (part == "LZ") {
+            mLeadingZerosOmitted = false; // leading zeros are included
+        } else if (QRegularExpression("^0+\\.0+$").match(part).hasMatch()) {
+            mIntegerDigits = part.indexOf('.');
+            mDecimalDigits = part.length() - mIntegerDigits - 1;
+        } else {
+            throw RuntimeError(__FILE__, __LINE__, QString(tr("Unsupported Excellon unit "
+                                                              "format: \"%1\"")).arg(line));
+        }
+    }
+}
+
+void ExcellonParser::parseToolCommand(const QString& line)
+{
+    QRegularExpressionMatch match = QRegularExpression("^T(\\d+)(.*)$").match(line);
+    int number = match.captured(1).toInt();
+    QRegularExpressionMatch diameter = QRegularExpression("C([0-9.]+)").match(match.captured(2));
+    if (diameter.hasMatch()) {
+        // tool definition (in the body, it also selects the tool)
+        bool ok = false;
+        qreal value = diameter.captured(1).toDouble(&ok);
+        if ((!ok) || (number <= 0)) {
+            throw RuntimeError(__FILE__, __LINE__, QString(tr("Invalid Excellon tool "
+                                                              "definition: \"%1\"")).arg(line));
+        }
+        mTools.insert(number, Length(qRound64(value * (mInch ? 25400000 : 1000000))));
+        if (!mInHeader) {
+            mCurrentTool = number;
+        }
+    } else if ((!match.hasMatch()) || (!match.captured(2).isEmpty())) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Unsupported Excellon tool "
+                                                          "command: \"%1\"")).arg(line));
+    } else if ((number != 0) && (!mTools.contains(number))) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Excellon tool T%1 is not "
+                                                          "defined.")).arg(number));
+    } else {
+        mCurrentTool = number; // T0 unloads the tool
+    }
+}
+
+void ExcellonParser::parseCoordinates(const QString& line)
+{
+    QRegularExpressionMatch match = QRegularExpression(
+        "^(?:X([+-]?[0-9.]+))?(?:Y([+-]?[0-9.]+))?$").match(line);
+    if (!match.hasMatch()) {
+        // e.g. slots (G85) or routing commands
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Unsupported Excellon command: "
+                                                          "\"%1\"")).arg(line));
+    }
+    if (mCurrentTool <= 0) {
+        throw RuntimeError(__FILE__, __LINE__, tr("Excellon file contains a drill without "
+                                                  "selected tool."));
+    }
+    // coordinates are modal
+    if (!match.captured(1).isEmpty()) {
+        mCurrentPosition.setX(parseCoordinate(match.captured(1)));
+    }
+    if (!match.captured(2).isEmpty()) {
+        mCurrentPosition.setY(parseCoordinate(match.captured(2)));
+    }
+    CamRasterizer::Contour contour{CamRasterizer::createCircle(mCurrentPosition,
+        mTools.value(mCurrentTool), mArcTolerance), true};
+    mObjects.append(CamRasterizer::Object{{contour}, true});
+}
+
+void ExcellonParser::repeatPattern(const QString& line)
+{
+    QRegularExpressionMatch match = QRegularExpression(
+        "^M02(?:X([+-]?[0-9.]+))?(?:Y([+-]?[0-9.]+))?$").match(line);
+    if ((!match.hasMatch()) || (mPatternStart >= 0)) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Invalid Excellon pattern "
+                                                          "repeat: \"%1\"")).arg(line));
+    }
+    // the offset is relative to the original pattern, not to the previous repetition
+    Point offset(0, 0);
+    if (!match.captured(1).isEmpty()) {
+        offset.setX(parseCoordinate(match.captured(1))); // can throw
+    }
+    if (!match.captured(2).isEmpty()) {
+        offset.setY(parseCoordinate(match.captured(2))); // can throw
+    }
+    foreach (CamRasterizer::Object object, mPattern) {
+        for (CamRasterizer::Contour& contour : object.contours) {
+            for (Point& vertex : contour.vertices) {
+                vertex += offset;
+            }
+        }
+        mObjects.append(object);
+    }
+}
+
+LengthBase_t ExcellonParser::parseCoordinate(const QString& number) const
+{
+    qreal nmPerUnit = mInch ? 25400000 : 1000000;
+    bool ok = false;
+    qreal value = 0;
+    if (number.contains('.')) {
+        value = number.toDouble(&ok);
+    } else {
+        bool negative = number.startsWith('-');
+        QString digits = (negative || number.startsWith('+')) ? number.mid(1) : number;
+        if (!mLeadingZerosOmitted) {
+            digits = digits.leftJustified(mIntegerDigits + mDecimalDigits, '0');
+        }
+        value = digits.toLongLong(&ok) / qPow(10, mDecimalDigits);
+        if (negative) value = -value;
+    }
+    if (!ok) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Invalid coordinate in Excellon "
+                                                          "file: \"%1\"")).arg(number));
+    }
+    return qRound64(value * nmPerUnit);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
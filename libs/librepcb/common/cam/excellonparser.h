@@ -0,0 +1,116 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_EXCELLONPARSER_H
+#define LIBREPCB_EXCELLONPARSER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "camrasterizer.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class ExcellonParser
+ ****************************************************************************************/
+
+/**
+ * @brief The ExcellonParser class reads the drills of Excellon files
+ *
+ * Supported are the commands written by librepcb::ExcellonGenerator and common variants
+ * of them (inch units, coordinates without decimal point, tool definitions in the body,
+ * repeated patterns).
+ * Routing and slot commands are not supported and raise an exception.
+ *
+ * @see librepcb::CamRasterizer
+ */
+class ExcellonParser final
+{
+        Q_DECLARE_TR_FUNCTIONS(ExcellonParser)
+
+    public:
+
+        // Constructors / Destructor
+        ExcellonParser() = delete;
+        ExcellonParser(const ExcellonParser& other) = delete;
+
+        /**
+         * @brief Constructor
+         *
+         * @param arcTolerance  Maximum deviation of the polygons from the drill circles
+         */
+        explicit ExcellonParser(const Length& arcTolerance) noexcept;
+        ~ExcellonParser() noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Parse the content of an Excellon file
+         *
+         * @return One object (a circle) per drill, in the order of the file
+         *
+         * @throw Exception If the file is invalid or uses unsupported features
+         */
+        QVector<CamRasterizer::Object> parse(const QByteArray& content);
+
+        // Operator Overloadings
+        ExcellonParser& operator=(const ExcellonParser& rhs) = delete;
+
+
+    private:
+
+        // Private Methods
+        void parseLine(const QString& line);
+        void parseUnit(const QString& line);
+        void parseToolCommand(const QString& line);
+        void parseCoordinates(const QString& line);
+        void repeatPattern(const QString& line);
+        LengthBase_t parseCoordinate(const QString& number) const;
+
+
+        // Attributes
+        Length mArcTolerance;
+
+        // Parser State
+        bool mInHeader;
+        bool mEndOfFile;
+        bool mInch;
+        bool mLeadingZerosOmitted;  ///< only relevant for numbers without decimal point
+        int mIntegerDigits;
+        int mDecimalDigits;
+        QMap<int, Length> mTools;
+        int mCurrentTool;       ///< 0 if no tool is selected
+        Point mCurrentPosition;
+        QVector<CamRasterizer::Object> mObjects;
+        int mPatternStart;      ///< index of the first object of the pattern, or -1
+        QVector<CamRasterizer::Object> mPattern; ///< the last pattern (M25 ... M01)
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_EXCELLONPARSER_H
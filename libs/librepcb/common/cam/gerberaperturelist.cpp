@@ -51,8 +51,8 @@ QString GerberApertureList::generateString() const noexcept
     foreach (const QString& macro, mApertureMacros) {
         str.append(QString("%AM%1*%\n").arg(macro));
     }
-    foreach (int number, mApertures.keys()) {
-        str.append(QString("%ADD%1%2*%\n").arg(number).arg(mApertures.value(number)));
+    for (int i = 0; i < mApertures.count(); ++i) {
+        str.append(QString("%ADD%1%2*%\n").arg(i + 10).arg(mApertures.at(i)));
     }
     str.append("G04 --- APERTURE LIST END --- *\n");
     return str;
@@ -64,40 +64,30 @@ QString GerberApertureList::generateString() const noexcept
 
 int GerberApertureList::setCircle(const Length& dia, const Length& hole)
 {
-    return setCurrentAperture(generateCircle(dia, hole));
+    return setCurrentAperture(Shape::Circle, dia, Length(0), Angle(0), hole);
 }
 
 int GerberApertureList::setRect(const Length& w, const Length& h, const Angle& rot, const Length& hole) noexcept
 {
     if (rot % Angle::deg180() == 0) {
-        return setCurrentAperture(generateRect(w, h, hole));
+        return setCurrentAperture(Shape::Rect, w, h, Angle(0), hole);
     } else if (rot % Angle::deg90() == 0) {
-        return setCurrentAperture(generateRect(h, w, hole));
+        return setCurrentAperture(Shape::Rect, h, w, Angle(0), hole);
     } else {
         // Rotation is not a multiple of 90 degrees --> we need to use an aperture macro
-        if (hole > 0) {
-            addMacro(generateRotatedRectMacroWithHole());
-        } else {
-            addMacro(generateRotatedRectMacro());
-        }
-        return setCurrentAperture(generateRotatedRect(w, h, rot, hole));
+        return setCurrentAperture(Shape::RotatedRect, w, h, rot, hole);
     }
 }
 
 int GerberApertureList::setObround(const Length& w, const Length& h, const Angle& rot, const Length& hole) noexcept
 {
     if (rot % Angle::deg180() == 0) {
-        return setCurrentAperture(generateObround(w, h, hole));
+        return setCurrentAperture(Shape::Obround, w, h, Angle(0), hole);
     } else if (rot % Angle::deg90() == 0) {
-        return setCurrentAperture(generateObround(h, w, hole));
+        return setCurrentAperture(Shape::Obround, h, w, Angle(0), hole);
     } else {
         // Rotation is not a multiple of 90 degrees --> we need to use an aperture macro
-        if (hole > 0) {
-            addMacro(generateRotatedObroundMacroWithHole());
-        } else {
-            addMacro(generateRotatedObroundMacro());
-        }
-        return setCurrentAperture(generateRotatedObround(w, h, rot, hole));
+        return setCurrentAperture(Shape::RotatedObround, w, h, rot, hole);
     }
 }
 
@@ -108,27 +98,48 @@ int GerberApertureList::setRegularPolygon(const Length& dia, int n, const Angle&
     }
     // Adjust rotation as its interpretation differs between LibrePCB and Gerber specs
     Angle grbRot = rot + (Angle::deg180() / (n > 0 ? n : 1));
-    return setCurrentAperture(generateRegularPolygon(dia, n, grbRot, hole));
+    return setCurrentAperture(Shape::RegularPolygon, dia, Length(0), grbRot, hole, n);
 }
 
 void GerberApertureList::reset() noexcept
 {
     //mApertureMacros.clear();
     mApertures.clear();
+    mApertureNumbers.clear();
 }
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
-int GerberApertureList::setCurrentAperture(const QString& aperture) noexcept
+int GerberApertureList::setCurrentAperture(Shape shape, const Length& width,
+                                           const Length& height, const Angle& rot,
+                                           const Length& hole, int vertices) noexcept
 {
-    int number = mApertures.key(aperture, -1);
-    if (number < 0) {
-        number = mApertures.count() + 10; // 10 is the number of the first aperture
-        Q_ASSERT(!mApertures.contains(number));
-        mApertures.insert(number, aperture);
+    Aperture aperture;
+    aperture.shape = shape;
+    aperture.width = width.toNm();
+    aperture.height = height.toNm();
+    aperture.rotation = rot.toMicroDeg();
+    aperture.hole = (hole > 0) ? hole.toNm() : 0; // the definition ignores negative holes
+    aperture.vertices = vertices;
+
+    auto it = mApertureNumbers.constFind(aperture);
+    if (it != mApertureNumbers.constEnd()) {
+        return it.value();
+    }
+
+    // new aperture --> generate its definition (and the macro it needs, if any)
+    if (shape == Shape::RotatedRect) {
+        addMacro((aperture.hole > 0) ? generateRotatedRectMacroWithHole()
+                                     : generateRotatedRectMacro());
+    } else if (shape == Shape::RotatedObround) {
+        addMacro((aperture.hole > 0) ? generateRotatedObroundMacroWithHole()
+                                     : generateRotatedObroundMacro());
     }
+    int number = mApertures.count() + 10; // 10 is the number of the first aperture
+    mApertures.append(generateAperture(aperture));
+    mApertureNumbers.insert(aperture, number);
     return number;
 }
 
@@ -143,6 +154,24 @@ void GerberApertureList::addMacro(const QString& macro) noexcept
  *  Aperture Generator Methods
  ****************************************************************************************/
 
+QString GerberApertureList::generateAperture(const Aperture& aperture) noexcept
+{
+    Length width(aperture.width);
+    Length height(aperture.height);
+    Angle rot(aperture.rotation);
+    Length hole(aperture.hole);
+    switch (aperture.shape)
+    {
+        case Shape::Circle:         return generateCircle(width, hole);
+        case Shape::Rect:           return generateRect(width, height, hole);
+        case Shape::Obround:        return generateObround(width, height, hole);
+        case Shape::RegularPolygon: return generateRegularPolygon(width, aperture.vertices, rot, hole);
+        case Shape::RotatedRect:    return generateRotatedRect(width, height, rot, hole);
+        case Shape::RotatedObround: return generateRotatedObround(width, height, rot, hole);
+        default: qCritical() << "Invalid aperture shape:" << static_cast<int>(aperture.shape); return QString();
+    }
+}
+
 QString GerberApertureList::generateCircle(const Length& dia, const Length& hole) noexcept
 {
     if (hole > 0) {
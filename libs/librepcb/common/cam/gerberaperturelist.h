@@ -41,6 +41,10 @@ namespace librepcb {
 /**
  * @brief The GerberApertureList class
  *
+ * Apertures are identified by a compact binary descriptor (shape, sizes and rotation)
+ * which is looked up in a hash map, so the aperture definition string is generated
+ * only once per aperture, not for every flash or line using it.
+ *
  * @author ubruhin
  * @date 2016-03-31
  */
@@ -72,11 +76,42 @@ class GerberApertureList final
 
     private:
 
+        // Private Types
+        enum class Shape {Circle, Rect, Obround, RegularPolygon, RotatedRect, RotatedObround};
+
+        /**
+         * @brief The binary descriptor of an aperture
+         *
+         * Unused fields must be zero, so equal apertures have equal descriptors.
+         */
+        struct Aperture {
+            Shape shape;
+            LengthBase_t width;     ///< width or diameter
+            LengthBase_t height;
+            qint32 rotation;        ///< in microdegrees
+            LengthBase_t hole;      ///< zero if there is no hole
+            int vertices;           ///< only for regular polygons
+
+            bool operator==(const Aperture& rhs) const noexcept {
+                return (shape == rhs.shape) && (width == rhs.width) &&
+                       (height == rhs.height) && (rotation == rhs.rotation) &&
+                       (hole == rhs.hole) && (vertices == rhs.vertices);
+            }
+            friend uint qHash(const Aperture& key, uint seed = 0) noexcept {
+                return ::qHash(qMakePair(
+                    qMakePair(static_cast<int>(key.shape), key.vertices),
+                    qMakePair(qMakePair(key.width, key.height),
+                              qMakePair(key.rotation, key.hole))), seed);
+            }
+        };
+
         // Private Methods
-        int setCurrentAperture(const QString& aperture) noexcept;
+        int setCurrentAperture(Shape shape, const Length& width, const Length& height,
+                               const Angle& rot, const Length& hole, int vertices = 0) noexcept;
         void addMacro(const QString& macro) noexcept;
 
         // Aperture Generator Methods
+        static QString generateAperture(const Aperture& aperture) noexcept;
         static QString generateCircle(const Length& dia, const Length& hole) noexcept;
         static QString generateRect(const Length& w, const Length& h, const Length& hole) noexcept;
         static QString generateObround(const Length& w, const Length& h, const Length& hole) noexcept;
@@ -90,7 +125,8 @@ class GerberApertureList final
 
 
         QList<QString> mApertureMacros;
-        QMap<int, QString> mApertures; ///< key: aperture number (>= 10); value: aperture definition
+        QVector<QString> mApertures; ///< aperture definitions, index 0 is aperture number 10
+        QHash<Aperture, int> mApertureNumbers; ///< value: aperture number (>= 10)
 };
 
 /*****************************************************************************************
@@ -25,7 +25,7 @@
 #include "gerberaperturelist.h"
 #include "../geometry/ellipse.h"
 #include "../geometry/path.h"
-#include "../fileio/smarttextfile.h"
+#include "../fileio/fileutils.h"
 #include "../application.h"
 #include "../toolbox.h"
 
@@ -41,10 +41,14 @@ namespace librepcb {
 GerberGenerator::GerberGenerator(const QString& projName, const Uuid& projUuid,
                                  const QString& projRevision) noexcept :
     mProjectId(escapeString(projName)), mProjectUuid(projUuid),
-    mProjectRevision(escapeString(projRevision)), mOutput(), mContent(),
-    mApertureList(new GerberApertureList()), mCurrentApertureNumber(-1),
-    mMultiQuadrantArcModeOn(false)
+    mProjectRevision(escapeString(projRevision)), mHeader(), mFooter(), mContentBuffer(),
+    mContentFile(), mContentFileFailed(false), mContentFileError(), mApertureList(new GerberApertureList()),
+    mCurrentApertureNumber(-1), mMultiQuadrantArcModeOn(false),
+    mInterpolationMode(InterpolationMode::Linear), mCurrentPosition(),
+    mCurrentPositionValid(false), mLinePending(false), mPendingLineEnd(), mRegionOpen(false),
+    mInArea(false)
 {
+    mContentBuffer.reserve(sContentBufferSize);
 }
 
 GerberGenerator::~GerberGenerator() noexcept
@@ -59,8 +63,8 @@ void GerberGenerator::setLayerPolarity(LayerPolarity p) noexcept
 {
     switch (p)
     {
-        case LayerPolarity::Positive: mContent.append("%LPD*%\n"); break;
-        case LayerPolarity::Negative: mContent.append("%LPC*%\n"); break;
+        case LayerPolarity::Positive: prepareCommand(); appendCommand("%LPD*%\n"); break;
+        case LayerPolarity::Negative: prepareCommand(); appendCommand("%LPC*%\n"); break;
         default: qCritical() << "Invalid Layer Polarity:" << static_cast<int>(p); break;
     }
 }
@@ -190,32 +194,85 @@ void GerberGenerator::flashRegularPolygon(const Point& pos, const Length& dia, i
     flashAtPosition(pos);
 }
 
+void GerberGenerator::beginStepAndRepeat(int columns, int rows, const Point& distance) noexcept
+{
+    Q_ASSERT((columns >= 1) && (rows >= 1));
+    Q_ASSERT((distance.getX() >= 0) && (distance.getY() >= 0));
+    prepareCommand();
+    QByteArray cmd = QString("%SRX%1Y%2I%3J%4*%\n").arg(columns).arg(rows)
+                     .arg(distance.getX().toMmString(), distance.getY().toMmString())
+                     .toLatin1();
+    appendCommand(cmd.constData());
+    mCurrentPositionValid = false; // the current point is undefined after SR commands
+}
+
+void GerberGenerator::endStepAndRepeat() noexcept
+{
+    prepareCommand();
+    appendCommand("%SR*%\n");
+    mCurrentPositionValid = false;
+}
+
 /*****************************************************************************************
  *  General Methods
  ****************************************************************************************/
 
 void GerberGenerator::reset() noexcept
 {
-    mOutput.clear();
-    mContent.clear();
+    mHeader.clear();
+    mFooter.clear();
+    mContentBuffer.resize(0); // keeps the reserved capacity
+    mContentFile.reset();
+    mContentFileFailed = false;
+    mContentFileError.clear();
     mApertureList->reset();
     mCurrentApertureNumber = -1;
+    mMultiQuadrantArcModeOn = false;
+    mInterpolationMode = InterpolationMode::Linear;
+    mCurrentPositionValid = false;
+    mLinePending = false;
+    mRegionOpen = false;
+    mInArea = false;
 }
 
 void GerberGenerator::generate()
 {
-    mOutput.clear();
+    prepareCommand(); // write the pending line and close the region, if any
+
+    mHeader.clear();
     printHeader();
     printApertureList();
-    printContent();
-    printFooter();
+    mHeader.append("G04 --- BOARD BEGIN --- *\n");
+
+    // according to the RS-274C standard, linebreaks are not included in the checksum
+    QCryptographicHash md5(QCryptographicHash::Md5);
+    addToChecksum(md5, mHeader.constData(), mHeader.size());
+    readContent([&md5](const char* data, qint64 size){addToChecksum(md5, data, size);});
+    const char* boardEnd = "G04 --- BOARD END --- *\n";
+    addToChecksum(md5, boardEnd, qstrlen(boardEnd));
+
+    mFooter = boardEnd;
+    printFooter(md5.result().toHex());
 }
 
 void GerberGenerator::saveToFile(const FilePath& filepath) const
 {
-    QScopedPointer<SmartTextFile> file(SmartTextFile::create(filepath));
-    file->setContent(mOutput.toLatin1());
-    file->save(true);
+    FileUtils::makePath(filepath.getParentDir()); // can throw
+    QSaveFile file(filepath.toStr());
+    if (!file.open(QIODevice::WriteOnly)) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("Could not open or create file \"%1\": %2"))
+            .arg(filepath.toNative(), file.errorString()));
+    }
+    bool success = (file.write(mHeader) == mHeader.size());
+    readContent([&file, &success](const char* data, qint64 size){
+        success = success && (file.write(data, size) == size);
+    });
+    success = success && (file.write(mFooter) == mFooter.size());
+    if ((!success) || (!file.commit())) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Could not write to "
+            "file \"%1\": %2")).arg(filepath.toNative(), file.errorString()));
+    }
 }
 
 /*****************************************************************************************
@@ -225,25 +282,36 @@ void GerberGenerator::saveToFile(const FilePath& filepath) const
 void GerberGenerator::setCurrentAperture(int number) noexcept
 {
     if (number != mCurrentApertureNumber) {
-        mContent.append(QString("D%1*\n").arg(number));
+        prepareCommand();
+        char buffer[16];
+        qsnprintf(buffer, sizeof(buffer), "D%d*\n", number);
+        appendCommand(buffer);
         mCurrentApertureNumber = number;
     }
 }
 
 void GerberGenerator::setRegionModeOn() noexcept
 {
-    mContent.append("G36*\n");
+    if (!mRegionOpen) {
+        prepareCommand();
+        appendCommand("G36*\n");
+        mRegionOpen = true;
+    }
+    mInArea = true;
 }
 
 void GerberGenerator::setRegionModeOff() noexcept
 {
-    mContent.append("G37*\n");
+    // G37 is written by the next command which is not part of an area, so subsequent
+    // areas are merged into the same region
+    mInArea = false;
 }
 
 void GerberGenerator::setMultiQuadrantArcModeOn() noexcept
 {
     if (!mMultiQuadrantArcModeOn) {
-        mContent.append("G75*\n");
+        prepareCommand();
+        appendCommand("G75*\n");
         mMultiQuadrantArcModeOn = true;
     }
 }
@@ -251,36 +319,61 @@ void GerberGenerator::setMultiQuadrantArcModeOn() noexcept
 void GerberGenerator::setMultiQuadrantArcModeOff() noexcept
 {
     if (mMultiQuadrantArcModeOn) {
-        mContent.append("G74*\n");
+        prepareCommand();
+        appendCommand("G74*\n");
         mMultiQuadrantArcModeOn = false;
     }
 }
 
 void GerberGenerator::switchToLinearInterpolationModeG01() noexcept
 {
-    mContent.append("G01*\n");
+    setInterpolationMode(InterpolationMode::Linear);
 }
 
 void GerberGenerator::switchToCircularCwInterpolationModeG02() noexcept
 {
-    mContent.append("G02*\n");
+    setInterpolationMode(InterpolationMode::CircularCw);
 }
 
 void GerberGenerator::switchToCircularCcwInterpolationModeG03() noexcept
 {
-    mContent.append("G03*\n");
+    setInterpolationMode(InterpolationMode::CircularCcw);
+}
+
+void GerberGenerator::setInterpolationMode(InterpolationMode mode) noexcept
+{
+    if (mode != mInterpolationMode) {
+        prepareCommand();
+        switch (mode)
+        {
+            case InterpolationMode::Linear:      appendCommand("G01*\n"); break;
+            case InterpolationMode::CircularCw:  appendCommand("G02*\n"); break;
+            case InterpolationMode::CircularCcw: appendCommand("G03*\n"); break;
+        }
+        mInterpolationMode = mode;
+    }
 }
 
 void GerberGenerator::moveToPosition(const Point& pos) noexcept
 {
-    mContent.append(QString("X%1Y%2D02*\n").arg(pos.getX().toNmString(),
-                                                pos.getY().toNmString()));
+    // outside of regions, moving to the current point is not needed (inside regions it
+    // starts a new contour)
+    Point currentPos = mLinePending ? mPendingLineEnd : mCurrentPosition;
+    if ((!mInArea) && mCurrentPositionValid && (pos == currentPos)) return;
+    prepareCommand();
+    writeCoordinates(pos);
+    appendCommand("D02*\n");
 }
 
 void GerberGenerator::linearInterpolateToPosition(const Point& pos) noexcept
 {
-    mContent.append(QString("X%1Y%2D01*\n").arg(pos.getX().toNmString(),
-                                                pos.getY().toNmString()));
+    if (mLinePending && isCollinearExtension(mCurrentPosition, mPendingLineEnd, pos)) {
+        mPendingLineEnd = pos; // just extend the pending line
+        return;
+    }
+    prepareCommand();
+    mLinePending = true;
+    mPendingLineEnd = pos;
 }
 
 void GerberGenerator::circularInterpolateToPosition(const Point& start, const Point& center, const Point& end) noexcept
@@ -289,21 +382,53 @@ void GerberGenerator::circularInterpolateToPosition(const Point& start, const Po
     if (!mMultiQuadrantArcModeOn) {
         diff.makeAbs(); // no sign allowed in single quadrant mode!
     }
-    mContent.append(QString("X%1Y%2I%3J%4D01*\n").arg(end.getX().toNmString(),
-                                                      end.getY().toNmString(),
-                                                      diff.getX().toNmString(),
-                                                      diff.getY().toNmString()));
+    prepareCommand();
+    writeCoordinates(end);
+    appendCoordinate('I', diff.getX());
+    appendCoordinate('J', diff.getY());
+    appendCommand("D01*\n");
 }
 
 void GerberGenerator::flashAtPosition(const Point& pos) noexcept
 {
-    mContent.append(QString("X%1Y%2D03*\n").arg(pos.getX().toNmString(),
-                                                pos.getY().toNmString()));
+    prepareCommand();
+    writeCoordinates(pos);
+    appendCommand("D03*\n");
+}
+
+void GerberGenerator::prepareCommand() noexcept
+{
+    flushPendingLine();
+    if (mRegionOpen && (!mInArea)) {
+        appendCommand("G37*\n");
+        mRegionOpen = false;
+    }
+}
+
+void GerberGenerator::flushPendingLine() noexcept
+{
+    if (mLinePending) {
+        mLinePending = false;
+        writeCoordinates(mPendingLineEnd);
+        appendCommand("D01*\n");
+    }
+}
+
+void GerberGenerator::writeCoordinates(const Point& pos) noexcept
+{
+    if ((!mCurrentPositionValid) || (pos.getX() != mCurrentPosition.getX())) {
+        appendCoordinate('X', pos.getX());
+    }
+    if ((!mCurrentPositionValid) || (pos.getY() != mCurrentPosition.getY())) {
+        appendCoordinate('Y', pos.getY());
+    }
+    mCurrentPosition = pos;
+    mCurrentPositionValid = true;
 }
 
 void GerberGenerator::printHeader() noexcept
 {
-    mOutput.append("G04 --- HEADER BEGIN --- *\n");
+    mHeader.append("G04 --- HEADER BEGIN --- *\n");
 
     // add some X2 attributes
     QString appVersion = qApp->getAppVersion().toPrettyStr(3);
@@ -311,56 +436,120 @@ void GerberGenerator::printHeader() noexcept
     QString projId = mProjectId.remove(',');
     QString projUuid = mProjectUuid.toStr();
     QString projRevision = mProjectRevision.remove(',');
-    mOutput.append(QString("%TF.GenerationSoftware,LibrePCB,LibrePCB,%1*%\n").arg(appVersion));
-    mOutput.append(QString("%TF.CreationDate,%1*%\n").arg(creationDate));
-    mOutput.append(QString("%TF.ProjectId,%1,%2,%3*%\n").arg(projId, projUuid, projRevision));
-    mOutput.append("%TF.Part,Single*%\n"); // "Single" means "this is a PCB"
-    //mOutput.append("%TF.FilePolarity,Positive*%\n");
+    mHeader.append(QString("%TF.GenerationSoftware,LibrePCB,LibrePCB,%1*%\n")
+                   .arg(appVersion).toUtf8());
+    mHeader.append(QString("%TF.CreationDate,%1*%\n").arg(creationDate).toUtf8());
+    mHeader.append(QString("%TF.ProjectId,%1,%2,%3*%\n")
+                   .arg(projId, projUuid, projRevision).toUtf8());
+    mHeader.append("%TF.Part,Single*%\n"); // "Single" means "this is a PCB"
+    //mHeader.append("%TF.FilePolarity,Positive*%\n");
 
     // coordinate format specification:
     //  - leading zeros omitted
     //  - absolute coordinates
     //  - coordiante format "6.6" --> allows us to directly use LengthBase_t (nanometers)!
-    mOutput.append("%FSLAX66Y66*%\n");
+    mHeader.append("%FSLAX66Y66*%\n");
 
     // set unit to millimeters
-    mOutput.append("%MOMM*%\n");
+    mHeader.append("%MOMM*%\n");
 
     // start linear interpolation mode
-    mOutput.append("G01*\n");
+    mHeader.append("G01*\n");
 
     // use single quadrant arc mode
-    mOutput.append("G74*\n");
+    mHeader.append("G74*\n");
 
-    mOutput.append("G04 --- HEADER END --- *\n");
+    mHeader.append("G04 --- HEADER END --- *\n");
 }
 
 void GerberGenerator::printApertureList() noexcept
 {
-    mOutput.append(mApertureList->generateString());
+    mHeader.append(mApertureList->generateString().toLatin1());
 }
 
-void GerberGenerator::printContent() noexcept
+void GerberGenerator::printFooter(const QByteArray& md5) noexcept
 {
-    mOutput.append("G04 --- BOARD BEGIN --- *\n");
-    mOutput.append(mContent);
-    mOutput.append("G04 --- BOARD END --- *\n");
+    // MD5 checksum over all data before this line
+    mFooter.append("%TF.MD5,");
+    mFooter.append(md5);
+    mFooter.append("*%\n");
+
+    // end of file
+    mFooter.append("M02*\n");
 }
 
-void GerberGenerator::printFooter() noexcept
+void GerberGenerator::appendCommand(const char* cmd) noexcept
 {
-    // MD5 checksum over content
-    mOutput.append(QString("%TF.MD5,%1*%\n").arg(calcOutputMd5Checksum()));
+    mContentBuffer.append(cmd);
+    if (mContentBuffer.size() >= sContentBufferSize) {
+        flushContentBuffer();
+    }
+}
 
-    // end of file
-    mOutput.append("M02*\n");
+void GerberGenerator::appendCoordinate(char axis, const Length& value) noexcept
+{
+    // format the nanometers directly, coordinate format "6.6" doesn't need a decimal point
+    char buffer[24];
+    char* end = buffer + sizeof(buffer);
+    char* p = end;
+    LengthBase_t nm = value.toNm();
+    quint64 abs = (nm < 0) ? (0 - static_cast<quint64>(nm)) : static_cast<quint64>(nm);
+    do {
+        *--p = static_cast<char>('0' + (abs % 10));
+        abs /= 10;
+    } while (abs > 0);
+    if (nm < 0) *--p = '-';
+    *--p = axis;
+    mContentBuffer.append(p, static_cast<int>(end - p));
 }
 
-QString GerberGenerator::calcOutputMd5Checksum() const noexcept
+void GerberGenerator::flushContentBuffer() noexcept
 {
-    // according to the RS-274C standard, linebreaks are not included in the checksum
-    QString data = QString(mOutput).remove(QChar('\n'));
-    return QString(QCryptographicHash::hash(data.toUtf8(), QCryptographicHash::Md5).toHex());
+    if (mContentFileFailed) return; // keep everything in memory
+    if (!mContentFileError.isEmpty()) {
+        // the content is incomplete anyway, #readContent() will throw
+        mContentBuffer.resize(0);
+        return;
+    }
+    if (!mContentFile) {
+        mContentFile.reset(new QTemporaryFile());
+        if (!mContentFile->open()) {
+            qWarning() << "Could not create temporary file for gerber output:"
+                       << mContentFile->errorString();
+            mContentFile.reset();
+            mContentFileFailed = true;
+            return;
+        }
+    }
+    if (mContentFile->write(mContentBuffer) != mContentBuffer.size()) {
+        // the file content is now incomplete, so the output must not be saved
+        mContentFileError = QString(tr("Could not write temporary file \"%1\": %2"))
+                            .arg(mContentFile->fileName(), mContentFile->errorString());
+    }
+    mContentBuffer.resize(0); // keeps the reserved capacity
+}
+
+void GerberGenerator::readContent(const std::function<void(const char*, qint64)>& reader) const
+{
+    if (!mContentFileError.isEmpty()) {
+        throw RuntimeError(__FILE__, __LINE__, mContentFileError);
+    }
+    if (mContentFile) {
+        if ((!mContentFile->flush()) || (!mContentFile->seek(0))) {
+            throw RuntimeError(__FILE__, __LINE__, QString(tr("Could not read temporary "
+                "file \"%1\": %2")).arg(mContentFile->fileName(), mContentFile->errorString()));
+        }
+        char buffer[64 * 1024];
+        qint64 size;
+        while ((size = mContentFile->read(buffer, sizeof(buffer))) > 0) {
+            reader(buffer, size);
+        }
+        if ((size < 0) || (!mContentFile->seek(mContentFile->size()))) {
+            throw RuntimeError(__FILE__, __LINE__, QString(tr("Could not read temporary "
+                "file \"%1\": %2")).arg(mContentFile->fileName(), mContentFile->errorString()));
+        }
+    }
+    reader(mContentBuffer.constData(), mContentBuffer.size());
 }
 
 /*****************************************************************************************
@@ -381,6 +570,31 @@ QString GerberGenerator::escapeString(const QString& str) noexcept
     return ret;
 }
 
+void GerberGenerator::addToChecksum(QCryptographicHash& hash, const char* data,
+                                    qint64 size) noexcept
+{
+    const char* end = data + size;
+    while (data < end) {
+        const char* newline = static_cast<const char*>(memchr(data, '\n', end - data));
+        const char* segmentEnd = newline ? newline : end;
+        hash.addData(data, static_cast<int>(segmentEnd - data));
+        data = newline ? (newline + 1) : end;
+    }
+}
+
+bool GerberGenerator::isCollinearExtension(const Point& start, const Point& end,
+                                           const Point& next) noexcept
+{
+    // exact integer arithmetic, differences are small enough to not overflow 64 bits
+    qint64 dx1 = end.getX().toNm() - start.getX().toNm();
+    qint64 dy1 = end.getY().toNm() - start.getY().toNm();
+    qint64 dx2 = next.getX().toNm() - end.getX().toNm();
+    qint64 dy2 = next.getY().toNm() - end.getY().toNm();
+    bool collinear = (dx1 * dy2 == dy1 * dx2);
+    bool sameDirection = (dx1 * dx2 + dy1 * dy2 > 0); // also false for zero length lines
+    return collinear && sameDirection;
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
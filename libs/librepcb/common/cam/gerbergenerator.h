@@ -24,6 +24,7 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <functional>
 #include "../exceptions.h"
 #include "../fileio/filepath.h"
 #include "../units/all_length_units.h"
@@ -45,6 +46,23 @@ class GerberApertureList;
 /**
  * @brief The GerberGenerator class
  *
+ * The plot methods write the Gerber commands directly as ASCII bytes into a small
+ * buffer which is spilled to a temporary file whenever it is full, so the memory usage
+ * doesn't depend on the size of the generated file. Since the aperture list must be
+ * written before the commands, #generate() only creates the (small) header and footer
+ * and calculates the MD5 checksum incrementally over all data, then #saveToFile()
+ * streams header, commands and footer into the output file.
+ *
+ * To keep the files small, the output is optimized without changing the image:
+ *  - Coordinates which are equal to the current point are omitted (they are modal).
+ *  - Modal commands (aperture, interpolation and quadrant mode) are only written if
+ *    they change.
+ *  - Contiguous, collinear lines drawn with the same aperture are merged into one line,
+ *    and a line starting at the current point doesn't need a move command.
+ *  - Areas drawn one after another are put into a single region statement.
+ *
+ * Panels are exported with step and repeat blocks (see #beginStepAndRepeat()).
+ *
  * @todo Remove/Escape illegal characters in #mProjectId and #mProjectRevision!
  * @todo Use file/aperture attributes
  *
@@ -69,9 +87,6 @@ class GerberGenerator final
                         const QString& projRevision) noexcept;
         ~GerberGenerator() noexcept;
 
-        // Getters
-        const QString& toStr() const noexcept {return mOutput;}
-
         // Plot Methods
         void setLayerPolarity(LayerPolarity p) noexcept;
         void drawLine(const Point& start, const Point& end, const Length& width) noexcept;
@@ -84,9 +99,35 @@ class GerberGenerator final
         void flashObround(const Point& pos, const Length& w, const Length& h, const Angle& rot, const Length& hole) noexcept;
         void flashRegularPolygon(const Point& pos, const Length& dia, int n, const Angle& rot, const Length& hole) noexcept;
 
+        /**
+         * @brief Start a step and repeat block (%SR command)
+         *
+         * Everything drawn until #endStepAndRepeat() is written only once, but replicated
+         * by the reader in a grid of @p columns times @p rows copies. This allows to
+         * export panels with the file size of a single board.
+         *
+         * @param columns   Count of copies in X direction (at least 1)
+         * @param rows      Count of copies in Y direction (at least 1)
+         * @param distance  Step distance between the copies (must not be negative)
+         */
+        void beginStepAndRepeat(int columns, int rows, const Point& distance) noexcept;
+        void endStepAndRepeat() noexcept;
+
         // General Methods
         void reset() noexcept;
+
+        /**
+         * @brief Create header and footer (incl. checksum), must be called before saving
+         *
+         * @throw Exception If the buffered commands could not be written or read
+         */
         void generate();
+
+        /**
+         * @brief Write the generated file
+         *
+         * @throw Exception If the file or the buffered commands could not be written
+         */
         void saveToFile(const FilePath& filepath) const;
 
         // Operator Overloadings
@@ -95,6 +136,9 @@ class GerberGenerator final
 
     private:
 
+        // Private Types
+        enum class InterpolationMode {Linear, CircularCw, CircularCcw};
+
         // Private Methods
         void setCurrentAperture(int number) noexcept;
         void setRegionModeOn() noexcept;
@@ -104,18 +148,28 @@ class GerberGenerator final
         void switchToLinearInterpolationModeG01() noexcept;
         void switchToCircularCwInterpolationModeG02() noexcept;
         void switchToCircularCcwInterpolationModeG03() noexcept;
+        void setInterpolationMode(InterpolationMode mode) noexcept;
         void moveToPosition(const Point& pos) noexcept;
         void linearInterpolateToPosition(const Point& pos) noexcept;
         void circularInterpolateToPosition(const Point& start, const Point& center, const Point& end) noexcept;
         void flashAtPosition(const Point& pos) noexcept;
+        void prepareCommand() noexcept;
+        void flushPendingLine() noexcept;
+        void writeCoordinates(const Point& pos) noexcept;
         void printHeader() noexcept;
         void printApertureList() noexcept;
-        void printContent() noexcept;
-        void printFooter() noexcept;
-        QString calcOutputMd5Checksum() const noexcept;
+        void printFooter(const QByteArray& md5) noexcept;
+        void appendCommand(const char* cmd) noexcept;
+        void appendCoordinate(char axis, const Length& value) noexcept;
+        void flushContentBuffer() noexcept;
+        void readContent(const std::function<void(const char*, qint64)>& reader) const;
 
         // Static Methods
         static QString escapeString(const QString& str) noexcept;
+        static void addToChecksum(QCryptographicHash& hash, const char* data,
+                                  qint64 size) noexcept;
+        static bool isCollinearExtension(const Point& start, const Point& end,
+                                         const Point& next) noexcept;
 
 
         // Metadata
@@ -124,11 +178,27 @@ class GerberGenerator final
         QString mProjectRevision;
 
         // Gerber Data
-        QString mOutput;
-        QString mContent;
+        QByteArray mHeader;         ///< header and aperture list, created by #generate()
+        QByteArray mFooter;         ///< checksum and end of file, created by #generate()
+        QByteArray mContentBuffer;  ///< the latest commands (not yet in #mContentFile)
+        QScopedPointer<QTemporaryFile> mContentFile; ///< spilled commands (if any)
+        bool mContentFileFailed;    ///< if true, all commands are kept in the buffer
+        QString mContentFileError;  ///< set if spilling failed (the content is incomplete)
         QScopedPointer<GerberApertureList> mApertureList;
         int mCurrentApertureNumber;
         bool mMultiQuadrantArcModeOn;
+        InterpolationMode mInterpolationMode;
+
+        // Output Optimization State
+        Point mCurrentPosition;         ///< the current point of the written commands
+        bool mCurrentPositionValid;     ///< false until the first coordinate is written
+        bool mLinePending;              ///< if true, a line to #mPendingLineEnd is pending
+        Point mPendingLineEnd;          ///< end of the pending line (may be extended)
+        bool mRegionOpen;               ///< G36 written, but G37 not yet
+        bool mInArea;                   ///< true while drawing a path area
+
+        // Static Variables
+        static constexpr int sContentBufferSize = 1 << 20; ///< 1MB
 };
 
 /*****************************************************************************************
@@ -0,0 +1,773 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "gerberparser.h"
+#include "../exceptions.h"
+#include "../toolbox.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+namespace {
+
+/**
+ * @brief Evaluates arithmetic expressions of aperture macros (e.g. "$1x2+0.5")
+ */
+class MacroExpression final
+{
+    public:
+        MacroExpression(const QString& expression, const QMap<int, qreal>& variables) noexcept :
+            mExpression(expression), mVariables(variables), mPos(0) {}
+
+        qreal evaluate() {
+            qreal value = parseSum();
+            if (mPos != mExpression.length()) throwError();
+            return value;
+        }
+
+    private:
+        qreal parseSum() {
+            qreal value = parseProduct();
+            while (mPos < mExpression.length()) {
+                QChar op = mExpression.at(mPos);
+                if (op == '+') {
+                    ++mPos;
+                    value += parseProduct();
+                } else if (op == '-') {
+                    ++mPos;
+                    value -= parseProduct();
+                } else {
+                    break;
+                }
+            }
+            return value;
+        }
+
+        qreal parseProduct() {
+            qreal value = parseFactor();
+            while (mPos < mExpression.length()) {
+                QChar op = mExpression.at(mPos);
+                if ((op == 'x') || (op == 'X')) {
+                    ++mPos;
+                    value *= parseFactor();
+                } else if (op == '/') {
+                    ++mPos;
+                    value /= parseFactor();
+                } else {
+                    break;
+                }
+            }
+            return value;
+        }
+
+        qreal parseFactor() {
+            if (mPos >= mExpression.length()) throwError();
+            QChar c = mExpression.at(mPos);
+            if ((c == '+') || (c == '-')) {
+                ++mPos;
+                return (c == '-') ? -parseFactor() : parseFactor();
+            } else if (c == '(') {
+                ++mPos;
+                qreal value = parseSum();
+                if ((mPos >= mExpression.length()) || (mExpression.at(mPos) != ')')) {
+                    throwError();
+                }
+                ++mPos;
+                return value;
+            } else if (c == '$') {
+                ++mPos;
+                int index = parseNumber().toInt();
+                if (!mVariables.contains(index)) throwError();
+                return mVariables.value(index);
+            } else {
+                bool ok = false;
+                qreal value = parseNumber().toDouble(&ok);
+                if (!ok) throwError();
+                return value;
+            }
+        }
+
+        QString parseNumber() noexcept {
+            int start = mPos;
+            while ((mPos < mExpression.length()) &&
+                   (mExpression.at(mPos).isDigit() || (mExpression.at(mPos) == '.'))) {
+                ++mPos;
+            }
+            return mExpression.mid(start, mPos - start);
+        }
+
+        void throwError() const {
+            throw RuntimeError(__FILE__, __LINE__, QString(GerberParser::tr("Invalid "
+                "expression in aperture macro: \"%1\"")).arg(mExpression));
+        }
+
+        QString mExpression;
+        const QMap<int, qreal>& mVariables;
+        int mPos;
+};
+
+} // namespace
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+GerberParser::GerberParser(const Length& arcTolerance) noexcept :
+    mArcTolerance(arcTolerance)
+{
+    reset();
+}
+
+GerberParser::~GerberParser() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+QVector<CamRasterizer::Object> GerberParser::parse(const QByteArray& content)
+{
+    reset();
+    int pos = 0;
+    while ((pos < content.size()) && (!mEndOfFile)) {
+        if (QChar(content.at(pos)).isSpace()) {
+            ++pos;
+        } else if (content.at(pos) == '%') {
+            int end = content.indexOf('%', pos + 1);
+            if (end < 0) {
+                throw RuntimeError(__FILE__, __LINE__,
+                                   tr("Unterminated extended command in Gerber file."));
+            }
+            parseExtendedCommand(content.mid(pos + 1, end - pos - 1)); // can throw
+            pos = end + 1;
+        } else {
+            int end = content.indexOf('*', pos);
+            if (end < 0) {
+                throw RuntimeError(__FILE__, __LINE__,
+                                   tr("Unterminated command in Gerber file."));
+            }
+            parseWordCommand(content.mid(pos, end - pos)); // can throw
+            pos = end + 1;
+        }
+    }
+    if (!mEndOfFile) {
+        throw RuntimeError(__FILE__, __LINE__, tr("Gerber file has no end of file command."));
+    }
+    if (mRegionMode) {
+        throw RuntimeError(__FILE__, __LINE__, tr("Gerber file has an unclosed region."));
+    }
+    closeStepAndRepeat(); // the end of file implicitly closes a step and repeat block
+    QVector<CamRasterizer::Object> objects = mObjects;
+    reset();
+    return objects;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void GerberParser::reset() noexcept
+{
+    mFormatSpecified = false;
+    mDecimalDigits = 0;
+    mIntegerDigits = 0;
+    mTrailingZerosOmitted = false;
+    mNmPerUnit = 0;
+    mMacros.clear();
+    mApertures.clear();
+    mCurrentAperture = -1;
+    mCurrentPosition = Point(0, 0);
+    mInterpolation = Interpolation::Linear;
+    mMultiQuadrant = false;
+    mRegionMode = false;
+    mDarkPolarity = true;
+    mEndOfFile = false;
+    mContour.clear();
+    mObjects.clear();
+    mStepAndRepeatStart = -1;
+    mStepAndRepeatCount = QPair<int, int>(1, 1);
+    mStepAndRepeatDistance = Point(0, 0);
+}
+
+void GerberParser::parseExtendedCommand(const QByteArray& command)
+{
+    QList<QByteArray> blocks;
+    foreach (QByteArray block, command.split('*')) {
+        block = block.trimmed();
+        if (!block.isEmpty()) {
+            blocks.append(block);
+        }
+    }
+    if (blocks.isEmpty()) {
+        return;
+    }
+
+    if (blocks.first().startsWith("AM")) {
+        // aperture macro: the first block is the name, the others are the primitives
+        QStringList primitives;
+        for (int i = 1; i < blocks.count(); ++i) {
+            primitives.append(QString::fromLatin1(blocks.at(i)).remove(QRegularExpression("\\s")));
+        }
+        mMacros.insert(QString::fromLatin1(blocks.first().mid(2)), primitives);
+        return;
+    }
+
+    // deprecated files may contain several commands in one extended command
+    foreach (const QByteArray& block, blocks) {
+        QByteArray code = block.left(2);
+        if (code == "FS") {
+            parseFormatSpecification(block); // can throw
+        } else if (block == "MOMM") {
+            mNmPerUnit = 1000000;
+        } else if (block == "MOIN") {
+            mNmPerUnit = 25400000;
+        } else if (code == "AD") {
+            parseApertureDefinition(block); // can throw
+        } else if (block == "LPD") {
+            mDarkPolarity = true;
+        } else if (block == "LPC") {
+            mDarkPolarity = false;
+        } else if (code == "SR") {
+            parseStepAndRepeat(block); // can throw
+        } else if ((code == "TF") || (code == "TA") || (code == "TO") || (code == "TD") ||
+                   (code == "IN") || (code == "LN") || (block == "IPPOS")) {
+            // attributes and names don't affect the image
+        } else {
+            throw RuntimeError(__FILE__, __LINE__, QString(tr("Unsupported Gerber "
+                "command: \"%1\"")).arg(QString::fromLatin1(block)));
+        }
+    }
+}
+
+void GerberParser::parseFormatSpecification(const QByteArray& command)
+{
+    QRegularExpression regex("^FS([LT])A"
+                             "X([1-6])([1-6])Y([1-6])([1-6])$");
+    QRegularExpressionMatch match = regex.match(QString::fromLatin1(command));
+    if ((!match.hasMatch()) || (match.captured(2) != match.captured(4)) ||
+        (match.captured(3) != match.captured(5))) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Unsupported Gerber format "
+            "specification: \"%1\"")).arg(QString::fromLatin1(command)));
+    }
+    mTrailingZerosOmitted = (match.captured(1) == "T");
+    mIntegerDigits = match.captured(2).toInt();
+    mDecimalDigits = match.captured(3).toInt();
+    mFormatSpecified = true;
+}
+
+void GerberParser::parseStepAndRepeat(const QByteArray& command)
+{
+    if (mRegionMode) {
+        throw RuntimeError(__FILE__, __LINE__, tr("Step and repeat is not allowed within "
+                                                  "a region."));
+    }
+    closeStepAndRepeat(); // a new block implicitly closes the previous one
+    if (command == "SR") {
+        return;
+    }
+    QRegularExpression regex("^SRX(\\d+)Y(\\d+)I(\\d*\\.?\\d*)J(\\d*\\.?\\d*)$");
+    QRegularExpressionMatch match = regex.match(QString::fromLatin1(command));
+    bool validI = false, validJ = false;
+    int columns = match.captured(1).toInt();
+    int rows = match.captured(2).toInt();
+    qreal distanceX = match.captured(3).toDouble(&validI);
+    qreal distanceY = match.captured(4).toDouble(&validJ);
+    if ((!match.hasMatch()) || (!validI) || (!validJ) || (columns < 1) || (rows < 1) ||
+        (qint64(columns) * rows > 1000000) || (mNmPerUnit <= 0)) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Invalid Gerber step and repeat "
+            "command: \"%1\"")).arg(QString::fromLatin1(command)));
+    }
+    mStepAndRepeatStart = mObjects.count();
+    mStepAndRepeatCount = QPair<int, int>(columns, rows);
+    mStepAndRepeatDistance = Point(toNm(distanceX), toNm(distanceY));
+}
+
+void GerberParser::closeStepAndRepeat() noexcept
+{
+    if (mStepAndRepeatStart < 0) {
+        return;
+    }
+    QVector<CamRasterizer::Object> block = mObjects.mid(mStepAndRepeatStart);
+    for (int row = 0; row < mStepAndRepeatCount.second; ++row) {
+        for (int column = 0; column < mStepAndRepeatCount.first; ++column) {
+            if ((row == 0) && (column == 0)) {
+                continue; // the first copy is the block itself
+            }
+            Point offset(mStepAndRepeatDistance.getX() * column,
+                         mStepAndRepeatDistance.getY() * row);
+            foreach (CamRasterizer::Object object, block) {
+                for (CamRasterizer::Contour& contour : object.contours) {
+                    contour.vertices = translated(contour.vertices, offset);
+                }
+                mObjects.append(object);
+            }
+        }
+    }
+    mStepAndRepeatStart = -1;
+}
+
+void GerberParser::parseApertureDefinition(const QByteArray& command)
+{
+    QRegularExpression regex("^ADD(\\d+)([^,]+)(?:,(.*))?$");
+    QRegularExpressionMatch match = regex.match(QString::fromLatin1(command));
+    int number = match.captured(1).toInt();
+    if ((!match.hasMatch()) || (number < 10)) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Invalid aperture definition: "
+            "\"%1\"")).arg(QString::fromLatin1(command)));
+    }
+    if (mNmPerUnit <= 0) {
+        throw RuntimeError(__FILE__, __LINE__,
+                           tr("Aperture defined before the unit was specified."));
+    }
+    QString name = match.captured(2);
+    QVector<qreal> params = parseNumbers(match.captured(3), 'X'); // can throw
+    if (mMacros.contains(name)) {
+        mApertures.insert(number, createMacroAperture(mMacros.value(name), params));
+    } else {
+        mApertures.insert(number, createStandardAperture(name, params));
+    }
+}
+
+void GerberParser::parseWordCommand(const QByteArray& command)
+{
+    QByteArray cmd = command.trimmed();
+    if (cmd.startsWith("G04") || (cmd.startsWith("G4") && ((cmd.size() < 3) ||
+                                                           (!QChar(cmd.at(2)).isDigit())))) {
+        return; // comment
+    }
+    cmd = cmd.simplified().replace(" ", "");
+
+    QByteArray x, y, i, j;
+    int dcode = -1;
+    int pos = 0;
+    while (pos < cmd.size()) {
+        char letter = cmd.at(pos++);
+        int start = pos;
+        while ((pos < cmd.size()) && (QChar(cmd.at(pos)).isDigit() || (cmd.at(pos) == '+') ||
+                                      (cmd.at(pos) == '-'))) {
+            ++pos;
+        }
+        QByteArray number = cmd.mid(start, pos - start);
+        if (number.isEmpty()) {
+            throw RuntimeError(__FILE__, __LINE__, QString(tr("Invalid Gerber command: "
+                "\"%1\"")).arg(QString::fromLatin1(command)));
+        }
+        switch (letter)
+        {
+            case 'G': {
+                switch (number.toInt())
+                {
+                    case 1:  mInterpolation = Interpolation::Linear; break;
+                    case 2:  mInterpolation = Interpolation::CircularCw; break;
+                    case 3:  mInterpolation = Interpolation::CircularCcw; break;
+                    case 36: mRegionMode = true; mContour.clear(); break;
+                    case 37: closeContour(); mRegionMode = false; break;
+                    case 54: break; // deprecated prefix of aperture selection
+                    case 70: mNmPerUnit = 25400000; break;
+                    case 71: mNmPerUnit = 1000000; break;
+                    case 74: mMultiQuadrant = false; break;
+                    case 75: mMultiQuadrant = true; break;
+                    case 90: break; // absolute coordinates
+                    default: throw RuntimeError(__FILE__, __LINE__, QString(tr("Unsupported "
+                        "Gerber command: \"%1\"")).arg(QString::fromLatin1(command)));
+                }
+                break;
+            }
+            case 'M': {
+                if (number.toInt() > 2) {
+                    throw RuntimeError(__FILE__, __LINE__, QString(tr("Unsupported Gerber "
+                        "command: \"%1\"")).arg(QString::fromLatin1(command)));
+                }
+                mEndOfFile = true; // M02 (or the deprecated M00 / M01)
+                break;
+            }
+            case 'D': dcode = number.toInt(); break;
+            case 'X': x = number; break;
+            case 'Y': y = number; break;
+            case 'I': i = number; break;
+            case 'J': j = number; break;
+            default: throw RuntimeError(__FILE__, __LINE__, QString(tr("Invalid Gerber "
+                "command: \"%1\"")).arg(QString::fromLatin1(command)));
+        }
+    }
+
+    // coordinates are modal, offsets are zero if omitted
+    Point pos(x.isEmpty() ? mCurrentPosition.getX() : Length(parseCoordinate(x)),
+              y.isEmpty() ? mCurrentPosition.getY() : Length(parseCoordinate(y)));
+    Point offset(i.isEmpty() ? Length(0) : Length(parseCoordinate(i)),
+                 j.isEmpty() ? Length(0) : Length(parseCoordinate(j)));
+    if (dcode >= 10) {
+        if (!mApertures.contains(dcode)) {
+            throw RuntimeError(__FILE__, __LINE__, QString(tr("Aperture D%1 is not "
+                                                              "defined.")).arg(dcode));
+        }
+        mCurrentAperture = dcode;
+    } else if (dcode == 1) {
+        interpolate(pos, offset); // can throw
+    } else if (dcode == 2) {
+        if (mRegionMode) closeContour(); // starts a new contour
+        mCurrentPosition = pos;
+    } else if (dcode == 3) {
+        flash(pos); // can throw
+    } else if ((dcode >= 0) || (!x.isEmpty()) || (!y.isEmpty())) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Invalid or deprecated Gerber "
+            "operation: \"%1\"")).arg(QString::fromLatin1(command)));
+    }
+}
+
+void GerberParser::interpolate(const Point& end, const Point& offset)
+{
+    QVector<Point> points;
+    if (mInterpolation == Interpolation::Linear) {
+        points = QVector<Point>{mCurrentPosition, end};
+    } else {
+        points = flattenArc(mCurrentPosition, end, offset); // can throw
+    }
+
+    if (mRegionMode) {
+        if (mContour.isEmpty()) {
+            mContour.append(mCurrentPosition);
+        }
+        for (int i = 1; i < points.count(); ++i) {
+            mContour.append(points.at(i));
+        }
+    } else {
+        if (mCurrentAperture < 0) {
+            throw RuntimeError(__FILE__, __LINE__, tr("Gerber file draws a line without "
+                                                      "selecting an aperture."));
+        }
+        // apertures used for drawing are convex (circles or rectangles), so the area
+        // swept by moving them along a straight segment is the hull of both ends
+        const Aperture& aperture = mApertures[mCurrentAperture];
+        QVector<Point> shape = aperture.isEmpty() ? QVector<Point>() : aperture.first().vertices;
+        for (int i = 1; i < points.count(); ++i) {
+            QVector<Point> vertices = translated(shape, points.at(i - 1)) +
+                                      translated(shape, points.at(i));
+            CamRasterizer::Contour contour{Toolbox::convexHull(vertices), true};
+            mObjects.append(CamRasterizer::Object{{contour}, mDarkPolarity});
+        }
+    }
+    mCurrentPosition = end;
+}
+
+void GerberParser::flash(const Point& pos)
+{
+    if (mRegionMode || (mCurrentAperture < 0)) {
+        throw RuntimeError(__FILE__, __LINE__, tr("Invalid flash in Gerber file."));
+    }
+    CamRasterizer::Object object{Aperture(), mDarkPolarity};
+    foreach (const CamRasterizer::Contour& contour, mApertures[mCurrentAperture]) {
+        object.contours.append(CamRasterizer::Contour{translated(contour.vertices, pos),
+                                                      contour.dark});
+    }
+    mObjects.append(object);
+    mCurrentPosition = pos;
+}
+
+void GerberParser::closeContour() noexcept
+{
+    if (mContour.count() >= 3) {
+        CamRasterizer::Contour contour{mContour, true};
+        mObjects.append(CamRasterizer::Object{{contour}, mDarkPolarity});
+    }
+    mContour.clear();
+}
+
+LengthBase_t GerberParser::parseCoordinate(const QByteArray& number) const
+{
+    if ((!mFormatSpecified) || (mNmPerUnit <= 0)) {
+        throw RuntimeError(__FILE__, __LINE__, tr("Coordinates used before the format and "
+                                                  "unit were specified."));
+    }
+    bool negative = number.startsWith('-');
+    QByteArray digits = (number.startsWith('-') || number.startsWith('+')) ? number.mid(1) : number;
+    if (mTrailingZerosOmitted) {
+        digits = digits.leftJustified(mIntegerDigits + mDecimalDigits, '0');
+    }
+    bool ok = false;
+    qint64 value = digits.toLongLong(&ok);
+    if ((!ok) || (digits.length() > mIntegerDigits + mDecimalDigits)) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Invalid coordinate in Gerber "
+            "file: \"%1\"")).arg(QString::fromLatin1(number)));
+    }
+    LengthBase_t nm = qRound64(value * mNmPerUnit / qPow(10, mDecimalDigits));
+    return negative ? -nm : nm;
+}
+
+QVector<Point> GerberParser::flattenArc(const Point& start, const Point& end,
+                                        const Point& offset) const
+{
+    qreal sx = start.getX().toNm(), sy = start.getY().toNm();
+    qreal ex = end.getX().toNm(), ey = end.getY().toNm();
+    int direction = (mInterpolation == Interpolation::CircularCcw) ? 1 : -1;
+
+    // in single quadrant mode, the signs of the offsets are not specified
+    QVector<QPointF> centers;
+    if (mMultiQuadrant) {
+        centers.append(QPointF(sx + offset.getX().toNm(), sy + offset.getY().toNm()));
+    } else {
+        qreal i = qAbs(offset.getX().toNm()), j = qAbs(offset.getY().toNm());
+        centers << QPointF(sx + i, sy + j) << QPointF(sx - i, sy + j)
+                << QPointF(sx + i, sy - j) << QPointF(sx - i, sy - j);
+    }
+    bool valid = false;
+    QPointF center;
+    qreal startAngle = 0, sweep = 0, radius = 0, radiusError = 0;
+    foreach (const QPointF& c, centers) {
+        qreal a1 = qAtan2(sy - c.y(), sx - c.x());
+        qreal a2 = qAtan2(ey - c.y(), ex - c.x());
+        qreal s = (a2 - a1) * direction;
+        if (mMultiQuadrant) {
+            while (s <= 0) s += 2 * M_PI; // start == end is a full circle
+        } else {
+            while (s < 0) s += 2 * M_PI;
+            if (s > M_PI / 2 + 1e-6) continue;
+        }
+        qreal r1 = qSqrt((sx - c.x()) * (sx - c.x()) + (sy - c.y()) * (sy - c.y()));
+        qreal r2 = qSqrt((ex - c.x()) * (ex - c.x()) + (ey - c.y()) * (ey - c.y()));
+        if ((!valid) || (qAbs(r1 - r2) < radiusError)) {
+            valid = true;
+            center = c;
+            startAngle = a1;
+            sweep = s;
+            radius = (r1 + r2) / 2;
+            radiusError = qAbs(r1 - r2);
+        }
+    }
+    if (!valid) {
+        throw RuntimeError(__FILE__, __LINE__, tr("Invalid arc in Gerber file."));
+    }
+
+    // the sagitta of each segment must not exceed the tolerance
+    qreal ratio = qBound(qreal(-1), 1 - qMax(mArcTolerance.toNm(), LengthBase_t(1)) / radius,
+                         qreal(1));
+    int count = qBound(1, qCeil(sweep / (2 * qAcos(ratio))), 10000);
+    QVector<Point> points;
+    points.reserve(count + 1);
+    points.append(start);
+    for (int k = 1; k < count; ++k) {
+        qreal angle = startAngle + direction * sweep * k / count;
+        points.append(Point(Length(qRound64(center.x() + radius * qCos(angle))),
+                            Length(qRound64(center.y() + radius * qSin(angle)))));
+    }
+    points.append(end);
+    return points;
+}
+
+QVector<Point> GerberParser::createCircle(const Point& center, qreal diameter) const noexcept
+{
+    return CamRasterizer::createCircle(center, Length(toNm(diameter)), mArcTolerance);
+}
+
+QVector<Point> GerberParser::createRect(const Point& center, qreal width,
+                                        qreal height) const noexcept
+{
+    Point half(toNm(width / 2), toNm(height / 2));
+    Point halfMirrored(half.getX(), -half.getY());
+    return QVector<Point>{center - half, center + halfMirrored, center + half,
+                          center - halfMirrored};
+}
+
+GerberParser::Aperture GerberParser::createStandardAperture(const QString& name,
+                                                            const QVector<qreal>& params) const
+{
+    Aperture aperture;
+    int holeIndex = -1;
+    if ((name == "C") && (params.count() >= 1)) {
+        aperture.append(CamRasterizer::Contour{createCircle(Point(0, 0), params.at(0)), true});
+        holeIndex = 1;
+    } else if ((name == "R") && (params.count() >= 2)) {
+        aperture.append(CamRasterizer::Contour{createRect(Point(0, 0), params.at(0),
+                                                          params.at(1)), true});
+        holeIndex = 2;
+    } else if ((name == "O") && (params.count() >= 2)) {
+        // two half circles connected by a rectangle
+        qreal dia = qMin(params.at(0), params.at(1));
+        Point offset = (params.at(0) > params.at(1)) ? Point(toNm((params.at(0) - dia) / 2), 0)
+                                                     : Point(0, toNm((params.at(1) - dia) / 2));
+        QVector<Point> vertices = createCircle(offset, dia) + createCircle(-offset, dia);
+        aperture.append(CamRasterizer::Contour{Toolbox::convexHull(vertices), true});
+        holeIndex = 2;
+    } else if ((name == "P") && (params.count() >= 2)) {
+        int count = qRound(params.at(1));
+        qreal radius = params.at(0) / 2;
+        qreal rotation = params.value(2, 0) * M_PI / 180;
+        QVector<Point> vertices;
+        for (int i = 0; i < count; ++i) {
+            qreal angle = rotation + 2 * M_PI * i / count;
+            vertices.append(Point(toNm(radius * qCos(angle)), toNm(radius * qSin(angle))));
+        }
+        aperture.append(CamRasterizer::Contour{vertices, true});
+        holeIndex = 3;
+    } else {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Invalid or unknown aperture "
+                                                          "\"%1\".")).arg(name));
+    }
+    if (params.value(holeIndex, 0) > 0) {
+        aperture.append(CamRasterizer::Contour{createCircle(Point(0, 0),
+                                                            params.at(holeIndex)), false});
+    }
+    return aperture;
+}
+
+GerberParser::Aperture GerberParser::createMacroAperture(const QStringList& macro,
+                                                         const QVector<qreal>& params) const
+{
+    QMap<int, qreal> variables;
+    for (int i = 0; i < params.count(); ++i) {
+        variables.insert(i + 1, params.at(i));
+    }
+
+    Aperture aperture;
+    foreach (const QString& block, macro) {
+        if (block.startsWith("0") && (!block.startsWith("0."))) {
+            continue; // comment
+        } else if (block.startsWith("$")) {
+            int index = block.indexOf('=');
+            variables.insert(block.mid(1, index - 1).toInt(),
+                             MacroExpression(block.mid(index + 1), variables).evaluate());
+            continue;
+        }
+        QVector<qreal> values;
+        foreach (const QString& field, block.split(',')) {
+            values.append(MacroExpression(field, variables).evaluate()); // can throw
+        }
+        auto value = [&](int index) {
+            if (index >= values.count()) {
+                throw RuntimeError(__FILE__, __LINE__, QString(tr("Missing parameter in "
+                    "aperture macro primitive: \"%1\"")).arg(block));
+            }
+            return values.at(index);
+        };
+        int exposure = qRound(value(1));
+        if ((exposure != 0) && (exposure != 1)) {
+            throw RuntimeError(__FILE__, __LINE__, QString(tr("Unsupported exposure in "
+                "aperture macro primitive: \"%1\"")).arg(block));
+        }
+        QVector<Point> vertices;
+        switch (qRound(value(0)))
+        {
+            case 1: { // circle: exposure, diameter, center x, center y [, rotation]
+                Point center(toNm(value(3)), toNm(value(4)));
+                vertices = rotated(createCircle(center, value(2)), values.value(5, 0));
+                break;
+            }
+            case 4: { // outline: exposure, count, x0, y0, ..., xn, yn, rotation
+                int count = qRound(value(2));
+                for (int i = 0; i < count; ++i) { // the last point is equal to the first
+                    vertices.append(Point(toNm(value(3 + 2 * i)), toNm(value(4 + 2 * i))));
+                }
+                vertices = rotated(vertices, value(5 + 2 * count));
+                break;
+            }
+            case 5: { // polygon: exposure, count, center x, center y, diameter, rotation
+                int count = qRound(value(2));
+                for (int i = 0; i < count; ++i) {
+                    qreal angle = 2 * M_PI * i / count;
+                    vertices.append(Point(toNm(value(3) + value(5) / 2 * qCos(angle)),
+                                          toNm(value(4) + value(5) / 2 * qSin(angle))));
+                }
+                vertices = rotated(vertices, value(6));
+                break;
+            }
+            case 20: { // vector line: exposure, width, start x/y, end x/y, rotation
+                qreal dx = value(5) - value(3), dy = value(6) - value(4);
+                qreal length = qSqrt(dx * dx + dy * dy);
+                if (length > 0) {
+                    Point normal(toNm(-dy / length * value(2) / 2),
+                                 toNm(dx / length * value(2) / 2));
+                    Point start(toNm(value(3)), toNm(value(4)));
+                    Point end(toNm(value(5)), toNm(value(6)));
+                    vertices = rotated(QVector<Point>{start + normal, end + normal,
+                                                      end - normal, start - normal}, value(7));
+                }
+                break;
+            }
+            case 21: { // center line: exposure, width, height, center x/y, rotation
+                Point center(toNm(value(4)), toNm(value(5)));
+                vertices = rotated(createRect(center, value(2), value(3)), value(6));
+                break;
+            }
+            default: {
+                throw RuntimeError(__FILE__, __LINE__, QString(tr("Unsupported aperture "
+                    "macro primitive: \"%1\"")).arg(block));
+            }
+        }
+        aperture.append(CamRasterizer::Contour{vertices, exposure == 1});
+    }
+    return aperture;
+}
+
+QVector<qreal> GerberParser::parseNumbers(const QString& str, QChar separator)
+{
+    QVector<qreal> numbers;
+    if (str.isEmpty()) {
+        return numbers;
+    }
+    foreach (const QString& part, str.split(separator)) {
+        bool ok = false;
+        numbers.append(part.toDouble(&ok));
+        if (!ok) {
+            throw RuntimeError(__FILE__, __LINE__, QString(tr("Invalid number in Gerber "
+                                                              "file: \"%1\"")).arg(part));
+        }
+    }
+    return numbers;
+}
+
+QVector<Point> GerberParser::rotated(const QVector<Point>& vertices, qreal degrees) noexcept
+{
+    if (degrees == 0) {
+        return vertices;
+    }
+    qreal sin = qSin(degrees * M_PI / 180);
+    qreal cos = qCos(degrees * M_PI / 180);
+    QVector<Point> result;
+    result.reserve(vertices.count());
+    foreach (const Point& vertex, vertices) {
+        qreal x = vertex.getX().toNm(), y = vertex.getY().toNm();
+        result.append(Point(Length(qRound64(x * cos - y * sin)),
+                            Length(qRound64(x * sin + y * cos))));
+    }
+    return result;
+}
+
+QVector<Point> GerberParser::translated(const QVector<Point>& vertices,
+                                        const Point& offset) noexcept
+{
+    QVector<Point> result;
+    result.reserve(vertices.count());
+    foreach (const Point& vertex, vertices) {
+        result.append(vertex + offset);
+    }
+    return result;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,146 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_GERBERPARSER_H
+#define LIBREPCB_GERBERPARSER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "camrasterizer.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class GerberParser
+ ****************************************************************************************/
+
+/**
+ * @brief The GerberParser class reads RS-274X files into graphical objects
+ *
+ * The parser supports everything which librepcb::GerberGenerator writes (and a bit more):
+ * standard apertures (C, R, O, P), aperture macros with the primitives 1, 4, 5, 20 and
+ * 21, linear and circular interpolation, regions, step and repeat blocks and both
+ * polarities. Arcs and circles are approximated with polygons. Unsupported or invalid
+ * commands raise an exception instead of being ignored, since the parser is used to
+ * verify generated files.
+ *
+ * @see librepcb::CamRasterizer
+ */
+class GerberParser final
+{
+        Q_DECLARE_TR_FUNCTIONS(GerberParser)
+
+    public:
+
+        // Constructors / Destructor
+        GerberParser() = delete;
+        GerberParser(const GerberParser& other) = delete;
+
+        /**
+         * @brief Constructor
+         *
+         * @param arcTolerance  Maximum deviation of the polygons from arcs and circles
+         */
+        explicit GerberParser(const Length& arcTolerance) noexcept;
+        ~GerberParser() noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Parse the content of a Gerber file
+         *
+         * @return All graphical objects in the order of their creation
+         *
+         * @throw Exception If the file is invalid or uses unsupported features
+         */
+        QVector<CamRasterizer::Object> parse(const QByteArray& content);
+
+        // Operator Overloadings
+        GerberParser& operator=(const GerberParser& rhs) = delete;
+
+
+    private:
+
+        // Types
+        enum class Interpolation {Linear, CircularCw, CircularCcw};
+        typedef QVector<CamRasterizer::Contour> Aperture; ///< relative to the flash position
+
+        // Private Methods
+        void reset() noexcept;
+        void parseExtendedCommand(const QByteArray& command);
+        void parseFormatSpecification(const QByteArray& command);
+        void parseApertureDefinition(const QByteArray& command);
+        void parseStepAndRepeat(const QByteArray& command);
+        void closeStepAndRepeat() noexcept;
+        void parseWordCommand(const QByteArray& command);
+        void interpolate(const Point& end, const Point& offset);
+        void flash(const Point& pos);
+        void closeContour() noexcept;
+        LengthBase_t parseCoordinate(const QByteArray& number) const;
+        LengthBase_t toNm(qreal value) const noexcept {return qRound64(value * mNmPerUnit);}
+        QVector<Point> flattenArc(const Point& start, const Point& end,
+                                  const Point& offset) const;
+        QVector<Point> createCircle(const Point& center, qreal diameter) const noexcept;
+        QVector<Point> createRect(const Point& center, qreal width, qreal height) const noexcept;
+        Aperture createStandardAperture(const QString& name, const QVector<qreal>& params) const;
+        Aperture createMacroAperture(const QStringList& macro, const QVector<qreal>& params) const;
+        static QVector<qreal> parseNumbers(const QString& str, QChar separator);
+        static QVector<Point> rotated(const QVector<Point>& vertices, qreal degrees) noexcept;
+        static QVector<Point> translated(const QVector<Point>& vertices, const Point& offset) noexcept;
+
+
+        // Attributes
+        Length mArcTolerance;
+
+        // Graphics State
+        bool mFormatSpecified;
+        int mDecimalDigits;
+        int mIntegerDigits;
+        bool mTrailingZerosOmitted;
+        qreal mNmPerUnit;               ///< 1'000'000 for millimeters, 25'400'000 for inches
+        QHash<QString, QStringList> mMacros;
+        QHash<int, Aperture> mApertures;
+        int mCurrentAperture;           ///< -1 if no aperture is selected
+        Point mCurrentPosition;
+        Interpolation mInterpolation;
+        bool mMultiQuadrant;
+        bool mRegionMode;
+        bool mDarkPolarity;
+        bool mEndOfFile;
+        QVector<Point> mContour;        ///< the current contour in region mode
+        QVector<CamRasterizer::Object> mObjects;
+
+        // Step and Repeat
+        int mStepAndRepeatStart;        ///< index of the first object of the block, or -1
+        QPair<int, int> mStepAndRepeatCount;  ///< columns and rows
+        Point mStepAndRepeatDistance;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_GERBERPARSER_H
@@ -19,7 +19,7 @@ DEFINES += FILE_FORMAT_VERSION="\\\"0.1\\\""
 DEFINES += GIT_VERSION="\\\"$(shell git -C \""$$_PRO_FILE_PWD_"\" describe --abbrev=7 --dirty --always --tags)\\\""
 #DEFINES += USE_32BIT_LENGTH_UNITS          # see units/length.h
 
-QT += core widgets xml opengl network sql
+QT += core widgets xml opengl network sql concurrent svg
 
 CONFIG += staticlib
 
@@ -28,6 +28,9 @@ INCLUDEPATH += \
     ../../sexpresso \
 
 SOURCES += \
+    algorithm/airwiresbuilder.cpp \
+    algorithm/drillpathoptimizer.cpp \
+    algorithm/polygonclipper.cpp \
     alignment.cpp \
     application.cpp \
     attributes/attribute.cpp \
@@ -42,9 +45,12 @@ SOURCES += \
     attributes/attrtypestring.cpp \
     attributes/attrtypevoltage.cpp \
     boarddesignrules.cpp \
+    cam/camrasterizer.cpp \
     cam/excellongenerator.cpp \
+    cam/excellonparser.cpp \
     cam/gerberaperturelist.cpp \
     cam/gerbergenerator.cpp \
+    cam/gerberparser.cpp \
     debug.cpp \
     dialogs/boarddesignrulesdialog.cpp \
     dialogs/ellipsepropertiesdialog.cpp \
@@ -73,18 +79,25 @@ SOURCES += \
     geometry/vertex.cpp \
     graphics/defaultgraphicslayerprovider.cpp \
     graphics/ellipsegraphicsitem.cpp \
+    graphics/graphicsexport.cpp \
     graphics/graphicslayer.cpp \
+    graphics/graphicspagecache.cpp \
+    graphics/graphicsprimitives.cpp \
     graphics/graphicsscene.cpp \
     graphics/graphicsview.cpp \
     graphics/holegraphicsitem.cpp \
+    graphics/levelofdetail.cpp \
     graphics/linegraphicsitem.cpp \
     graphics/origincrossgraphicsitem.cpp \
     graphics/polygongraphicsitem.cpp \
     graphics/primitiveellipsegraphicsitem.cpp \
     graphics/primitivepathgraphicsitem.cpp \
     graphics/primitivetextgraphicsitem.cpp \
+    graphics/renderstatistics.cpp \
     graphics/textgraphicsitem.cpp \
+    graphics/textlayoutcache.cpp \
     gridproperties.cpp \
+    memorypool.cpp \
     network/filedownload.cpp \
     network/networkaccessmanager.cpp \
     network/networkrequest.cpp \
@@ -118,6 +131,10 @@ SOURCES += \
     widgets/statusbar.cpp \
 
 HEADERS += \
+    algorithm/airwiresbuilder.h \
+    algorithm/drillpathoptimizer.h \
+    algorithm/polygonclipper.h \
+    algorithm/rtree.h \
     alignment.h \
     application.h \
     attributes/attribute.h \
@@ -132,9 +149,12 @@ HEADERS += \
     attributes/attrtypestring.h \
     attributes/attrtypevoltage.h \
     boarddesignrules.h \
+    cam/camrasterizer.h \
     cam/excellongenerator.h \
+    cam/excellonparser.h \
     cam/gerberaperturelist.h \
     cam/gerbergenerator.h \
+    cam/gerberparser.h \
     debug.h \
     dialogs/boarddesignrulesdialog.h \
     dialogs/ellipsepropertiesdialog.h \
@@ -169,19 +189,26 @@ HEADERS += \
     geometry/vertex.h \
     graphics/defaultgraphicslayerprovider.h \
     graphics/ellipsegraphicsitem.h \
+    graphics/graphicsexport.h \
     graphics/graphicslayer.h \
+    graphics/graphicspagecache.h \
+    graphics/graphicsprimitives.h \
     graphics/graphicsscene.h \
     graphics/graphicsview.h \
     graphics/holegraphicsitem.h \
     graphics/if_graphicsvieweventhandler.h \
+    graphics/levelofdetail.h \
     graphics/linegraphicsitem.h \
     graphics/origincrossgraphicsitem.h \
     graphics/polygongraphicsitem.h \
     graphics/primitiveellipsegraphicsitem.h \
     graphics/primitivepathgraphicsitem.h \
     graphics/primitivetextgraphicsitem.h \
+    graphics/renderstatistics.h \
     graphics/textgraphicsitem.h \
+    graphics/textlayoutcache.h \
     gridproperties.h \
+    memorypool.h \
     network/filedownload.h \
     network/networkaccessmanager.h \
     network/networkrequest.h \
@@ -96,6 +96,12 @@ void BoardDesignRulesDialog::updateWidgets() noexcept
     mUi->spbxRestringViasRatio->setValue(mDesignRules.getRestringViaRatio().toPercent());
     mUi->spbxRestringViasMin->setValue(mDesignRules.getRestringViaMin().toMm());
     mUi->spbxRestringViasMax->setValue(mDesignRules.getRestringViaMax().toMm());
+    // design rule check
+    mUi->spbxMinCopperClearance->setValue(mDesignRules.getMinCopperClearance().toMm());
+    mUi->spbxMinCopperWidth->setValue(mDesignRules.getMinCopperWidth().toMm());
+    mUi->spbxMinAnnularRing->setValue(mDesignRules.getMinAnnularRing().toMm());
+    mUi->spbxMinDrillDiameter->setValue(mDesignRules.getMinDrillDiameter().toMm());
+    mUi->spbxMinOutlineClearance->setValue(mDesignRules.getMinOutlineClearance().toMm());
 }
 
 void BoardDesignRulesDialog::applyRules() noexcept
@@ -119,6 +125,12 @@ void BoardDesignRulesDialog::applyRules() noexcept
     mDesignRules.setRestringViaRatio(Ratio::fromPercent(mUi->spbxRestringViasRatio->value()));
     mDesignRules.setRestringViaMin(Length::fromMm(mUi->spbxRestringViasMin->value()));
     mDesignRules.setRestringViaMax(Length::fromMm(mUi->spbxRestringViasMax->value()));
+    // design rule check
+    mDesignRules.setMinCopperClearance(Length::fromMm(mUi->spbxMinCopperClearance->value()));
+    mDesignRules.setMinCopperWidth(Length::fromMm(mUi->spbxMinCopperWidth->value()));
+    mDesignRules.setMinAnnularRing(Length::fromMm(mUi->spbxMinAnnularRing->value()));
+    mDesignRules.setMinDrillDiameter(Length::fromMm(mUi->spbxMinDrillDiameter->value()));
+    mDesignRules.setMinOutlineClearance(Length::fromMm(mUi->spbxMinOutlineClearance->value()));
 }
 
 /*****************************************************************************************
@@ -50,6 +50,16 @@ CmdPolygonEdit::~CmdPolygonEdit() noexcept
     }
 }
 
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+qint64 CmdPolygonEdit::getSizeEstimate() const noexcept
+{
+    return UndoCommand::getSizeEstimate() + sizeof(*this) - sizeof(UndoCommand)
+        + (mOldPath.getVertices().count() + mNewPath.getVertices().count()) * sizeof(Vertex);
+}
+
 /*****************************************************************************************
  *  Setters
  ****************************************************************************************/
@@ -133,6 +143,25 @@ void CmdPolygonEdit::performRedo()
     mPolygon.setPath(mNewPath);
 }
 
+bool CmdPolygonEdit::canMergeWith(const UndoCommand& other) const noexcept
+{
+    // only merge if the other command continues where this command ended
+    const CmdPolygonEdit& cmd = static_cast<const CmdPolygonEdit&>(other);
+    return (&cmd.mPolygon == &mPolygon) && (cmd.mOldLayerName == mNewLayerName)
+        && (cmd.mOldLineWidth == mNewLineWidth) && (cmd.mOldIsFilled == mNewIsFilled)
+        && (cmd.mOldIsGrabArea == mNewIsGrabArea) && (cmd.mOldPath == mNewPath);
+}
+
+void CmdPolygonEdit::performMergeWith(const UndoCommand& other) noexcept
+{
+    const CmdPolygonEdit& cmd = static_cast<const CmdPolygonEdit&>(other);
+    mNewLayerName = cmd.mNewLayerName;
+    mNewLineWidth = cmd.mNewLineWidth;
+    mNewIsFilled = cmd.mNewIsFilled;
+    mNewIsGrabArea = cmd.mNewIsGrabArea;
+    mNewPath = cmd.mNewPath;
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -52,6 +52,9 @@ class CmdPolygonEdit final : public UndoCommand
         explicit CmdPolygonEdit(Polygon& polygon) noexcept;
         ~CmdPolygonEdit() noexcept;
 
+        // Getters
+        qint64 getSizeEstimate() const noexcept override;
+
         // Setters
         void setLayerName(const QString& name, bool immediate) noexcept;
         void setLineWidth(const Length& width, bool immediate) noexcept;
@@ -78,6 +81,12 @@ class CmdPolygonEdit final : public UndoCommand
         /// @copydoc UndoCommand::performRedo()
         void performRedo() override;
 
+        /// @copydoc UndoCommand::canMergeWith()
+        bool canMergeWith(const UndoCommand& other) const noexcept override;
+
+        /// @copydoc UndoCommand::performMergeWith()
+        void performMergeWith(const UndoCommand& other) noexcept override;
+
 
         // Private Member Variables
 
@@ -0,0 +1,317 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include <QtConcurrent/QtConcurrent>
+#include <QtSvg>
+#include "graphicsexport.h"
+#include "graphicspagecache.h"
+#include "../fileio/filepath.h"
+#include "../fileio/fileutils.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+GraphicsExport::GraphicsExport(const GraphicsPrimitives& primitives) noexcept :
+    mPrimitives(primitives), mDpi(300), mMargin(1000000), mBackground(Qt::white),
+    mTileSize(512)
+{
+}
+
+GraphicsExport::~GraphicsExport() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+QRectF GraphicsExport::getSceneRectPx() const noexcept
+{
+    qreal margin = mMargin.toPx();
+    return mPrimitives.getBoundingRectPx().adjusted(-margin, -margin, margin, margin);
+}
+
+QSize GraphicsExport::getImageSize() const noexcept
+{
+    QSizeF size = getSceneRectPx().size() * getScaleFactor();
+    return QSize(qMax(qCeil(size.width()), 1), qMax(qCeil(size.height()), 1));
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+QImage GraphicsExport::renderImage() const noexcept
+{
+    QSize size = getImageSize();
+    if (qint64(size.width()) * size.height() > sMaxImagePixels) {
+        return QImage();
+    }
+
+    struct Tile {
+        QRect rect;
+        QImage image;
+    };
+    QVector<Tile> tiles;
+    foreach (const QRect& rect, getTiles()) {
+        tiles.append(Tile{rect, QImage()});
+    }
+    QtConcurrent::blockingMap(tiles, [this](Tile& tile){
+        tile.image = renderTile(tile.rect);
+    });
+
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QPainter painter(&image);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    foreach (const Tile& tile, tiles) {
+        painter.drawImage(tile.rect.topLeft(), tile.image);
+    }
+    return image;
+}
+
+QImage GraphicsExport::renderTile(const QRect& rect) const noexcept
+{
+    QImage image(rect.size(), QImage::Format_ARGB32_Premultiplied);
+    image.fill(mBackground);
+    QPainter painter(&image);
+    painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing);
+    qreal scaleFactor = getScaleFactor();
+    QRectF sceneRect = getSceneRectPx();
+    QRectF exposedRect(sceneRect.topLeft() + QPointF(rect.topLeft()) / scaleFactor,
+                       QSizeF(rect.size()) / scaleFactor);
+    painter.scale(scaleFactor, scaleFactor);
+    painter.translate(-exposedRect.topLeft());
+    mPrimitives.paint(painter, exposedRect);
+    return image;
+}
+
+void GraphicsExport::exportImage(const FilePath& filepath) const
+{
+    QImage image = renderImage();
+    if (image.isNull()) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("The image is too large (%1x%2 pixels), please reduce the resolution."))
+            .arg(getImageSize().width()).arg(getImageSize().height()));
+    }
+    FileUtils::makePath(filepath.getParentDir()); // can throw
+    if (!image.save(filepath.toStr(), "PNG")) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("Could not write file \"%1\".")).arg(filepath.toNative()));
+    }
+}
+
+QSize GraphicsExport::exportImageTiles(const FilePath& directory) const
+{
+    struct Job {
+        QRect rect;
+        FilePath filepath;
+        bool success;
+    };
+    QVector<Job> jobs;
+    QSize count(0, 0);
+    foreach (const QRect& rect, getTiles()) {
+        int row = rect.top() / mTileSize;
+        int column = rect.left() / mTileSize;
+        count = count.expandedTo(QSize(column + 1, row + 1));
+        FilePath fp = directory.getPathTo(QString("tile_%1_%2.png").arg(row).arg(column));
+        jobs.append(Job{rect, fp, false});
+    }
+
+    FileUtils::makePath(directory); // can throw
+    QtConcurrent::blockingMap(jobs, [this](Job& job){
+        job.success = renderTile(job.rect).save(job.filepath.toStr(), "PNG");
+    });
+    foreach (const Job& job, jobs) {
+        if (!job.success) {
+            throw RuntimeError(__FILE__, __LINE__,
+                QString(tr("Could not write file \"%1\".")).arg(job.filepath.toNative()));
+        }
+    }
+    return count;
+}
+
+void GraphicsExport::exportSvg(const FilePath& filepath) const
+{
+    FileUtils::makePath(filepath.getParentDir()); // can throw
+    QRectF sceneRect = getSceneRectPx();
+    QSvgGenerator generator;
+    generator.setFileName(filepath.toStr());
+    generator.setResolution(qRound(Length(25400000).toPx())); // one scene pixel is one point
+    generator.setSize(sceneRect.size().toSize());
+    generator.setViewBox(QRectF(QPointF(0, 0), sceneRect.size()));
+    QPainter painter;
+    if (!painter.begin(&generator)) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("Could not write file \"%1\".")).arg(filepath.toNative()));
+    }
+    paintPage(painter, QRectF(QPointF(0, 0), sceneRect.size()));
+    painter.end();
+}
+
+GraphicsExport::Recording GraphicsExport::recordPage() const noexcept
+{
+    Recording recording{QPicture(), getSceneRectPx()};
+    QPainter painter(&recording.picture);
+    if (mBackground.alpha() > 0) {
+        painter.fillRect(recording.sceneRect, mBackground);
+    }
+    mPrimitives.paint(painter);
+    painter.end();
+    return recording;
+}
+
+void GraphicsExport::exportPdf(const FilePath& filepath) const
+{
+    exportPdf(QList<GraphicsExport>{*this}, filepath);
+}
+
+void GraphicsExport::exportPdf(const QList<GraphicsExport>& pages, const FilePath& filepath)
+{
+    QList<PdfPage> pdfPages;
+    foreach (const GraphicsExport& page, pages) {
+        pdfPages.append(PdfPage{QByteArray(), [page](){return page;}});
+    }
+    exportPdf(pdfPages, filepath);
+}
+
+void GraphicsExport::exportPdf(const QList<PdfPage>& pages, const FilePath& filepath,
+                               GraphicsPageCache* cache, const QPageLayout& layout)
+{
+    if (pages.isEmpty()) {
+        throw LogicError(__FILE__, __LINE__, tr("No pages to export."));
+    }
+    FileUtils::makePath(filepath.getParentDir()); // can throw
+
+    // build and record all pages in parallel, only the PDF writer itself is sequential
+    struct Page {
+        const PdfPage* page;
+        Recording recording;
+    };
+    QVector<Page> recordings;
+    for (int i = 0; i < pages.count(); ++i) {
+        recordings.append(Page{&pages.at(i), Recording()});
+    }
+    QtConcurrent::blockingMap(recordings, [cache](Page& p){
+        if (cache && (!p.page->key.isEmpty())) {
+            p.recording = cache->getPage(p.page->key, p.page->build);
+        } else {
+            p.recording = p.page->build().recordPage();
+        }
+    });
+
+    // without a fixed layout, each page gets the size of its exported area
+    auto getPageLayout = [&layout, &recordings](int index) {
+        if (layout.isValid()) return layout;
+        QSizeF size = recordings.at(index).recording.sceneRect.size();
+        return QPageLayout(QPageSize(size, QPageSize::Point), QPageLayout::Portrait,
+                           QMarginsF(0, 0, 0, 0));
+    };
+    QPdfWriter writer(filepath.toStr());
+    writer.setCreator(qApp->applicationName());
+    writer.setPageLayout(getPageLayout(0));
+    QPainter painter;
+    if (!painter.begin(&writer)) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("Could not write file \"%1\".")).arg(filepath.toNative()));
+    }
+    for (int i = 0; i < recordings.count(); ++i) {
+        if (i > 0) {
+            writer.setPageLayout(getPageLayout(i));
+            writer.newPage();
+        }
+        // scale to fit the page (keeping the aspect ratio) and center it
+        QSizeF pageSize = writer.pageLayout().paintRectPixels(writer.resolution()).size();
+        QSizeF size = recordings.at(i).recording.sceneRect.size();
+        size.scale(pageSize, Qt::KeepAspectRatio);
+        QPointF pos((pageSize.width() - size.width()) / 2,
+                    (pageSize.height() - size.height()) / 2);
+        replayPage(painter, QRectF(pos, size), recordings.at(i).recording);
+    }
+    painter.end();
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+qreal GraphicsExport::getScaleFactor() const noexcept
+{
+    return mDpi / Length(25400000).toPx(); // image pixels per scene pixel
+}
+
+QList<QRect> GraphicsExport::getTiles() const noexcept
+{
+    QList<QRect> tiles;
+    QSize size = getImageSize();
+    for (int y = 0; y < size.height(); y += mTileSize) {
+        for (int x = 0; x < size.width(); x += mTileSize) {
+            tiles.append(QRect(x, y, qMin(mTileSize, size.width() - x),
+                               qMin(mTileSize, size.height() - y)));
+        }
+    }
+    return tiles;
+}
+
+void GraphicsExport::replayPage(QPainter& painter, const QRectF& targetRect,
+                                const Recording& recording) noexcept
+{
+    const QRectF& sceneRect = recording.sceneRect;
+    painter.save();
+    painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing);
+    painter.translate(targetRect.topLeft());
+    painter.scale(targetRect.width() / sceneRect.width(),
+                  targetRect.height() / sceneRect.height());
+    painter.translate(-sceneRect.topLeft());
+    painter.drawPicture(QPointF(0, 0), recording.picture); // in scene pixels
+    painter.restore();
+}
+
+void GraphicsExport::paintPage(QPainter& painter, const QRectF& targetRect) const noexcept
+{
+    QRectF sceneRect = getSceneRectPx();
+    painter.save();
+    painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing);
+    if (mBackground.alpha() > 0) {
+        painter.fillRect(targetRect, mBackground);
+    }
+    painter.translate(targetRect.topLeft());
+    painter.scale(targetRect.width() / sceneRect.width(),
+                  targetRect.height() / sceneRect.height());
+    painter.translate(-sceneRect.topLeft());
+    mPrimitives.paint(painter);
+    painter.restore();
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,215 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_GRAPHICSEXPORT_H
+#define LIBREPCB_GRAPHICSEXPORT_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include <functional>
+#include "graphicsprimitives.h"
+#include "../exceptions.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class FilePath;
+class GraphicsPageCache;
+
+/*****************************************************************************************
+ *  Class GraphicsExport
+ ****************************************************************************************/
+
+/**
+ * @brief The GraphicsExport class writes librepcb::GraphicsPrimitives to image files
+ *
+ * Supported formats are PNG (rendered in parallel tiles, either stitched to a single
+ * image or written as separate files), SVG and PDF. No widgets and no graphics scene
+ * are involved, so the export also works without display (e.g. with the "offscreen"
+ * platform plugin).
+ *
+ * The exported area is the bounding rect of the primitives plus a margin. Scene pixels
+ * are 1/72 inch (see librepcb::Length::toPx()), so vector formats use points as unit and
+ * keep the real size of the board or schematic.
+ *
+ * Multi-page PDFs are exported by building and recording all pages in parallel (see
+ * #recordPage()) and then streaming the recordings into the PDF writer in order.
+ * Optionally, the recordings are taken from a librepcb::GraphicsPageCache, so unchanged
+ * pages are neither built nor recorded again when exporting the same document once more.
+ */
+class GraphicsExport final
+{
+        Q_DECLARE_TR_FUNCTIONS(GraphicsExport)
+
+    public:
+
+        // Types
+
+        /**
+         * @brief A recorded page, see #recordPage()
+         */
+        struct Recording {
+            QPicture picture;   ///< in scene pixels
+            QRectF sceneRect;   ///< the exported area
+        };
+
+        /**
+         * @brief A page of a multi-page PDF, see #exportPdf()
+         */
+        struct PdfPage {
+            QByteArray key;                         ///< content hash, empty to not cache
+            std::function<GraphicsExport()> build;  ///< called in the thread pool
+        };
+
+        // Constructors / Destructor
+        GraphicsExport() = delete;
+        GraphicsExport(const GraphicsExport& other) = default;
+        explicit GraphicsExport(const GraphicsPrimitives& primitives) noexcept;
+        ~GraphicsExport() noexcept;
+
+        // Getters
+        const GraphicsPrimitives& getPrimitives() const noexcept {return mPrimitives;}
+        int getResolution() const noexcept {return mDpi;}
+        const QColor& getBackground() const noexcept {return mBackground;}
+        QRectF getSceneRectPx() const noexcept;
+        QSize getImageSize() const noexcept;
+
+        // Setters
+        void setResolution(int dpi) noexcept {mDpi = qMax(dpi, 1);}
+        void setMargin(const Length& margin) noexcept {mMargin = margin;}
+        void setBackground(const QColor& color) noexcept {mBackground = color;}
+        void setTileSize(int size) noexcept {mTileSize = qMax(size, 16);}
+
+        // General Methods
+
+        /**
+         * @brief Render the primitives to an image, split into tiles rendered in parallel
+         *
+         * @return A null image if the image would be too large (see #sMaxImagePixels)
+         */
+        QImage renderImage() const noexcept;
+
+        /**
+         * @brief Render a part of the image (in image pixel coordinates)
+         */
+        QImage renderTile(const QRect& rect) const noexcept;
+
+        /**
+         * @brief Export the whole image as a PNG file
+         *
+         * @throw Exception If the image is too large or the file could not be written
+         */
+        void exportImage(const FilePath& filepath) const;
+
+        /**
+         * @brief Export the image as PNG tiles ("tile_<row>_<column>.png") into a directory
+         *
+         * In contrast to #exportImage(), the whole image is never held in memory, so
+         * this works for any resolution.
+         *
+         * @return The number of tiles in each direction
+         *
+         * @throw Exception If a file could not be written
+         */
+        QSize exportImageTiles(const FilePath& directory) const;
+
+        /**
+         * @brief Export as SVG file
+         *
+         * @throw Exception If the file could not be written
+         */
+        void exportSvg(const FilePath& filepath) const;
+
+        /**
+         * @brief Record the page as vector graphics (reentrant)
+         *
+         * The recording contains the background and all primitives in scene pixel
+         * coordinates, so it can be replayed into any paint device and resolution.
+         */
+        Recording recordPage() const noexcept;
+
+        /**
+         * @brief Export as PDF file with a single page fitting the exported area
+         *
+         * @throw Exception If the file could not be written
+         */
+        void exportPdf(const FilePath& filepath) const;
+
+        /**
+         * @brief Export multiple pages (e.g. all schematics) to a single PDF file
+         *
+         * Each page gets the size of its exported area.
+         *
+         * @throw Exception If the file could not be written
+         */
+        static void exportPdf(const QList<GraphicsExport>& pages, const FilePath& filepath);
+
+        /**
+         * @brief Export multiple pages which are built in the thread pool
+         *
+         * @param pages     The pages to export, only their keys are evaluated in the
+         *                  calling thread
+         * @param filepath  The PDF file to write
+         * @param cache     If not nullptr, recorded pages are taken from (and added to)
+         *                  this cache, so pages with a known key are not built again
+         * @param layout    The page layout of all pages (the exported area is scaled to
+         *                  fit), or an invalid layout to give each page the size of its
+         *                  exported area
+         *
+         * @throw Exception If the file could not be written
+         */
+        static void exportPdf(const QList<PdfPage>& pages, const FilePath& filepath,
+                              GraphicsPageCache* cache = nullptr,
+                              const QPageLayout& layout = QPageLayout());
+
+        // Operator Overloadings
+        GraphicsExport& operator=(const GraphicsExport& rhs) = default;
+
+        // Static Variables
+        static constexpr qint64 sMaxImagePixels = 400000000; ///< 1.6GB with 32bit pixels
+
+
+    private: // Methods
+        qreal getScaleFactor() const noexcept;
+        QList<QRect> getTiles() const noexcept;
+        void paintPage(QPainter& painter, const QRectF& targetRect) const noexcept;
+        static void replayPage(QPainter& painter, const QRectF& targetRect,
+                               const Recording& recording) noexcept;
+
+
+    private: // Data
+        GraphicsPrimitives mPrimitives;
+        int mDpi;
+        Length mMargin;
+        QColor mBackground;
+        int mTileSize;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_GRAPHICSEXPORT_H
@@ -262,6 +262,7 @@ void GraphicsLayer::getDefaultValues(const QString& name, QString& nameTr, QColo
         h.insert(sBoardDocumentation,       {tr("Documentation"),               Qt::white,                  Qt::lightGray,              true});
         h.insert(sBoardComments,            {tr("Comments"),                    Qt::yellow,                 Qt::darkYellow,             true});
         h.insert(sBoardGuide,               {tr("Guide"),                       Qt::darkYellow,             Qt::yellow,                 true});
+        h.insert(sBoardAirWires,            {tr("Air Wires"),                   Qt::yellow,                 Qt::white,                  true});
         // board symmetric
         h.insert(sTopPlacement,             {tr("Top Placement"),               QColor(224, 224, 224, 150), QColor(224, 224, 224, 220), true});
         h.insert(sBotPlacement,             {tr("Bot Placement"),               QColor(224, 224, 224, 150), QColor(224, 224, 224, 220), true});
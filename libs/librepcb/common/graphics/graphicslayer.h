@@ -91,6 +91,7 @@ class GraphicsLayer : public QObject
         static constexpr const char* sBoardDocumentation      = "brd_documentation";      ///< for documentation purposes, e.g. text
         static constexpr const char* sBoardComments           = "brd_comments";           ///< for personal comments, e.g. text
         static constexpr const char* sBoardGuide              = "brd_guide";              ///< e.g. for boxes around circuits
+        static constexpr const char* sBoardAirWires           = "brd_airwires";           ///< librepcb::project::BI_AirWire
 
         // symmetric board layers
         static constexpr const char* sTopPlacement            = "top_placement";          ///< placement information (e.g. outline) of devices
@@ -131,6 +132,7 @@ class GraphicsLayer : public QObject
         static constexpr const char* sDebugNetLinesNetSignalNames           = "dbg_NetLinesNetSignalNames";
         static constexpr const char* sDebugInvisibleNetPoints               = "dbg_InvisibleNetPoints";
         static constexpr const char* sDebugComponentSymbolsCounts           = "dbg_ComponentSymbolsCounts";
+        static constexpr const char* sDebugRepaintedRegions                 = "dbg_RepaintedRegions";
 #endif
 
         // Constructors / Destructor
@@ -0,0 +1,108 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include "graphicspagecache.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+GraphicsPageCache::GraphicsPageCache() noexcept :
+    mRecordedPageCount(0)
+{
+}
+
+GraphicsPageCache::~GraphicsPageCache() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+int GraphicsPageCache::getPageCount() const noexcept
+{
+    QMutexLocker locker(&mMutex);
+    return mPages.count();
+}
+
+int GraphicsPageCache::getRecordedPageCount() const noexcept
+{
+    QMutexLocker locker(&mMutex);
+    return mRecordedPageCount;
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+GraphicsExport::Recording GraphicsPageCache::getPage(const QByteArray& key,
+    const std::function<GraphicsExport()>& build) noexcept
+{
+    {
+        QMutexLocker locker(&mMutex);
+        auto it = mPages.find(key);
+        if (it != mPages.end()) {
+            it->used = true;
+            return it->recording;
+        }
+    }
+
+    // build and record without holding the lock, so other pages can be done concurrently
+    GraphicsExport::Recording recording = build().recordPage();
+    QMutexLocker locker(&mMutex);
+    mPages.insert(key, Page{recording, true});
+    ++mRecordedPageCount;
+    return recording;
+}
+
+void GraphicsPageCache::removeUnusedPages() noexcept
+{
+    QMutexLocker locker(&mMutex);
+    for (auto it = mPages.begin(); it != mPages.end();) {
+        if (it->used) {
+            it->used = false;
+            ++it;
+        } else {
+            it = mPages.erase(it);
+        }
+    }
+}
+
+void GraphicsPageCache::clear() noexcept
+{
+    QMutexLocker locker(&mMutex);
+    mPages.clear();
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,112 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_GRAPHICSPAGECACHE_H
+#define LIBREPCB_GRAPHICSPAGECACHE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include <functional>
+#include "graphicsexport.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class GraphicsPageCache
+ ****************************************************************************************/
+
+/**
+ * @brief The GraphicsPageCache class keeps recorded pages of multi-page exports
+ *
+ * The recordings (see librepcb::GraphicsExport::recordPage()) are keyed by a hash of the
+ * page content, so exporting a document again after a small modification only builds
+ * and records the pages which have actually changed. The hash is provided by the caller
+ * and should be calculated from the document (e.g. see
+ * librepcb::project::SchematicPainter::getContentHash()), as hashing the built page
+ * would be about as expensive as recording it. All methods are thread-safe, pages can
+ * be requested concurrently from the thread pool.
+ *
+ * To limit the memory usage, #removeUnusedPages() should be called after each export.
+ */
+class GraphicsPageCache final
+{
+    public:
+
+        // Constructors / Destructor
+        GraphicsPageCache(const GraphicsPageCache& other) = delete;
+        GraphicsPageCache() noexcept;
+        ~GraphicsPageCache() noexcept;
+
+        // Getters
+        int getPageCount() const noexcept;
+
+        /**
+         * @brief Get the count of pages recorded so far (i.e. the count of cache misses)
+         */
+        int getRecordedPageCount() const noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Get the recording of a page, either from the cache or recorded now
+         *
+         * @param key       A hash over everything which affects the page
+         * @param build     Builds the page if it is not cached yet (called without
+         *                  holding the lock, so pages can be built concurrently)
+         */
+        GraphicsExport::Recording getPage(const QByteArray& key,
+                                          const std::function<GraphicsExport()>& build) noexcept;
+
+        /**
+         * @brief Remove all pages which were not requested since the last call
+         */
+        void removeUnusedPages() noexcept;
+
+        void clear() noexcept;
+
+        // Operator Overloadings
+        GraphicsPageCache& operator=(const GraphicsPageCache& rhs) = delete;
+
+
+    private: // Types
+        struct Page {
+            GraphicsExport::Recording recording;
+            bool used;      ///< requested since the last #removeUnusedPages()
+        };
+
+
+    private: // Data
+        mutable QMutex mMutex;
+        QHash<QByteArray, Page> mPages; ///< key: hash of the page content
+        int mRecordedPageCount;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_GRAPHICSPAGECACHE_H
@@ -0,0 +1,142 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include "graphicsprimitives.h"
+#include "textlayoutcache.h"
+#include "../alignment.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+GraphicsPrimitives::GraphicsPrimitives() noexcept :
+    mCount(0)
+{
+}
+
+GraphicsPrimitives::GraphicsPrimitives(const GraphicsPrimitives& other) noexcept :
+    mPrimitives(other.mPrimitives), mBoundingRect(other.mBoundingRect), mCount(other.mCount)
+{
+}
+
+GraphicsPrimitives::~GraphicsPrimitives() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void GraphicsPrimitives::addFill(qreal z, const QColor& color, const QPainterPath& path) noexcept
+{
+    if (path.isEmpty()) return;
+    addPrimitive(z, Primitive{color, path, -1, path.boundingRect()});
+}
+
+void GraphicsPrimitives::addStroke(qreal z, const QColor& color, const QPainterPath& path,
+                                   qreal lineWidth) noexcept
+{
+    if (path.isEmpty()) return;
+    qreal w = qMax(lineWidth / 2, qreal(1)); // cosmetic pens are 1px wide on any device
+    addPrimitive(z, Primitive{color, path, qMax(lineWidth, qreal(0)),
+                           path.boundingRect().adjusted(-w, -w, w, w)});
+}
+
+void GraphicsPrimitives::paint(QPainter& painter, const QRectF& exposedRect) const noexcept
+{
+    painter.save();
+    for (const QVector<Primitive>& primitives : mPrimitives) {
+        for (const Primitive& primitive : primitives) {
+            if ((!exposedRect.isNull()) && (!exposedRect.intersects(primitive.boundingRect))) {
+                continue;
+            }
+            if (primitive.lineWidth < 0) {
+                painter.setPen(Qt::NoPen);
+                painter.setBrush(primitive.color);
+            } else {
+                painter.setPen(QPen(primitive.color, primitive.lineWidth, Qt::SolidLine,
+                                    Qt::RoundCap, Qt::RoundJoin));
+                painter.setBrush(Qt::NoBrush);
+            }
+            painter.drawPath(primitive.path);
+        }
+    }
+    painter.restore();
+}
+
+QPainterPath GraphicsPrimitives::createTextPath(const QString& text, QFont font,
+                                                const Length& height, const Alignment& align,
+                                                const Point& position, const Angle& rotation,
+                                                bool rotate180) noexcept
+{
+    // same layout as used by the graphics items, see BGI_Footprint or SGI_Symbol
+    font.setPixelSize(qCeil(height.toPx()));
+    Qt::Alignment flags = rotate180 ? align.mirrored().toQtAlign() : align.toQtAlign();
+    QSharedPointer<const TextLayout> layout =
+        TextLayoutCache::instance().getLayout(text, font, flags);
+    QPainterPath path = layout->toPainterPath();
+    qreal scaleFactor = height.toPx() / layout->getFontHeight();
+
+    // scale, rotate and move the text to its position
+    QTransform transform = QTransform::fromTranslate(position.toPxQPointF().x(),
+                                                     position.toPxQPointF().y());
+    transform.rotate(-rotation.toDeg());
+    if (rotate180) transform.rotate(180);
+    transform.scale(scaleFactor, scaleFactor);
+    return transform.map(path);
+}
+
+/*****************************************************************************************
+ *  Operator Overloadings
+ ****************************************************************************************/
+
+GraphicsPrimitives& GraphicsPrimitives::operator=(const GraphicsPrimitives& rhs) noexcept
+{
+    mPrimitives = rhs.mPrimitives;
+    mBoundingRect = rhs.mBoundingRect;
+    mCount = rhs.mCount;
+    return *this;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void GraphicsPrimitives::addPrimitive(qreal z, const Primitive& primitive) noexcept
+{
+    mPrimitives[z].append(primitive);
+    mCount++;
+    mBoundingRect = mBoundingRect.united(primitive.boundingRect);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
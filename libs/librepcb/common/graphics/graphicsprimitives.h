@@ -0,0 +1,144 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_GRAPHICSPRIMITIVES_H
+#define LIBREPCB_GRAPHICSPRIMITIVES_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include "../units/all_length_units.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class Alignment;
+
+/*****************************************************************************************
+ *  Class GraphicsPrimitives
+ ****************************************************************************************/
+
+/**
+ * @brief The GraphicsPrimitives class is a flat list of filled or stroked painter paths
+ *
+ * It is used to render boards and schematics without a QGraphicsScene (e.g. to export
+ * images in a headless environment). The primitives are built once from the model (in
+ * the thread which owns the model, see librepcb::project::BoardPainter and
+ * librepcb::project::SchematicPainter) and can then be painted any number of times from
+ * any thread, even concurrently, because #paint() only reads implicitly shared data.
+ *
+ * Texts are converted to paths with #createTextPath() while building the primitives,
+ * so painting them does not need the font database at all.
+ *
+ * Primitives are painted in the order of their Z value, primitives with the same Z value
+ * in the order they were added.
+ */
+class GraphicsPrimitives final
+{
+    public:
+
+        // Constructors / Destructor
+        GraphicsPrimitives() noexcept;
+        GraphicsPrimitives(const GraphicsPrimitives& other) noexcept;
+        ~GraphicsPrimitives() noexcept;
+
+        // Getters
+        bool isEmpty() const noexcept {return mCount == 0;}
+        int getCount() const noexcept {return mCount;}
+        const QRectF& getBoundingRectPx() const noexcept {return mBoundingRect;}
+
+        // General Methods
+
+        /**
+         * @brief Add a filled path
+         */
+        void addFill(qreal z, const QColor& color, const QPainterPath& path) noexcept;
+
+        /**
+         * @brief Add a stroked path (with round caps and joins)
+         *
+         * @param lineWidth     Line width in pixels (zero means a cosmetic pen)
+         */
+        void addStroke(qreal z, const QColor& color, const QPainterPath& path,
+                       qreal lineWidth) noexcept;
+
+        /**
+         * @brief Paint all primitives (reentrant)
+         *
+         * @param painter       The painter to use (scene pixel coordinates)
+         * @param exposedRect   If not null, primitives outside this rect (in scene
+         *                      pixels) are skipped
+         */
+        void paint(QPainter& painter, const QRectF& exposedRect = QRectF()) const noexcept;
+
+        /**
+         * @brief Convert a text to a path, laid out like texts of symbols and footprints
+         *
+         * @param text          The (already substituted) text, may contain newlines
+         * @param font          The font to use (its pixel size is overridden)
+         * @param height        The text height
+         * @param align         Alignment of the text relative to its position
+         * @param position      Position of the text
+         * @param rotation      Rotation of the text (around its position)
+         * @param rotate180     Rotate the text by 180 degrees to keep it readable
+         *                      (the covered area stays the same)
+         *
+         * @note    May be called from any thread, but layouts are only shared with the
+         *          graphics items if called in the GUI thread (see
+         *          librepcb::TextLayoutCache).
+         */
+        static QPainterPath createTextPath(const QString& text, QFont font,
+                                           const Length& height, const Alignment& align,
+                                           const Point& position, const Angle& rotation,
+                                           bool rotate180) noexcept;
+
+        // Operator Overloadings
+        GraphicsPrimitives& operator=(const GraphicsPrimitives& rhs) noexcept;
+
+
+    private: // Types
+        struct Primitive {
+            QColor color;
+            QPainterPath path;
+            qreal lineWidth;    ///< -1 for filled paths
+            QRectF boundingRect;
+        };
+
+
+    private: // Methods
+        void addPrimitive(qreal z, const Primitive& primitive) noexcept;
+
+
+    private: // Data
+        QMap<qreal, QVector<Primitive>> mPrimitives; ///< grouped by Z value
+        int mCount;
+        QRectF mBoundingRect;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_GRAPHICSPRIMITIVES_H
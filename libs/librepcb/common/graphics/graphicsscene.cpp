@@ -46,26 +46,37 @@ GraphicsScene::GraphicsScene() noexcept :
     mSelectionRectItem->setPen(QPen(QColor(120, 170, 255, 255), 0));
     mSelectionRectItem->setBrush(selectBrush);
     mSelectionRectItem->setZValue(1000);
-    QGraphicsScene::addItem(mSelectionRectItem);
+    addItem(*mSelectionRectItem, true);
 }
 
 GraphicsScene::~GraphicsScene() noexcept
 {
-    QGraphicsScene::removeItem(mSelectionRectItem);
+    removeItem(*mSelectionRectItem);
     delete mSelectionRectItem;  mSelectionRectItem = nullptr;
 }
 
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+bool GraphicsScene::isUncachedItem(const QGraphicsItem& item) const noexcept
+{
+    return mUncachedItems.contains(item.topLevelItem());
+}
+
 /*****************************************************************************************
  *  General Methods
  ****************************************************************************************/
 
-void GraphicsScene::addItem(QGraphicsItem& item) noexcept
+void GraphicsScene::addItem(QGraphicsItem& item, bool uncached) noexcept
 {
     QGraphicsScene::addItem(&item);
+    if (uncached) mUncachedItems.insert(&item);
 }
 
 void GraphicsScene::removeItem(QGraphicsItem& item) noexcept
 {
+    mUncachedItems.remove(&item);
     QGraphicsScene::removeItem(&item);
 }
 
@@ -50,8 +50,19 @@ class GraphicsScene final : public QGraphicsScene
         explicit GraphicsScene() noexcept;
         ~GraphicsScene() noexcept;
 
+        // Getters
+
+        /**
+         * @brief Get all items which change very often and thus should not be cached
+         *
+         * Views with a tile cache (see GraphicsView::setTileCacheEnabled()) paint these
+         * items directly on top of the cached tiles.
+         */
+        const QSet<QGraphicsItem*>& getUncachedItems() const noexcept {return mUncachedItems;}
+        bool isUncachedItem(const QGraphicsItem& item) const noexcept;
+
         // General Methods
-        void addItem(QGraphicsItem& item) noexcept;
+        void addItem(QGraphicsItem& item, bool uncached = false) noexcept;
         void removeItem(QGraphicsItem& item) noexcept;
         void setSelectionRect(const Point& p1, const Point& p2) noexcept;
 
@@ -59,6 +70,7 @@ class GraphicsScene final : public QGraphicsScene
     private:
 
         QGraphicsRectItem* mSelectionRectItem;
+        QSet<QGraphicsItem*> mUncachedItems;
 };
 
 /*****************************************************************************************
@@ -26,7 +26,10 @@
 #include "graphicsview.h"
 #include "graphicsscene.h"
 #include "if_graphicsvieweventhandler.h"
+#include "renderstatistics.h"
+#include "../exceptions.h"
 #include "../gridproperties.h"
+#include "../fileio/filepath.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -40,10 +43,17 @@ namespace librepcb {
 GraphicsView::GraphicsView(QWidget* parent, IF_GraphicsViewEventHandler* eventHandler) noexcept :
     QGraphicsView(parent), mEventHandlerObject(eventHandler), mScene(nullptr),
     mZoomAnimation(nullptr), mGridProperties(new GridProperties()), mOriginCrossVisible(true),
-    mUseOpenGl(false), mPanningActive(false)
+    mUseOpenGl(false), mPanningActive(false), mGridPattern{-1, 0, 0, QColor(), QBrush()},
+    mTileCacheEnabled(false), mTileCacheCounter(0),
+    mRepaintFlashingEnabled(false), mRemovingRepaintFlashes(false),
+    mRepaintFlashTimer(nullptr), mRenderStatisticsEnabled(false),
+    mRenderStatistics(new RenderStatistics()), mRenderStatisticsLabel(nullptr),
+    mRenderStatisticsTimer(nullptr)
 {
     setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
-    setViewportUpdateMode(QGraphicsView::FullViewportUpdate);
+    // only repaint the regions of changed items (merged to a bounding rect if there are
+    // too many of them), this requires accurate bounding rects of all items!
+    setViewportUpdateMode(QGraphicsView::SmartViewportUpdate);
     setOptimizationFlags(QGraphicsView::DontSavePainterState);
     setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
     setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
@@ -53,10 +63,35 @@ GraphicsView::GraphicsView(QWidget* parent, IF_GraphicsViewEventHandler* eventHa
     mZoomAnimation = new QVariantAnimation();
     connect(mZoomAnimation, &QVariantAnimation::valueChanged,
             this, &GraphicsView::zoomAnimationValueChanged);
+
+    mRepaintFlashTimer = new QTimer();
+    mRepaintFlashTimer->setSingleShot(true);
+    mRepaintFlashTimer->setInterval(300);
+    connect(mRepaintFlashTimer, &QTimer::timeout,
+            this, &GraphicsView::removeRepaintFlashes);
+
+    // the overlay is opaque to avoid repainting the scene below it on every update
+    mRenderStatisticsLabel = new QLabel(this);
+    mRenderStatisticsLabel->setAttribute(Qt::WA_TransparentForMouseEvents);
+    mRenderStatisticsLabel->setAutoFillBackground(true);
+    QPalette palette = mRenderStatisticsLabel->palette();
+    palette.setColor(QPalette::Window, Qt::black);
+    palette.setColor(QPalette::WindowText, Qt::white);
+    mRenderStatisticsLabel->setPalette(palette);
+    mRenderStatisticsLabel->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    mRenderStatisticsLabel->setMargin(4);
+    mRenderStatisticsLabel->hide();
+    mRenderStatisticsTimer = new QTimer();
+    mRenderStatisticsTimer->setInterval(500);
+    connect(mRenderStatisticsTimer, &QTimer::timeout,
+            this, &GraphicsView::updateRenderStatisticsOverlay);
 }
 
 GraphicsView::~GraphicsView() noexcept
 {
+    delete mRenderStatisticsTimer;  mRenderStatisticsTimer = nullptr;
+    delete mRenderStatistics;   mRenderStatistics = nullptr;
+    delete mRepaintFlashTimer;  mRepaintFlashTimer = nullptr;
     delete mZoomAnimation;      mZoomAnimation = nullptr;
     delete mGridProperties;     mGridProperties = nullptr;
 }
@@ -78,25 +113,73 @@ void GraphicsView::setUseOpenGl(bool useOpenGl) noexcept
 {
     if (useOpenGl != mUseOpenGl)
     {
-        if (useOpenGl)
+        // partial updates are not possible with a double buffered OpenGL viewport
+        if (useOpenGl) {
             setViewport(new QGLWidget(QGLFormat(QGL::DoubleBuffer | QGL::AlphaChannel | QGL::SampleBuffers)));
-        else
+            setViewportUpdateMode(QGraphicsView::FullViewportUpdate);
+        } else {
             setViewport(nullptr);
+            setViewportUpdateMode(QGraphicsView::SmartViewportUpdate);
+        }
         mUseOpenGl = useOpenGl;
     }
 }
 
+void GraphicsView::setTileCacheEnabled(bool enabled) noexcept
+{
+    if (mScene) {
+        disconnect(mScene, &QGraphicsScene::changed, this, &GraphicsView::sceneChanged);
+        if (enabled) {
+            connect(mScene, &QGraphicsScene::changed, this, &GraphicsView::sceneChanged);
+        }
+    }
+    mTileCacheEnabled = enabled;
+    updateOptimizationFlags();
+    invalidateTileCache();
+}
+
+void GraphicsView::setRepaintFlashingEnabled(bool enabled) noexcept
+{
+    mRepaintFlashingEnabled = enabled;
+    if (!enabled) removeRepaintFlashes();
+}
+
+void GraphicsView::setRenderStatisticsEnabled(bool enabled) noexcept
+{
+    mRenderStatisticsEnabled = enabled;
+    updateOptimizationFlags();
+    if (enabled) {
+        mRenderStatistics->clear();
+        updateRenderStatisticsOverlay();
+        mRenderStatisticsTimer->start();
+    } else {
+        mRenderStatisticsTimer->stop();
+    }
+    mRenderStatisticsLabel->setVisible(enabled);
+}
+
 void GraphicsView::setGridProperties(const GridProperties& properties) noexcept
 {
     *mGridProperties = properties;
+    mTileCache.clear(); // the grid is part of the tiles
     setBackgroundBrush(backgroundBrush()); // this will repaint the background
 }
 
 void GraphicsView::setScene(GraphicsScene* scene) noexcept
 {
-    if (mScene) mScene->removeEventFilter(this);
+    if (mScene) {
+        mScene->removeEventFilter(this);
+        disconnect(mScene, &QGraphicsScene::changed, this, &GraphicsView::sceneChanged);
+    }
     mScene = scene;
-    if (mScene) mScene->installEventFilter(this);
+    mUncachedItemRects.clear();
+    mTileCache.clear();
+    if (mScene) {
+        mScene->installEventFilter(this);
+        if (mTileCacheEnabled) {
+            connect(mScene, &QGraphicsScene::changed, this, &GraphicsView::sceneChanged);
+        }
+    }
     QGraphicsView::setScene(mScene);
 }
 
@@ -153,6 +236,42 @@ void GraphicsView::handleMouseWheelEvent(QGraphicsSceneWheelEvent* event) noexce
     event->setAccepted(true);
 }
 
+void GraphicsView::startRenderTrace(const FilePath& filepath)
+{
+    mRenderStatistics->startTrace(filepath); // can throw
+    updateOptimizationFlags();
+}
+
+void GraphicsView::stopRenderTrace() noexcept
+{
+    mRenderStatistics->stopTrace();
+    updateOptimizationFlags();
+}
+
+bool GraphicsView::toggleRenderTrace(bool enabled) noexcept
+{
+    if (!enabled) {
+        stopRenderTrace();
+        return false;
+    }
+    try
+    {
+        QString filename = QFileDialog::getSaveFileName(this, tr("Record Render Trace"),
+                                                        QDir::homePath(), "*.csv");
+        if (filename.isEmpty()) {
+            return false;
+        }
+        if (!filename.endsWith(".csv")) filename.append(".csv");
+        startRenderTrace(FilePath(filename)); // can throw
+        return true;
+    }
+    catch (Exception& e)
+    {
+        QMessageBox::warning(this, tr("Error"), e.getMsg());
+        return false;
+    }
+}
+
 /*****************************************************************************************
  *  Public Slots
  ****************************************************************************************/
@@ -184,6 +303,12 @@ void GraphicsView::zoomAll() noexcept
     mZoomAnimation->start();
 }
 
+void GraphicsView::invalidateTileCache() noexcept
+{
+    mTileCache.clear();
+    viewport()->update();
+}
+
 /*****************************************************************************************
  *  Private Slots
  ****************************************************************************************/
@@ -194,6 +319,270 @@ void GraphicsView::zoomAnimationValueChanged(const QVariant& value) noexcept
         fitInView(value.toRectF(), Qt::KeepAspectRatio); // zoom smoothly
 }
 
+void GraphicsView::sceneChanged(const QList<QRectF>& region) noexcept
+{
+    if (!mScene) return;
+
+    // uncached items are painted directly, so their own updates don't affect any tile
+    QVector<QRectF> uncachedRects;
+    QHash<QGraphicsItem*, QRectF> uncachedItemRects;
+    foreach (QGraphicsItem* item, mScene->getUncachedItems()) {
+        QRectF rect = item->sceneBoundingRect();
+        uncachedRects.append(rect);
+        uncachedRects.append(mUncachedItemRects.value(item, rect));
+        uncachedItemRects.insert(item, rect);
+    }
+    mUncachedItemRects = uncachedItemRects;
+
+    auto isUncachedRect = [&uncachedRects](const QRectF& rect) {
+        foreach (const QRectF& r, uncachedRects) {
+            if ((qAbs(r.left() - rect.left()) < 1e-3) && (qAbs(r.top() - rect.top()) < 1e-3) &&
+                (qAbs(r.right() - rect.right()) < 1e-3) && (qAbs(r.bottom() - rect.bottom()) < 1e-3)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    foreach (const QRectF& rect, region) {
+        if (mTileCache.isEmpty()) break;
+        if (isUncachedRect(rect)) continue;
+        for (auto it = mTileCache.begin(); it != mTileCache.end();) {
+            // antialiasing may paint up to two pixels outside of the bounding rect
+            qreal margin = 2 * it.value().sceneRect.width() / sTileSize;
+            if (it.value().sceneRect.intersects(rect.adjusted(-margin, -margin, margin, margin))) {
+                it = mTileCache.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+void GraphicsView::removeRepaintFlashes() noexcept
+{
+    mRepaintFlashTimer->stop();
+    QRegion region = mFlashedRegion;
+    mFlashedRegion = QRegion();
+    mRemovingRepaintFlashes = true; // don't flash the areas repainted right now
+    viewport()->repaint(region);
+    mRemovingRepaintFlashes = false;
+}
+
+void GraphicsView::updateRenderStatisticsOverlay() noexcept
+{
+    mRenderStatisticsLabel->setText(mRenderStatistics->getSummary());
+    mRenderStatisticsLabel->adjustSize();
+    mRenderStatisticsLabel->move(viewport()->geometry().topLeft() + QPoint(5, 5));
+    mRenderStatisticsLabel->raise();
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void GraphicsView::drawGrid(QPainter* painter, const QRectF& rect) noexcept
+{
+    updateGridPattern(painter->worldTransform().m11());
+
+    // the pattern is aligned to device pixels, so it must not be interpolated
+    bool smooth = painter->testRenderHint(QPainter::SmoothPixmapTransform);
+    painter->setRenderHint(QPainter::SmoothPixmapTransform, false);
+    painter->fillRect(rect, mGridPattern.brush);
+    painter->setRenderHint(QPainter::SmoothPixmapTransform, smooth);
+}
+
+void GraphicsView::updateGridPattern(qreal scaleFactor) noexcept
+{
+    const int type = static_cast<int>(mGridProperties->getType());
+    const qreal interval = mGridProperties->getInterval().toPx();
+    const QColor background = backgroundBrush().color();
+    if ((type == mGridPattern.type) && (interval == mGridPattern.interval) &&
+        (scaleFactor == mGridPattern.scaleFactor) && (background == mGridPattern.background)) {
+        return; // pattern is up to date
+    }
+    mGridPattern.type = type;
+    mGridPattern.interval = interval;
+    mGridPattern.scaleFactor = scaleFactor;
+    mGridPattern.background = background;
+    mGridPattern.brush = backgroundBrush();
+
+    const qreal spacing = interval * scaleFactor; // in device pixels
+    if ((mGridProperties->getType() == GridProperties::Type_t::Off) || (spacing < (qreal)5)) {
+        return; // no grid visible, only fill the background
+    }
+
+    // Render several grid intervals into the pattern to avoid tiny tiles. The pattern size
+    // is rounded down, so each pixel of it is scaled to slightly more than one device
+    // pixel (never less, otherwise grid lines could disappear).
+    const int count = qCeil(sMinGridPatternSize / spacing);
+    const int size = qMax(qFloor(count * spacing), count);
+    const qreal step = size / qreal(count);
+    QPixmap pixmap(size, size);
+    pixmap.fill(background);
+    QPainter painter(&pixmap);
+    QPen gridPen(Qt::gray);
+    gridPen.setCosmetic(true);
+    switch (mGridProperties->getType())
+    {
+        case GridProperties::Type_t::Lines:
+        {
+            QVarLengthArray<QLineF, 64> lines;
+            for (int i = 0; i < count; ++i) {
+                qreal pos = qRound(i * step);
+                lines.append(QLineF(pos, 0, pos, size));
+                lines.append(QLineF(0, pos, size, pos));
+            }
+            gridPen.setWidth(1);
+            painter.setPen(gridPen);
+            painter.setOpacity(0.5);
+            painter.drawLines(lines.data(), lines.size());
+            break;
+        }
+
+        case GridProperties::Type_t::Dots:
+        {
+            // dots on the edges are drawn on both sides to get whole dots when tiling
+            QVarLengthArray<QPointF, 256> dots;
+            for (int x = 0; x <= count; ++x) {
+                for (int y = 0; y <= count; ++y) {
+                    dots.append(QPointF(qRound(x * step), qRound(y * step)));
+                }
+            }
+            gridPen.setWidth(2);
+            painter.setPen(gridPen);
+            painter.drawPoints(dots.data(), dots.size());
+            break;
+        }
+
+        default:
+            break;
+    }
+    painter.end();
+
+    // map the pattern to exactly "count" grid intervals, aligned to the scene origin
+    mGridPattern.brush = QBrush(pixmap);
+    qreal patternScale = (count * interval) / size;
+    mGridPattern.brush.setTransform(QTransform::fromScale(patternScale, patternScale));
+}
+
+void GraphicsView::drawTiles(QPainter* painter, const QRectF& rect) noexcept
+{
+    // tiles are aligned to the device pixels of the current zoom level, independent
+    // of the scrollbar positions, so they can be reused when panning
+    const QTransform zoom = transform();
+    const qint64 zoomKey = qRound64(zoom.m11() * 1e6);
+    const QRect deviceRect = zoom.mapRect(rect).toAlignedRect();
+    const int left = qFloor(deviceRect.left() / qreal(sTileSize));
+    const int right = qFloor(deviceRect.right() / qreal(sTileSize));
+    const int top = qFloor(deviceRect.top() / qreal(sTileSize));
+    const int bottom = qFloor(deviceRect.bottom() / qreal(sTileSize));
+    ++mTileCacheCounter;
+
+    const QTransform vt = viewportTransform();
+    painter->save();
+    painter->setWorldTransform(QTransform::fromTranslate(qRound(vt.dx() - zoom.dx()),
+                                                         qRound(vt.dy() - zoom.dy())));
+    for (int y = top; y <= bottom; ++y) {
+        for (int x = left; x <= right; ++x) {
+            TileKey key(zoomKey, qMakePair(x, y));
+            auto it = mTileCache.find(key);
+            if (it == mTileCache.end()) {
+                if (mTileCache.count() >= sMaxCachedTiles) {
+                    // evict the least recently used tile, unless it's needed right now
+                    auto lru = mTileCache.begin();
+                    for (auto i = mTileCache.begin(); i != mTileCache.end(); ++i) {
+                        if (i.value().lastUsed < lru.value().lastUsed) lru = i;
+                    }
+                    if (lru.value().lastUsed < mTileCacheCounter) mTileCache.erase(lru);
+                }
+                QRect tileRect(x * sTileSize, y * sTileSize, sTileSize, sTileSize);
+                it = mTileCache.insert(key, renderTile(tileRect));
+            }
+            it.value().lastUsed = mTileCacheCounter;
+            painter->drawPixmap(x * sTileSize, y * sTileSize, it.value().pixmap);
+        }
+    }
+    painter->restore();
+}
+
+GraphicsView::CachedTile GraphicsView::renderTile(const QRect& deviceRect) noexcept
+{
+    const QTransform zoom = transform();
+    const QTransform tileTransform = zoom * QTransform::fromTranslate(-deviceRect.left(),
+                                                                      -deviceRect.top());
+    CachedTile tile;
+    tile.sceneRect = zoom.inverted().mapRect(QRectF(deviceRect));
+    tile.lastUsed = mTileCacheCounter;
+    tile.pixmap = QPixmap(deviceRect.size());
+
+    QPainter painter(&tile.pixmap);
+    painter.setRenderHints(renderHints());
+    painter.setWorldTransform(tileTransform);
+    drawGrid(&painter, tile.sceneRect);
+
+    // paint all cached items in the same order as QGraphicsView would do it
+    QStyleOptionGraphicsItem option;
+    QElapsedTimer timer;
+    foreach (QGraphicsItem* item, mScene->items(tile.sceneRect, Qt::IntersectsItemBoundingRect,
+                                               Qt::AscendingOrder, zoom)) {
+        if ((!item->isVisible()) || (mScene->isUncachedItem(*item)) ||
+            (item->flags().testFlag(QGraphicsItem::ItemHasNoContents))) {
+            continue;
+        }
+        option.state = QStyle::State_None;
+        if (item->isEnabled()) option.state |= QStyle::State_Enabled;
+        if (item->isSelected()) option.state |= QStyle::State_Selected;
+        option.exposedRect = item->boundingRect();
+        painter.setWorldTransform(item->sceneTransform() * tileTransform);
+        painter.setOpacity(item->effectiveOpacity());
+        painter.save();
+        timer.start();
+        item->paint(&painter, &option, nullptr);
+        mRenderStatistics->addItem(RenderStatistics::getItemTypeName(*item),
+                                   timer.nsecsElapsed()); // ignored if not collecting
+        painter.restore();
+    }
+    return tile;
+}
+
+bool GraphicsView::collectRenderStatistics() const noexcept
+{
+    return mRenderStatisticsEnabled || mRenderStatistics->isTracing();
+}
+
+void GraphicsView::updateOptimizationFlags() noexcept
+{
+    // drawItems() is only called if indirect painting is enabled
+    setOptimizationFlag(QGraphicsView::IndirectPainting,
+                        mTileCacheEnabled || collectRenderStatistics());
+}
+
+void GraphicsView::paintItems(QPainter* painter, int numItems, QGraphicsItem* items[],
+                              const QStyleOptionGraphicsItem options[]) noexcept
+{
+    if (!mRenderStatistics->isFrameActive()) {
+        QGraphicsView::drawItems(painter, numItems, items, options);
+        return;
+    }
+
+    // paint the items one by one to measure the time per item type
+    QElapsedTimer timer;
+    for (int i = 0; i < numItems; ++i) {
+        timer.start();
+        QGraphicsView::drawItems(painter, 1, &items[i], &options[i]);
+        mRenderStatistics->addItem(RenderStatistics::getItemTypeName(*items[i]),
+                                   timer.nsecsElapsed());
+    }
+}
+
+bool GraphicsView::useTileCache() const noexcept
+{
+    // while zooming smoothly, each frame has another zoom level, so caching is useless
+    return mTileCacheEnabled && mScene &&
+           (mZoomAnimation->state() != QAbstractAnimation::Running);
+}
+
 /*****************************************************************************************
  *  Inherited from QGraphicsView
  ****************************************************************************************/
@@ -259,61 +648,21 @@ bool GraphicsView::eventFilter(QObject* obj, QEvent* event)
 
 void GraphicsView::drawBackground(QPainter* painter, const QRectF& rect)
 {
-    QPen gridPen(Qt::gray);
-    gridPen.setCosmetic(true);
-
-    // draw background color
-    painter->setPen(Qt::NoPen);
-    painter->setBrush(backgroundBrush());
-    painter->fillRect(rect, backgroundBrush());
-
-    // draw background grid lines
-    gridPen.setWidth((mGridProperties->getType() == GridProperties::Type_t::Dots) ? 2 : 1);
-    painter->setPen(gridPen);
-    painter->setBrush(Qt::NoBrush);
-    qreal gridIntervalPixels = mGridProperties->getInterval().toPx();
-    qreal scaleFactor = width() / rect.width();
-    if (gridIntervalPixels * scaleFactor >= (qreal)5)
-    {
-        qreal left, right, top, bottom;
-        left = qFloor(rect.left() / gridIntervalPixels) * gridIntervalPixels;
-        right = rect.right();
-        top = rect.top();
-        bottom = qFloor(rect.bottom() / gridIntervalPixels) * gridIntervalPixels;
-        switch (mGridProperties->getType())
-        {
-            case GridProperties::Type_t::Lines:
-            {
-                QVarLengthArray<QLineF, 500> lines;
-                for (qreal x = left; x < right; x += gridIntervalPixels)
-                    lines.append(QLineF(x, rect.top(), x, rect.bottom()));
-                for (qreal y = bottom; y > top; y -= gridIntervalPixels)
-                    lines.append(QLineF(rect.left(), y, rect.right(), y));
-                painter->setOpacity(0.5);
-                painter->drawLines(lines.data(), lines.size());
-                break;
-            }
-
-            case GridProperties::Type_t::Dots:
-            {
-                QVarLengthArray<QPointF, 2000> dots;
-                for (qreal x = left; x < right; x += gridIntervalPixels)
-                    for (qreal y = bottom; y > top; y -= gridIntervalPixels)
-                        dots.append(QPointF(x, y));
-                painter->drawPoints(dots.data(), dots.size());
-                break;
-            }
-
-            default:
-                break;
-        }
+    if (useTileCache()) {
+        drawTiles(painter, rect);
+    } else {
+        drawGrid(painter, rect);
     }
+    mRenderStatistics->endPhase(RenderStatistics::Phase::Background);
 }
 
 void GraphicsView::drawForeground(QPainter* painter, const QRectF& rect)
 {
     Q_UNUSED(rect);
 
+    // if no items were painted, the time since the background is spent to find them
+    mRenderStatistics->endPhase(RenderStatistics::Phase::Index);
+
     if (mOriginCrossVisible)
     {
         // draw origin cross
@@ -324,6 +673,58 @@ void GraphicsView::drawForeground(QPainter* painter, const QRectF& rect)
         painter->drawLine(QLineF(-len, 0.0, len, 0.0));
         painter->drawLine(QLineF(0.0, -len, 0.0, len));
     }
+
+    if (mRepaintFlashingEnabled && (!mRemovingRepaintFlashes)) {
+        // highlight the repainted area (painting is clipped to the exposed region)
+        QRect deviceRect = mapFromScene(rect).boundingRect().adjusted(-1, -1, 1, 1);
+        painter->save();
+        painter->resetTransform();
+        painter->fillRect(deviceRect, QColor(255, 0, 255, 60));
+        painter->restore();
+        mFlashedRegion += deviceRect;
+        if (!mRepaintFlashTimer->isActive()) mRepaintFlashTimer->start();
+    }
+
+    mRenderStatistics->endPhase(RenderStatistics::Phase::Foreground);
+}
+
+void GraphicsView::scrollContentsBy(int dx, int dy)
+{
+    // the viewport content is scrolled, including the highlighted areas
+    mFlashedRegion.translate(dx, dy);
+    QGraphicsView::scrollContentsBy(dx, dy);
+}
+
+void GraphicsView::paintEvent(QPaintEvent* event)
+{
+    bool collect = collectRenderStatistics();
+    if (collect) mRenderStatistics->beginFrame();
+    QGraphicsView::paintEvent(event);
+    if (collect) mRenderStatistics->endFrame();
+}
+
+void GraphicsView::drawItems(QPainter* painter, int numItems, QGraphicsItem* items[],
+                             const QStyleOptionGraphicsItem options[])
+{
+    mRenderStatistics->endPhase(RenderStatistics::Phase::Index);
+
+    if (!useTileCache()) {
+        paintItems(painter, numItems, items, options);
+    } else {
+        // all other items are already contained in the cached tiles
+        QVector<QGraphicsItem*> uncachedItems;
+        QVector<QStyleOptionGraphicsItem> uncachedOptions;
+        for (int i = 0; i < numItems; ++i) {
+            if (mScene->isUncachedItem(*items[i])) {
+                uncachedItems.append(items[i]);
+                uncachedOptions.append(options[i]);
+            }
+        }
+        paintItems(painter, uncachedItems.count(), uncachedItems.data(),
+                   uncachedOptions.constData());
+    }
+
+    mRenderStatistics->endPhase(RenderStatistics::Phase::Items);
 }
 
 /*****************************************************************************************
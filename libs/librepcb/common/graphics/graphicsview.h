@@ -35,6 +35,8 @@ namespace librepcb {
 class IF_GraphicsViewEventHandler;
 class GraphicsScene;
 class GridProperties;
+class RenderStatistics;
+class FilePath;
 
 /*****************************************************************************************
  *  Class GraphicsView
@@ -58,10 +60,40 @@ class GraphicsView final : public QGraphicsView
         GraphicsScene* getScene() const noexcept {return mScene;}
         QRectF getVisibleSceneRect() const noexcept;
         bool getUseOpenGl() const noexcept {return mUseOpenGl;}
+        bool isTileCacheEnabled() const noexcept {return mTileCacheEnabled;}
         const GridProperties& getGridProperties() const noexcept {return *mGridProperties;}
+        bool isRenderStatisticsEnabled() const noexcept {return mRenderStatisticsEnabled;}
+        const RenderStatistics& getRenderStatistics() const noexcept {return *mRenderStatistics;}
 
         // Setters
         void setUseOpenGl(bool useOpenGl) noexcept;
+
+        /**
+         * @brief Enable or disable the tile cache
+         *
+         * If enabled, the background and all items of the scene (except the uncached
+         * items, see GraphicsScene::getUncachedItems()) are rendered into raster tiles
+         * which are cached per zoom level. Repainting the view (e.g. when panning) then
+         * only needs to draw the cached tiles. Tiles are invalidated by the dirty regions
+         * of the scene, so only the tiles touched by modified items are rendered again.
+         *
+         * @note Changes which don't lead to a dirty region of the scene (e.g. changing
+         *       the visibility of a layer without updating the items) require a call to
+         *       #invalidateTileCache().
+         */
+        void setTileCacheEnabled(bool enabled) noexcept;
+
+        /**
+         * @brief Highlight repainted areas of the viewport for a short time (for debugging)
+         */
+        void setRepaintFlashingEnabled(bool enabled) noexcept;
+
+        /**
+         * @brief Show or hide an overlay with statistics about the rendering performance
+         *
+         * @see librepcb::RenderStatistics
+         */
+        void setRenderStatisticsEnabled(bool enabled) noexcept;
         void setGridProperties(const GridProperties& properties) noexcept;
         void setScene(GraphicsScene* scene) noexcept;
         void setVisibleSceneRect(const QRectF& rect) noexcept;
@@ -73,6 +105,25 @@ class GraphicsView final : public QGraphicsView
                                      bool mapToGrid) const noexcept;
         void handleMouseWheelEvent(QGraphicsSceneWheelEvent* event) noexcept;
 
+        /**
+         * @brief Write the render statistics of all subsequent frames to a CSV file
+         *
+         * @throw Exception If the file could not be opened
+         */
+        void startRenderTrace(const FilePath& filepath);
+        void stopRenderTrace() noexcept;
+
+        /**
+         * @brief Start or stop the render trace from a (checkable) action of the GUI
+         *
+         * Starting asks for the CSV file with a file dialog, errors are shown in a
+         * message box.
+         *
+         * @return True if a trace is being recorded now, false if it was stopped, the
+         *         dialog was aborted or the trace could not be started
+         */
+        bool toggleRenderTrace(bool enabled) noexcept;
+
 
     public slots:
 
@@ -80,6 +131,7 @@ class GraphicsView final : public QGraphicsView
         void zoomIn() noexcept;
         void zoomOut() noexcept;
         void zoomAll() noexcept;
+        void invalidateTileCache() noexcept;
 
 
     signals:
@@ -95,6 +147,9 @@ class GraphicsView final : public QGraphicsView
 
         // Private Slots
         void zoomAnimationValueChanged(const QVariant& value) noexcept;
+        void sceneChanged(const QList<QRectF>& region) noexcept;
+        void removeRepaintFlashes() noexcept;
+        void updateRenderStatisticsOverlay() noexcept;
 
 
     private:
@@ -103,10 +158,40 @@ class GraphicsView final : public QGraphicsView
         GraphicsView(const GraphicsView& other) = delete;
         GraphicsView& operator=(const GraphicsView& rhs) = delete;
 
+        // Types
+        typedef QPair<qint64, QPair<int, int>> TileKey; ///< zoom level and tile index
+        struct CachedTile {
+            QPixmap pixmap;
+            QRectF sceneRect;   ///< area of the scene covered by the tile
+            quint64 lastUsed;   ///< value of #mTileCacheCounter when last painted
+        };
+        struct GridPattern {
+            int type;           ///< GridProperties::Type_t, or -1 if not yet rendered
+            qreal interval;     ///< grid interval in scene pixels
+            qreal scaleFactor;  ///< scene to device pixels
+            QColor background;
+            QBrush brush;       ///< the background, tiled with the grid if visible
+        };
+
+        // Private Methods
+        void drawGrid(QPainter* painter, const QRectF& rect) noexcept;
+        void updateGridPattern(qreal scaleFactor) noexcept;
+        void drawTiles(QPainter* painter, const QRectF& rect) noexcept;
+        CachedTile renderTile(const QRect& deviceRect) noexcept;
+        bool useTileCache() const noexcept;
+        bool collectRenderStatistics() const noexcept;
+        void updateOptimizationFlags() noexcept;
+        void paintItems(QPainter* painter, int numItems, QGraphicsItem* items[],
+                        const QStyleOptionGraphicsItem options[]) noexcept;
+
         // Inherited Methods
         bool eventFilter(QObject* obj, QEvent* event);
         void drawBackground(QPainter* painter, const QRectF& rect);
         void drawForeground(QPainter* painter, const QRectF& rect);
+        void scrollContentsBy(int dx, int dy);
+        void paintEvent(QPaintEvent* event);
+        void drawItems(QPainter* painter, int numItems, QGraphicsItem* items[],
+                       const QStyleOptionGraphicsItem options[]);
 
 
         // General Attributes
@@ -119,8 +204,32 @@ class GraphicsView final : public QGraphicsView
         volatile bool mPanningActive;
         QCursor mCursorBeforePanning;
 
+        // Grid Pattern (rendered once per grid and zoom level, drawn with a single fill)
+        GridPattern mGridPattern;
+
+        // Tile Cache
+        bool mTileCacheEnabled;
+        QHash<TileKey, CachedTile> mTileCache;
+        quint64 mTileCacheCounter; ///< incremented on every paint, used for LRU eviction
+        QHash<QGraphicsItem*, QRectF> mUncachedItemRects; ///< scene rects of uncached items
+
+        // Repaint Flashing
+        bool mRepaintFlashingEnabled;
+        bool mRemovingRepaintFlashes;   ///< true while repainting to remove the flashes
+        QRegion mFlashedRegion;         ///< highlighted area (viewport coordinates)
+        QTimer* mRepaintFlashTimer;
+
+        // Render Statistics
+        bool mRenderStatisticsEnabled;
+        RenderStatistics* mRenderStatistics;
+        QLabel* mRenderStatisticsLabel;  ///< the overlay (child widget, owned by Qt)
+        QTimer* mRenderStatisticsTimer;  ///< updates the overlay periodically
+
         // Static Variables
         static constexpr qreal sZoomStepFactor = 1.3;
+        static constexpr int sTileSize = 256;       ///< tile width and height in pixels
+        static constexpr int sMinGridPatternSize = 64; ///< in pixels, to avoid tiny tiles
+        static constexpr int sMaxCachedTiles = 256; ///< limits memory to 64MB
 };
 
 /*****************************************************************************************
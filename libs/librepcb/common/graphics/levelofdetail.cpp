@@ -0,0 +1,107 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include "levelofdetail.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+LevelOfDetail::LevelOfDetail() noexcept :
+    mTextMinHeight(8), mTextBoxMinHeight(2), mShapeMinSize(1), mPadDetailsMinSize(6),
+    mHairlineMaxWidth(1)
+{
+}
+
+LevelOfDetail::~LevelOfDetail() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+LevelOfDetail::TextMode LevelOfDetail::getTextMode(qreal lod, qreal height) const noexcept
+{
+    qreal size = lod * height;
+    if (qIsInf(lod) || (size > mTextMinHeight)) {
+        return TextMode::Full;
+    } else if (size > mTextBoxMinHeight) {
+        return TextMode::Box;
+    } else {
+        return TextMode::Hidden;
+    }
+}
+
+bool LevelOfDetail::isShapeVisible(qreal lod, const QRectF& rect) const noexcept
+{
+    return qIsInf(lod) || (lod * qMax(rect.width(), rect.height()) >= mShapeMinSize);
+}
+
+bool LevelOfDetail::drawPadDetails(qreal lod, const QRectF& rect) const noexcept
+{
+    return qIsInf(lod) || (lod * qMin(rect.width(), rect.height()) >= mPadDetailsMinSize);
+}
+
+bool LevelOfDetail::drawAsHairline(qreal lod, qreal width) const noexcept
+{
+    return (!qIsInf(lod)) && (lod * width < mHairlineMaxWidth);
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+LevelOfDetail& LevelOfDetail::instance() noexcept
+{
+    static LevelOfDetail policy;
+    return policy;
+}
+
+qreal LevelOfDetail::getLod(const QPainter& painter,
+                            const QStyleOptionGraphicsItem& option) noexcept
+{
+    switch (painter.device() ? painter.device()->devType() : QInternal::UnknownDevice) {
+        case QInternal::Widget:
+        case QInternal::Pixmap:
+        case QInternal::Image:
+        case QInternal::OpenGL:
+        case QInternal::FramebufferObject:
+            return option.levelOfDetailFromTransform(painter.worldTransform());
+        default: // printers, PDF, SVG, ... -> always full detail
+            return std::numeric_limits<qreal>::infinity();
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
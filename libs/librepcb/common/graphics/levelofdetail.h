@@ -0,0 +1,153 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_LEVELOFDETAIL_H
+#define LIBREPCB_LEVELOFDETAIL_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class LevelOfDetail
+ ****************************************************************************************/
+
+/**
+ * @brief The LevelOfDetail class decides how detailed graphics items are painted
+ *
+ * When zoomed out, many elements (texts, pads, small polygons, ...) are only a few
+ * pixels large on the screen. Painting them in full detail costs a lot of time but
+ * doesn't show anything useful, so graphics items ask this policy how to paint them.
+ *
+ * All thresholds are sizes on the paint device in pixels, i.e. the size in scene
+ * coordinates multiplied with the "lod" factor returned by #getLod(). The application
+ * wide policy is available with #instance() and can be configured with the setters.
+ *
+ * @note Painting to printers or other non-screen devices (PDF, SVG, ...) always uses
+ *       full detail, see #getLod().
+ */
+class LevelOfDetail final
+{
+    public:
+
+        // Types
+        enum class TextMode {
+            Full,   ///< draw the text
+            Box,    ///< fill the text bounding rect instead of drawing the glyphs
+            Hidden, ///< don't draw anything
+        };
+
+        // Constructors / Destructor
+        LevelOfDetail() noexcept;
+        LevelOfDetail(const LevelOfDetail& other) = default;
+        ~LevelOfDetail() noexcept;
+
+        // Getters
+        qreal getTextMinHeight() const noexcept {return mTextMinHeight;}
+        qreal getTextBoxMinHeight() const noexcept {return mTextBoxMinHeight;}
+        qreal getShapeMinSize() const noexcept {return mShapeMinSize;}
+        qreal getPadDetailsMinSize() const noexcept {return mPadDetailsMinSize;}
+        qreal getHairlineMaxWidth() const noexcept {return mHairlineMaxWidth;}
+
+        // Setters
+        void setTextMinHeight(qreal px) noexcept {mTextMinHeight = px;}
+        void setTextBoxMinHeight(qreal px) noexcept {mTextBoxMinHeight = px;}
+        void setShapeMinSize(qreal px) noexcept {mShapeMinSize = px;}
+        void setPadDetailsMinSize(qreal px) noexcept {mPadDetailsMinSize = px;}
+        void setHairlineMaxWidth(qreal px) noexcept {mHairlineMaxWidth = px;}
+
+        // General Methods
+
+        /**
+         * @brief Get how to paint a text
+         *
+         * @param lod       The level of detail (see #getLod())
+         * @param height    Height of the text in scene pixels
+         */
+        TextMode getTextMode(qreal lod, qreal height) const noexcept;
+
+        /**
+         * @brief Check whether a shape (polygon, ellipse, hole, ...) is large enough
+         *
+         * @param lod       The level of detail (see #getLod())
+         * @param rect      Bounding rect of the shape in scene pixels
+         */
+        bool isShapeVisible(qreal lod, const QRectF& rect) const noexcept;
+
+        /**
+         * @brief Check whether pads should be painted with all details (exact shape,
+         *        masks, text) or only as a filled bounding rect
+         *
+         * @param lod       The level of detail (see #getLod())
+         * @param rect      Bounding rect of the pad in scene pixels
+         */
+        bool drawPadDetails(qreal lod, const QRectF& rect) const noexcept;
+
+        /**
+         * @brief Check whether a line should be painted as a cosmetic hairline
+         *
+         * @param lod       The level of detail (see #getLod())
+         * @param width     Line width in scene pixels
+         */
+        bool drawAsHairline(qreal lod, qreal width) const noexcept;
+
+        // Operator Overloadings
+        LevelOfDetail& operator=(const LevelOfDetail& rhs) = default;
+
+        // Static Methods
+
+        /**
+         * @brief Get the application wide level of detail policy
+         */
+        static LevelOfDetail& instance() noexcept;
+
+        /**
+         * @brief Get the level of detail for painting a graphics item
+         *
+         * @return The scale factor from scene to device pixels, or infinity if the
+         *         painter doesn't paint on a screen (e.g. a printer), so that everything
+         *         is painted in full detail
+         */
+        static qreal getLod(const QPainter& painter,
+                            const QStyleOptionGraphicsItem& option) noexcept;
+
+
+    private: // Data
+        qreal mTextMinHeight;       ///< texts smaller than this are painted as boxes
+        qreal mTextBoxMinHeight;    ///< texts smaller than this are not painted at all
+        qreal mShapeMinSize;        ///< shapes smaller than this are not painted
+        qreal mPadDetailsMinSize;   ///< pads smaller than this are painted as rects
+        qreal mHairlineMaxWidth;    ///< lines thinner than this are painted as hairlines
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_LEVELOFDETAIL_H
@@ -0,0 +1,242 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include <typeinfo>
+#if defined(__GNUC__)
+#include <cxxabi.h>
+#endif
+#include "renderstatistics.h"
+#include "../fileio/filepath.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+RenderStatistics::RenderStatistics() noexcept :
+    mPhaseStart(0), mFrameActive(false)
+{
+    mClock.start();
+}
+
+RenderStatistics::~RenderStatistics() noexcept
+{
+    stopTrace();
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+int RenderStatistics::getFramesPerSecond() const noexcept
+{
+    qint64 now = mClock.elapsed();
+    int count = 0;
+    for (int i = mFrames.count() - 1; i >= 0; --i) {
+        if (now - mFrames.at(i).timestamp > 1000) break;
+        ++count;
+    }
+    return count;
+}
+
+qreal RenderStatistics::getFrameTimePercentile(qreal percent) const noexcept
+{
+    if (mFrames.isEmpty()) return 0;
+    QVector<qint64> times;
+    times.reserve(mFrames.count());
+    foreach (const Frame& frame, mFrames) {
+        times.append(frame.nsecs);
+    }
+    std::sort(times.begin(), times.end());
+    int index = qBound(0, qCeil(percent * times.count() / 100) - 1, times.count() - 1);
+    return times.at(index) / 1e6;
+}
+
+QString RenderStatistics::getSummary(int maxItemTypes) const noexcept
+{
+    QStringList lines;
+    lines << QString("FPS: %1").arg(getFramesPerSecond());
+    lines << QString("Frame [ms]: 50%: %1  90%: %2  99%: %3")
+             .arg(getFrameTimePercentile(50), 0, 'f', 2)
+             .arg(getFrameTimePercentile(90), 0, 'f', 2)
+             .arg(getFrameTimePercentile(99), 0, 'f', 2);
+    if (!mFrames.isEmpty()) {
+        const Frame& frame = mFrames.last();
+        auto ms = [&frame](Phase phase) {return frame.phaseNsecs[static_cast<int>(phase)] / 1e6;};
+        lines << QString("Last Frame [ms]: %1").arg(frame.nsecs / 1e6, 0, 'f', 2);
+        lines << QString("  Background: %1").arg(ms(Phase::Background), 0, 'f', 2);
+        lines << QString("  Scene Index: %1").arg(ms(Phase::Index), 0, 'f', 2);
+        lines << QString("  Items: %1 (%2 items)").arg(ms(Phase::Items), 0, 'f', 2)
+                                                 .arg(frame.itemCount);
+        lines << QString("  Foreground: %1").arg(ms(Phase::Foreground), 0, 'f', 2);
+
+        // slowest item types first
+        QList<QPair<qint64, QString>> types;
+        for (auto it = frame.itemTypes.constBegin(); it != frame.itemTypes.constEnd(); ++it) {
+            types.append(qMakePair(it.value().nsecs, it.key()));
+        }
+        std::sort(types.begin(), types.end(), std::greater<QPair<qint64, QString>>());
+        for (int i = 0; (i < types.count()) && (i < maxItemTypes); ++i) {
+            const ItemType& type = frame.itemTypes.value(types.at(i).second);
+            lines << QString("    %1: %2 (%3x)").arg(types.at(i).second)
+                     .arg(type.nsecs / 1e6, 0, 'f', 2).arg(type.count);
+        }
+    }
+    if (isTracing()) {
+        lines << QString("Tracing to %1").arg(QDir::toNativeSeparators(mTraceFile->fileName()));
+    }
+    return lines.join("\n");
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void RenderStatistics::beginFrame() noexcept
+{
+    mCurrentFrame = Frame(); // all values zero
+    mFrameTimer.start();
+    mPhaseStart = 0;
+    mFrameActive = true;
+}
+
+void RenderStatistics::endPhase(Phase phase) noexcept
+{
+    if (!mFrameActive) return;
+    qint64 now = mFrameTimer.nsecsElapsed();
+    mCurrentFrame.phaseNsecs[static_cast<int>(phase)] += now - mPhaseStart;
+    mPhaseStart = now;
+}
+
+void RenderStatistics::addItem(const QString& type, qint64 nsecs) noexcept
+{
+    if (!mFrameActive) return;
+    ItemType& stats = mCurrentFrame.itemTypes[type];
+    stats.count += 1;
+    stats.nsecs += nsecs;
+    mCurrentFrame.itemCount += 1;
+}
+
+void RenderStatistics::endFrame() noexcept
+{
+    if (!mFrameActive) return;
+    mCurrentFrame.nsecs = mFrameTimer.nsecsElapsed();
+    mCurrentFrame.timestamp = mClock.elapsed();
+    mFrameActive = false;
+    addFrame(mCurrentFrame);
+}
+
+void RenderStatistics::addFrame(const Frame& frame) noexcept
+{
+    mFrames.append(frame);
+    while (mFrames.count() > sMaxFrames) {
+        mFrames.removeFirst();
+    }
+    if (isTracing()) {
+        writeTraceLine(frame);
+    }
+}
+
+void RenderStatistics::clear() noexcept
+{
+    mFrames.clear();
+}
+
+void RenderStatistics::startTrace(const FilePath& filepath)
+{
+    stopTrace();
+    QScopedPointer<QFile> file(new QFile(filepath.toStr()));
+    if (!file->open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("Could not open or create file \"%1\": %2"))
+            .arg(filepath.toNative(), file->errorString()));
+    }
+    file->write("timestamp_ms,frame_ms,background_ms,index_ms,items_ms,foreground_ms,"
+                "item_count,item_types\n");
+    mTraceFile.reset(file.take());
+}
+
+void RenderStatistics::stopTrace() noexcept
+{
+    if (mTraceFile) {
+        mTraceFile->close();
+        mTraceFile.reset();
+    }
+}
+
+QString RenderStatistics::getItemTypeName(const QGraphicsItem& item) noexcept
+{
+    // demangling is expensive, so the names are cached per type
+    static QHash<const char*, QString> cache;
+    const char* mangled = typeid(item).name();
+    auto it = cache.constFind(mangled);
+    if (it != cache.constEnd()) {
+        return it.value();
+    }
+    QString name = QString::fromLatin1(mangled);
+#if defined(__GNUC__)
+    int status = -1;
+    char* demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+    if (demangled && (status == 0)) {
+        name = QString::fromLatin1(demangled);
+    }
+    free(demangled);
+#endif
+    name = name.mid(name.lastIndexOf("::") + 1).remove(':').remove("class ");
+    cache.insert(mangled, name);
+    return name;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void RenderStatistics::writeTraceLine(const Frame& frame) noexcept
+{
+    QStringList types;
+    for (auto it = frame.itemTypes.constBegin(); it != frame.itemTypes.constEnd(); ++it) {
+        types << QString("%1:%2:%3").arg(it.key()).arg(it.value().count)
+                                    .arg(it.value().nsecs / 1e6, 0, 'f', 3);
+    }
+    QStringList columns;
+    columns << QString::number(frame.timestamp);
+    columns << QString::number(frame.nsecs / 1e6, 'f', 3);
+    for (int i = 0; i < sPhaseCount; ++i) {
+        columns << QString::number(frame.phaseNsecs[i] / 1e6, 'f', 3);
+    }
+    columns << QString::number(frame.itemCount);
+    columns << types.join(";");
+    mTraceFile->write(columns.join(",").toUtf8() + "\n");
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,159 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_RENDERSTATISTICS_H
+#define LIBREPCB_RENDERSTATISTICS_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include "../exceptions.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class FilePath;
+
+/*****************************************************************************************
+ *  Class RenderStatistics
+ ****************************************************************************************/
+
+/**
+ * @brief The RenderStatistics class measures the rendering performance of a GraphicsView
+ *
+ * Each repaint of the view is recorded as a #Frame which is split into the following
+ * phases:
+ *  - #Phase::Background: Background and grid (and cached tiles, if enabled)
+ *  - #Phase::Index: Finding and sorting the exposed items, including updates of the
+ *    scene index (QGraphicsScene rebuilds its index lazily when it's needed)
+ *  - #Phase::Items: Painting the items, also recorded per item type
+ *  - #Phase::Foreground: Foreground (origin cross etc.)
+ *
+ * The last #sMaxFrames frames are kept to calculate frame time percentiles. In addition,
+ * all frames can be written to a CSV file with #startTrace() to analyze them later.
+ *
+ * @see librepcb::GraphicsView::setRenderStatisticsEnabled()
+ */
+class RenderStatistics final
+{
+        Q_DECLARE_TR_FUNCTIONS(RenderStatistics)
+
+    public:
+
+        // Types
+        enum class Phase {Background = 0, Index = 1, Items = 2, Foreground = 3};
+        static constexpr int sPhaseCount = 4;
+        struct ItemType {
+            int count;      ///< number of painted items of this type
+            qint64 nsecs;   ///< total time to paint them
+        };
+        struct Frame {
+            qint64 timestamp;   ///< end of the frame [ms] (see #getElapsedTime())
+            qint64 nsecs;       ///< total time of the frame
+            qint64 phaseNsecs[sPhaseCount]; ///< indexed by #Phase
+            int itemCount;      ///< number of painted items
+            QHash<QString, ItemType> itemTypes;
+        };
+
+        // Constructors / Destructor
+        RenderStatistics() noexcept;
+        RenderStatistics(const RenderStatistics& other) = delete;
+        ~RenderStatistics() noexcept;
+
+        // Getters
+        qint64 getElapsedTime() const noexcept {return mClock.elapsed();}
+        const QList<Frame>& getFrames() const noexcept {return mFrames;}
+        bool isFrameActive() const noexcept {return mFrameActive;}
+        bool isTracing() const noexcept {return !mTraceFile.isNull();}
+
+        /**
+         * @brief Get the number of frames painted within the last second
+         */
+        int getFramesPerSecond() const noexcept;
+
+        /**
+         * @brief Get a percentile of the frame time of the recorded frames
+         *
+         * @param percent   The percentile in the range 0..100
+         *
+         * @return The frame time in milliseconds (0 if no frames are recorded)
+         */
+        qreal getFrameTimePercentile(qreal percent) const noexcept;
+
+        /**
+         * @brief Get a human readable multi-line summary of the statistics
+         *
+         * @param maxItemTypes  Maximum number of (slowest) item types to show
+         */
+        QString getSummary(int maxItemTypes = 8) const noexcept;
+
+        // General Methods
+        void beginFrame() noexcept;
+        void endPhase(Phase phase) noexcept;
+        void addItem(const QString& type, qint64 nsecs) noexcept;
+        void endFrame() noexcept;
+        void addFrame(const Frame& frame) noexcept;
+        void clear() noexcept;
+
+        /**
+         * @brief Start writing all subsequent frames to a CSV file (one line per frame)
+         *
+         * @throw Exception If the file could not be opened
+         */
+        void startTrace(const FilePath& filepath);
+        void stopTrace() noexcept;
+
+        /**
+         * @brief Get the (unqualified) class name of a graphics item, e.g. "BGI_NetLine"
+         */
+        static QString getItemTypeName(const QGraphicsItem& item) noexcept;
+
+        // Operator Overloadings
+        RenderStatistics& operator=(const RenderStatistics& rhs) = delete;
+
+
+    private: // Methods
+        void writeTraceLine(const Frame& frame) noexcept;
+
+
+    private: // Data
+        QElapsedTimer mClock;       ///< started in the constructor
+        QElapsedTimer mFrameTimer;  ///< started at the begin of each frame
+        qint64 mPhaseStart;         ///< end of the last phase of the current frame [ns]
+        bool mFrameActive;
+        Frame mCurrentFrame;
+        QList<Frame> mFrames;       ///< the last #sMaxFrames frames, the newest at the end
+        QScopedPointer<QFile> mTraceFile;
+
+        // Static Variables
+        static constexpr int sMaxFrames = 500;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_RENDERSTATISTICS_H
@@ -0,0 +1,161 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include "textlayoutcache.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class TextLayout
+ ****************************************************************************************/
+
+TextLayout::TextLayout(const QString& text, const QFont& font, Qt::Alignment align) noexcept :
+    mText(text)
+{
+    QFontMetricsF metrics(font);
+    mFontHeight = metrics.height();
+
+    // shape all lines
+    QStringList lines = text.split('\n');
+    QVector<QSharedPointer<QTextLayout>> layouts;
+    qreal blockWidth = 0;
+    foreach (const QString& line, lines) {
+        QSharedPointer<QTextLayout> layout(new QTextLayout(line, font));
+        QTextOption option(Qt::AlignLeft);
+        option.setWrapMode(QTextOption::NoWrap);
+        layout->setTextOption(option);
+        layout->beginLayout();
+        QTextLine textLine = layout->createLine();
+        if (textLine.isValid()) textLine.setNumColumns(line.length());
+        layout->endLayout();
+        if (layout->lineCount() > 0) {
+            blockWidth = qMax(blockWidth, layout->lineAt(0).naturalTextWidth());
+        }
+        layouts.append(layout);
+    }
+    qreal blockHeight = mFontHeight + (lines.count() - 1) * metrics.lineSpacing();
+
+    // align the text block to the origin
+    qreal left = 0, top = 0;
+    if (align & Qt::AlignRight)         left = -blockWidth;
+    else if (align & Qt::AlignHCenter)  left = -blockWidth / 2;
+    if (align & Qt::AlignBottom)        top = -blockHeight;
+    else if (align & Qt::AlignVCenter)  top = -blockHeight / 2;
+    mBoundingRect = QRectF(left, top, blockWidth, blockHeight);
+
+    // position the lines and collect their glyphs
+    for (int i = 0; i < layouts.count(); ++i) {
+        if (layouts.at(i)->lineCount() < 1) continue;
+        QTextLine textLine = layouts.at(i)->lineAt(0);
+        qreal x = left;
+        if (align & Qt::AlignRight)         x += blockWidth - textLine.naturalTextWidth();
+        else if (align & Qt::AlignHCenter)  x += (blockWidth - textLine.naturalTextWidth()) / 2;
+        textLine.setPosition(QPointF(x, top + i * metrics.lineSpacing()));
+        mGlyphRuns.append(textLine.glyphRuns());
+    }
+}
+
+TextLayout::~TextLayout() noexcept
+{
+}
+
+void TextLayout::paint(QPainter& painter) const noexcept
+{
+    foreach (const QGlyphRun& run, mGlyphRuns) {
+        painter.drawGlyphRun(QPointF(0, 0), run);
+    }
+}
+
+QPainterPath TextLayout::toPainterPath() const noexcept
+{
+    QPainterPath path;
+    foreach (const QGlyphRun& run, mGlyphRuns) {
+        QRawFont font = run.rawFont();
+        QVector<quint32> indexes = run.glyphIndexes();
+        QVector<QPointF> positions = run.positions();
+        for (int i = 0; i < indexes.count() && i < positions.count(); ++i) {
+            path.addPath(font.pathForGlyph(indexes.at(i)).translated(positions.at(i)));
+        }
+    }
+    return path;
+}
+
+/*****************************************************************************************
+ *  Class TextLayoutCache
+ ****************************************************************************************/
+
+TextLayoutCache::TextLayoutCache() noexcept :
+    mMaxCount(10000), mHits(0), mMisses(0)
+{
+}
+
+TextLayoutCache::~TextLayoutCache() noexcept
+{
+}
+
+QSharedPointer<const TextLayout> TextLayoutCache::getLayout(const QString& text,
+    const QFont& font, Qt::Alignment align) noexcept
+{
+    // the raw fonts of the glyph runs must not be used in other threads
+    QCoreApplication* app = QCoreApplication::instance();
+    if ((!app) || (QThread::currentThread() != app->thread())) {
+        return QSharedPointer<const TextLayout>(new TextLayout(text, font, align));
+    }
+
+    // QFont::key() contains the family, pixel size, weight, style etc.
+    QString key = font.key() % QChar('\x1F') % QString::number(int(align)) % QChar('\x1F') % text;
+    auto it = mLayouts.constFind(key);
+    if (it != mLayouts.constEnd()) {
+        mHits++;
+        return *it;
+    }
+
+    mMisses++;
+    if (mLayouts.count() >= mMaxCount) {
+        mLayouts.clear();
+    }
+    QSharedPointer<const TextLayout> layout(new TextLayout(text, font, align));
+    mLayouts.insert(key, layout);
+    return layout;
+}
+
+void TextLayoutCache::clear() noexcept
+{
+    mLayouts.clear();
+}
+
+TextLayoutCache& TextLayoutCache::instance() noexcept
+{
+    static TextLayoutCache cache;
+    return cache;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
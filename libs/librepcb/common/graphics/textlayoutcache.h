@@ -0,0 +1,162 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_TEXTLAYOUTCACHE_H
+#define LIBREPCB_TEXTLAYOUTCACHE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class TextLayout
+ ****************************************************************************************/
+
+/**
+ * @brief The TextLayout class holds the shaped glyphs of a (multi-line) text
+ *
+ * The text is aligned relative to the origin (like QPainter::drawText() with a null
+ * rect), all coordinates are in pixels of the font. Objects are immutable once created,
+ * see librepcb::TextLayoutCache.
+ */
+class TextLayout final
+{
+    public:
+
+        // Constructors / Destructor
+        TextLayout() = delete;
+        TextLayout(const TextLayout& other) = delete;
+        TextLayout(const QString& text, const QFont& font, Qt::Alignment align) noexcept;
+        ~TextLayout() noexcept;
+
+        // Getters
+        const QString& getText() const noexcept {return mText;}
+        qreal getFontHeight() const noexcept {return mFontHeight;}
+        const QRectF& getBoundingRect() const noexcept {return mBoundingRect;}
+        const QList<QGlyphRun>& getGlyphRuns() const noexcept {return mGlyphRuns;}
+
+        // General Methods
+
+        /**
+         * @brief Draw the glyphs with the current pen of the painter
+         */
+        void paint(QPainter& painter) const noexcept;
+
+        /**
+         * @brief Get the outlines of all glyphs
+         */
+        QPainterPath toPainterPath() const noexcept;
+
+        // Operator Overloadings
+        TextLayout& operator=(const TextLayout& rhs) = delete;
+
+
+    private:
+        QString mText;
+        qreal mFontHeight;      ///< QFontMetricsF::height() of the font
+        QRectF mBoundingRect;   ///< aligned to the origin
+        QList<QGlyphRun> mGlyphRuns;
+};
+
+/*****************************************************************************************
+ *  Class TextLayoutCache
+ ****************************************************************************************/
+
+/**
+ * @brief The TextLayoutCache class shares text layouts between all graphics items
+ *
+ * Laying out a text (font metrics, shaping) is expensive compared to drawing it, and
+ * most texts of symbols and footprints are identical (e.g. "#NAME" of equal
+ * components, "#VALUE" of resistors), so the layouts are cached application wide by
+ * text, font and alignment. Graphics items keep a shared pointer to their layout and
+ * replay its glyphs in QGraphicsItem::paint().
+ *
+ * If the cache grows larger than #getMaxCount(), it is cleared completely. Layouts still
+ * used by graphics items are kept alive by their shared pointers.
+ *
+ * Glyph runs can't be shared between threads, so only layouts requested in the GUI
+ * thread are cached. Other threads (e.g. headless exporters) get a new layout on every
+ * call, which doesn't touch the cache at all, so #getLayout() may be called from any
+ * thread.
+ */
+class TextLayoutCache final
+{
+    public:
+
+        // Constructors / Destructor
+        TextLayoutCache() noexcept;
+        TextLayoutCache(const TextLayoutCache& other) = delete;
+        ~TextLayoutCache() noexcept;
+
+        // Getters
+        int getCount() const noexcept {return mLayouts.count();}
+        int getMaxCount() const noexcept {return mMaxCount;}
+        qint64 getHits() const noexcept {return mHits;}
+        qint64 getMisses() const noexcept {return mMisses;}
+
+        // Setters
+        void setMaxCount(int count) noexcept {mMaxCount = qMax(count, 1);}
+
+        // General Methods
+
+        /**
+         * @brief Get the layout of a text, create it if it is not cached yet
+         *
+         * @param text      The text to draw (lines separated by '\\n')
+         * @param font      The font, including its pixel size
+         * @param align     Alignment of the text relative to the origin
+         *
+         * @note    Layouts are only cached in the GUI thread, see class description.
+         */
+        QSharedPointer<const TextLayout> getLayout(const QString& text, const QFont& font,
+                                                   Qt::Alignment align) noexcept;
+        void clear() noexcept;
+
+        // Operator Overloadings
+        TextLayoutCache& operator=(const TextLayoutCache& rhs) = delete;
+
+        // Static Methods
+
+        /**
+         * @brief Get the application wide cache
+         */
+        static TextLayoutCache& instance() noexcept;
+
+
+    private:
+        QHash<QString, QSharedPointer<const TextLayout>> mLayouts;
+        int mMaxCount;
+        qint64 mHits;
+        qint64 mMisses;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_TEXTLAYOUTCACHE_H
@@ -0,0 +1,109 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "memorypool.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+MemoryPool::MemoryPool(std::size_t blockSize, int blocksPerChunk) noexcept :
+    mMutex(), mBlockSize(0), mBlocksPerChunk(qMax(blocksPerChunk, 1)), mChunks(),
+    mFreeList(nullptr), mUsedBlockCount(0)
+{
+    const std::size_t alignment = alignof(std::max_align_t);
+    mBlockSize = qMax(blockSize, sizeof(FreeBlock));
+    mBlockSize = ((mBlockSize + alignment - 1) / alignment) * alignment;
+}
+
+MemoryPool::~MemoryPool() noexcept
+{
+    // If blocks are still in use (e.g. objects which are deleted after the pool at
+    // application exit), the chunks are leaked intentionally to avoid dangling pointers.
+    if (mUsedBlockCount == 0) {
+        foreach (char* chunk, mChunks) {
+            ::operator delete(chunk);
+        }
+    }
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+int MemoryPool::getUsedBlockCount() const noexcept
+{
+    QMutexLocker locker(&mMutex);
+    return mUsedBlockCount;
+}
+
+int MemoryPool::getChunkCount() const noexcept
+{
+    QMutexLocker locker(&mMutex);
+    return mChunks.count();
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void* MemoryPool::allocate()
+{
+    QMutexLocker locker(&mMutex);
+    if (!mFreeList) {
+        // allocate a new chunk and put all its blocks into the free list
+        char* chunk = static_cast<char*>(::operator new(mBlockSize * mBlocksPerChunk));
+        mChunks.append(chunk);
+        for (int i = mBlocksPerChunk - 1; i >= 0; --i) {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + i * mBlockSize);
+            block->next = mFreeList;
+            mFreeList = block;
+        }
+    }
+    FreeBlock* block = mFreeList;
+    mFreeList = block->next;
+    ++mUsedBlockCount;
+    return block;
+}
+
+void MemoryPool::release(void* block) noexcept
+{
+    if (!block) return;
+    QMutexLocker locker(&mMutex);
+    FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+    freeBlock->next = mFreeList;
+    mFreeList = freeBlock;
+    --mUsedBlockCount;
+    Q_ASSERT(mUsedBlockCount >= 0);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,124 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_MEMORYPOOL_H
+#define LIBREPCB_MEMORYPOOL_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <cstddef>
+
+/*****************************************************************************************
+ *  Macros
+ ****************************************************************************************/
+
+/**
+ * @brief Allocate all objects of a (final) class from a librepcb::MemoryPool
+ *
+ * Add this macro to the class declaration to get class specific operator new/delete.
+ * Use it only for classes with a very high instance count (e.g. net lines), the pool
+ * avoids the per-object overhead of the heap and keeps the objects close together.
+ */
+#define DECLARE_MEMORY_POOL(className) \
+public: \
+    static void* operator new(std::size_t size) { \
+        Q_ASSERT(size == sizeof(className)); Q_UNUSED(size); \
+        return getMemoryPool().allocate(); \
+    } \
+    static void operator delete(void* ptr) noexcept {getMemoryPool().release(ptr);} \
+    static librepcb::MemoryPool& getMemoryPool() noexcept { \
+        static librepcb::MemoryPool pool(sizeof(className)); \
+        return pool; \
+    } \
+private:
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class MemoryPool
+ ****************************************************************************************/
+
+/**
+ * @brief The MemoryPool class allocates blocks of a fixed size from larger chunks
+ *
+ * Released blocks are kept in a free list and reused by subsequent allocations, chunks
+ * are only returned to the system when the pool is destroyed. All methods are thread
+ * safe.
+ *
+ * @see #DECLARE_MEMORY_POOL
+ */
+class MemoryPool final
+{
+    public:
+
+        // Constructors / Destructor
+        MemoryPool() = delete;
+        MemoryPool(const MemoryPool& other) = delete;
+        explicit MemoryPool(std::size_t blockSize, int blocksPerChunk = 1024) noexcept;
+        ~MemoryPool() noexcept;
+
+        // Getters
+        std::size_t getBlockSize() const noexcept {return mBlockSize;}
+        int getUsedBlockCount() const noexcept;
+        int getChunkCount() const noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Get an uninitialized block of #getBlockSize() bytes
+         *
+         * @throw std::bad_alloc If a new chunk could not be allocated
+         */
+        void* allocate();
+
+        /**
+         * @brief Return a block obtained by #allocate() to the pool
+         */
+        void release(void* block) noexcept;
+
+        // Operator Overloadings
+        MemoryPool& operator=(const MemoryPool& rhs) = delete;
+
+
+    private:
+
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+
+        mutable QMutex mMutex;
+        std::size_t mBlockSize;     ///< rounded up to keep all blocks aligned
+        int mBlocksPerChunk;
+        QVector<char*> mChunks;
+        FreeBlock* mFreeList;       ///< singly linked list of released blocks
+        int mUsedBlockCount;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_MEMORYPOOL_H
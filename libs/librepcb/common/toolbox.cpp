@@ -21,7 +21,9 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <algorithm>
 #include "toolbox.h"
+#include "geometry/path.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -119,6 +121,53 @@ Length Toolbox::shortestDistanceBetweenPointAndLine(const Point& p, const Point&
     return (p - np).getLength();
 }
 
+QVector<Point> Toolbox::convexHull(QVector<Point> points) noexcept
+{
+    // Andrew's monotone chain algorithm
+    std::sort(points.begin(), points.end(), [](const Point& a, const Point& b) {
+        return (a.getX() < b.getX()) || ((a.getX() == b.getX()) && (a.getY() < b.getY()));
+    });
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+    if (points.count() < 3) {
+        return points;
+    }
+    auto cross = [](const Point& o, const Point& a, const Point& b) {
+        return (qreal)(a.getX() - o.getX()).toNm() * (b.getY() - o.getY()).toNm()
+             - (qreal)(a.getY() - o.getY()).toNm() * (b.getX() - o.getX()).toNm();
+    };
+    QVector<Point> hull(2 * points.count());
+    int k = 0;
+    for (int i = 0; i < points.count(); ++i) { // lower hull
+        while ((k >= 2) && (cross(hull.at(k - 2), hull.at(k - 1), points.at(i)) <= 0)) --k;
+        hull[k++] = points.at(i);
+    }
+    for (int i = points.count() - 2, lower = k + 1; i >= 0; --i) { // upper hull
+        while ((k >= lower) && (cross(hull.at(k - 2), hull.at(k - 1), points.at(i)) <= 0)) --k;
+        hull[k++] = points.at(i);
+    }
+    hull.resize(k - 1); // the last point is equal to the first
+    return hull;
+}
+
+QVector<Point> Toolbox::flattenedPath(const Path& path, qreal arcTolerance) noexcept
+{
+    QVector<Point> points;
+    const QVector<Vertex>& vertices = path.getVertices();
+    for (int i = 0; i < vertices.count(); ++i) {
+        // the angle of a vertex belongs to the segment ending at that vertex
+        const Vertex& v = vertices.at(i);
+        if ((v.getAngle() != 0) && (i > 0)) {
+            Path arc = Path::flatArc(vertices.at(i - 1).getPos(), v.getPos(), v.getAngle(),
+                                     arcTolerance);
+            for (int k = 1; k < arc.getVertices().count() - 1; ++k) {
+                points.append(arc.getVertices().at(k).getPos());
+            }
+        }
+        points.append(v.getPos());
+    }
+    return points;
+}
+
 QVariant Toolbox::stringOrNumberToQVariant(const QString& string) noexcept
 {
     bool isInt;
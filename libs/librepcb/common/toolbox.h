@@ -32,6 +32,8 @@
  ****************************************************************************************/
 namespace librepcb {
 
+class Path;
+
 /*****************************************************************************************
  *  Class Toolbox
  ****************************************************************************************/
@@ -107,6 +109,29 @@ class Toolbox final
         static Length shortestDistanceBetweenPointAndLine(const Point& p, const Point& l1,
                                                           const Point& l2, Point* nearest = nullptr) noexcept;
 
+        /**
+         * @brief Calculate the convex hull of a set of points
+         *
+         * @param points    Arbitrary points (duplicates are allowed)
+         *
+         * @return The corners of the hull in counterclockwise order (without collinear
+         *         points), or the unique points if there are less than three of them
+         */
+        static QVector<Point> convexHull(QVector<Point> points) noexcept;
+
+        /**
+         * @brief Get the positions of all vertices of a path with arcs flattened
+         *
+         * Arcs are approximated by straight segments with Path::flatArc(), so every
+         * user of this method gets the same approximation.
+         *
+         * @param path          The path to flatten
+         * @param arcTolerance  Maximum deviation of the segments from the arcs [nm]
+         *
+         * @return The vertex positions (closed paths end with the first position again)
+         */
+        static QVector<Point> flattenedPath(const Path& path, qreal arcTolerance = 5000) noexcept;
+
         /**
          * @brief Convert a numeric or non-numeric string to the corresponding QVariant
          *
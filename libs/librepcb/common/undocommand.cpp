@@ -21,6 +21,7 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <typeinfo>
 #include "undocommand.h"
 
 /*****************************************************************************************
@@ -42,6 +43,15 @@ UndoCommand::~UndoCommand() noexcept
     Q_ASSERT(qAbs(mRedoCount - mUndoCount) <= 1);
 }
 
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+qint64 UndoCommand::getSizeEstimate() const noexcept
+{
+    return sizeof(UndoCommand) + mText.capacity() * sizeof(QChar);
+}
+
 /*****************************************************************************************
  *  General Methods
  ****************************************************************************************/
@@ -79,6 +89,38 @@ void UndoCommand::redo()
     mRedoCount++;
 }
 
+bool UndoCommand::isMergeableWith(const UndoCommand& other) const noexcept
+{
+    return (&other != this) && (typeid(other) == typeid(*this)) && isCurrentlyExecuted()
+        && other.isCurrentlyExecuted() && (!other.wasEverReverted())
+        && canMergeWith(other);
+}
+
+bool UndoCommand::mergeWith(const UndoCommand& other) noexcept
+{
+    if (!isMergeableWith(other)) {
+        return false;
+    }
+
+    performMergeWith(other);
+    return true;
+}
+
+/*****************************************************************************************
+ *  Protected Methods
+ ****************************************************************************************/
+
+bool UndoCommand::canMergeWith(const UndoCommand& other) const noexcept
+{
+    Q_UNUSED(other);
+    return false;
+}
+
+void UndoCommand::performMergeWith(const UndoCommand& other) noexcept
+{
+    Q_UNUSED(other);
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -81,6 +81,18 @@ class UndoCommand
          */
         bool isCurrentlyExecuted() const noexcept {return mRedoCount > mUndoCount;}
 
+        /**
+         * @brief Get a rough estimate of the memory used by this command (in bytes)
+         *
+         * This is used by librepcb::UndoStack to limit its memory usage. The default
+         * implementation only accounts the base class, so commands holding larger data
+         * (e.g. copies of paths) should override it.
+         *
+         * @note The estimate must not change as long as the command is on an undo stack,
+         *       except by #mergeWith().
+         */
+        virtual qint64 getSizeEstimate() const noexcept;
+
 
         // General Methods
 
@@ -102,6 +114,30 @@ class UndoCommand
          */
         virtual void redo() final;
 
+        /**
+         * @brief Check whether #mergeWith() would succeed for a given command
+         *
+         * @param other     A command which was executed directly after this command
+         *
+         * @return True if @p other has the same type, both commands are currently
+         *         executed and the command implementation supports merging them
+         */
+        bool isMergeableWith(const UndoCommand& other) const noexcept;
+
+        /**
+         * @brief Try to merge a subsequently executed command into this command
+         *
+         * If successful, this command afterwards represents the changes of both commands
+         * (undo restores the state from before this command, redo the state after
+         * @p other) and @p other can be deleted without undoing it.
+         *
+         * @param other     A command which was executed directly after this command
+         *
+         * @retval true     If @p other was merged into this command
+         * @retval false    If the commands can't be merged (nothing was modified)
+         */
+        bool mergeWith(const UndoCommand& other) noexcept;
+
         // Operator Overloadings
         UndoCommand& operator=(const UndoCommand& rhs) = delete;
 
@@ -134,6 +170,22 @@ class UndoCommand
          */
         virtual void performRedo() = 0;
 
+        /**
+         * @brief Check whether #performMergeWith() can be called with another command
+         *
+         * @note The default implementation returns false, i.e. commands are not mergeable
+         *       unless they explicitly implement it. @p other always has the same type
+         *       as this command.
+         */
+        virtual bool canMergeWith(const UndoCommand& other) const noexcept;
+
+        /**
+         * @brief Merge the "new" state of another command into this command
+         *
+         * @note Only called if #canMergeWith() returned true for @p other.
+         */
+        virtual void performMergeWith(const UndoCommand& other) noexcept;
+
 
     private:
 
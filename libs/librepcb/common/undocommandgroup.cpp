@@ -46,6 +46,19 @@ UndoCommandGroup::~UndoCommandGroup() noexcept
     }
 }
 
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+qint64 UndoCommandGroup::getSizeEstimate() const noexcept
+{
+    qint64 size = UndoCommand::getSizeEstimate() + sizeof(*this) - sizeof(UndoCommand);
+    foreach (const UndoCommand* cmd, mChilds) {
+        size += cmd->getSizeEstimate();
+    }
+    return size;
+}
+
 /*****************************************************************************************
  *  General Methods
  ****************************************************************************************/
@@ -108,6 +121,30 @@ void UndoCommandGroup::performRedo()
     sgl.dismiss();
 }
 
+bool UndoCommandGroup::canMergeWith(const UndoCommand& other) const noexcept
+{
+    const UndoCommandGroup& group = static_cast<const UndoCommandGroup&>(other);
+    if ((group.getText() != getText()) || (group.mChilds.count() != mChilds.count())
+        || (mChilds.isEmpty())) {
+        return false;
+    }
+    for (int i = 0; i < mChilds.count(); ++i) {
+        if (!mChilds.at(i)->isMergeableWith(*group.mChilds.at(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void UndoCommandGroup::performMergeWith(const UndoCommand& other) noexcept
+{
+    const UndoCommandGroup& group = static_cast<const UndoCommandGroup&>(other);
+    for (int i = 0; i < mChilds.count(); ++i) {
+        bool merged = mChilds.at(i)->mergeWith(*group.mChilds.at(i));
+        Q_ASSERT(merged); Q_UNUSED(merged);
+    }
+}
+
 /*****************************************************************************************
  *  Protected Methods
  ****************************************************************************************/
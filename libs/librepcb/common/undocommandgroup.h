@@ -57,6 +57,9 @@ class UndoCommandGroup : public UndoCommand
         // Getters
         int getChildCount() const noexcept {return mChilds.count();}
 
+        /// @copydoc UndoCommand::getSizeEstimate()
+        virtual qint64 getSizeEstimate() const noexcept override;
+
         // General Methods
 
         /**
@@ -87,6 +90,18 @@ class UndoCommandGroup : public UndoCommand
         /// @copydoc UndoCommand::performRedo()
         virtual void performRedo() override;
 
+        /**
+         * @brief Check whether all childs can be merged with the childs of another group
+         *
+         * Groups are mergeable if they have the same text and each child is mergeable
+         * with the child at the same index of the other group (e.g. two subsequent
+         * moves of the same selection).
+         */
+        virtual bool canMergeWith(const UndoCommand& other) const noexcept override;
+
+        /// @copydoc UndoCommand::performMergeWith()
+        virtual void performMergeWith(const UndoCommand& other) noexcept override;
+
         /**
          * @brief Helper method for derived classes to execute and add new child commands
          *
@@ -75,7 +75,9 @@ void UndoStackTransaction::commit()
  ****************************************************************************************/
 
 UndoStack::UndoStack() noexcept :
-    QObject(nullptr), mCurrentIndex(0), mCleanIndex(0), mActiveCommandGroup(nullptr)
+    QObject(nullptr), mCurrentIndex(0), mCleanIndex(0), mActiveCommandGroup(nullptr),
+    mMaxCommandCount(1000), mMaxMemoryUsage(64 * 1024 * 1024), mMemoryUsage(0),
+    mDroppedCommandCount(0), mMergeInterval(2000)
 {
 }
 
@@ -137,6 +139,23 @@ void UndoStack::setClean() noexcept
     emit cleanChanged(true);
 }
 
+void UndoStack::setMaxCommandCount(int count) noexcept
+{
+    mMaxCommandCount = qMax(count, 0);
+    enforceLimits();
+}
+
+void UndoStack::setMaxMemoryUsage(qint64 bytes) noexcept
+{
+    mMaxMemoryUsage = qMax(bytes, qint64(0));
+    enforceLimits();
+}
+
+void UndoStack::setMergeInterval(int ms) noexcept
+{
+    mMergeInterval = qMax(ms, 0);
+}
+
 /*****************************************************************************************
  *  General Methods
  ****************************************************************************************/
@@ -160,18 +179,19 @@ void UndoStack::execCmd(UndoCommand* cmd, bool forceKeepCmd)
         }
 
         // delete all commands above the current index (make redoing them impossible)
-        // --> in reverse order (from top to bottom)!
-        while (mCurrentIndex < mCommands.count()) {
-            delete mCommands.takeLast();
-        }
-        Q_ASSERT(mCurrentIndex == mCommands.count());
+        deleteCommandsAboveCurrentIndex();
 
-        // add command to the command stack
-        mCommands.append(cmdScopeGuard.take()); // move ownership of "cmd" to "mCommands"
-        mCurrentIndex++;
+        if (forceKeepCmd || (!tryMergeWithTopCommand(*cmd))) {
+            // add command to the command stack
+            mCommands.append(cmdScopeGuard.take()); // move ownership of "cmd" to "mCommands"
+            mCurrentIndex++;
+            setMemoryUsage(mMemoryUsage + cmd->getSizeEstimate());
+        } // else: "cmd" was merged into the top command and gets deleted by the scope guard
+        mLastExecTimer.start();
+        enforceLimits();
 
         // emit signals
-        emit undoTextChanged(QString(tr("Undo: %1")).arg(cmd->getText()));
+        emit undoTextChanged(getUndoText());
         emit redoTextChanged(tr("Redo"));
         emit canUndoChanged(true);
         emit canRedoChanged(false);
@@ -194,6 +214,7 @@ void UndoStack::beginCmdGroup(const QString& text)
     execCmd(cmd, true); // throws an exception on error; emits all signals
     Q_ASSERT(mCommands.last() == cmd);
     mActiveCommandGroup = cmd;
+    mLastExecTimer.invalidate(); // command groups are not merged with other commands
 
     // emit signals
     emit canUndoChanged(false);
@@ -212,7 +233,10 @@ void UndoStack::appendToCmdGroup(UndoCommand* cmd)
 
     // append new command as a child of active command group
     // note: this will also execute the new command!
+    qint64 groupSize = mActiveCommandGroup->getSizeEstimate();
     mActiveCommandGroup->appendChild(cmdScopeGuard.take()); // can throw
+    setMemoryUsage(mMemoryUsage - groupSize + mActiveCommandGroup->getSizeEstimate());
+    enforceLimits();
 
     // emit signals
     emit stateModified();
@@ -252,6 +276,7 @@ void UndoStack::abortCmdGroup()
 
     try {
         mActiveCommandGroup->undo(); // can throw (but should usually not)
+        setMemoryUsage(mMemoryUsage - mActiveCommandGroup->getSizeEstimate());
         mActiveCommandGroup = nullptr;
         mCurrentIndex--;
         delete mCommands.takeLast(); // delete and remove the aborted command group from the stack
@@ -279,6 +304,7 @@ void UndoStack::undo()
     try {
         mCommands[mCurrentIndex-1]->undo(); // can throw (but should usually not)
         mCurrentIndex--;
+        mLastExecTimer.invalidate(); // never merge with an undone command
     } catch (Exception& e) {
         qCritical() << "UndoCommand::undo() has thrown an exception:" << e.getMsg();
         throw;
@@ -302,6 +328,7 @@ void UndoStack::redo()
     try {
         mCommands[mCurrentIndex]->redo(); // can throw (but should usually not)
         mCurrentIndex++;
+        mLastExecTimer.invalidate(); // only merge directly subsequent commands
     } catch (Exception& e) {
         qCritical() << "UndoCommand::redo() has thrown an exception:" << e.getMsg();
         throw;
@@ -338,6 +365,8 @@ void UndoStack::clear() noexcept
     mCurrentIndex = 0;
     mCleanIndex = 0;
     mActiveCommandGroup = nullptr;
+    mLastExecTimer.invalidate();
+    setMemoryUsage(0);
 
     // emit signals
     emit undoTextChanged(tr("Undo"));
@@ -347,6 +376,63 @@ void UndoStack::clear() noexcept
     emit cleanChanged(true);
 }
 
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+bool UndoStack::tryMergeWithTopCommand(UndoCommand& cmd) noexcept
+{
+    if ((mMergeInterval <= 0) || (!canUndo()) || (isCommandGroupActive()) || isClean()
+        || (!mLastExecTimer.isValid()) || (mLastExecTimer.elapsed() > mMergeInterval)) {
+        return false;
+    }
+
+    UndoCommand* top = mCommands[mCurrentIndex-1];
+    qint64 topSize = top->getSizeEstimate();
+    if (!top->mergeWith(cmd)) {
+        return false;
+    }
+    setMemoryUsage(mMemoryUsage - topSize + top->getSizeEstimate());
+    return true;
+}
+
+void UndoStack::deleteCommandsAboveCurrentIndex() noexcept
+{
+    // in reverse order (from top to bottom)!
+    while (mCurrentIndex < mCommands.count()) {
+        UndoCommand* cmd = mCommands.takeLast();
+        setMemoryUsage(mMemoryUsage - cmd->getSizeEstimate());
+        delete cmd;
+    }
+    Q_ASSERT(mCurrentIndex == mCommands.count());
+}
+
+void UndoStack::enforceLimits() noexcept
+{
+    // drop the oldest commands, but always keep the last executed command
+    while ((mCurrentIndex > 1) &&
+           (((mMaxCommandCount > 0) && (mCommands.count() > mMaxCommandCount)) ||
+            ((mMaxMemoryUsage > 0) && (mMemoryUsage > mMaxMemoryUsage))))
+    {
+        UndoCommand* cmd = mCommands.takeFirst();
+        Q_ASSERT(cmd != mActiveCommandGroup);
+        setMemoryUsage(mMemoryUsage - cmd->getSizeEstimate());
+        delete cmd;
+        mCurrentIndex--;
+        if (mCleanIndex >= 0) mCleanIndex--; // if it was zero, the clean state is lost now
+        mDroppedCommandCount++;
+    }
+}
+
+void UndoStack::setMemoryUsage(qint64 bytes) noexcept
+{
+    Q_ASSERT(bytes >= 0);
+    if (bytes != mMemoryUsage) {
+        mMemoryUsage = bytes;
+        emit memoryUsageChanged(mMemoryUsage);
+    }
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -101,6 +101,12 @@ class UndoStackTransaction final
  *  - <b>Added support for exclusive macro command creation:</b> @todo Don't sure if this
  *    is a good way, we need some tests first... If the tests are successful, we should
  *    complete this documentation (explain how this feature works).
+ *  - <b>Limited history:</b> The number of commands and their estimated memory usage
+ *    (see UndoCommand#getSizeEstimate()) is limited, the oldest commands are dropped
+ *    when a limit is exceeded (see #setMaxCommandCount() and #setMaxMemoryUsage()).
+ *  - <b>Merging of commands:</b> A command which is executed shortly after another
+ *    mergeable command (see UndoCommand#mergeWith()) is merged into that command
+ *    instead of being pushed, e.g. subsequent moves of the same selection.
  *
  * @see #UndoCommand, #UndoCommandGroup
  *
@@ -174,6 +180,21 @@ class UndoStack final : public QObject
          */
         bool isCommandGroupActive() const noexcept;
 
+        /**
+         * @brief Get the count of commands on the stack (including redoable commands)
+         */
+        int getCommandCount() const noexcept {return mCommands.count();}
+
+        /**
+         * @brief Get the estimated memory usage of all commands on the stack (in bytes)
+         */
+        qint64 getMemoryUsage() const noexcept {return mMemoryUsage;}
+
+        /**
+         * @brief Get the count of commands dropped so far because of the stack limits
+         */
+        int getDroppedCommandCount() const noexcept {return mDroppedCommandCount;}
+
 
         // Setters
 
@@ -182,6 +203,24 @@ class UndoStack final : public QObject
          */
         void setClean() noexcept;
 
+        /**
+         * @brief Set the maximum count of commands on the stack (zero means unlimited)
+         */
+        void setMaxCommandCount(int count) noexcept;
+
+        /**
+         * @brief Set the maximum estimated memory usage in bytes (zero means unlimited)
+         */
+        void setMaxMemoryUsage(qint64 bytes) noexcept;
+
+        /**
+         * @brief Set the time interval in which subsequent commands are merged
+         *
+         * @param ms    Maximum milliseconds between two commands to merge them (zero
+         *              disables merging)
+         */
+        void setMergeInterval(int ms) noexcept;
+
 
         // General Methods
 
@@ -288,10 +327,16 @@ class UndoStack final : public QObject
         void commandGroupEnded();
         void commandGroupAborted();
         void stateModified();
+        void memoryUsageChanged(qint64 bytes);
 
 
     private:
 
+        bool tryMergeWithTopCommand(UndoCommand& cmd) noexcept;
+        void deleteCommandsAboveCurrentIndex() noexcept;
+        void enforceLimits() noexcept;
+        void setMemoryUsage(qint64 bytes) noexcept;
+
         /**
          * @brief This list holds all commands of the undo stack
          *
@@ -321,6 +366,16 @@ class UndoStack final : public QObject
          * or #abortCmdGroup(). Otherwise, the variable contains the nullptr.
          */
         UndoCommandGroup* mActiveCommandGroup;
+
+        // Limits
+        int mMaxCommandCount;       ///< zero means unlimited
+        qint64 mMaxMemoryUsage;     ///< in bytes, zero means unlimited
+        qint64 mMemoryUsage;        ///< sum of the size estimates of all commands
+        int mDroppedCommandCount;   ///< count of dropped (oldest) commands
+
+        // Merging
+        int mMergeInterval;         ///< in milliseconds, zero disables merging
+        QElapsedTimer mLastExecTimer; ///< measures time since the last #execCmd()
 };
 
 /*****************************************************************************************
@@ -22,9 +22,11 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <QtWidgets>
+#include <QtConcurrent>
 #include "board.h"
 #include <librepcb/common/fileio/smartsexprfile.h>
 #include <librepcb/common/fileio/sexpression.h>
+#include <librepcb/common/scopeguard.h>
 #include <librepcb/common/scopeguardlist.h>
 #include <librepcb/common/boarddesignrules.h>
 #include "../project.h"
@@ -44,7 +46,13 @@
 #include "items/bi_netline.h"
 #include <librepcb/library/cmp/component.h>
 #include "items/bi_polygon.h"
+#include "items/bi_plane.h"
+#include "items/bi_airwire.h"
+#include "boardairwiresbuilder.h"
+#include "boardplanefragmentsbuilder.h"
+#include "boarddesignrulecheck.h"
 #include "boardlayerstack.h"
+#include "boardgraphicsbatcher.h"
 #include "boardusersettings.h"
 #include "boardselectionquery.h"
 #include "../circuit/netsignal.h"
@@ -66,6 +74,7 @@ Board::Board(const Board& other, const FilePath& filepath, const QString& name)
     try
     {
         mGraphicsScene.reset(new GraphicsScene());
+        mGraphicsBatcher.reset(new BoardGraphicsBatcher(*this));
 
         // copy the other board
         mFile.reset(SmartSExprFile::create(mFilePath));
@@ -108,6 +117,13 @@ Board::Board(const Board& other, const FilePath& filepath, const QString& name)
             mPolygons.append(copy);
         }
 
+        // copy planes
+        foreach (const BI_Plane* plane, other.mPlanes) {
+            BI_Plane* copy = new BI_Plane(*this, *plane);
+            mPlanes.append(copy);
+        }
+
+        mDesignRuleCheck.reset(new BoardDesignRuleCheck(*this));
         updateErcMessages();
         updateIcon();
 
@@ -116,6 +132,10 @@ Board::Board(const Board& other, const FilePath& filepath, const QString& name)
 
         connect(&mProject.getCircuit(), &Circuit::componentAdded, this, &Board::updateErcMessages);
         connect(&mProject.getCircuit(), &Circuit::componentRemoved, this, &Board::updateErcMessages);
+        connect(&mProject.getCircuit(), &Circuit::netSignalAdded,
+                this, [this](NetSignal& netsignal){scheduleAirWiresRebuild(&netsignal);});
+        connect(&mProject.getCircuit(), &Circuit::netSignalRemoved,
+                this, [this](NetSignal& netsignal){removeAirWires(&netsignal);});
 
         if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
     }
@@ -123,14 +143,17 @@ Board::Board(const Board& other, const FilePath& filepath, const QString& name)
     {
         // free the allocated memory in the reverse order of their allocation...
         qDeleteAll(mErcMsgListUnplacedComponentInstances);    mErcMsgListUnplacedComponentInstances.clear();
+        qDeleteAll(mPlanes);            mPlanes.clear();
         qDeleteAll(mPolygons);          mPolygons.clear();
         qDeleteAll(mNetSegments);       mNetSegments.clear();
         qDeleteAll(mDeviceInstances);   mDeviceInstances.clear();
+        mDesignRuleCheck.reset();
         mUserSettings.reset();
         mDesignRules.reset();
         mGridProperties.reset();
         mLayerStack.reset();
         mFile.reset();
+        mGraphicsBatcher.reset();
         mGraphicsScene.reset();
         throw; // ...and rethrow the exception
     }
@@ -143,6 +166,7 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
     try
     {
         mGraphicsScene.reset(new GraphicsScene());
+        mGraphicsBatcher.reset(new BoardGraphicsBatcher(*this));
 
         // try to open/create the board file
         if (create)
@@ -224,8 +248,15 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
                 BI_Polygon* polygon = new BI_Polygon(*this, node);
                 mPolygons.append(polygon);
             }
+
+            // Load all planes
+            foreach (const SExpression& node, root.getChildren("plane")) {
+                BI_Plane* plane = new BI_Plane(*this, node);
+                mPlanes.append(plane);
+            }
         }
 
+        mDesignRuleCheck.reset(new BoardDesignRuleCheck(*this));
         updateErcMessages();
         updateIcon();
 
@@ -234,6 +265,10 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
 
         connect(&mProject.getCircuit(), &Circuit::componentAdded, this, &Board::updateErcMessages);
         connect(&mProject.getCircuit(), &Circuit::componentRemoved, this, &Board::updateErcMessages);
+        connect(&mProject.getCircuit(), &Circuit::netSignalAdded,
+                this, [this](NetSignal& netsignal){scheduleAirWiresRebuild(&netsignal);});
+        connect(&mProject.getCircuit(), &Circuit::netSignalRemoved,
+                this, [this](NetSignal& netsignal){removeAirWires(&netsignal);});
 
         if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
     }
@@ -241,14 +276,17 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
     {
         // free the allocated memory in the reverse order of their allocation...
         qDeleteAll(mErcMsgListUnplacedComponentInstances);    mErcMsgListUnplacedComponentInstances.clear();
+        qDeleteAll(mPlanes);            mPlanes.clear();
         qDeleteAll(mPolygons);          mPolygons.clear();
         qDeleteAll(mNetSegments);       mNetSegments.clear();
         qDeleteAll(mDeviceInstances);   mDeviceInstances.clear();
+        mDesignRuleCheck.reset();
         mUserSettings.reset();
         mDesignRules.reset();
         mGridProperties.reset();
         mLayerStack.reset();
         mFile.reset();
+        mGraphicsBatcher.reset();
         mGraphicsScene.reset();
         throw; // ...and rethrow the exception
     }
@@ -261,15 +299,19 @@ Board::~Board() noexcept
     qDeleteAll(mErcMsgListUnplacedComponentInstances);    mErcMsgListUnplacedComponentInstances.clear();
 
     // delete all items
+    qDeleteAll(mAirWires);          mAirWires.clear();
+    qDeleteAll(mPlanes);            mPlanes.clear();
     qDeleteAll(mPolygons);          mPolygons.clear();
     qDeleteAll(mNetSegments);       mNetSegments.clear();
     qDeleteAll(mDeviceInstances);   mDeviceInstances.clear();
 
+    mDesignRuleCheck.reset();
     mUserSettings.reset();
     mDesignRules.reset();
     mGridProperties.reset();
     mLayerStack.reset();
     mFile.reset();
+    mGraphicsBatcher.reset();
     mGraphicsScene.reset();
 }
 
@@ -391,6 +433,8 @@ QList<BI_Base*> Board::getAllItems() const noexcept
         items.append(netsegment);
     foreach (BI_Polygon* polygon, mPolygons)
         items.append(polygon);
+    foreach (BI_Plane* plane, mPlanes)
+        items.append(plane);
     return items;
 }
 
@@ -507,6 +551,51 @@ void Board::removePolygon(BI_Polygon& polygon)
     mPolygons.removeOne(&polygon);
 }
 
+/*****************************************************************************************
+ *  Plane Methods
+ ****************************************************************************************/
+
+void Board::addPlane(BI_Plane& plane)
+{
+    if ((!mIsAddedToProject) || (mPlanes.contains(&plane)) || (&plane.getBoard() != this)) {
+        throw LogicError(__FILE__, __LINE__);
+    }
+    plane.addToBoard(); // can throw
+    mPlanes.append(&plane);
+}
+
+void Board::removePlane(BI_Plane& plane)
+{
+    if ((!mIsAddedToProject) || (!mPlanes.contains(&plane))) {
+        throw LogicError(__FILE__, __LINE__);
+    }
+    plane.removeFromBoard(); // can throw
+    mPlanes.removeOne(&plane);
+}
+
+/*****************************************************************************************
+ *  AirWire Methods
+ ****************************************************************************************/
+
+void Board::scheduleAirWiresRebuild(NetSignal* netsignal) noexcept
+{
+    if (mScheduledNetSignalsForAirWireRebuild.isEmpty()) {
+        // rebuild them when control returns to the event loop, so modifying many items
+        // at once (e.g. moving a device) rebuilds the airwires of each net only once
+        QMetaObject::invokeMethod(this, "triggerAirWiresRebuild", Qt::QueuedConnection);
+    }
+    mScheduledNetSignalsForAirWireRebuild.insert(netsignal);
+}
+
+void Board::removeAirWires(NetSignal* netsignal) noexcept
+{
+    foreach (BI_AirWire* airwire, mAirWires.values(netsignal)) {
+        airwire->removeFromBoard(); // can't throw as the airwire is added to the board
+        delete airwire;
+    }
+    mAirWires.remove(netsignal);
+}
+
 /*****************************************************************************************
  *  General Methods
  ****************************************************************************************/
@@ -525,6 +614,8 @@ void Board::addToProject()
     }
     mIsAddedToProject = true;
     updateErcMessages();
+    scheduleAirWiresRebuild(nullptr);
+    QMetaObject::invokeMethod(this, "rebuildAllPlanes", Qt::QueuedConnection);
     sgl.dismiss();
 }
 
@@ -533,6 +624,11 @@ void Board::removeFromProject()
     if (!mIsAddedToProject) {
         throw LogicError(__FILE__, __LINE__);
     }
+    foreach (NetSignal* netsignal, mAirWires.uniqueKeys()) {
+        removeAirWires(netsignal);
+    }
+    mScheduledNetSignalsForAirWireRebuild.clear();
+    mDesignRuleCheck->clear();
     QList<BI_Base*> items = getAllItems();
     ScopeGuardList sgl(items.count());
     for (int i = items.count()-1; i >= 0; --i) {
@@ -642,6 +738,83 @@ QVector<const AttributeProvider*> Board::getAttributeProviderParents() const noe
     return QVector<const AttributeProvider*>{&mProject};
 }
 
+/*****************************************************************************************
+ *  Public Slots
+ ****************************************************************************************/
+
+void Board::triggerAirWiresRebuild() noexcept
+{
+    try {
+        if (mScheduledNetSignalsForAirWireRebuild.contains(nullptr)) {
+            // rebuild all airwires
+            mScheduledNetSignalsForAirWireRebuild.remove(nullptr);
+            foreach (NetSignal* netsignal, mAirWires.uniqueKeys()) {
+                mScheduledNetSignalsForAirWireRebuild.insert(netsignal);
+            }
+            foreach (NetSignal* netsignal, mProject.getCircuit().getNetSignals()) {
+                mScheduledNetSignalsForAirWireRebuild.insert(netsignal);
+            }
+        }
+
+        // scheduled netsignals may already be removed from the circuit (and even be
+        // deleted), so only the netsignals of the circuit are dereferenced
+        QSet<NetSignal*> netsignals = mProject.getCircuit().getNetSignals().values().toSet();
+
+        foreach (NetSignal* netsignal, mScheduledNetSignalsForAirWireRebuild) {
+            // build the new airwires completely before replacing the old ones, so the
+            // airwires of a net are left unchanged if building them fails
+            QList<BI_AirWire*> airwires;
+            auto sg = scopeGuard([&airwires](){qDeleteAll(airwires);});
+            if (mIsAddedToProject && netsignals.contains(netsignal)) {
+                BoardAirWiresBuilder builder(*this, *netsignal);
+                foreach (const auto& points, builder.buildAirWires()) {
+                    airwires.append(new BI_AirWire(*this, *netsignal, points.first,
+                                                   points.second)); // can throw
+                }
+            }
+            removeAirWires(netsignal);
+            foreach (BI_AirWire* airwire, airwires) {
+                airwire->addToBoard(); // can't throw as the airwire is not added yet
+                mAirWires.insert(netsignal, airwire);
+            }
+            sg.dismiss();
+        }
+    } catch (const Exception& e) {
+        qCritical() << "Failed to build airwires:" << e.getMsg();
+    }
+    mScheduledNetSignalsForAirWireRebuild.clear();
+}
+
+void Board::rebuildAllPlanes() noexcept
+{
+    if (!mIsAddedToProject) {
+        return;
+    }
+
+    // collect the inputs of all planes in this thread, but only refill planes whose
+    // inputs have changed since the last time
+    struct Job {
+        BI_Plane* plane;
+        QSharedPointer<BoardPlaneFragmentsBuilder> builder;
+        QVector<Path> fragments;
+    };
+    QVector<Job> jobs;
+    foreach (BI_Plane* plane, mPlanes) {
+        QSharedPointer<BoardPlaneFragmentsBuilder> builder(new BoardPlaneFragmentsBuilder(*plane));
+        if (builder->getInputHash() != plane->getFragmentsInputHash()) {
+            jobs.append(Job{plane, builder, QVector<Path>()});
+        }
+    }
+
+    // fill the planes concurrently
+    QtConcurrent::blockingMap(jobs, [](Job& job){
+        job.fragments = job.builder->buildFragments();
+    });
+    foreach (const Job& job, jobs) {
+        job.plane->setFragments(job.fragments, job.builder->getInputHash());
+    }
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
@@ -681,6 +854,8 @@ void Board::serialize(SExpression& root) const
     root.appendLineBreak();
     serializePointerContainer(root, mPolygons, "polygon");
     root.appendLineBreak();
+    serializePointerContainer(root, mPlanes, "plane");
+    root.appendLineBreak();
 }
 
 void Board::updateErcMessages() noexcept
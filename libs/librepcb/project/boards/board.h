@@ -58,8 +58,12 @@ class BI_NetSegment;
 class BI_NetPoint;
 class BI_NetLine;
 class BI_Polygon;
+class BI_Plane;
+class BI_AirWire;
 class BoardLayerStack;
+class BoardGraphicsBatcher;
 class BoardUserSettings;
+class BoardDesignRuleCheck;
 class BoardSelectionQuery;
 
 /*****************************************************************************************
@@ -97,6 +101,7 @@ class Board final : public QObject, public AttributeProvider,
             ZValue_FootprintPadsTop,    ///< Z value for #project#BI_FootprintPad items
             ZValue_FootprintsTop,       ///< Z value for #project#BI_Footprint items
             ZValue_Vias,                ///< Z value for #project#BI_Via items
+            ZValue_AirWires,            ///< Z value for #project#BI_AirWire items
         };
 
         // Constructors / Destructor
@@ -112,9 +117,12 @@ class Board final : public QObject, public AttributeProvider,
         const FilePath& getFilePath() const noexcept {return mFilePath;}
         const GridProperties& getGridProperties() const noexcept {return *mGridProperties;}
         GraphicsScene& getGraphicsScene () const noexcept {return *mGraphicsScene;}
+        BoardGraphicsBatcher& getGraphicsBatcher() const noexcept {return *mGraphicsBatcher;}
         BoardLayerStack& getLayerStack() noexcept {return *mLayerStack;}
+        const BoardLayerStack& getLayerStack() const noexcept {return *mLayerStack;}
         BoardDesignRules& getDesignRules() noexcept {return *mDesignRules;}
         const BoardDesignRules& getDesignRules() const noexcept {return *mDesignRules;}
+        BoardDesignRuleCheck& getDesignRuleCheck() noexcept {return *mDesignRuleCheck;}
         bool isEmpty() const noexcept;
         QList<BI_Base*> getItemsAtScenePos(const Point& pos) const noexcept;
         QList<BI_Via*> getViasAtScenePos(const Point& pos, const NetSignal* netsignal) const noexcept;
@@ -151,6 +159,23 @@ class Board final : public QObject, public AttributeProvider,
         void addPolygon(BI_Polygon& polygon);
         void removePolygon(BI_Polygon& polygon);
 
+        // Plane Methods
+        const QList<BI_Plane*>& getPlanes() const noexcept {return mPlanes;}
+        void addPlane(BI_Plane& plane);
+        void removePlane(BI_Plane& plane);
+
+        // AirWire Methods
+        QList<BI_AirWire*> getAirWires() const noexcept {return mAirWires.values();}
+        void scheduleAirWiresRebuild(NetSignal* netsignal) noexcept;
+
+        /**
+         * @brief Remove the airwires of a netsignal immediately
+         *
+         * Called when a netsignal is removed from the circuit, as the airwires
+         * reference it and it may be deleted before the next (scheduled) rebuild.
+         */
+        void removeAirWires(NetSignal* netsignal) noexcept;
+
         // General Methods
         void addToProject();
         void removeFromProject();
@@ -178,6 +203,12 @@ class Board final : public QObject, public AttributeProvider,
                              const QString& name);
 
 
+    public slots:
+
+        void triggerAirWiresRebuild() noexcept;
+        void rebuildAllPlanes() noexcept;
+
+
     signals:
 
         /// @copydoc AttributeProvider::attributesChanged()
@@ -206,10 +237,12 @@ class Board final : public QObject, public AttributeProvider,
         bool mIsAddedToProject;
 
         QScopedPointer<GraphicsScene> mGraphicsScene;
+        QScopedPointer<BoardGraphicsBatcher> mGraphicsBatcher;
         QScopedPointer<BoardLayerStack> mLayerStack;
         QScopedPointer<GridProperties> mGridProperties;
         QScopedPointer<BoardDesignRules> mDesignRules;
         QScopedPointer<BoardUserSettings> mUserSettings;
+        QScopedPointer<BoardDesignRuleCheck> mDesignRuleCheck;
         QRectF mViewRect;
 
         // Attributes
@@ -221,6 +254,11 @@ class Board final : public QObject, public AttributeProvider,
         QMap<Uuid, BI_Device*> mDeviceInstances;
         QList<BI_NetSegment*> mNetSegments;
         QList<BI_Polygon*> mPolygons;
+        QList<BI_Plane*> mPlanes;
+        QMultiHash<NetSignal*, BI_AirWire*> mAirWires;
+
+        // netsignals whose airwires need to be rebuilt (nullptr means all netsignals)
+        QSet<NetSignal*> mScheduledNetSignalsForAirWireRebuild;
 
         // ERC messages
         QHash<Uuid, ErcMsg*> mErcMsgListUnplacedComponentInstances;
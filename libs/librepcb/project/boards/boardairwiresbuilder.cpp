@@ -0,0 +1,111 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "boardairwiresbuilder.h"
+#include "board.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_netsegment.h"
+#include "items/bi_netpoint.h"
+#include "items/bi_netline.h"
+#include "items/bi_via.h"
+#include "../circuit/netsignal.h"
+#include "../circuit/componentsignalinstance.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardAirWiresBuilder::BoardAirWiresBuilder(const Board& board,
+                                           const NetSignal& netsignal) noexcept :
+    mBoard(board), mNetSignal(netsignal)
+{
+}
+
+BoardAirWiresBuilder::~BoardAirWiresBuilder() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+AirWiresBuilder::AirWires BoardAirWiresBuilder::buildAirWires() const noexcept
+{
+    AirWiresBuilder builder;
+    QHash<const BI_FootprintPad*, int> padIds;
+    QHash<const BI_Via*, int> viaIds;
+    QHash<const BI_NetPoint*, int> netPointIds;
+
+    // pads
+    foreach (const ComponentSignalInstance* cmpSig, mNetSignal.getComponentSignals()) {
+        foreach (const BI_FootprintPad* pad, cmpSig->getRegisteredFootprintPads()) {
+            if (&pad->getBoard() == &mBoard) {
+                padIds.insert(pad, builder.addPoint(pad->getPosition()));
+            }
+        }
+    }
+
+    foreach (const BI_NetSegment* netsegment, mNetSignal.getBoardNetSegments()) {
+        if (&netsegment->getBoard() != &mBoard) continue;
+
+        // vias
+        foreach (const BI_Via* via, netsegment->getVias()) {
+            viaIds.insert(via, builder.addPoint(via->getPosition()));
+        }
+
+        // netpoints, connected to the pad or via they are attached to
+        foreach (const BI_NetPoint* netpoint, netsegment->getNetPoints()) {
+            int id = builder.addPoint(netpoint->getPosition());
+            netPointIds.insert(netpoint, id);
+            if (padIds.contains(netpoint->getFootprintPad())) {
+                builder.addEdge(id, padIds.value(netpoint->getFootprintPad()));
+            } else if (viaIds.contains(netpoint->getVia())) {
+                builder.addEdge(id, viaIds.value(netpoint->getVia()));
+            }
+        }
+
+        // netlines
+        foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
+            int p1 = netPointIds.value(&netline->getStartPoint(), -1);
+            int p2 = netPointIds.value(&netline->getEndPoint(), -1);
+            if ((p1 >= 0) && (p2 >= 0)) {
+                builder.addEdge(p1, p2);
+            }
+        }
+    }
+
+    return builder.buildAirWires();
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
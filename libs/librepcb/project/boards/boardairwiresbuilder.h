@@ -0,0 +1,77 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDAIRWIRESBUILDER_H
+#define LIBREPCB_PROJECT_BOARDAIRWIRESBUILDER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/algorithm/airwiresbuilder.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class NetSignal;
+
+/*****************************************************************************************
+ *  Class BoardAirWiresBuilder
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardAirWiresBuilder class collects all copper items of one net on a board
+ *        and calculates the air wires between its unconnected islands
+ *
+ * @see librepcb::AirWiresBuilder
+ */
+class BoardAirWiresBuilder final
+{
+    public:
+
+        // Constructors / Destructor
+        BoardAirWiresBuilder() = delete;
+        BoardAirWiresBuilder(const BoardAirWiresBuilder& other) = delete;
+        BoardAirWiresBuilder(const Board& board, const NetSignal& netsignal) noexcept;
+        ~BoardAirWiresBuilder() noexcept;
+
+        // General Methods
+        AirWiresBuilder::AirWires buildAirWires() const noexcept;
+
+        // Operator Overloadings
+        BoardAirWiresBuilder& operator=(const BoardAirWiresBuilder& rhs) = delete;
+
+
+    private: // Data
+        const Board& mBoard;
+        const NetSignal& mNetSignal;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDAIRWIRESBUILDER_H
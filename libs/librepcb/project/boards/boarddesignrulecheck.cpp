@@ -0,0 +1,776 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtConcurrent>
+#include <numeric>
+#include "boarddesignrulecheck.h"
+#include <librepcb/common/algorithm/polygonclipper.h>
+#include <librepcb/common/boarddesignrules.h>
+#include <librepcb/common/geometry/hole.h>
+#include <librepcb/common/geometry/path.h>
+#include <librepcb/common/geometry/polygon.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/toolbox.h>
+#include <librepcb/library/pkg/footprint.h>
+#include <librepcb/library/pkg/footprintpad.h>
+#include <librepcb/library/pkg/packagepad.h>
+#include "../project.h"
+#include "../circuit/circuit.h"
+#include "../circuit/componentinstance.h"
+#include "../circuit/netsignal.h"
+#include "../erc/ercmsg.h"
+#include "board.h"
+#include "boardairwiresbuilder.h"
+#include "boardlayerstack.h"
+#include "items/bi_device.h"
+#include "items/bi_footprint.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_via.h"
+#include "items/bi_netsegment.h"
+#include "items/bi_netpoint.h"
+#include "items/bi_netline.h"
+#include "items/bi_polygon.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Geometry Helpers
+ ****************************************************************************************/
+
+namespace {
+
+// Note: The integer predicates below don't overflow as long as all coordinates are
+// within +/-1 meter, which is far beyond any realistic board size.
+
+LengthBase_t cross(const Point& o, const Point& a, const Point& b) noexcept
+{
+    return (a.getX().toNm() - o.getX().toNm()) * (b.getY().toNm() - o.getY().toNm())
+         - (a.getY().toNm() - o.getY().toNm()) * (b.getX().toNm() - o.getX().toNm());
+}
+
+int sign(LengthBase_t value) noexcept
+{
+    return (value > 0) - (value < 0);
+}
+
+/// Check if a point which is collinear with a segment lies within its bounding box
+bool isOnSegment(const Point& p, const Point& s1, const Point& s2) noexcept
+{
+    return (p.getX() >= qMin(s1.getX(), s2.getX())) && (p.getX() <= qMax(s1.getX(), s2.getX()))
+        && (p.getY() >= qMin(s1.getY(), s2.getY())) && (p.getY() <= qMax(s1.getY(), s2.getY()));
+}
+
+bool doSegmentsIntersect(const Point& a1, const Point& a2,
+                         const Point& b1, const Point& b2) noexcept
+{
+    int d1 = sign(cross(b1, b2, a1));
+    int d2 = sign(cross(b1, b2, a2));
+    int d3 = sign(cross(a1, a2, b1));
+    int d4 = sign(cross(a1, a2, b2));
+    if ((d1 * d2 < 0) && (d3 * d4 < 0)) return true;
+    if ((d1 == 0) && isOnSegment(a1, b1, b2)) return true;
+    if ((d2 == 0) && isOnSegment(a2, b1, b2)) return true;
+    if ((d3 == 0) && isOnSegment(b1, a1, a2)) return true;
+    if ((d4 == 0) && isOnSegment(b2, a1, a2)) return true;
+    return false;
+}
+
+bool isInsideConvexPolygon(const Point& p, const QVector<Point>& polygon) noexcept
+{
+    if (polygon.count() < 3) return false;
+    int side = 0;
+    for (int i = 0; i < polygon.count(); ++i) {
+        int s = sign(cross(polygon.at(i), polygon.at((i + 1) % polygon.count()), p));
+        if (s == 0) continue;
+        if (side == 0) {
+            side = s;
+        } else if (s != side) {
+            return false;
+        }
+    }
+    return true;
+}
+
+qreal getDistanceToSegment(const Point& p, const Point& s1, const Point& s2,
+                           Point& nearest) noexcept
+{
+    qreal px = p.getX().toNm(), py = p.getY().toNm();
+    qreal x1 = s1.getX().toNm(), y1 = s1.getY().toNm();
+    qreal dx = s2.getX().toNm() - x1, dy = s2.getY().toNm() - y1;
+    qreal lengthSquared = dx * dx + dy * dy;
+    qreal t = (lengthSquared > 0) ? qBound(0.0, ((px - x1) * dx + (py - y1) * dy) / lengthSquared, 1.0) : 0.0;
+    qreal nx = x1 + t * dx, ny = y1 + t * dy;
+    nearest = Point(Length(qRound64(nx)), Length(qRound64(ny)));
+    return qSqrt((px - nx) * (px - nx) + (py - ny) * (py - ny));
+}
+
+/// The edges of a convex polygon (a single point is a degenerated edge)
+int getEdgeCount(const QVector<Point>& polygon) noexcept
+{
+    return (polygon.count() < 3) ? 1 : polygon.count();
+}
+
+const Point& getEdgeEnd(const QVector<Point>& polygon, int edge) noexcept
+{
+    return polygon.at((edge + 1) % polygon.count());
+}
+
+/**
+ * @brief Calculate the distance between two convex polygons
+ *
+ * @return 0 if they overlap, otherwise the distance between the nearest points
+ */
+qreal getDistance(const QVector<Point>& a, const QVector<Point>& b, Point& nearest) noexcept
+{
+    // overlapping polygons (exact)
+    for (int i = 0; i < getEdgeCount(a); ++i) {
+        for (int k = 0; k < getEdgeCount(b); ++k) {
+            if (doSegmentsIntersect(a.at(i), getEdgeEnd(a, i), b.at(k), getEdgeEnd(b, k))) {
+                nearest = a.at(i);
+                return 0;
+            }
+        }
+    }
+    if (isInsideConvexPolygon(b.first(), a)) {nearest = b.first(); return 0;}
+    if (isInsideConvexPolygon(a.first(), b)) {nearest = a.first(); return 0;}
+
+    // separated polygons: the nearest points always involve at least one vertex
+    qreal distance = std::numeric_limits<qreal>::max();
+    Point p;
+    for (int i = 0; i < a.count(); ++i) {
+        for (int k = 0; k < getEdgeCount(b); ++k) {
+            qreal d = getDistanceToSegment(a.at(i), b.at(k), getEdgeEnd(b, k), p);
+            if (d < distance) {distance = d; nearest = p;}
+        }
+    }
+    for (int i = 0; i < b.count(); ++i) {
+        for (int k = 0; k < getEdgeCount(a); ++k) {
+            qreal d = getDistanceToSegment(b.at(i), a.at(k), getEdgeEnd(a, k), p);
+            if (d < distance) {distance = d; nearest = b.at(i);}
+        }
+    }
+    return distance;
+}
+
+RTree<int>::Box getBoundingBox(const QVector<Point>& points, LengthBase_t radius) noexcept
+{
+    RTree<int>::Box box;
+    foreach (const Point& p, points) {
+        box = box.united(RTree<int>::Box(p, p));
+    }
+    return box.expanded(radius);
+}
+
+QString getPadId(const BI_FootprintPad& pad) noexcept
+{
+    return QString("device/%1/pad/%2").arg(
+        pad.getFootprint().getComponentInstanceUuid().toStr(), pad.getLibPadUuid().toStr());
+}
+
+} // namespace
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardDesignRuleCheck::BoardDesignRuleCheck(Board& board) noexcept :
+    QObject(nullptr), mBoard(board), mIsExecuted(false)
+{
+}
+
+BoardDesignRuleCheck::~BoardDesignRuleCheck() noexcept
+{
+    clear();
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+QStringList BoardDesignRuleCheck::getViolationMessages() const noexcept
+{
+    QStringList messages;
+    foreach (const Violation& v, mViolations) {
+        messages.append(v.message);
+    }
+    messages.sort();
+    return messages;
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void BoardDesignRuleCheck::execute() noexcept
+{
+    run(false);
+}
+
+void BoardDesignRuleCheck::executeIncremental() noexcept
+{
+    run(mIsExecuted);
+}
+
+void BoardDesignRuleCheck::clear() noexcept
+{
+    qDeleteAll(mErcMessages);
+    mErcMessages.clear();
+    mViolations.clear();
+    mIsExecuted = false;
+    mObjectNets.clear();
+    mObjectHashes.clear();
+    mLayers.clear();
+    mOutline = Layer();
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void BoardDesignRuleCheck::run(bool incremental) noexcept
+{
+    // take a snapshot of all objects
+    QHash<QString, const NetSignal*> previousObjectNets = mObjectNets;
+    QHash<QString, uint> previousObjectHashes = mObjectHashes;
+    Length previousCopperClearance = mCopperClearance;
+    Length previousOutlineClearance = mOutlineClearance;
+    collectObjects();
+    if ((mCopperClearance != previousCopperClearance)
+        || (mOutlineClearance != previousOutlineClearance))
+    {
+        incremental = false; // all results may have changed
+    }
+
+    // determine the added, modified and removed objects
+    QSet<QString> dirtyIdSet;
+    const QSet<QString>* dirtyIds = incremental ? &dirtyIdSet : nullptr;
+    if (incremental) {
+        for (auto it = mObjectHashes.constBegin(); it != mObjectHashes.constEnd(); ++it) {
+            auto previous = previousObjectHashes.constFind(it.key());
+            if ((previous == previousObjectHashes.constEnd()) || (*previous != it.value())) {
+                dirtyIdSet.insert(it.key());
+            }
+        }
+        for (auto it = previousObjectHashes.constBegin();
+             it != previousObjectHashes.constEnd(); ++it)
+        {
+            if (!mObjectHashes.contains(it.key())) dirtyIdSet.insert(it.key());
+        }
+    }
+
+    // create the tasks for the pairwise checks, split by layer and region
+    QVector<Task> tasks;
+    if (dirtyIds) {
+        // only the modified objects (against all of their neighbours)
+        for (int i = -1; i < mLayers.count(); ++i) {
+            const Layer& layer = (i < 0) ? mOutline : mLayers.at(i);
+            Task task{i, QVector<int>(), true, QVector<Violation>()};
+            for (int k = 0; k < layer.objects.count(); ++k) {
+                if (dirtyIds->contains(layer.objects.at(k).id)) task.objects.append(k);
+            }
+            if (!task.objects.isEmpty()) tasks.append(task);
+        }
+    } else {
+        // all copper objects, the board outline is checked from the copper side
+        int chunks = qMax(1, QThread::idealThreadCount() * 4);
+        for (int i = 0; i < mLayers.count(); ++i) {
+            const Layer& layer = mLayers.at(i);
+            QVector<int> indices(layer.objects.count());
+            std::iota(indices.begin(), indices.end(), 0);
+            std::sort(indices.begin(), indices.end(), [&layer](int a, int b){
+                return layer.objects.at(a).box.left < layer.objects.at(b).box.left;});
+            int chunkSize = qMax(256, (indices.count() + chunks - 1) / chunks);
+            for (int k = 0; k < indices.count(); k += chunkSize) {
+                tasks.append(Task{i, indices.mid(k, chunkSize), false, QVector<Violation>()});
+            }
+        }
+    }
+    QFuture<void> future = QtConcurrent::map(tasks, [this](Task& task){runTask(task);});
+
+    // meanwhile, run the checks which access the board in this thread
+    QVector<Violation> violations;
+    checkSingleObjects(violations);
+    QSet<const NetSignal*> dirtyNets;
+    if (dirtyIds) {
+        foreach (const QString& id, *dirtyIds) {
+            dirtyNets.insert(previousObjectNets.value(id));
+            dirtyNets.insert(mObjectNets.value(id));
+        }
+        dirtyNets.remove(nullptr);
+    }
+    checkUnconnectedNets(dirtyIds ? &dirtyNets : nullptr, violations);
+
+    future.waitForFinished();
+    foreach (const Task& task, tasks) {
+        violations += task.violations;
+    }
+    updateMessages(violations, dirtyIds, dirtyIds ? &dirtyNets : nullptr);
+    mIsExecuted = true;
+}
+
+void BoardDesignRuleCheck::collectObjects() noexcept
+{
+    mLayers.clear();
+    mOutline = Layer();
+    mOutline.name = GraphicsLayer::sBoardOutlines;
+    mObjectNets.clear();
+    mObjectHashes.clear();
+    mCopperClearance = mBoard.getDesignRules().getMinCopperClearance();
+    mOutlineClearance = mBoard.getDesignRules().getMinOutlineClearance();
+    foreach (const GraphicsLayer* layer, mBoard.getLayerStack().getAllLayers()) {
+        if (layer->isCopperLayer()) {
+            mLayers.append(Layer{layer->getName(), QVector<Object>(), RTree<int>()});
+        }
+    }
+
+    // pads
+    foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+        foreach (const BI_FootprintPad* pad, device->getFootprint().getPads()) {
+            const library::FootprintPad& libPad = pad->getLibPad();
+            Object obj;
+            obj.id = getPadId(*pad);
+            obj.name = tr("pad %1:%2").arg(device->getComponentInstance().getName(),
+                                           pad->getLibPackagePad().getName());
+            obj.net = pad->getCompSigInstNetSignal();
+            obj.radius = 0;
+            Length width = libPad.getWidth();
+            Length height = libPad.getHeight();
+            switch (libPad.getShape()) {
+                case library::FootprintPad::Shape::ROUND: {
+                    Length diameter = qMin(width, height);
+                    Length offset = (qMax(width, height) - diameter) / 2;
+                    obj.radius = (diameter / 2).toNm();
+                    if (width > height) {
+                        obj.points = {Point(-offset, 0), Point(offset, 0)};
+                    } else if (height > width) {
+                        obj.points = {Point(0, -offset), Point(0, offset)};
+                    } else {
+                        obj.points = {Point(0, 0)};
+                    }
+                    break;
+                }
+                case library::FootprintPad::Shape::RECT:
+                    obj.points = Toolbox::flattenedPath(Path::centeredRect(width, height));
+                    break;
+                case library::FootprintPad::Shape::OCTAGON:
+                    obj.points = Toolbox::flattenedPath(Path::octagon(width, height));
+                    break;
+            }
+            Angle rot = pad->getIsMirrored() ? -pad->getRotation() : pad->getRotation();
+            for (Point& p : obj.points) {
+                p = p.rotated(rot) + pad->getPosition();
+            }
+            foreach (const Layer& layer, mLayers) {
+                if (pad->isOnLayer(layer.name)) {
+                    addObject(layer.name, obj);
+                }
+            }
+        }
+    }
+
+    // non-plated holes are cutouts of the board, so they are checked like the outline
+    foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+        const BI_Footprint& footprint = device->getFootprint();
+        for (const Hole& hole : footprint.getLibFootprint().getHoles()) {
+            Object obj;
+            obj.id = QString("device/%1/hole/%2").arg(
+                device->getComponentInstanceUuid().toStr(), hole.getUuid().toStr());
+            obj.name = tr("hole of %1").arg(device->getComponentInstance().getName());
+            obj.net = nullptr;
+            obj.points = {footprint.mapToScene(hole.getPosition())};
+            obj.radius = (hole.getDiameter() / 2).toNm();
+            addObject(mOutline.name, obj);
+        }
+    }
+
+    // vias and traces
+    foreach (const BI_NetSegment* netsegment, mBoard.getNetSegments()) {
+        foreach (const BI_Via* via, netsegment->getVias()) {
+            Object obj;
+            obj.id = QString("via/%1").arg(via->getUuid().toStr());
+            obj.name = tr("via of net \"%1\"").arg(netsegment->getNetSignal().getName());
+            obj.net = &netsegment->getNetSignal();
+            obj.radius = 0;
+            switch (via->getShape()) {
+                case BI_Via::Shape::Round:
+                    obj.points = {Point(0, 0)};
+                    obj.radius = (via->getSize() / 2).toNm();
+                    break;
+                case BI_Via::Shape::Square:
+                    obj.points = Toolbox::flattenedPath(
+                        Path::centeredRect(via->getSize(), via->getSize()));
+                    break;
+                case BI_Via::Shape::Octagon:
+                    obj.points = Toolbox::flattenedPath(
+                        Path::octagon(via->getSize(), via->getSize()));
+                    break;
+            }
+            for (Point& p : obj.points) {
+                p += via->getPosition();
+            }
+            foreach (const Layer& layer, mLayers) {
+                if (via->isOnLayer(layer.name)) {
+                    addObject(layer.name, obj);
+                }
+            }
+        }
+        foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
+            Object obj;
+            obj.id = QString("netline/%1").arg(netline->getUuid().toStr());
+            obj.name = tr("trace of net \"%1\"").arg(netsegment->getNetSignal().getName());
+            obj.net = &netsegment->getNetSignal();
+            obj.points = {netline->getStartPoint().getPosition(),
+                          netline->getEndPoint().getPosition()};
+            obj.radius = (netline->getWidth() / 2).toNm();
+            addObject(netline->getLayer().getName(), obj);
+        }
+    }
+
+    // polygons (copper and board outline)
+    foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+        const Polygon& p = polygon->getPolygon();
+        bool isOutline = (p.getLayerName() == mOutline.name);
+        addPathObjects(p.getLayerName(), QString("polygon/%1").arg(p.getUuid().toStr()),
+                       isOutline ? tr("board outline") : tr("polygon"), p.getPath(),
+                       p.getLineWidth(), true, p.isFilled() && (!isOutline));
+    }
+
+    // build the spatial indices
+    auto buildTree = [](Layer& layer) {
+        QVector<QPair<RTree<int>::Box, int>> entries;
+        entries.reserve(layer.objects.count());
+        for (int i = 0; i < layer.objects.count(); ++i) {
+            entries.append(qMakePair(layer.objects.at(i).box, i));
+        }
+        layer.tree.build(entries);
+    };
+    for (Layer& layer : mLayers) {
+        buildTree(layer);
+    }
+    buildTree(mOutline);
+}
+
+void BoardDesignRuleCheck::addObject(const QString& layer, Object obj) noexcept
+{
+    obj.box = getBoundingBox(obj.points, obj.radius);
+    mObjectNets.insert(obj.id, obj.net);
+
+    // objects consisting of several parts (e.g. polygons) get a hash over all parts
+    uint& hash = mObjectHashes[obj.id];
+    hash = hash * 31 + qHash(layer);
+    hash = hash * 31 + qHash(obj.net);
+    hash = hash * 31 + qHash(obj.radius);
+    foreach (const Point& p, obj.points) {
+        hash = hash * 31 + qHash(p.getX().toNm());
+        hash = hash * 31 + qHash(p.getY().toNm());
+    }
+    if (layer == mOutline.name) {
+        mOutline.objects.append(obj);
+        return;
+    }
+    for (Layer& l : mLayers) {
+        if (l.name == layer) {
+            l.objects.append(obj);
+            return;
+        }
+    }
+}
+
+void BoardDesignRuleCheck::addPathObjects(const QString& layer, const QString& id,
+                                          const QString& name, const Path& path,
+                                          const Length& width, bool closed,
+                                          bool filled) noexcept
+{
+    // flatten arcs into straight segments (the same way as the plane fill does)
+    QVector<Point> points = Toolbox::flattenedPath(path);
+    if (closed && (points.count() > 2) && (points.first() != points.last())) {
+        points.append(points.first());
+    }
+
+    // every segment becomes an object, all with the same ID to not check them against
+    // each other
+    for (int i = 0; i < qMax(points.count() - 1, qMin(points.count(), 1)); ++i) {
+        Object obj;
+        obj.id = id;
+        obj.name = name;
+        obj.net = nullptr;
+        obj.points = points.mid(i, 2);
+        obj.radius = (width / 2).toNm();
+        addObject(layer, obj);
+    }
+
+    // the area of filled polygons is split into convex trapezoids
+    if (filled && (points.count() > 2)) {
+        PolygonClipper clipper;
+        clipper.addPolygon(points, 0);
+        foreach (const PolygonClipper::Trapezoid& trapezoid,
+                 clipper.execute([](const bool* inside){return inside[0];}))
+        {
+            Object obj;
+            obj.id = id;
+            obj.name = name;
+            obj.net = nullptr;
+            obj.points = trapezoid.toPolygon();
+            obj.radius = 0;
+            addObject(layer, obj);
+        }
+    }
+}
+
+void BoardDesignRuleCheck::runTask(Task& task) const noexcept
+{
+    const Layer& layer = (task.layer < 0) ? mOutline : mLayers.at(task.layer);
+    foreach (int i, task.objects) {
+        const Object& obj = layer.objects.at(i);
+        if (task.layer >= 0) {
+            // copper to copper
+            layer.tree.query(obj.box.expanded(mCopperClearance.toNm()), [&](int k){
+                if ((k == i) || ((!task.allNeighbours) && (k < i))) return;
+                checkPair(obj, layer.objects.at(k), mCopperClearance, false, task.violations);
+            });
+            // copper to board outline
+            mOutline.tree.query(obj.box.expanded(mOutlineClearance.toNm()), [&](int k){
+                checkPair(obj, mOutline.objects.at(k), mOutlineClearance, true, task.violations);
+            });
+        } else {
+            // board outline to copper
+            foreach (const Layer& copper, mLayers) {
+                copper.tree.query(obj.box.expanded(mOutlineClearance.toNm()), [&](int k){
+                    checkPair(copper.objects.at(k), obj, mOutlineClearance, true,
+                              task.violations);
+                });
+            }
+        }
+    }
+}
+
+void BoardDesignRuleCheck::checkPair(const Object& a, const Object& b,
+                                     const Length& clearance, bool isBoardOutline,
+                                     QVector<Violation>& violations) const noexcept
+{
+    if ((a.id == b.id) || ((a.net) && (a.net == b.net))) {
+        return; // same object or same net
+    }
+    // the reported position depends on the order, so it is independent of which of
+    // both objects was checked against the other
+    const Object& first = (a.id < b.id) ? a : b;
+    const Object& second = (a.id < b.id) ? b : a;
+    Point nearest;
+    qreal distance = isBoardOutline ? getDistance(a.points, b.points, nearest)
+                                    : getDistance(first.points, second.points, nearest);
+    LengthBase_t gap = qRound64(distance) - a.radius - b.radius;
+    if ((gap > 0) && (gap >= clearance.toNm())) {
+        return;
+    }
+    Length actual(qMax(LengthBase_t(0), gap));
+    Violation v;
+    v.distance = actual;
+    if (isBoardOutline) {
+        v.key = QString("outline/%1/%2").arg(a.id, b.id);
+        v.message = tr("Clearance between %1 and %2: %3mm < %4mm (at %5/%6)")
+                    .arg(a.name, b.name, actual.toMmString(), clearance.toMmString(),
+                         nearest.getX().toMmString(), nearest.getY().toMmString());
+        v.objectIds = QStringList{a.id, b.id};
+    } else {
+        v.key = QString("clearance/%1/%2").arg(first.id, second.id);
+        v.message = tr("Clearance between %1 and %2: %3mm < %4mm (at %5/%6)")
+                    .arg(first.name, second.name, actual.toMmString(),
+                         clearance.toMmString(), nearest.getX().toMmString(),
+                         nearest.getY().toMmString());
+        v.objectIds = QStringList{first.id, second.id};
+    }
+    violations.append(v);
+}
+
+void BoardDesignRuleCheck::checkSingleObjects(QVector<Violation>& violations) const noexcept
+{
+    const BoardDesignRules& rules = mBoard.getDesignRules();
+    auto addViolation = [&violations](const QString& key, const QString& id, const QString& msg) {
+        violations.append(Violation{key, msg, QStringList{id}, Length(0)});
+    };
+
+    // pads and holes
+    foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+        const QString cmpName = device->getComponentInstance().getName();
+        const QString cmpUuid = device->getComponentInstanceUuid().toStr();
+        foreach (const BI_FootprintPad* pad, device->getFootprint().getPads()) {
+            const library::FootprintPad& libPad = pad->getLibPad();
+            QString id = getPadId(*pad);
+            QString name = QString("%1:%2").arg(cmpName, pad->getLibPackagePad().getName());
+            Length width = qMin(libPad.getWidth(), libPad.getHeight());
+            if (width < rules.getMinCopperWidth()) {
+                addViolation("width/" % id, id, tr("Pad %1 too narrow: %2mm < %3mm")
+                    .arg(name, width.toMmString(), rules.getMinCopperWidth().toMmString()));
+            }
+            if (libPad.getBoardSide() == library::FootprintPad::BoardSide::THT) {
+                Length drill = libPad.getDrillDiameter();
+                Length ring = (width - drill) / 2;
+                if (drill < rules.getMinDrillDiameter()) {
+                    addViolation("drill/" % id, id, tr("Drill of pad %1 too small: %2mm < %3mm")
+                        .arg(name, drill.toMmString(), rules.getMinDrillDiameter().toMmString()));
+                }
+                if (ring < rules.getMinAnnularRing()) {
+                    addViolation("annular_ring/" % id, id, tr("Annular ring of pad %1 too small: %2mm < %3mm")
+                        .arg(name, ring.toMmString(), rules.getMinAnnularRing().toMmString()));
+                }
+            }
+        }
+        for (const Hole& hole : device->getFootprint().getLibFootprint().getHoles()) {
+            Length drill = hole.getDiameter();
+            QString id = QString("device/%1/hole/%2").arg(cmpUuid, hole.getUuid().toStr());
+            if (drill < rules.getMinDrillDiameter()) {
+                addViolation("drill/" % id, id, tr("Hole of %1 too small: %2mm < %3mm")
+                    .arg(cmpName, drill.toMmString(), rules.getMinDrillDiameter().toMmString()));
+            }
+        }
+    }
+
+    // vias and traces
+    foreach (const BI_NetSegment* netsegment, mBoard.getNetSegments()) {
+        const QString netName = netsegment->getNetSignal().getName();
+        foreach (const BI_Via* via, netsegment->getVias()) {
+            QString id = QString("via/%1").arg(via->getUuid().toStr());
+            Length drill = via->getDrillDiameter();
+            Length ring = (via->getSize() - drill) / 2;
+            if (drill < rules.getMinDrillDiameter()) {
+                addViolation("drill/" % id, id, tr("Drill of via in net \"%1\" too small: %2mm < %3mm")
+                    .arg(netName, drill.toMmString(), rules.getMinDrillDiameter().toMmString()));
+            }
+            if (ring < rules.getMinAnnularRing()) {
+                addViolation("annular_ring/" % id, id, tr("Annular ring of via in net \"%1\" too small: %2mm < %3mm")
+                    .arg(netName, ring.toMmString(), rules.getMinAnnularRing().toMmString()));
+            }
+        }
+        foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
+            QString id = QString("netline/%1").arg(netline->getUuid().toStr());
+            if (netline->getWidth() < rules.getMinCopperWidth()) {
+                addViolation("width/" % id, id, tr("Trace in net \"%1\" too narrow: %2mm < %3mm")
+                    .arg(netName, netline->getWidth().toMmString(),
+                         rules.getMinCopperWidth().toMmString()));
+            }
+        }
+    }
+
+    // copper polygons
+    foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+        const Polygon& p = polygon->getPolygon();
+        QString id = QString("polygon/%1").arg(p.getUuid().toStr());
+        if (GraphicsLayer::isCopperLayer(p.getLayerName()) && (!p.isFilled())
+            && (p.getLineWidth() < rules.getMinCopperWidth()))
+        {
+            addViolation("width/" % id, id, tr("Copper polygon too narrow: %1mm < %2mm")
+                .arg(p.getLineWidth().toMmString(), rules.getMinCopperWidth().toMmString()));
+        }
+    }
+}
+
+void BoardDesignRuleCheck::checkUnconnectedNets(const QSet<const NetSignal*>* nets,
+                                                QVector<Violation>& violations) const noexcept
+{
+    foreach (const NetSignal* netsignal, mBoard.getProject().getCircuit().getNetSignals()) {
+        if (nets && (!nets->contains(netsignal))) continue;
+        BoardAirWiresBuilder builder(mBoard, *netsignal);
+        int count = builder.buildAirWires().count();
+        if (count > 0) {
+            QString id = QString("net/%1").arg(netsignal->getUuid().toStr());
+            violations.append(Violation{"unconnected/" % id,
+                tr("Net \"%1\" has %2 unconnected item(s)").arg(netsignal->getName()).arg(count),
+                QStringList{id}, Length(0)});
+        }
+    }
+}
+
+void BoardDesignRuleCheck::updateMessages(const QVector<Violation>& violations,
+                                          const QSet<QString>* dirtyIds,
+                                          const QSet<const NetSignal*>* dirtyNets) noexcept
+{
+    // objects consisting of several parts may violate the same rule several times,
+    // report only the smallest distance (independent of the order of the checks)
+    QHash<QString, Violation> newViolations;
+    foreach (const Violation& v, violations) {
+        auto it = newViolations.find(v.key);
+        if (it == newViolations.end()) {
+            newViolations.insert(v.key, v);
+        } else if ((v.distance < it->distance)
+                   || ((v.distance == it->distance) && (v.message < it->message))) {
+            *it = v;
+        }
+    }
+
+    // determine which of the previous results were checked again
+    QSet<QString> existingIds;
+    foreach (const QString& id, mObjectNets.keys()) {
+        existingIds.insert(id);
+    }
+    QSet<QString> dirtyNetIds;
+    foreach (const NetSignal* netsignal, mBoard.getProject().getCircuit().getNetSignals()) {
+        QString id = QString("net/%1").arg(netsignal->getUuid().toStr());
+        existingIds.insert(id);
+        if (dirtyNets && dirtyNets->contains(netsignal)) dirtyNetIds.insert(id);
+    }
+    auto wasChecked = [&](const Violation& v) {
+        if (!dirtyIds) return true; // full check
+        if (v.key.startsWith("width/") || v.key.startsWith("drill/")
+            || v.key.startsWith("annular_ring/")) {
+            return true; // always checked completely
+        }
+        foreach (const QString& id, v.objectIds) {
+            if (dirtyIds->contains(id) || dirtyNetIds.contains(id) || (!existingIds.contains(id))) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // remove resolved violations
+    foreach (const Violation& v, mViolations.values()) {
+        if (wasChecked(v) && (!newViolations.contains(v.key))) {
+            delete mErcMessages.take(v.key);
+            mViolations.remove(v.key);
+        }
+    }
+
+    // add new violations resp. update existing ones
+    foreach (const Violation& v, newViolations) {
+        mViolations.insert(v.key, v);
+        if (ErcMsg* msg = mErcMessages.value(v.key)) {
+            msg->setMsg(v.message);
+        } else {
+            msg = new ErcMsg(mBoard.getProject(), *this, mBoard.getUuid().toStr(), v.key,
+                             ErcMsg::ErcMsgType_t::BoardError, v.message);
+            msg->setVisible(true);
+            mErcMessages.insert(v.key, msg);
+        }
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
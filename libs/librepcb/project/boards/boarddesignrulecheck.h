@@ -0,0 +1,184 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDDESIGNRULECHECK_H
+#define LIBREPCB_PROJECT_BOARDDESIGNRULECHECK_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/units/all_length_units.h>
+#include <librepcb/common/algorithm/rtree.h>
+#include "../erc/if_ercmsgprovider.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class Path;
+
+namespace project {
+
+class Board;
+class NetSignal;
+
+/*****************************************************************************************
+ *  Class BoardDesignRuleCheck
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardDesignRuleCheck class checks a board against its design rules
+ *
+ * The following checks are performed, using the limits of the board's
+ * #librepcb::BoardDesignRules:
+ *  - Clearance between copper objects of different nets (including the area of filled
+ *    copper polygons)
+ *  - Minimum copper width (traces, pads, copper polygon outlines)
+ *  - Minimum drill diameter (vias, pads, holes)
+ *  - Minimum annular ring (vias, THT pads)
+ *  - Clearance between copper objects and the board outline resp. non-plated holes
+ *  - Unconnected nets (i.e. nets which still have air wires)
+ *
+ * All copper objects are first copied into plain geometry snapshots (convex polygons
+ * with a rounding radius), so the pairwise checks can run in parallel on all cores
+ * without touching the board. Neighbours are found with an #librepcb::RTree per layer,
+ * and the work is split by layer and by region. Violations are reported as
+ * #project#ErcMsg objects and thus show up in the ERC messages of the project.
+ *
+ * After a full check with #execute(), #executeIncremental() re-checks only the
+ * surroundings of objects which were added, modified or removed since the previous
+ * check, which is much faster on large boards. The modified objects are determined by
+ * comparing the snapshots, so every kind of modification (including undo and redo) is
+ * covered.
+ */
+class BoardDesignRuleCheck final : public QObject, public IF_ErcMsgProvider
+{
+        Q_OBJECT
+        DECLARE_ERC_MSG_CLASS_NAME(BoardDesignRuleCheck)
+
+    public:
+
+        // Constructors / Destructor
+        BoardDesignRuleCheck() = delete;
+        BoardDesignRuleCheck(const BoardDesignRuleCheck& other) = delete;
+        explicit BoardDesignRuleCheck(Board& board) noexcept;
+        ~BoardDesignRuleCheck() noexcept;
+
+        // Getters
+        bool isExecuted() const noexcept {return mIsExecuted;}
+        int getViolationCount() const noexcept {return mViolations.count();}
+        QStringList getViolationMessages() const noexcept;
+
+        // General Methods
+        void execute() noexcept;
+
+        /**
+         * @brief Re-check only the objects modified since the previous check
+         *
+         * Falls back to a full check if there was no previous check or if the design
+         * rules have changed.
+         */
+        void executeIncremental() noexcept;
+        void clear() noexcept;
+
+        // Operator Overloadings
+        BoardDesignRuleCheck& operator=(const BoardDesignRuleCheck& rhs) = delete;
+
+
+    private: // Types
+        typedef RTree<int>::Box Box;
+
+        /// A snapshot of a copper or board outline object
+        struct Object {
+            QString id;             ///< unique ID of the board item (e.g. "via/<uuid>")
+            QString name;           ///< human readable name, used in messages
+            const NetSignal* net;   ///< nullptr if not connected to a net
+            QVector<Point> points;  ///< convex polygon (1 point = circle, 2 = obround)
+            LengthBase_t radius;    ///< rounding radius around #points
+            Box box;
+        };
+
+        /// All objects on one layer with their spatial index
+        struct Layer {
+            QString name;
+            QVector<Object> objects;
+            RTree<int> tree;
+        };
+
+        struct Violation {
+            QString key;            ///< unique key, also used as key of the ERC message
+            QString message;
+            QStringList objectIds;
+            Length distance;        ///< the smallest violation of a key is reported
+        };
+
+        struct Task {
+            int layer;              ///< index in #mLayers, -1 for the board outline
+            QVector<int> objects;   ///< indices of the objects to check
+            bool allNeighbours;     ///< if false, only neighbours with higher index
+            QVector<Violation> violations;
+        };
+
+
+    private: // Methods
+        void run(bool incremental) noexcept;
+        void collectObjects() noexcept;
+        void addObject(const QString& layer, Object obj) noexcept;
+        void addPathObjects(const QString& layer, const QString& id, const QString& name,
+                            const Path& path, const Length& width, bool closed,
+                            bool filled) noexcept;
+        void runTask(Task& task) const noexcept;
+        void checkPair(const Object& a, const Object& b, const Length& clearance,
+                       bool isBoardOutline, QVector<Violation>& violations) const noexcept;
+        void checkSingleObjects(QVector<Violation>& violations) const noexcept;
+        void checkUnconnectedNets(const QSet<const NetSignal*>* nets,
+                                  QVector<Violation>& violations) const noexcept;
+        void updateMessages(const QVector<Violation>& violations,
+                            const QSet<QString>* dirtyIds,
+                            const QSet<const NetSignal*>* dirtyNets) noexcept;
+
+
+    private: // Data
+        Board& mBoard;
+
+        // snapshot of the current check
+        Length mCopperClearance;
+        Length mOutlineClearance;
+        QVector<Layer> mLayers;     ///< all copper layers
+        Layer mOutline;             ///< board outline segments
+        QHash<QString, const NetSignal*> mObjectNets; ///< key: object ID
+        QHash<QString, uint> mObjectHashes; ///< geometry of the objects, key: object ID
+
+        // results of the previous checks, key: Violation::key
+        bool mIsExecuted;
+        QHash<QString, Violation> mViolations;
+        QHash<QString, ErcMsg*> mErcMessages;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDDESIGNRULECHECK_H
@@ -21,12 +21,14 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <QtConcurrent>
 #include "boardgerberexport.h"
 #include <librepcb/common/cam/gerbergenerator.h>
 #include <librepcb/common/cam/excellongenerator.h>
 #include <librepcb/common/graphics/graphicslayer.h>
 #include <librepcb/common/boarddesignrules.h>
 #include <librepcb/common/geometry/hole.h>
+#include <librepcb/common/toolbox.h>
 #include <librepcb/library/pkg/footprint.h>
 #include <librepcb/library/pkg/footprintpad.h>
 #include "../metadata/projectmetadata.h"
@@ -40,6 +42,7 @@
 #include "items/bi_netpoint.h"
 #include "items/bi_netline.h"
 #include "items/bi_polygon.h"
+#include "items/bi_plane.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -52,7 +55,9 @@ namespace project {
  ****************************************************************************************/
 
 BoardGerberExport::BoardGerberExport(const Board& board, const FilePath& outputDir) noexcept :
-    mProject(board.getProject()), mBoard(board), mOutputDirectory(outputDir)
+    mProject(board.getProject()), mBoard(board), mOutputDirectory(outputDir),
+    mPanelSettings{1, 1, Length(0), Length(0)},
+    mDrillStatistics(new DrillStatistics{0, Length(0), Length(0), 0})
 {
 }
 
@@ -66,34 +71,140 @@ BoardGerberExport::~BoardGerberExport() noexcept
 
 void BoardGerberExport::exportAllLayers() const
 {
-    exportDrillsPTH();
-    exportLayerBoardOutlines();
-    exportLayerTopCopper();
-    exportLayerTopSolderMask();
-    exportLayerTopSilkscreen();
-    exportLayerBottomCopper();
-    exportLayerBottomSolderMask();
-    exportLayerBottomSilkscreen();
+    QFuture<void> future = startExport();
+    future.waitForFinished(); // can throw
+}
+
+QFuture<void> BoardGerberExport::startExport() const
+{
+    QSharedPointer<const Snapshot> snapshot = createSnapshot();
+    QSharedPointer<DrillStatistics> statistics(new DrillStatistics{0, Length(0), Length(0), 0});
+    mDrillStatistics = statistics;
+
+    // the jobs hold a reference to the snapshot, so it is kept alive until all jobs
+    // are finished, even if this object is destroyed in the meantime
+    QVector<Job> jobs;
+    jobs.append([snapshot, statistics](){exportDrillsPTH(*snapshot, *statistics);});
+    jobs.append([snapshot](){exportLayerBoardOutlines(*snapshot);});
+    jobs.append([snapshot](){exportLayerTopCopper(*snapshot);});
+    jobs.append([snapshot](){exportLayerTopSolderMask(*snapshot);});
+    jobs.append([snapshot](){exportLayerTopSilkscreen(*snapshot);});
+    jobs.append([snapshot](){exportLayerBottomCopper(*snapshot);});
+    jobs.append([snapshot](){exportLayerBottomSolderMask(*snapshot);});
+    jobs.append([snapshot](){exportLayerBottomSilkscreen(*snapshot);});
+    return QtConcurrent::mapped(jobs, &BoardGerberExport::runJob);
 }
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
-void BoardGerberExport::exportDrillsPTH() const
+QSharedPointer<const BoardGerberExport::Snapshot> BoardGerberExport::createSnapshot() const
 {
-    ExcellonGenerator gen;
+    QSharedPointer<Snapshot> snapshot(new Snapshot());
+    snapshot->title = mProject.getMetadata().getName() % " - " % mBoard.getName();
+    snapshot->boardUuid = mBoard.getUuid();
+    snapshot->version = mProject.getMetadata().getVersion();
+    snapshot->outputDirectory = mOutputDirectory;
+    snapshot->fileBaseName = FilePath::cleanFileName(mProject.getMetadata().getName(),
+                             FilePath::ReplaceSpaces | FilePath::KeepCase);
+    snapshot->drills = collectDrills();
+    snapshot->layers = collectPrimitives();
+    setupPanel(*snapshot); // can throw
+    return snapshot;
+}
+
+void BoardGerberExport::setupPanel(Snapshot& snapshot) const
+{
+    const PanelSettings& s = mPanelSettings;
+    snapshot.panelColumns = 1;
+    snapshot.panelRows = 1;
+    if ((s.columns < 1) || (s.rows < 1) || (s.spacing < 0) || (s.railWidth < 0)) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Invalid panel settings: "
+            "%1x%2 boards, %3mm spacing, %4mm rails")).arg(s.columns).arg(s.rows)
+            .arg(s.spacing.toMmString(), s.railWidth.toMmString()));
+    }
+    if ((s.columns == 1) && (s.rows == 1) && (s.railWidth == 0)) {
+        return; // no panel
+    }
+
+    Point bottomLeft, topRight;
+    if (!calcBoardOutlineBoundingRect(bottomLeft, topRight)) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("The board \"%1\" has no "
+            "outline, so it can't be panelized.")).arg(mBoard.getName()));
+    }
+    Point size = topRight - bottomLeft;
+    snapshot.panelColumns = s.columns;
+    snapshot.panelRows = s.rows;
+    snapshot.panelStep = size + Point(s.spacing, s.spacing);
+
+    if (s.railWidth > 0) {
+        // the rails are separated from the boards by routing the gap along the panel
+        Length right = bottomLeft.getX() + snapshot.panelStep.getX() * (s.columns - 1)
+                       + size.getX();
+        Length top = bottomLeft.getY() + snapshot.panelStep.getY() * (s.rows - 1)
+                     + size.getY() + s.spacing;
+        Length bottom = bottomLeft.getY() - s.spacing;
+        snapshot.panelOutlines.append(Path::rect(Point(bottomLeft.getX(), top),
+            Point(right, top + s.railWidth)));
+        snapshot.panelOutlines.append(Path::rect(Point(bottomLeft.getX(), bottom - s.railWidth),
+            Point(right, bottom)));
+    }
+}
+
+bool BoardGerberExport::calcBoardOutlineBoundingRect(Point& bottomLeft,
+                                                     Point& topRight) const noexcept
+{
+    bool valid = false;
+    auto include = [&](const Point& p) {
+        if (!valid) {
+            bottomLeft = topRight = p;
+            valid = true;
+        } else {
+            bottomLeft = Point(qMin(bottomLeft.getX(), p.getX()), qMin(bottomLeft.getY(), p.getY()));
+            topRight = Point(qMax(topRight.getX(), p.getX()), qMax(topRight.getY(), p.getY()));
+        }
+    };
+    foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+        if (polygon->getPolygon().getLayerName() != GraphicsLayer::sBoardOutlines) continue;
+        const QVector<Vertex>& vertices = polygon->getPolygon().getPath().getVertices();
+        for (int i = 0; i < vertices.count(); ++i) {
+            include(vertices.at(i).getPos());
+            if ((i == 0) || (vertices.at(i).getAngle() == 0)) continue;
+            // arcs may bulge beyond their end points at multiples of 90 degrees
+            Point start = vertices.at(i-1).getPos();
+            Point end = vertices.at(i).getPos();
+            Point center = Toolbox::arcCenter(start, end, vertices.at(i).getAngle());
+            qreal radius = (start - center).getLength().toNm();
+            qreal startAngle = qAtan2((start - center).getY().toNm(),
+                                      (start - center).getX().toNm());
+            qreal sweep = vertices.at(i).getAngle().toRad();
+            for (int k = -8; k <= 8; ++k) {
+                qreal t = (k * M_PI / 2 - startAngle) / sweep;
+                if ((t > 0) && (t < 1)) {
+                    include(center + Point(qRound64(radius * qCos(k * M_PI / 2)),
+                                           qRound64(radius * qSin(k * M_PI / 2))));
+                }
+            }
+        }
+    }
+    return valid;
+}
+
+QVector<QPair<Point, Length>> BoardGerberExport::collectDrills() const
+{
+    QVector<QPair<Point, Length>> drills;
 
     // footprint holes and pads
     foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
         const BI_Footprint& footprint = device->getFootprint();
         for (const Hole& hole : footprint.getLibFootprint().getHoles()) {
-            gen.drill(footprint.mapToScene(hole.getPosition()), hole.getDiameter());
+            drills.append(qMakePair(footprint.mapToScene(hole.getPosition()), hole.getDiameter()));
         }
         foreach (const BI_FootprintPad* pad, footprint.getPads()) {
             const library::FootprintPad& libPad = pad->getLibPad();
             if (libPad.getBoardSide() == library::FootprintPad::BoardSide::THT) {
-                gen.drill(pad->getPosition(), libPad.getDrillDiameter());
+                drills.append(qMakePair(pad->getPosition(), libPad.getDrillDiameter()));
             }
         }
     }
@@ -101,129 +212,83 @@ void BoardGerberExport::exportDrillsPTH() const
     // vias
     foreach (const BI_NetSegment* netsegment, mBoard.getNetSegments()) {
         foreach (const BI_Via* via, netsegment->getVias()) {
-            gen.drill(via->getPosition(), via->getDrillDiameter());
+            drills.append(qMakePair(via->getPosition(), via->getDrillDiameter()));
         }
     }
 
-    gen.generate();
-    gen.saveToFile(getOutputFilePath("DRILLS-PTH.drl"));
-}
-
-void BoardGerberExport::exportLayerBoardOutlines() const
-{
-    GerberGenerator gen(mProject.getMetadata().getName() % " - " % mBoard.getName(),
-                        mBoard.getUuid(), mProject.getMetadata().getVersion());
-    drawLayer(gen, GraphicsLayer::sBoardOutlines);
-    gen.generate();
-    gen.saveToFile(getOutputFilePath("OUTLINES.gbr"));
+    return drills;
 }
 
-void BoardGerberExport::exportLayerTopCopper() const
+BoardGerberExport::LayerBuckets BoardGerberExport::collectPrimitives() const
 {
-    GerberGenerator gen(mProject.getMetadata().getName() % " - " % mBoard.getName(),
-                        mBoard.getUuid(), mProject.getMetadata().getVersion());
-    drawLayer(gen, GraphicsLayer::sTopCopper);
-    gen.generate();
-    gen.saveToFile(getOutputFilePath("COPPER-TOP.gbr"));
-}
-
-void BoardGerberExport::exportLayerTopSolderMask() const
-{
-    GerberGenerator gen(mProject.getMetadata().getName() % " - " % mBoard.getName(),
-                        mBoard.getUuid(), mProject.getMetadata().getVersion());
-    drawLayer(gen, GraphicsLayer::sTopStopMask);
-    gen.generate();
-    gen.saveToFile(getOutputFilePath("SOLDERMASK-TOP.gbr"));
-}
-
-void BoardGerberExport::exportLayerTopSilkscreen() const
-{
-    GerberGenerator gen(mProject.getMetadata().getName() % " - " % mBoard.getName(),
-                        mBoard.getUuid(), mProject.getMetadata().getVersion());
-    drawLayer(gen, GraphicsLayer::sTopPlacement);
-    drawLayer(gen, GraphicsLayer::sTopNames);
-    gen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
-    drawLayer(gen, GraphicsLayer::sTopStopMask);
-    gen.generate();
-    gen.saveToFile(getOutputFilePath("SILKSCREEN-TOP.gbr"));
-}
-
-void BoardGerberExport::exportLayerBottomCopper() const
-{
-    GerberGenerator gen(mProject.getMetadata().getName() % " - " % mBoard.getName(),
-                        mBoard.getUuid(), mProject.getMetadata().getVersion());
-    drawLayer(gen, GraphicsLayer::sBotCopper);
-    gen.generate();
-    gen.saveToFile(getOutputFilePath("COPPER-BOTTOM.gbr"));
-}
-
-void BoardGerberExport::exportLayerBottomSolderMask() const
-{
-    GerberGenerator gen(mProject.getMetadata().getName() % " - " % mBoard.getName(),
-                        mBoard.getUuid(), mProject.getMetadata().getVersion());
-    drawLayer(gen, GraphicsLayer::sBotStopMask);
-    gen.generate();
-    gen.saveToFile(getOutputFilePath("SOLDERMASK-BOTTOM.gbr"));
-}
-
-void BoardGerberExport::exportLayerBottomSilkscreen() const
-{
-    GerberGenerator gen(mProject.getMetadata().getName() % " - " % mBoard.getName(),
-                        mBoard.getUuid(), mProject.getMetadata().getVersion());
-    drawLayer(gen, GraphicsLayer::sBotPlacement);
-    drawLayer(gen, GraphicsLayer::sBotNames);
-    gen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
-    drawLayer(gen, GraphicsLayer::sBotStopMask);
-    gen.generate();
-    gen.saveToFile(getOutputFilePath("SILKSCREEN-BOTTOM.gbr"));
-}
+    LayerBuckets buckets;
+    foreach (const QString& layerName, getExportedLayerNames()) {
+        buckets.insert(layerName, LayerBucket());
+    }
 
-void BoardGerberExport::drawLayer(GerberGenerator& gen, const QString& layerName) const
-{
-    // draw footprints incl. pads
+    // footprints incl. pads
     foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
         Q_ASSERT(device);
-        drawFootprint(gen, device->getFootprint(), layerName);
+        collectFootprint(buckets, device->getFootprint());
     }
 
-    // draw vias
+    // vias
     foreach (const BI_NetSegment* netsegment, mBoard.getNetSegments()) {
         Q_ASSERT(netsegment);
         foreach (const BI_Via* via, netsegment->getVias()) {
             Q_ASSERT(via);
-            drawVia(gen, *via, layerName);
+            collectVia(buckets, *via);
         }
     }
 
-    // draw traces
+    // traces
     foreach (const BI_NetSegment* netsegment, mBoard.getNetSegments()) {
         Q_ASSERT(netsegment);
         foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
             Q_ASSERT(netline);
-            if (netline->getLayer().getName() == layerName) {
-                gen.drawLine(netline->getStartPoint().getPosition(),
-                             netline->getEndPoint().getPosition(),
-                             netline->getWidth());
-            }
+            Point start = netline->getStartPoint().getPosition();
+            Point end = netline->getEndPoint().getPosition();
+            Length width = netline->getWidth();
+            addPrimitive(buckets, netline->getLayer().getName(),
+                         [start, end, width](GerberGenerator& gen){
+                gen.drawLine(start, end, width);
+            });
         }
     }
 
-    // draw polygons
+    // polygons
     foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
         Q_ASSERT(polygon);
-        if (layerName == polygon->getPolygon().getLayerName()) {
-            Length lineWidth = calcWidthOfLayer(polygon->getPolygon().getLineWidth(), layerName);
-            gen.drawPathOutline(polygon->getPolygon().getPath(), lineWidth);
+        const QString& layerName = polygon->getPolygon().getLayerName();
+        Path path = polygon->getPolygon().getPath();
+        Length lineWidth = calcWidthOfLayer(polygon->getPolygon().getLineWidth(), layerName);
+        addPrimitive(buckets, layerName, [path, lineWidth](GerberGenerator& gen){
+            gen.drawPathOutline(path, lineWidth);
+        });
+    }
+
+    // plane fragments
+    foreach (const BI_Plane* plane, mBoard.getPlanes()) {
+        Q_ASSERT(plane);
+        foreach (const Path& fragment, plane->getFragments()) {
+            addArea(buckets, plane->getLayerName(), fragment);
         }
     }
+
+    return buckets;
 }
 
-void BoardGerberExport::drawVia(GerberGenerator& gen, const BI_Via& via, const QString& layerName) const
+void BoardGerberExport::collectVia(LayerBuckets& buckets, const BI_Via& via) const
 {
-    bool drawCopper = via.isOnLayer(layerName);
-    bool drawStopMask = (layerName == GraphicsLayer::sTopStopMask || layerName == GraphicsLayer::sBotStopMask)
-                        && mBoard.getDesignRules().doesViaRequireStopMask(via.getDrillDiameter());
-    if (drawCopper || drawStopMask) {
+    for (auto it = buckets.begin(); it != buckets.end(); ++it) {
+        const QString& layerName = it.key();
+        bool drawCopper = via.isOnLayer(layerName);
+        bool drawStopMask = (layerName == GraphicsLayer::sTopStopMask || layerName == GraphicsLayer::sBotStopMask)
+                            && mBoard.getDesignRules().doesViaRequireStopMask(via.getDrillDiameter());
+        if (!drawCopper && !drawStopMask) {
+            continue;
+        }
+        Point pos = via.getPosition();
         Length outerDiameter = via.getSize();
         if (drawStopMask) {
             outerDiameter += mBoard.getDesignRules().calcStopMaskClearance(via.getSize()) * 2;
@@ -231,17 +296,21 @@ void BoardGerberExport::drawVia(GerberGenerator& gen, const BI_Via& via, const Q
         switch (via.getShape())
         {
             case BI_Via::Shape::Round: {
-                gen.flashCircle(via.getPosition(), outerDiameter, Length(0));
+                it->primitives.append([pos, outerDiameter](GerberGenerator& gen){
+                    gen.flashCircle(pos, outerDiameter, Length(0));
+                });
                 break;
             }
             case BI_Via::Shape::Square: {
-                gen.flashRect(via.getPosition(), outerDiameter, outerDiameter,
-                              Angle::deg0(), Length(0));
+                it->primitives.append([pos, outerDiameter](GerberGenerator& gen){
+                    gen.flashRect(pos, outerDiameter, outerDiameter, Angle::deg0(), Length(0));
+                });
                 break;
             }
             case BI_Via::Shape::Octagon: {
-                gen.flashRegularPolygon(via.getPosition(), outerDiameter, 8,
-                                        Angle::deg0(), Length(0));
+                it->primitives.append([pos, outerDiameter](GerberGenerator& gen){
+                    gen.flashRegularPolygon(pos, outerDiameter, 8, Angle::deg0(), Length(0));
+                });
                 break;
             }
             default: {
@@ -251,111 +320,294 @@ void BoardGerberExport::drawVia(GerberGenerator& gen, const BI_Via& via, const Q
     }
 }
 
-void BoardGerberExport::drawFootprint(GerberGenerator& gen, const BI_Footprint& footprint, const QString& layerName) const
+void BoardGerberExport::collectFootprint(LayerBuckets& buckets, const BI_Footprint& footprint) const
 {
-    // draw pads
+    // pads
     foreach (const BI_FootprintPad* pad, footprint.getPads()) {
-        drawFootprintPad(gen, *pad, layerName);
+        collectFootprintPad(buckets, *pad);
     }
 
-    // draw polygons
+    // the transformation (and the mirroring of layers) is the same for all primitives
+    bool mirrored = footprint.getIsMirrored();
+    Angle rotation = mirrored ? -footprint.getRotation() : footprint.getRotation();
+
+    // polygons
     for (const Polygon& polygon : footprint.getLibFootprint().getPolygons()) {
-        QString layer = footprint.getIsMirrored() ? GraphicsLayer::getMirroredLayerName(layerName) : layerName;
-        if (layer == polygon.getLayerName()) {
-            Path path = polygon.getPath();
-            if (footprint.getIsMirrored()) path.mirror(Qt::Horizontal);
-            path.rotate(footprint.getIsMirrored() ? -footprint.getRotation() : footprint.getRotation());
-            path.translate(footprint.getPosition());
-            gen.drawPathOutline(path, calcWidthOfLayer(polygon.getLineWidth(), layer));
-            if (polygon.isFilled()) {
-                gen.drawPathArea(path);
-            }
+        const QString& libLayerName = polygon.getLayerName();
+        QString layerName = mirrored ? GraphicsLayer::getMirroredLayerName(libLayerName) : libLayerName;
+        if (!buckets.contains(layerName)) continue;
+        Path path = polygon.getPath();
+        if (mirrored) path.mirror(Qt::Horizontal);
+        path.rotate(rotation);
+        path.translate(footprint.getPosition());
+        Length lineWidth = calcWidthOfLayer(polygon.getLineWidth(), libLayerName);
+        addPrimitive(buckets, layerName, [path, lineWidth](GerberGenerator& gen){
+            gen.drawPathOutline(path, lineWidth);
+        });
+        if (polygon.isFilled()) {
+            addArea(buckets, layerName, path);
         }
     }
 
-    // draw ellipses
+    // ellipses
     for (const Ellipse& ellipse : footprint.getLibFootprint().getEllipses()) {
-        QString layer = footprint.getIsMirrored() ? GraphicsLayer::getMirroredLayerName(layerName) : layerName;
-        if (layer == ellipse.getLayerName()) {
-            Ellipse e = ellipse;
-            if (footprint.getIsMirrored()) e.setCenter(e.getCenter().mirrored(Qt::Horizontal));
-            e.rotate(footprint.getIsMirrored() ? -footprint.getRotation() : footprint.getRotation());
-            e.translate(footprint.getPosition());
-            e.setLineWidth(calcWidthOfLayer(e.getLineWidth(), layer));
+        const QString& libLayerName = ellipse.getLayerName();
+        QString layerName = mirrored ? GraphicsLayer::getMirroredLayerName(libLayerName) : libLayerName;
+        if (!buckets.contains(layerName)) continue;
+        Ellipse e = ellipse;
+        if (mirrored) e.setCenter(e.getCenter().mirrored(Qt::Horizontal));
+        e.rotate(rotation);
+        e.translate(footprint.getPosition());
+        e.setLineWidth(calcWidthOfLayer(e.getLineWidth(), libLayerName));
+        addPrimitive(buckets, layerName, [e](GerberGenerator& gen){
             gen.drawEllipseOutline(e);
             if (e.isFilled()) {
                 gen.drawEllipseArea(e);
             }
-        }
+        });
     }
 
     // TODO: draw texts
 
-    // draw holes
+    // holes (drawn on all layers)
     for (const Hole& hole : footprint.getLibFootprint().getHoles()) {
-        gen.flashCircle(footprint.mapToScene(hole.getPosition()), hole.getDiameter(), Length(0));
+        Point pos = footprint.mapToScene(hole.getPosition());
+        Length diameter = hole.getDiameter();
+        for (auto it = buckets.begin(); it != buckets.end(); ++it) {
+            it->primitives.append([pos, diameter](GerberGenerator& gen){
+                gen.flashCircle(pos, diameter, Length(0));
+            });
+        }
     }
 }
 
-void BoardGerberExport::drawFootprintPad(GerberGenerator& gen, const BI_FootprintPad& pad, const QString& layerName) const
+void BoardGerberExport::collectFootprintPad(LayerBuckets& buckets, const BI_FootprintPad& pad) const
 {
-    bool isOnCopperLayer = pad.isOnLayer(layerName);
-    bool isOnSolderMaskTop = pad.isOnLayer(GraphicsLayer::sTopCopper) && (layerName == GraphicsLayer::sTopStopMask);
-    bool isOnSolderMaskBottom = pad.isOnLayer(GraphicsLayer::sBotCopper) && (layerName == GraphicsLayer::sBotStopMask);
-    if (!isOnCopperLayer && !isOnSolderMaskTop && !isOnSolderMaskBottom) {
-        return;
-    }
-
-    Angle rot = pad.getIsMirrored() ? -pad.getRotation() : pad.getRotation();
     const library::FootprintPad& libPad = pad.getLibPad();
-    Length width = libPad.getWidth();
-    Length height = libPad.getHeight();
-    if (isOnSolderMaskTop || isOnSolderMaskBottom) {
-        Length size = qMin(width, height);
-        Length clearance = mBoard.getDesignRules().calcStopMaskClearance(size);
-        width += clearance*2;
-        height += clearance*2;
-    }
-
-    switch (libPad.getShape())
-    {
-        case library::FootprintPad::Shape::ROUND: {
-            if (width == height) {
-                gen.flashCircle(pad.getPosition(), width, Length(0));
-            } else {
-                gen.flashObround(pad.getPosition(), width, height, rot, Length(0));
-            }
-            break;
+    Point pos = pad.getPosition();
+    Angle rot = pad.getIsMirrored() ? -pad.getRotation() : pad.getRotation();
+    bool isOnTopCopper = pad.isOnLayer(GraphicsLayer::sTopCopper);
+    bool isOnBottomCopper = pad.isOnLayer(GraphicsLayer::sBotCopper);
+
+    for (auto it = buckets.begin(); it != buckets.end(); ++it) {
+        const QString& layerName = it.key();
+        bool isOnCopperLayer = pad.isOnLayer(layerName);
+        bool isOnSolderMaskTop = isOnTopCopper && (layerName == GraphicsLayer::sTopStopMask);
+        bool isOnSolderMaskBottom = isOnBottomCopper && (layerName == GraphicsLayer::sBotStopMask);
+        if (!isOnCopperLayer && !isOnSolderMaskTop && !isOnSolderMaskBottom) {
+            continue;
         }
-        case library::FootprintPad::Shape::RECT: {
-            gen.flashRect(pad.getPosition(), width, height, rot, Length(0));
-            break;
+
+        Length width = libPad.getWidth();
+        Length height = libPad.getHeight();
+        if (isOnSolderMaskTop || isOnSolderMaskBottom) {
+            Length size = qMin(width, height);
+            Length clearance = mBoard.getDesignRules().calcStopMaskClearance(size);
+            width += clearance*2;
+            height += clearance*2;
         }
-        case library::FootprintPad::Shape::OCTAGON: {
-            if (width != height) {
-                throw LogicError(__FILE__, __LINE__,
-                    tr("Sorry, non-square octagons are not yet supported."));
+
+        switch (libPad.getShape())
+        {
+            case library::FootprintPad::Shape::ROUND: {
+                if (width == height) {
+                    it->primitives.append([pos, width](GerberGenerator& gen){
+                        gen.flashCircle(pos, width, Length(0));
+                    });
+                } else {
+                    it->primitives.append([pos, width, height, rot](GerberGenerator& gen){
+                        gen.flashObround(pos, width, height, rot, Length(0));
+                    });
+                }
+                break;
+            }
+            case library::FootprintPad::Shape::RECT: {
+                it->primitives.append([pos, width, height, rot](GerberGenerator& gen){
+                    gen.flashRect(pos, width, height, rot, Length(0));
+                });
+                break;
+            }
+            case library::FootprintPad::Shape::OCTAGON: {
+                if (width != height) {
+                    throw LogicError(__FILE__, __LINE__,
+                        tr("Sorry, non-square octagons are not yet supported."));
+                }
+                it->primitives.append([pos, width, rot](GerberGenerator& gen){
+                    gen.flashRegularPolygon(pos, width, 8, rot, Length(0));
+                });
+                break;
+            }
+            default: {
+                throw LogicError(__FILE__, __LINE__);
             }
-            gen.flashRegularPolygon(pad.getPosition(), width, 8, rot, Length(0));
-            break;
-        }
-        default: {
-            throw LogicError(__FILE__, __LINE__);
         }
     }
 }
 
-FilePath BoardGerberExport::getOutputFilePath(const QString& suffix) const noexcept
-{
-    QString projectName = FilePath::cleanFileName(mProject.getMetadata().getName(),
-                          FilePath::ReplaceSpaces | FilePath::KeepCase);
-    return mOutputDirectory.getPathTo(projectName % "_" % suffix);
-}
-
 /*****************************************************************************************
  *  Static Methods
  ****************************************************************************************/
 
+void BoardGerberExport::exportDrillsPTH(const Snapshot& snapshot, DrillStatistics& statistics)
+{
+    ExcellonGenerator gen;
+    gen.setStepAndRepeat(snapshot.panelColumns, snapshot.panelRows, snapshot.panelStep);
+    foreach (const auto& drill, snapshot.drills) {
+        gen.drill(drill.first, drill.second);
+    }
+    gen.generate();
+    gen.saveToFile(getOutputFilePath(snapshot, "DRILLS-PTH.drl"));
+    statistics = DrillStatistics{gen.getHoleCount(), gen.getUnoptimizedPathLength(),
+                                 gen.getOptimizedPathLength(), gen.getOptimizationTimeMs()};
+}
+
+void BoardGerberExport::exportLayerBoardOutlines(const Snapshot& snapshot)
+{
+    GerberGenerator gen(snapshot.title, snapshot.boardUuid, snapshot.version);
+    beginPanel(gen, snapshot);
+    drawLayer(gen, snapshot, GraphicsLayer::sBoardOutlines);
+    endPanel(gen, snapshot);
+    Length lineWidth = calcWidthOfLayer(Length(0), GraphicsLayer::sBoardOutlines);
+    foreach (const Path& outline, snapshot.panelOutlines) {
+        gen.drawPathOutline(outline, lineWidth);
+    }
+    gen.generate();
+    gen.saveToFile(getOutputFilePath(snapshot, "OUTLINES.gbr"));
+}
+
+void BoardGerberExport::exportLayerTopCopper(const Snapshot& snapshot)
+{
+    GerberGenerator gen(snapshot.title, snapshot.boardUuid, snapshot.version);
+    beginPanel(gen, snapshot);
+    drawLayer(gen, snapshot, GraphicsLayer::sTopCopper);
+    endPanel(gen, snapshot);
+    gen.generate();
+    gen.saveToFile(getOutputFilePath(snapshot, "COPPER-TOP.gbr"));
+}
+
+void BoardGerberExport::exportLayerTopSolderMask(const Snapshot& snapshot)
+{
+    GerberGenerator gen(snapshot.title, snapshot.boardUuid, snapshot.version);
+    beginPanel(gen, snapshot);
+    drawLayer(gen, snapshot, GraphicsLayer::sTopStopMask);
+    endPanel(gen, snapshot);
+    gen.generate();
+    gen.saveToFile(getOutputFilePath(snapshot, "SOLDERMASK-TOP.gbr"));
+}
+
+void BoardGerberExport::exportLayerTopSilkscreen(const Snapshot& snapshot)
+{
+    GerberGenerator gen(snapshot.title, snapshot.boardUuid, snapshot.version);
+    beginPanel(gen, snapshot);
+    drawLayer(gen, snapshot, GraphicsLayer::sTopPlacement);
+    drawLayer(gen, snapshot, GraphicsLayer::sTopNames);
+    gen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
+    drawLayer(gen, snapshot, GraphicsLayer::sTopStopMask);
+    endPanel(gen, snapshot);
+    gen.generate();
+    gen.saveToFile(getOutputFilePath(snapshot, "SILKSCREEN-TOP.gbr"));
+}
+
+void BoardGerberExport::exportLayerBottomCopper(const Snapshot& snapshot)
+{
+    GerberGenerator gen(snapshot.title, snapshot.boardUuid, snapshot.version);
+    beginPanel(gen, snapshot);
+    drawLayer(gen, snapshot, GraphicsLayer::sBotCopper);
+    endPanel(gen, snapshot);
+    gen.generate();
+    gen.saveToFile(getOutputFilePath(snapshot, "COPPER-BOTTOM.gbr"));
+}
+
+void BoardGerberExport::exportLayerBottomSolderMask(const Snapshot& snapshot)
+{
+    GerberGenerator gen(snapshot.title, snapshot.boardUuid, snapshot.version);
+    beginPanel(gen, snapshot);
+    drawLayer(gen, snapshot, GraphicsLayer::sBotStopMask);
+    endPanel(gen, snapshot);
+    gen.generate();
+    gen.saveToFile(getOutputFilePath(snapshot, "SOLDERMASK-BOTTOM.gbr"));
+}
+
+void BoardGerberExport::exportLayerBottomSilkscreen(const Snapshot& snapshot)
+{
+    GerberGenerator gen(snapshot.title, snapshot.boardUuid, snapshot.version);
+    beginPanel(gen, snapshot);
+    drawLayer(gen, snapshot, GraphicsLayer::sBotPlacement);
+    drawLayer(gen, snapshot, GraphicsLayer::sBotNames);
+    gen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
+    drawLayer(gen, snapshot, GraphicsLayer::sBotStopMask);
+    endPanel(gen, snapshot);
+    gen.generate();
+    gen.saveToFile(getOutputFilePath(snapshot, "SILKSCREEN-BOTTOM.gbr"));
+}
+
+void BoardGerberExport::drawLayer(GerberGenerator& gen, const Snapshot& snapshot,
+                                  const QString& layerName)
+{
+    Q_ASSERT(snapshot.layers.contains(layerName));
+    const LayerBucket bucket = snapshot.layers.value(layerName);
+    // all areas have the same polarity, so their order doesn't matter
+    foreach (const Path& area, bucket.areas) {
+        gen.drawPathArea(area);
+    }
+    foreach (const DrawFunction& draw, bucket.primitives) {
+        draw(gen);
+    }
+}
+
+void BoardGerberExport::beginPanel(GerberGenerator& gen, const Snapshot& snapshot) noexcept
+{
+    if ((snapshot.panelColumns > 1) || (snapshot.panelRows > 1)) {
+        gen.beginStepAndRepeat(snapshot.panelColumns, snapshot.panelRows, snapshot.panelStep);
+    }
+}
+
+void BoardGerberExport::endPanel(GerberGenerator& gen, const Snapshot& snapshot) noexcept
+{
+    if ((snapshot.panelColumns > 1) || (snapshot.panelRows > 1)) {
+        gen.endStepAndRepeat();
+    }
+}
+
+FilePath BoardGerberExport::getOutputFilePath(const Snapshot& snapshot,
+                                              const QString& suffix) noexcept
+{
+    return snapshot.outputDirectory.getPathTo(snapshot.fileBaseName % "_" % suffix);
+}
+
+bool BoardGerberExport::runJob(const Job& job)
+{
+    job(); // can throw
+    return true;
+}
+
+QStringList BoardGerberExport::getExportedLayerNames() noexcept
+{
+    return QStringList{GraphicsLayer::sBoardOutlines,
+                       GraphicsLayer::sTopCopper, GraphicsLayer::sTopStopMask,
+                       GraphicsLayer::sTopPlacement, GraphicsLayer::sTopNames,
+                       GraphicsLayer::sBotCopper, GraphicsLayer::sBotStopMask,
+                       GraphicsLayer::sBotPlacement, GraphicsLayer::sBotNames};
+}
+
+void BoardGerberExport::addPrimitive(LayerBuckets& buckets, const QString& layerName,
+                                     const DrawFunction& draw) noexcept
+{
+    auto it = buckets.find(layerName);
+    if (it != buckets.end()) {
+        it->primitives.append(draw);
+    }
+}
+
+void BoardGerberExport::addArea(LayerBuckets& buckets, const QString& layerName,
+                                const Path& area) noexcept
+{
+    auto it = buckets.find(layerName);
+    if (it != buckets.end()) {
+        it->areas.append(area);
+    }
+}
+
 Length BoardGerberExport::calcWidthOfLayer(const Length& width, const QString& name) noexcept
 {
     if ((name == GraphicsLayer::sBoardOutlines) && (width < Length(1000))) {
@@ -24,9 +24,12 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <functional>
 #include <librepcb/common/exceptions.h>
 #include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/geometry/path.h>
 #include <librepcb/common/units/all_length_units.h>
+#include <librepcb/common/uuid.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -52,6 +55,17 @@ class BI_FootprintPad;
 /**
  * @brief The BoardGerberExport class
  *
+ * All primitives of the board are sorted into per-layer buckets in a single pass
+ * (see #collectPrimitives()) before any Gerber file is generated, so the export time
+ * doesn't grow with the number of exported layers. The files are then generated in
+ * parallel from these buckets, without accessing the board anymore.
+ *
+ * Optionally, a panel with several copies of the board can be exported (see
+ * #setPanelSettings()). Every layer of the board is still written only once, wrapped
+ * into a Gerber step and repeat block, and the drills are repeated as Excellon patterns.
+ * So panels are exported in the same time and with about the same file sizes as a
+ * single board.
+ *
  * @author ubruhin
  * @date 2016-01-10
  */
@@ -61,39 +75,162 @@ class BoardGerberExport final : public QObject
 
     public:
 
+        // Types
+
+        /**
+         * @brief The layout of an exported panel
+         *
+         * The copies of the board are arranged in a grid, separated by the spacing. The
+         * rails are added at the top and the bottom of the panel, separated from the
+         * boards by the spacing as well.
+         */
+        struct PanelSettings {
+            int columns;        ///< count of copies in X direction
+            int rows;           ///< count of copies in Y direction
+            Length spacing;     ///< gap between the board outlines
+            Length railWidth;   ///< zero to not add rails
+        };
+
+        /**
+         * @brief Statistics of the drill path optimization (see librepcb::ExcellonGenerator)
+         */
+        struct DrillStatistics {
+            int holeCount;                  ///< holes of a single copy of the board
+            Length unoptimizedPathLength;   ///< travel distance without optimization
+            Length optimizedPathLength;     ///< travel distance of the written file
+            qint64 optimizationTimeMs;
+        };
+
         // Constructors / Destructor
         BoardGerberExport() = delete;
         BoardGerberExport(const BoardGerberExport& other) = delete;
         BoardGerberExport(const Board& board, const FilePath& outputDir) noexcept;
         ~BoardGerberExport() noexcept;
 
+        // Getters
+        const PanelSettings& getPanelSettings() const noexcept {return mPanelSettings;}
+
+        /**
+         * @brief Get the drill statistics of the last export
+         *
+         * @warning The statistics are only valid after the future returned by
+         *          #startExport() has finished.
+         */
+        DrillStatistics getDrillStatistics() const noexcept {return *mDrillStatistics;}
+
+        // Setters
+
+        /**
+         * @brief Export a panel instead of a single board
+         *
+         * The default settings (one column, one row, no rails) export a single board.
+         */
+        void setPanelSettings(const PanelSettings& settings) noexcept {mPanelSettings = settings;}
+
         // General Methods
+
+        /**
+         * @brief Export all layers and wait until all files are written
+         *
+         * @throw Exception If a file could not be generated or saved
+         */
         void exportAllLayers() const;
 
+        /**
+         * @brief Start exporting all layers in the global thread pool
+         *
+         * The board is only accessed in this method: all primitives are collected into
+         * a snapshot, the returned future then generates and saves the files of the
+         * snapshot concurrently. Its progress range is the count of files, it can be
+         * canceled and QFuture::waitForFinished() rethrows errors of the export.
+         *
+         * @throw Exception If the panel settings are invalid, or if a panel should be
+         *                  exported but the board has no outline
+         */
+        QFuture<void> startExport() const;
+
         // Operator Overloadings
         BoardGerberExport& operator=(const BoardGerberExport& rhs) = delete;
 
 
     private:
 
+        // Types
+
+        /**
+         * @brief A primitive to draw, captures all its data by value
+         */
+        typedef std::function<void(GerberGenerator& gen)> DrawFunction;
+
+        /**
+         * @brief The primitives of a layer
+         *
+         * Filled areas are kept separately to draw all of them in a row, so the Gerber
+         * generator can put them into a single region.
+         */
+        struct LayerBucket {
+            QVector<Path> areas;
+            QVector<DrawFunction> primitives;
+        };
+
+        /**
+         * @brief The primitives of all exported layers (key: layer name)
+         */
+        typedef QHash<QString, LayerBucket> LayerBuckets;
+
+        /**
+         * @brief All data needed to generate the files (independent of the board)
+         */
+        struct Snapshot {
+            QString title;                          ///< project and board name
+            Uuid boardUuid;
+            QString version;                        ///< project version
+            FilePath outputDirectory;
+            QString fileBaseName;                   ///< cleaned project name
+            QVector<QPair<Point, Length>> drills;   ///< position and diameter
+            LayerBuckets layers;
+            int panelColumns;                       ///< 1 if no panel is exported
+            int panelRows;                          ///< 1 if no panel is exported
+            Point panelStep;                        ///< distance between the copies
+            QVector<Path> panelOutlines;            ///< rails (not repeated)
+        };
+
+        /**
+         * @brief Generates and saves one file
+         */
+        typedef std::function<void()> Job;
+
         // Private Methods
-        void exportDrillsPTH() const;
-        void exportLayerBoardOutlines() const;
-        void exportLayerTopCopper() const;
-        void exportLayerTopSolderMask() const;
-        void exportLayerTopSilkscreen() const;
-        void exportLayerBottomCopper() const;
-        void exportLayerBottomSolderMask() const;
-        void exportLayerBottomSilkscreen() const;
-
-        void drawLayer(GerberGenerator& gen, const QString& layerName) const;
-        void drawVia(GerberGenerator& gen, const BI_Via& via, const QString& layerName) const;
-        void drawFootprint(GerberGenerator& gen, const BI_Footprint& footprint, const QString& layerName) const;
-        void drawFootprintPad(GerberGenerator& gen, const BI_FootprintPad& pad, const QString& layerName) const;
-
-        FilePath getOutputFilePath(const QString& suffix) const noexcept;
+        QSharedPointer<const Snapshot> createSnapshot() const;
+        void setupPanel(Snapshot& snapshot) const;
+        bool calcBoardOutlineBoundingRect(Point& bottomLeft, Point& topRight) const noexcept;
+        QVector<QPair<Point, Length>> collectDrills() const;
+        LayerBuckets collectPrimitives() const;
+        void collectVia(LayerBuckets& buckets, const BI_Via& via) const;
+        void collectFootprint(LayerBuckets& buckets, const BI_Footprint& footprint) const;
+        void collectFootprintPad(LayerBuckets& buckets, const BI_FootprintPad& pad) const;
 
         // Static Methods
+        static void exportDrillsPTH(const Snapshot& snapshot, DrillStatistics& statistics);
+        static void exportLayerBoardOutlines(const Snapshot& snapshot);
+        static void exportLayerTopCopper(const Snapshot& snapshot);
+        static void exportLayerTopSolderMask(const Snapshot& snapshot);
+        static void exportLayerTopSilkscreen(const Snapshot& snapshot);
+        static void exportLayerBottomCopper(const Snapshot& snapshot);
+        static void exportLayerBottomSolderMask(const Snapshot& snapshot);
+        static void exportLayerBottomSilkscreen(const Snapshot& snapshot);
+        static void drawLayer(GerberGenerator& gen, const Snapshot& snapshot,
+                              const QString& layerName);
+        static void beginPanel(GerberGenerator& gen, const Snapshot& snapshot) noexcept;
+        static void endPanel(GerberGenerator& gen, const Snapshot& snapshot) noexcept;
+        static FilePath getOutputFilePath(const Snapshot& snapshot,
+                                          const QString& suffix) noexcept;
+        static bool runJob(const Job& job);
+        static QStringList getExportedLayerNames() noexcept;
+        static void addPrimitive(LayerBuckets& buckets, const QString& layerName,
+                                 const DrawFunction& draw) noexcept;
+        static void addArea(LayerBuckets& buckets, const QString& layerName,
+                            const Path& area) noexcept;
         static Length calcWidthOfLayer(const Length& width, const QString& name) noexcept;
 
 
@@ -101,6 +238,8 @@ class BoardGerberExport final : public QObject
         const Project& mProject;
         const Board& mBoard;
         FilePath mOutputDirectory;
+        PanelSettings mPanelSettings;
+        mutable QSharedPointer<DrillStatistics> mDrillStatistics; ///< written by the export
 };
 
 /*****************************************************************************************
@@ -0,0 +1,151 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "boardgraphicsbatcher.h"
+#include "board.h"
+#include "graphicsitems/bgi_base.h"
+#include "graphicsitems/bgi_batch.h"
+#include <librepcb/common/graphics/graphicsscene.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardGraphicsBatcher::BoardGraphicsBatcher(Board& board) noexcept :
+    mBoard(board), mEnabled(false)
+{
+}
+
+BoardGraphicsBatcher::~BoardGraphicsBatcher() noexcept
+{
+    Q_ASSERT(mItems.isEmpty());
+    foreach (BGI_Base* item, mItems.keys()) {
+        removeItem(*item);
+    }
+}
+
+/*****************************************************************************************
+ *  Setters
+ ****************************************************************************************/
+
+void BoardGraphicsBatcher::setEnabled(bool enabled) noexcept
+{
+    if (enabled == mEnabled) return;
+    QList<BGI_Base*> items = mItems.keys();
+    foreach (BGI_Base* item, items) {
+        removeFromScene(*item);
+    }
+    mEnabled = enabled;
+    foreach (BGI_Base* item, items) {
+        addToScene(*item);
+    }
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void BoardGraphicsBatcher::addItem(BGI_Base& item, bool batchable) noexcept
+{
+    Q_ASSERT(!mItems.contains(&item));
+    mItems.insert(&item, batchable);
+    addToScene(item);
+}
+
+void BoardGraphicsBatcher::removeItem(BGI_Base& item) noexcept
+{
+    Q_ASSERT(mItems.contains(&item));
+    removeFromScene(item);
+    mItems.remove(&item);
+}
+
+void BoardGraphicsBatcher::setBatchable(BGI_Base& item, bool batchable) noexcept
+{
+    if ((!mItems.contains(&item)) || (mItems.value(&item) == batchable)) return;
+    removeFromScene(item);
+    mItems.insert(&item, batchable);
+    addToScene(item);
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+bool BoardGraphicsBatcher::isBatched(BGI_Base& item) const noexcept
+{
+    return mEnabled && mItems.value(&item, false);
+}
+
+void BoardGraphicsBatcher::addToScene(BGI_Base& item) noexcept
+{
+    if (isBatched(item)) {
+        BatchKey key = getBatchKey(item);
+        BGI_Batch* batch = mBatches.value(key, nullptr);
+        if (!batch) {
+            batch = new BGI_Batch(mBoard, key.first);
+            mBatches.insert(key, batch);
+            mBoard.getGraphicsScene().addItem(*batch);
+        }
+        batch->addItem(item);
+    } else {
+        mBoard.getGraphicsScene().addItem(item);
+    }
+}
+
+void BoardGraphicsBatcher::removeFromScene(BGI_Base& item) noexcept
+{
+    BGI_Batch* batch = item.getBatch();
+    if (batch) {
+        batch->removeItem(item);
+        if (batch->isEmpty()) {
+            mBatches.remove(mBatches.key(batch));
+            mBoard.getGraphicsScene().removeItem(*batch);
+            delete batch;
+        }
+    } else {
+        mBoard.getGraphicsScene().removeItem(item);
+    }
+}
+
+BoardGraphicsBatcher::BatchKey BoardGraphicsBatcher::getBatchKey(const BGI_Base& item) const noexcept
+{
+    // the position of the item may change later, but that's not a problem since the
+    // batch updates its bounding rect accordingly (see BGI_Batch)
+    QPointF center = item.sceneBoundingRect().center();
+    return qMakePair(item.zValue(), qMakePair(qFloor(center.x() / sChunkSize),
+                                              qFloor(center.y() / sChunkSize)));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
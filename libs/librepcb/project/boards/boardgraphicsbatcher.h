@@ -0,0 +1,115 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_BOARDGRAPHICSBATCHER_H
+#define LIBREPCB_PROJECT_BOARDGRAPHICSBATCHER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class BGI_Base;
+class BGI_Batch;
+
+/*****************************************************************************************
+ *  Class BoardGraphicsBatcher
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardGraphicsBatcher class adds netlines and vias to the scene of a board
+ *
+ * Boards may contain thousands of netlines and vias, and painting each of them as a
+ * separate graphics item is expensive (many items to index and sort, one pen/brush change
+ * per item). If enabled, this class therefore doesn't add these items to the scene, but
+ * groups them by their z-value (i.e. their layer) and by area (chunks of #sChunkSize) into
+ * librepcb::project::BGI_Batch items which paint all their items at once.
+ *
+ * Items which need to be handled individually (e.g. selected items, which can be dragged
+ * around) can be excluded from batching with #setBatchable().
+ *
+ * @note Hit testing doesn't depend on the scene (see
+ *       librepcb::project::Board::getItemsAtScenePos()), so batched items stay fully
+ *       interactive. This also means that every item still owns its graphics item, so
+ *       batching reduces the painting time but not the memory usage.
+ */
+class BoardGraphicsBatcher final
+{
+    public:
+
+        // Constructors / Destructor
+        BoardGraphicsBatcher() = delete;
+        BoardGraphicsBatcher(const BoardGraphicsBatcher& other) = delete;
+        explicit BoardGraphicsBatcher(Board& board) noexcept;
+        ~BoardGraphicsBatcher() noexcept;
+
+        // Getters
+        bool isEnabled() const noexcept {return mEnabled;}
+        int getBatchCount() const noexcept {return mBatches.count();}
+
+        // Setters
+        void setEnabled(bool enabled) noexcept;
+
+        // General Methods
+        void addItem(BGI_Base& item, bool batchable) noexcept;
+        void removeItem(BGI_Base& item) noexcept;
+        void setBatchable(BGI_Base& item, bool batchable) noexcept;
+
+        // Operator Overloadings
+        BoardGraphicsBatcher& operator=(const BoardGraphicsBatcher& rhs) = delete;
+
+
+    private:
+
+        // Types
+        typedef QPair<qreal, QPair<int, int>> BatchKey; ///< z-value and chunk index
+
+        // Private Methods
+        bool isBatched(BGI_Base& item) const noexcept;
+        void addToScene(BGI_Base& item) noexcept;
+        void removeFromScene(BGI_Base& item) noexcept;
+        BatchKey getBatchKey(const BGI_Base& item) const noexcept;
+
+
+        // General Attributes
+        Board& mBoard;
+        bool mEnabled;
+        QHash<BGI_Base*, bool> mItems; ///< all added items and whether they are batchable
+        QHash<BatchKey, BGI_Batch*> mBatches;
+
+        // Static Variables
+        static constexpr qreal sChunkSize = 72; ///< 1 inch in scene pixels
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDGRAPHICSBATCHER_H
@@ -200,11 +200,13 @@ void BoardLayerStack::addAllLayers() noexcept
     addLayer(GraphicsLayer::sBoardDocumentation);
     addLayer(GraphicsLayer::sBoardComments);
     addLayer(GraphicsLayer::sBoardGuide);
+    addLayer(GraphicsLayer::sBoardAirWires);
 
 #ifdef QT_DEBUG
     // debug layers
     addLayer(GraphicsLayer::sDebugGraphicsItemsBoundingRects);
     addLayer(GraphicsLayer::sDebugGraphicsItemsTextsBoundingRects);
+    addLayer(GraphicsLayer::sDebugRepaintedRegions);
 #endif
 }
 
@@ -0,0 +1,313 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include "boardpainter.h"
+#include <librepcb/common/attributes/attributesubstitutor.h>
+#include <librepcb/common/boarddesignrules.h>
+#include <librepcb/common/geometry/ellipse.h>
+#include <librepcb/common/geometry/hole.h>
+#include <librepcb/common/geometry/polygon.h>
+#include <librepcb/common/geometry/text.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/library/pkg/footprint.h>
+#include <librepcb/library/pkg/footprintpad.h>
+#include "board.h"
+#include "boardlayerstack.h"
+#include "items/bi_device.h"
+#include "items/bi_footprint.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_netline.h"
+#include "items/bi_netpoint.h"
+#include "items/bi_netsegment.h"
+#include "items/bi_plane.h"
+#include "items/bi_polygon.h"
+#include "items/bi_via.h"
+#include "graphicsitems/bgi_base.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardPainter::BoardPainter(const Board& board) noexcept :
+    mBoard(board)
+{
+    // same font as used by librepcb::project::BGI_Footprint
+    mFont.setStyleStrategy(QFont::StyleStrategy(QFont::OpenGLCompatible | QFont::PreferQuality));
+    mFont.setStyleHint(QFont::SansSerif);
+    mFont.setFamily("Nimbus Sans L");
+}
+
+BoardPainter::~BoardPainter() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+GraphicsPrimitives BoardPainter::createPrimitives() const noexcept
+{
+    GraphicsPrimitives primitives;
+
+    // polygons
+    foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+        const Polygon& p = polygon->getPolygon();
+        addPolygon(primitives, Board::ZValue_Default, p, QTransform(),
+                   GraphicsLayer::getGrabAreaLayerName(p.getLayerName()), false);
+    }
+
+    // planes (only the filled fragments, the outline is just a hint for the user)
+    foreach (const BI_Plane* plane, mBoard.getPlanes()) {
+        const GraphicsLayer* layer = getLayer(plane->getLayerName());
+        if (!layer) continue;
+        QPainterPath path;
+        path.setFillRule(Qt::WindingFill);
+        foreach (const Path& fragment, plane->getFragments()) {
+            path.addPath(fragment.toQPainterPathPx());
+        }
+        qreal z = BGI_Base::getZValueOfCopperLayer(plane->getLayerName()) - 0.005;
+        primitives.addFill(z, layer->getColor(false), path);
+    }
+
+    // devices
+    foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+        addFootprint(primitives, device->getFootprint());
+        foreach (const BI_FootprintPad* pad, device->getFootprint().getPads()) {
+            addFootprintPad(primitives, *pad);
+        }
+    }
+
+    // traces and vias
+    foreach (const BI_NetSegment* netsegment, mBoard.getNetSegments()) {
+        addNetSegment(primitives, *netsegment);
+    }
+
+    return primitives;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void BoardPainter::addFootprint(GraphicsPrimitives& primitives,
+                                const BI_Footprint& footprint) const noexcept
+{
+    const library::Footprint& libFootprint = footprint.getLibFootprint();
+    bool mirror = footprint.getIsMirrored();
+    qreal z = mirror ? Board::ZValue_FootprintsBottom : Board::ZValue_FootprintsTop;
+
+    // same transformation as the graphics item, see BI_Footprint
+    QTransform transform = QTransform::fromTranslate(footprint.getPosition().toPxQPointF().x(),
+                                                     footprint.getPosition().toPxQPointF().y());
+    if (mirror) transform.scale(qreal(-1), qreal(1));
+    transform.rotate(-footprint.getRotation().toDeg());
+
+    for (const Polygon& polygon : libFootprint.getPolygons()) {
+        addPolygon(primitives, z, polygon, transform, GraphicsLayer::sTopGrabAreas, mirror);
+    }
+
+    for (const Ellipse& ellipse : libFootprint.getEllipses()) {
+        addEllipse(primitives, z, ellipse, transform, GraphicsLayer::sTopGrabAreas, mirror);
+    }
+
+    for (const Text& text : libFootprint.getTexts()) {
+        const GraphicsLayer* layer = getLayer(text.getLayerName(), mirror);
+        if (!layer) continue;
+        Angle absAngle = text.getRotation() + footprint.getRotation();
+        absAngle.mapTo180deg();
+        bool rotate180 = (absAngle <= -Angle::deg90() || absAngle > Angle::deg90());
+        QPainterPath path = GraphicsPrimitives::createTextPath(
+            AttributeSubstitutor::substitute(text.getText(), &footprint), mFont,
+            text.getHeight(), text.getAlign(), text.getPosition(), text.getRotation(),
+            rotate180);
+        primitives.addFill(z, layer->getColor(false), transform.map(path));
+    }
+
+    const GraphicsLayer* holeLayer = getLayer(GraphicsLayer::sBoardDrillsNpth, mirror);
+    if (holeLayer) {
+        for (const Hole& hole : libFootprint.getHoles()) {
+            qreal radius = (hole.getDiameter() / 2).toPx();
+            QPainterPath path;
+            path.addEllipse(hole.getPosition().toPxQPointF(), radius, radius);
+            primitives.addFill(z, holeLayer->getColor(false), transform.map(path));
+        }
+    }
+}
+
+void BoardPainter::addFootprintPad(GraphicsPrimitives& primitives,
+                                   const BI_FootprintPad& pad) const noexcept
+{
+    const library::FootprintPad& libPad = pad.getLibPad();
+    bool mirror = pad.getIsMirrored();
+    bool bottom = (libPad.getBoardSide() == library::FootprintPad::BoardSide::BOTTOM);
+    qreal z = (bottom != mirror) ? Board::ZValue_FootprintPadsBottom
+                                 : Board::ZValue_FootprintPadsTop;
+
+    // same transformation as the graphics item, see BI_FootprintPad
+    QTransform transform = QTransform::fromTranslate(pad.getPosition().toPxQPointF().x(),
+                                                     pad.getPosition().toPxQPointF().y());
+    if (mirror) transform.scale(qreal(-1), qreal(1));
+    transform.rotate(-pad.getRotation().toDeg());
+
+    // determine layers
+    const GraphicsLayer* topStopMask = nullptr;
+    const GraphicsLayer* botStopMask = nullptr;
+    const GraphicsLayer* topCreamMask = nullptr;
+    const GraphicsLayer* botCreamMask = nullptr;
+    if (libPad.getBoardSide() == library::FootprintPad::BoardSide::THT) {
+        topStopMask = getLayer(GraphicsLayer::sTopStopMask, mirror);
+        botStopMask = getLayer(GraphicsLayer::sBotStopMask, mirror);
+    } else if (bottom) {
+        botStopMask = getLayer(GraphicsLayer::sBotStopMask, mirror);
+        botCreamMask = getLayer(GraphicsLayer::sBotSolderPaste, mirror);
+    } else {
+        topStopMask = getLayer(GraphicsLayer::sTopStopMask, mirror);
+        topCreamMask = getLayer(GraphicsLayer::sTopSolderPaste, mirror);
+    }
+
+    // determine stop/cream mask clearance
+    Length size = qMin(libPad.getWidth(), libPad.getHeight());
+    Length stopMaskClearance = mBoard.getDesignRules().calcStopMaskClearance(size);
+    Length creamMaskClearance = -mBoard.getDesignRules().calcCreamMaskClearance(size);
+    QPainterPath stopMaskPath = transform.map(libPad.toMaskQPainterPathPx(stopMaskClearance));
+    QPainterPath creamMaskPath = transform.map(libPad.toMaskQPainterPathPx(creamMaskClearance));
+
+    // add primitives in the same order as BGI_FootprintPad paints them
+    if (botCreamMask) primitives.addFill(z, botCreamMask->getColor(false), creamMaskPath);
+    if (botStopMask) primitives.addFill(z, botStopMask->getColor(false), stopMaskPath);
+    if (const GraphicsLayer* layer = getLayer(libPad.getLayerName(), mirror)) {
+        primitives.addFill(z, layer->getColor(false), transform.map(libPad.toQPainterPathPx()));
+    }
+    if (topStopMask) primitives.addFill(z, topStopMask->getColor(false), stopMaskPath);
+    if (topCreamMask) primitives.addFill(z, topCreamMask->getColor(false), creamMaskPath);
+}
+
+void BoardPainter::addNetSegment(GraphicsPrimitives& primitives,
+                                 const BI_NetSegment& netsegment) const noexcept
+{
+    foreach (const BI_NetLine* netline, netsegment.getNetLines()) {
+        const GraphicsLayer* layer = getLayer(netline->getLayer().getName());
+        if (!layer) continue;
+        QPainterPath path;
+        path.moveTo(netline->getStartPoint().getPosition().toPxQPointF());
+        path.lineTo(netline->getEndPoint().getPosition().toPxQPointF());
+        primitives.addStroke(BGI_Base::getZValueOfCopperLayer(layer->getName()),
+                             layer->getColor(false), path, netline->getWidth().toPx());
+    }
+
+    const GraphicsLayer* viaLayer = getLayer(GraphicsLayer::sBoardViasTht);
+    const GraphicsLayer* topStopMask = getLayer(GraphicsLayer::sTopStopMask);
+    const GraphicsLayer* botStopMask = getLayer(GraphicsLayer::sBotStopMask);
+    foreach (const BI_Via* via, netsegment.getVias()) {
+        QTransform transform = QTransform::fromTranslate(via->getPosition().toPxQPointF().x(),
+                                                         via->getPosition().toPxQPointF().y());
+        QPainterPath stopMaskPath;
+        if (mBoard.getDesignRules().doesViaRequireStopMask(via->getDrillDiameter())) {
+            Length clearance = mBoard.getDesignRules().calcStopMaskClearance(via->getSize());
+            stopMaskPath = transform.map(via->toQPainterPathPx(clearance, false));
+        }
+        // add primitives in the same order as BGI_Via paints them
+        if (botStopMask) primitives.addFill(Board::ZValue_Vias, botStopMask->getColor(false), stopMaskPath);
+        if (viaLayer) {
+            primitives.addFill(Board::ZValue_Vias, viaLayer->getColor(false),
+                               transform.map(via->toQPainterPathPx(Length(0), true)));
+        }
+        if (topStopMask) primitives.addFill(Board::ZValue_Vias, topStopMask->getColor(false), stopMaskPath);
+    }
+}
+
+void BoardPainter::addPolygon(GraphicsPrimitives& primitives, qreal z, const Polygon& polygon,
+                              const QTransform& transform, const QString& grabAreaLayer,
+                              bool mirror) const noexcept
+{
+    const GraphicsLayer* layer = getLayer(polygon.getLayerName(), mirror);
+    if (!layer) return;
+
+    QPainterPath path = transform.map(polygon.getPath().toQPainterPathPx());
+    const GraphicsLayer* fillLayer = nullptr;
+    if (polygon.isFilled()) {
+        fillLayer = layer;
+    } else if (polygon.isGrabArea()) {
+        fillLayer = getLayer(grabAreaLayer, mirror);
+    }
+    if (fillLayer) {
+        primitives.addFill(z, fillLayer->getColor(false), path);
+    }
+    if (polygon.getLineWidth() > 0) {
+        primitives.addStroke(z, layer->getColor(false), path, polygon.getLineWidth().toPx());
+    }
+}
+
+void BoardPainter::addEllipse(GraphicsPrimitives& primitives, qreal z, const Ellipse& ellipse,
+                              const QTransform& transform, const QString& grabAreaLayer,
+                              bool mirror) const noexcept
+{
+    const GraphicsLayer* layer = getLayer(ellipse.getLayerName(), mirror);
+    if (!layer) return;
+
+    QTransform t = QTransform::fromTranslate(ellipse.getCenter().toPxQPointF().x(),
+                                             ellipse.getCenter().toPxQPointF().y());
+    t.rotate(-ellipse.getRotation().toDeg());
+    QPainterPath path;
+    path.addEllipse(QPointF(0, 0), ellipse.getRadiusX().toPx(), ellipse.getRadiusY().toPx());
+    path = (t * transform).map(path);
+
+    const GraphicsLayer* fillLayer = nullptr;
+    if (ellipse.isFilled()) {
+        fillLayer = layer;
+    } else if (ellipse.isGrabArea()) {
+        fillLayer = getLayer(grabAreaLayer, mirror);
+    }
+    if (fillLayer) {
+        primitives.addFill(z, fillLayer->getColor(false), path);
+    }
+    if (ellipse.getLineWidth() > 0) {
+        primitives.addStroke(z, layer->getColor(false), path, ellipse.getLineWidth().toPx());
+    }
+}
+
+const GraphicsLayer* BoardPainter::getLayer(QString name, bool mirror) const noexcept
+{
+    if (mirror) name = GraphicsLayer::getMirroredLayerName(name);
+    const GraphicsLayer* layer = mBoard.getLayerStack().getLayer(name);
+    if (!layer) return nullptr;
+    if (mLayers.isEmpty()) {
+        return layer->isVisible() ? layer : nullptr;
+    } else {
+        return mLayers.contains(name) ? layer : nullptr;
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,115 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDPAINTER_H
+#define LIBREPCB_PROJECT_BOARDPAINTER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include <librepcb/common/graphics/graphicsprimitives.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class Polygon;
+class Ellipse;
+class GraphicsLayer;
+
+namespace project {
+
+class Board;
+class BI_Footprint;
+class BI_FootprintPad;
+class BI_NetSegment;
+
+/*****************************************************************************************
+ *  Class BoardPainter
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardPainter class converts a board to librepcb::GraphicsPrimitives
+ *
+ * The primitives are built directly from the board items (not from the graphics scene)
+ * and look like the board in the editor, but without editor decorations like origin
+ * crosses, pad names, airwires or plane outlines. They can be rendered or exported with
+ * librepcb::GraphicsExport in any thread.
+ *
+ * @note #createPrimitives() must be called in the thread which owns the board.
+ */
+class BoardPainter final
+{
+    public:
+
+        // Constructors / Destructor
+        BoardPainter() = delete;
+        BoardPainter(const BoardPainter& other) = delete;
+        explicit BoardPainter(const Board& board) noexcept;
+        ~BoardPainter() noexcept;
+
+        // Setters
+
+        /**
+         * @brief Set the names of the layers to paint
+         *
+         * @param layers    The layer names, or an empty list to paint all visible layers
+         *                  (the default)
+         */
+        void setLayers(const QStringList& layers) noexcept {mLayers = layers;}
+
+        // General Methods
+        GraphicsPrimitives createPrimitives() const noexcept;
+
+        // Operator Overloadings
+        BoardPainter& operator=(const BoardPainter& rhs) = delete;
+
+
+    private:
+
+        // Private Methods
+        void addFootprint(GraphicsPrimitives& primitives, const BI_Footprint& footprint) const noexcept;
+        void addFootprintPad(GraphicsPrimitives& primitives, const BI_FootprintPad& pad) const noexcept;
+        void addNetSegment(GraphicsPrimitives& primitives, const BI_NetSegment& netsegment) const noexcept;
+        void addPolygon(GraphicsPrimitives& primitives, qreal z, const Polygon& polygon,
+                        const QTransform& transform, const QString& grabAreaLayer,
+                        bool mirror) const noexcept;
+        void addEllipse(GraphicsPrimitives& primitives, qreal z, const Ellipse& ellipse,
+                        const QTransform& transform, const QString& grabAreaLayer,
+                        bool mirror) const noexcept;
+        const GraphicsLayer* getLayer(QString name, bool mirror = false) const noexcept;
+
+
+        // Private Member Variables
+        const Board& mBoard;
+        QStringList mLayers;
+        QFont mFont;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDPAINTER_H
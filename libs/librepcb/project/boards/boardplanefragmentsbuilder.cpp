@@ -0,0 +1,355 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <algorithm>
+#include "boardplanefragmentsbuilder.h"
+#include <librepcb/common/geometry/hole.h>
+#include <librepcb/common/geometry/path.h>
+#include <librepcb/common/geometry/polygon.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/toolbox.h>
+#include <librepcb/library/pkg/footprint.h>
+#include <librepcb/library/pkg/footprintpad.h>
+#include "board.h"
+#include "items/bi_device.h"
+#include "items/bi_footprint.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_netline.h"
+#include "items/bi_netpoint.h"
+#include "items/bi_netsegment.h"
+#include "items/bi_plane.h"
+#include "items/bi_polygon.h"
+#include "items/bi_via.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Geometry Helpers
+ ****************************************************************************************/
+
+namespace {
+
+/// Number of vertices to approximate a circle with a maximum deviation of 5um
+int getCircleVertexCount(LengthBase_t radius) noexcept
+{
+    const qreal tolerance = 5000;
+    if (radius <= tolerance) {
+        return 8;
+    }
+    return qBound(8, qCeil(M_PI / qAcos(1 - tolerance / radius)), 64);
+}
+
+} // namespace
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardPlaneFragmentsBuilder::BoardPlaneFragmentsBuilder(const BI_Plane& plane) noexcept :
+    mLeft(0), mBottom(0), mRight(0), mTop(0), mClearance(plane.getMinClearance()),
+    mKeepOrphans(plane.getKeepOrphans()), mHash(QCryptographicHash::Md5)
+{
+    collectObjects(plane);
+    mInputHash = mHash.result();
+}
+
+BoardPlaneFragmentsBuilder::~BoardPlaneFragmentsBuilder() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+QVector<Path> BoardPlaneFragmentsBuilder::buildFragments() const noexcept
+{
+    int islandCount = 0;
+    QVector<PolygonClipper::Trapezoid> trapezoids = mClipper.execute(fillRule, &islandCount);
+
+    // only keep islands which contain at least one copper object of the plane's net
+    QVector<bool> keepIsland(islandCount, mKeepOrphans);
+    if (!mKeepOrphans) {
+        QVector<Point> anchors = mAnchors;
+        auto lessY = [](const Point& a, const Point& b) {return a.getY() < b.getY();};
+        std::sort(anchors.begin(), anchors.end(), lessY);
+        foreach (const PolygonClipper::Trapezoid& t, trapezoids) {
+            if (keepIsland.at(t.island)) continue;
+            auto it = std::lower_bound(anchors.constBegin(), anchors.constEnd(),
+                                       Point(0, t.bottom), lessY);
+            for (; (it != anchors.constEnd()) && (it->getY() <= t.top); ++it) {
+                if (t.contains(*it)) {
+                    keepIsland[t.island] = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    // every island becomes a single fragment, so there are no seams between the
+    // trapezoids in the Gerber output or when rendering it antialiased
+    QVector<PolygonClipper::Trapezoid> kept;
+    foreach (const PolygonClipper::Trapezoid& t, trapezoids) {
+        if (keepIsland.at(t.island)) {
+            kept.append(t);
+        }
+    }
+    QVector<Path> fragments;
+    foreach (const QVector<Point>& contour, PolygonClipper::mergeTrapezoids(kept)) {
+        Path path;
+        foreach (const Point& p, contour) {
+            path.addVertex(p);
+        }
+        path.close();
+        fragments.append(path);
+    }
+    return fragments;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void BoardPlaneFragmentsBuilder::collectObjects(const BI_Plane& plane) noexcept
+{
+    const Board& board = plane.getBoard();
+    const NetSignal* netsignal = &plane.getNetSignal();
+    const QString& layer = plane.getLayerName();
+    BI_Plane::ConnectStyle style = plane.getConnectStyle();
+
+    // the outline determines the area of interest, everything outside is ignored
+    QVector<Point> outline = Toolbox::flattenedPath(plane.getOutline());
+    if (outline.isEmpty()) {
+        return;
+    }
+    mLeft = mRight = outline.first().getX().toNm();
+    mBottom = mTop = outline.first().getY().toNm();
+    foreach (const Point& p, outline) {
+        mLeft = qMin(mLeft, p.getX().toNm());
+        mRight = qMax(mRight, p.getX().toNm());
+        mBottom = qMin(mBottom, p.getY().toNm());
+        mTop = qMax(mTop, p.getY().toNm());
+    }
+    addPolygon(outline, Outline);
+    mHash.addData(mKeepOrphans ? "1" : "0", 1);
+
+    // pads and holes
+    foreach (const BI_Device* device, board.getDeviceInstances()) {
+        const BI_Footprint& footprint = device->getFootprint();
+        foreach (const BI_FootprintPad* pad, footprint.getPads()) {
+            if (!pad->isOnLayer(layer)) continue;
+            const library::FootprintPad& libPad = pad->getLibPad();
+            Length width = libPad.getWidth();
+            Length height = libPad.getHeight();
+            QVector<Point> points;
+            Length radius(0);
+            switch (libPad.getShape()) {
+                case library::FootprintPad::Shape::ROUND: {
+                    Length diameter = qMin(width, height);
+                    Length offset = (qMax(width, height) - diameter) / 2;
+                    radius = diameter / 2;
+                    if (width > height) {
+                        points = {Point(-offset, 0), Point(offset, 0)};
+                    } else {
+                        points = {Point(0, -offset), Point(0, offset)};
+                    }
+                    break;
+                }
+                case library::FootprintPad::Shape::RECT:
+                    points = Toolbox::flattenedPath(Path::centeredRect(width, height));
+                    break;
+                case library::FootprintPad::Shape::OCTAGON:
+                    points = Toolbox::flattenedPath(Path::octagon(width, height));
+                    break;
+            }
+            Angle rot = pad->getIsMirrored() ? -pad->getRotation() : pad->getRotation();
+            for (Point& p : points) {
+                p = p.rotated(rot) + pad->getPosition();
+            }
+            if ((pad->getCompSigInstNetSignal() != netsignal) || (style == BI_Plane::ConnectStyle::None)) {
+                addExpanded(points, radius + mClearance, Cutout);
+                continue;
+            }
+            addAnchor(pad->getPosition());
+            if (style == BI_Plane::ConnectStyle::Thermal) {
+                addExpanded(points, radius + mClearance, ThermalOuter);
+                addExpanded(points, radius, ThermalInner);
+                Length length = qMax(width, height) + mClearance * 2 + plane.getSpokeWidth();
+                for (const Path& spokePath : {Path::centeredRect(length, plane.getSpokeWidth()),
+                                              Path::centeredRect(plane.getSpokeWidth(), length)}) {
+                    QVector<Point> spoke = Toolbox::flattenedPath(spokePath);
+                    for (Point& p : spoke) {
+                        p = p.rotated(rot) + pad->getPosition();
+                    }
+                    addPolygon(spoke, ThermalSpoke);
+                }
+            }
+        }
+        for (const Hole& hole : footprint.getLibFootprint().getHoles()) {
+            addExpanded({footprint.mapToScene(hole.getPosition())},
+                        hole.getDiameter() / 2 + mClearance, Cutout);
+        }
+    }
+
+    // vias and traces
+    foreach (const BI_NetSegment* netsegment, board.getNetSegments()) {
+        bool sameNet = (&netsegment->getNetSignal() == netsignal);
+        foreach (const BI_Via* via, netsegment->getVias()) {
+            if (!via->isOnLayer(layer)) continue;
+            if (sameNet) {
+                addAnchor(via->getPosition());
+                continue;
+            }
+            QVector<Point> points;
+            Length radius(0);
+            switch (via->getShape()) {
+                case BI_Via::Shape::Round:
+                    points = {Point(0, 0)};
+                    radius = via->getSize() / 2;
+                    break;
+                case BI_Via::Shape::Square:
+                    points = Toolbox::flattenedPath(
+                        Path::centeredRect(via->getSize(), via->getSize()));
+                    break;
+                case BI_Via::Shape::Octagon:
+                    points = Toolbox::flattenedPath(
+                        Path::octagon(via->getSize(), via->getSize()));
+                    break;
+            }
+            for (Point& p : points) {
+                p += via->getPosition();
+            }
+            addExpanded(points, radius + mClearance, Cutout);
+        }
+        foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
+            if (netline->getLayer().getName() != layer) continue;
+            const Point& p1 = netline->getStartPoint().getPosition();
+            const Point& p2 = netline->getEndPoint().getPosition();
+            if (sameNet) {
+                addAnchor(p1);
+                addAnchor(p2);
+            } else {
+                addExpanded({p1, p2}, netline->getWidth() / 2 + mClearance, Cutout);
+            }
+        }
+    }
+
+    // board outlines and copper polygons (which are not connected to any net)
+    foreach (const BI_Polygon* polygon, board.getPolygons()) {
+        const Polygon& p = polygon->getPolygon();
+        if (p.getLayerName() == GraphicsLayer::sBoardOutlines) {
+            addPath(p.getPath(), p.getLineWidth(), false);
+        } else if (p.getLayerName() == layer) {
+            addPath(p.getPath(), p.getLineWidth(), p.isFilled());
+        }
+    }
+}
+
+void BoardPlaneFragmentsBuilder::addPolygon(const QVector<Point>& polygon, Class cls) noexcept
+{
+    if (polygon.count() < 3) {
+        return;
+    }
+    if (cls != Outline) {
+        // skip objects which are completely outside of the plane
+        LengthBase_t left = polygon.first().getX().toNm(), right = left;
+        LengthBase_t bottom = polygon.first().getY().toNm(), top = bottom;
+        foreach (const Point& p, polygon) {
+            left = qMin(left, p.getX().toNm());
+            right = qMax(right, p.getX().toNm());
+            bottom = qMin(bottom, p.getY().toNm());
+            top = qMax(top, p.getY().toNm());
+        }
+        if ((left > mRight) || (right < mLeft) || (bottom > mTop) || (top < mBottom)) {
+            return;
+        }
+    }
+    mClipper.addPolygon(polygon, cls);
+    mHash.addData(reinterpret_cast<const char*>(&cls), sizeof(cls));
+    foreach (const Point& p, polygon) {
+        LengthBase_t coords[2] = {p.getX().toNm(), p.getY().toNm()};
+        mHash.addData(reinterpret_cast<const char*>(coords), sizeof(coords));
+    }
+}
+
+void BoardPlaneFragmentsBuilder::addExpanded(const QVector<Point>& points,
+                                             const Length& offset, Class cls) noexcept
+{
+    if (offset <= 0) {
+        addPolygon(Toolbox::convexHull(points), cls);
+        return;
+    }
+
+    // expand each point to a polygon around the circle with the given radius (so the
+    // approximation never lies inside the circle) and take the convex hull of all
+    int count = getCircleVertexCount(offset.toNm());
+    qreal radius = offset.toNm() / qCos(M_PI / count);
+    QVector<Point> expanded;
+    expanded.reserve(points.count() * count);
+    foreach (const Point& p, points) {
+        for (int i = 0; i < count; ++i) {
+            qreal angle = 2 * M_PI * i / count;
+            expanded.append(p + Point(qRound64(radius * qCos(angle)),
+                                       qRound64(radius * qSin(angle))));
+        }
+    }
+    addPolygon(Toolbox::convexHull(expanded), cls);
+}
+
+void BoardPlaneFragmentsBuilder::addPath(const Path& path, const Length& width,
+                                         bool filled) noexcept
+{
+    QVector<Point> points = Toolbox::flattenedPath(path);
+    for (int i = 0; i + 1 < points.count(); ++i) {
+        addExpanded({points.at(i), points.at(i + 1)}, width / 2 + mClearance, Cutout);
+    }
+    if (filled) {
+        addPolygon(points, Cutout);
+    }
+}
+
+void BoardPlaneFragmentsBuilder::addAnchor(const Point& pos) noexcept
+{
+    if ((pos.getX().toNm() >= mLeft) && (pos.getX().toNm() <= mRight)
+        && (pos.getY().toNm() >= mBottom) && (pos.getY().toNm() <= mTop)) {
+        mAnchors.append(pos);
+        LengthBase_t coords[2] = {pos.getX().toNm(), pos.getY().toNm()};
+        mHash.addData(reinterpret_cast<const char*>(coords), sizeof(coords));
+    }
+}
+
+bool BoardPlaneFragmentsBuilder::fillRule(const bool* inside) noexcept
+{
+    return inside[Outline] && (!inside[Cutout])
+        && ((!inside[ThermalOuter]) || inside[ThermalInner] || inside[ThermalSpoke]);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
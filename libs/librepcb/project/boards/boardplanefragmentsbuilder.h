@@ -0,0 +1,117 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDPLANEFRAGMENTSBUILDER_H
+#define LIBREPCB_PROJECT_BOARDPLANEFRAGMENTSBUILDER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/units/all_length_units.h>
+#include <librepcb/common/algorithm/polygonclipper.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class Path;
+
+namespace project {
+
+class BI_Plane;
+
+/*****************************************************************************************
+ *  Class BoardPlaneFragmentsBuilder
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardPlaneFragmentsBuilder class calculates the copper areas of a plane
+ *
+ * The constructor collects all objects around the plane from the board (so it must be
+ * called in the thread of the board) and converts them into integer polygons:
+ *  - The outline of the plane
+ *  - Copper of other nets, board outlines and holes, expanded by the plane's clearance
+ *  - Thermal reliefs (clearance ring and spokes) around pads of the plane's net
+ *
+ * #buildFragments() then subtracts the obstacles from the outline with a
+ * #librepcb::PolygonClipper, removes islands which are not connected to any copper
+ * object of the plane's net and merges each remaining island into a single fragment
+ * (with cut-ins to its holes). It does not access the board anymore, so it can be
+ * executed in a worker thread. The hash returned by #getInputHash() covers all inputs,
+ * so fragments need to be rebuilt only if the hash has changed.
+ */
+class BoardPlaneFragmentsBuilder final
+{
+    public:
+
+        // Constructors / Destructor
+        BoardPlaneFragmentsBuilder() = delete;
+        BoardPlaneFragmentsBuilder(const BoardPlaneFragmentsBuilder& other) = delete;
+        explicit BoardPlaneFragmentsBuilder(const BI_Plane& plane) noexcept;
+        ~BoardPlaneFragmentsBuilder() noexcept;
+
+        // Getters
+        const QByteArray& getInputHash() const noexcept {return mInputHash;}
+
+        // General Methods
+        QVector<Path> buildFragments() const noexcept;
+
+        // Operator Overloadings
+        BoardPlaneFragmentsBuilder& operator=(const BoardPlaneFragmentsBuilder& rhs) = delete;
+
+
+    private: // Types
+        enum Class {
+            Outline,        ///< the area to fill
+            Cutout,         ///< areas which must not be filled
+            ThermalOuter,   ///< clearance around pads of the plane's net...
+            ThermalInner,   ///< ...except the pads themselves...
+            ThermalSpoke,   ///< ...and the spokes connecting them
+        };
+
+
+    private: // Methods
+        void collectObjects(const BI_Plane& plane) noexcept;
+        void addPolygon(const QVector<Point>& polygon, Class cls) noexcept;
+        void addExpanded(const QVector<Point>& points, const Length& offset, Class cls) noexcept;
+        void addPath(const Path& path, const Length& width, bool filled) noexcept;
+        void addAnchor(const Point& pos) noexcept;
+        static bool fillRule(const bool* inside) noexcept;
+
+
+    private: // Data
+        PolygonClipper mClipper;
+        LengthBase_t mLeft, mBottom, mRight, mTop; ///< bounding box of the plane outline
+        Length mClearance;
+        QVector<Point> mAnchors; ///< positions of copper objects of the plane's net
+        bool mKeepOrphans;
+        QCryptographicHash mHash;
+        QByteArray mInputHash;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDPLANEFRAGMENTSBUILDER_H
@@ -53,6 +53,15 @@ CmdBoardNetPointEdit::~CmdBoardNetPointEdit() noexcept
     }
 }
 
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+qint64 CmdBoardNetPointEdit::getSizeEstimate() const noexcept
+{
+    return UndoCommand::getSizeEstimate() + sizeof(*this) - sizeof(UndoCommand);
+}
+
 /*****************************************************************************************
  *  Setters
  ****************************************************************************************/
@@ -128,6 +137,24 @@ void CmdBoardNetPointEdit::performRedo()
     sgl.dismiss();
 }
 
+bool CmdBoardNetPointEdit::canMergeWith(const UndoCommand& other) const noexcept
+{
+    // only merge if the other command continues where this command ended
+    const CmdBoardNetPointEdit& cmd = static_cast<const CmdBoardNetPointEdit&>(other);
+    return (&cmd.mNetPoint == &mNetPoint) && (cmd.mOldLayer == mNewLayer)
+        && (cmd.mOldFootprintPad == mNewFootprintPad) && (cmd.mOldVia == mNewVia)
+        && (cmd.mOldPos == mNewPos);
+}
+
+void CmdBoardNetPointEdit::performMergeWith(const UndoCommand& other) noexcept
+{
+    const CmdBoardNetPointEdit& cmd = static_cast<const CmdBoardNetPointEdit&>(other);
+    mNewLayer = cmd.mNewLayer;
+    mNewFootprintPad = cmd.mNewFootprintPad;
+    mNewVia = cmd.mNewVia;
+    mNewPos = cmd.mNewPos;
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -56,6 +56,9 @@ class CmdBoardNetPointEdit final : public UndoCommand
         explicit CmdBoardNetPointEdit(BI_NetPoint& point) noexcept;
         ~CmdBoardNetPointEdit() noexcept;
 
+        // Getters
+        qint64 getSizeEstimate() const noexcept override;
+
         // Setters
         void setLayer(GraphicsLayer& layer) noexcept;
         void setPadToAttach(BI_FootprintPad* pad) noexcept;
@@ -77,6 +80,12 @@ class CmdBoardNetPointEdit final : public UndoCommand
         /// @copydoc UndoCommand::performRedo()
         void performRedo() override;
 
+        /// @copydoc UndoCommand::canMergeWith()
+        bool canMergeWith(const UndoCommand& other) const noexcept override;
+
+        /// @copydoc UndoCommand::performMergeWith()
+        void performMergeWith(const UndoCommand& other) noexcept override;
+
 
         // Private Member Variables
 
@@ -53,6 +53,15 @@ CmdBoardViaEdit::~CmdBoardViaEdit() noexcept
     }
 }
 
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+qint64 CmdBoardViaEdit::getSizeEstimate() const noexcept
+{
+    return UndoCommand::getSizeEstimate() + sizeof(*this) - sizeof(UndoCommand);
+}
+
 /*****************************************************************************************
  *  Setters
  ****************************************************************************************/
@@ -119,6 +128,24 @@ void CmdBoardViaEdit::performRedo()
     mVia.setDrillDiameter(mNewDrillDiameter);
 }
 
+bool CmdBoardViaEdit::canMergeWith(const UndoCommand& other) const noexcept
+{
+    // only merge if the other command continues where this command ended
+    const CmdBoardViaEdit& cmd = static_cast<const CmdBoardViaEdit&>(other);
+    return (&cmd.mVia == &mVia) && (cmd.mOldPos == mNewPos)
+        && (cmd.mOldShape == mNewShape) && (cmd.mOldSize == mNewSize)
+        && (cmd.mOldDrillDiameter == mNewDrillDiameter);
+}
+
+void CmdBoardViaEdit::performMergeWith(const UndoCommand& other) noexcept
+{
+    const CmdBoardViaEdit& cmd = static_cast<const CmdBoardViaEdit&>(other);
+    mNewPos = cmd.mNewPos;
+    mNewShape = cmd.mNewShape;
+    mNewSize = cmd.mNewSize;
+    mNewDrillDiameter = cmd.mNewDrillDiameter;
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
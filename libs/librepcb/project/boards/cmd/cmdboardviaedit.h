@@ -51,6 +51,9 @@ class CmdBoardViaEdit final : public UndoCommand
         explicit CmdBoardViaEdit(BI_Via& via) noexcept;
         ~CmdBoardViaEdit() noexcept;
 
+        // Getters
+        qint64 getSizeEstimate() const noexcept override;
+
         // Setters
         void setPosition(const Point& pos, bool immediate) noexcept;
         void setDeltaToStartPos(const Point& deltaPos, bool immediate) noexcept;
@@ -72,6 +75,12 @@ class CmdBoardViaEdit final : public UndoCommand
         /// @copydoc UndoCommand::performRedo()
         void performRedo() override;
 
+        /// @copydoc UndoCommand::canMergeWith()
+        bool canMergeWith(const UndoCommand& other) const noexcept override;
+
+        /// @copydoc UndoCommand::performMergeWith()
+        void performMergeWith(const UndoCommand& other) noexcept override;
+
 
         // Private Member Variables
 
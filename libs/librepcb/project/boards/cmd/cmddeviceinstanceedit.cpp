@@ -55,6 +55,15 @@ CmdDeviceInstanceEdit::~CmdDeviceInstanceEdit() noexcept
     }
 }
 
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+qint64 CmdDeviceInstanceEdit::getSizeEstimate() const noexcept
+{
+    return UndoCommand::getSizeEstimate() + sizeof(*this) - sizeof(UndoCommand);
+}
+
 /*****************************************************************************************
  *  General Methods
  ****************************************************************************************/
@@ -158,6 +167,22 @@ void CmdDeviceInstanceEdit::performRedo()
     mDevice.setRotation(mNewRotation);
 }
 
+bool CmdDeviceInstanceEdit::canMergeWith(const UndoCommand& other) const noexcept
+{
+    // only merge if the other command continues where this command ended
+    const CmdDeviceInstanceEdit& cmd = static_cast<const CmdDeviceInstanceEdit&>(other);
+    return (&cmd.mDevice == &mDevice) && (cmd.mOldPos == mNewPos)
+        && (cmd.mOldRotation == mNewRotation) && (cmd.mOldMirrored == mNewMirrored);
+}
+
+void CmdDeviceInstanceEdit::performMergeWith(const UndoCommand& other) noexcept
+{
+    const CmdDeviceInstanceEdit& cmd = static_cast<const CmdDeviceInstanceEdit&>(other);
+    mNewPos = cmd.mNewPos;
+    mNewRotation = cmd.mNewRotation;
+    mNewMirrored = cmd.mNewMirrored;
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -50,6 +50,9 @@ class CmdDeviceInstanceEdit final : public UndoCommand
         explicit CmdDeviceInstanceEdit(BI_Device& dev) noexcept;
         ~CmdDeviceInstanceEdit() noexcept;
 
+        // Getters
+        qint64 getSizeEstimate() const noexcept override;
+
         // General Methods
         void setPosition(Point& pos, bool immediate) noexcept;
         void setDeltaToStartPos(Point& deltaPos, bool immediate) noexcept;
@@ -72,6 +75,12 @@ class CmdDeviceInstanceEdit final : public UndoCommand
         /// @copydoc UndoCommand::performRedo()
         void performRedo() override;
 
+        /// @copydoc UndoCommand::canMergeWith()
+        bool canMergeWith(const UndoCommand& other) const noexcept override;
+
+        /// @copydoc UndoCommand::performMergeWith()
+        void performMergeWith(const UndoCommand& other) noexcept override;
+
 
         // Private Member Variables
 
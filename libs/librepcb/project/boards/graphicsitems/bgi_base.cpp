@@ -22,6 +22,7 @@
  ****************************************************************************************/
 #include <QtCore>
 #include "bgi_base.h"
+#include "bgi_batch.h"
 #include <librepcb/common/graphics/graphicslayer.h>
 #include "../board.h"
 
@@ -35,18 +36,32 @@ namespace project {
  *  Constructors / Destructor
  ****************************************************************************************/
 
-BGI_Base::BGI_Base() noexcept
+BGI_Base::BGI_Base() noexcept :
+    mBatch(nullptr)
 {
 
 }
 
 BGI_Base::~BGI_Base() noexcept
 {
+    Q_ASSERT(!mBatch);
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
 
+void BGI_Base::repaint() noexcept
+{
+    if (mBatch) {
+        mBatch->itemChanged(*this);
+    } else {
+        update();
+    }
 }
 
 /*****************************************************************************************
- *  Protected Methods
+ *  Static Methods
  ****************************************************************************************/
 
 qreal BGI_Base::getZValueOfCopperLayer(const QString& name) noexcept
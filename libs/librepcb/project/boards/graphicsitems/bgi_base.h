@@ -33,6 +33,8 @@
 namespace librepcb {
 namespace project {
 
+class BGI_Batch;
+
 /*****************************************************************************************
  *  Class BGI_Base
  ****************************************************************************************/
@@ -48,9 +50,29 @@ class BGI_Base : public QGraphicsItem
         explicit BGI_Base() noexcept;
         virtual ~BGI_Base() noexcept;
 
+        // Getters
+
+        /**
+         * @brief Get the batch which paints this item (see librepcb::project::BGI_Batch)
+         *
+         * @return The batch, or nullptr if the item is added to the scene by itself
+         */
+        BGI_Batch* getBatch() const noexcept {return mBatch;}
+
+        // Setters
+        void setBatch(BGI_Batch* batch) noexcept {mBatch = batch;}
 
-    protected:
+        // General Methods
 
+        /**
+         * @brief Repaint the item, no matter if it is painted by itself or by a batch
+         *
+         * @note Use this instead of QGraphicsItem::update() because batched items are
+         *       not added to the scene, so update() would have no effect.
+         */
+        void repaint() noexcept;
+
+        // Static Methods
         static qreal getZValueOfCopperLayer(const QString& name) noexcept;
 
 
@@ -60,6 +82,8 @@ class BGI_Base : public QGraphicsItem
         //BGI_Base() = delete;
         BGI_Base(const BGI_Base& other) = delete;
         BGI_Base& operator=(const BGI_Base& rhs) = delete;
+
+        BGI_Batch* mBatch;
 };
 
 /*****************************************************************************************
@@ -0,0 +1,281 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include "bgi_batch.h"
+#include "bgi_netline.h"
+#include "bgi_via.h"
+#include "../items/bi_netline.h"
+#include "../items/bi_via.h"
+#include "../board.h"
+#include "../boardlayerstack.h"
+#include "../../circuit/netsignal.h"
+#include <librepcb/common/graphics/levelofdetail.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Helpers
+ ****************************************************************************************/
+
+namespace {
+
+/// Check whether a rect touches the border of the bounding rect (i.e. determines its size)
+bool touchesBorder(const QRectF& rect, const QRectF& bounds) noexcept
+{
+    return (rect.left() <= bounds.left()) || (rect.top() <= bounds.top())
+        || (rect.right() >= bounds.right()) || (rect.bottom() >= bounds.bottom());
+}
+
+/// Add a path to a merged path, overlapping paths are united to not cancel out each other
+void addToMergedPath(QPainterPath& merged, QVector<QRectF>& rects,
+                     const QPainterPath& path) noexcept
+{
+    if (path.isEmpty()) return;
+    QRectF rect = path.boundingRect();
+    bool overlaps = false;
+    foreach (const QRectF& r, rects) {
+        if (r.intersects(rect)) {
+            overlaps = true;
+            break;
+        }
+    }
+    if (overlaps) {
+        merged = merged.united(path);
+        merged.setFillRule(Qt::OddEvenFill);
+    } else {
+        merged.addPath(path);
+    }
+    rects.append(rect);
+}
+
+} // namespace
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BGI_Batch::BGI_Batch(Board& board, qreal zValue) noexcept :
+    BGI_Base(), mBoard(board), mCacheOutdated(false)
+{
+    setZValue(zValue);
+}
+
+BGI_Batch::~BGI_Batch() noexcept
+{
+    Q_ASSERT(isEmpty());
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void BGI_Batch::addItem(BGI_Base& item) noexcept
+{
+    Q_ASSERT(!item.getBatch());
+    if (BGI_NetLine* netline = dynamic_cast<BGI_NetLine*>(&item)) {
+        mNetLines.insert(netline);
+    } else if (BGI_Via* via = dynamic_cast<BGI_Via*>(&item)) {
+        mVias.insert(via);
+    } else {
+        Q_ASSERT(false);
+        return;
+    }
+    item.setBatch(this);
+    itemChanged(item);
+}
+
+void BGI_Batch::removeItem(BGI_Base& item) noexcept
+{
+    Q_ASSERT(item.getBatch() == this);
+    QRectF oldRect = mItemRects.take(&item);
+    mNetLines.remove(static_cast<BGI_NetLine*>(&item));
+    mVias.remove(static_cast<BGI_Via*>(&item));
+    item.setBatch(nullptr);
+    if (touchesBorder(oldRect, mBoundingRect)) {
+        updateBoundingRect(); // the bounding rect may shrink
+    }
+    mCacheOutdated = true;
+    update(oldRect); // repaint the area of the removed item
+}
+
+void BGI_Batch::itemChanged(BGI_Base& item) noexcept
+{
+    // the batch is located at the scene origin, so scene coordinates can be used
+    QRectF oldRect = mItemRects.value(&item);
+    QRectF newRect = item.sceneBoundingRect();
+    mItemRects.insert(&item, newRect);
+    if ((!oldRect.isNull()) && touchesBorder(oldRect, mBoundingRect)) {
+        updateBoundingRect(); // the bounding rect may shrink
+    } else if (!mBoundingRect.contains(newRect)) {
+        prepareGeometryChange();
+        mBoundingRect = mBoundingRect.united(newRect);
+    }
+    mCacheOutdated = true;
+    if (!oldRect.isNull()) update(oldRect);
+    update(newRect);
+}
+
+/*****************************************************************************************
+ *  Inherited from QGraphicsItem
+ ****************************************************************************************/
+
+void BGI_Batch::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    Q_UNUSED(widget);
+    const qreal lod = LevelOfDetail::getLod(*painter, *option);
+    const LevelOfDetail& lodPolicy = LevelOfDetail::instance();
+
+    if (mCacheOutdated) {
+        updateCache();
+    }
+
+    // draw netlines
+    foreach (const LineGroup& group, mLineGroups) {
+        if (!group.layer->isVisible()) continue;
+        if (lodPolicy.drawAsHairline(lod, group.width)) {
+            painter->setPen(QPen(group.layer->getColor(group.highlight), 0));
+        } else {
+            painter->setPen(QPen(group.layer->getColor(group.highlight), group.width,
+                                 Qt::SolidLine, Qt::RoundCap));
+        }
+        painter->drawLines(group.lines);
+    }
+
+    // draw vias
+    if (mVias.isEmpty()) return;
+    GraphicsLayer* viaLayer = getLayer(GraphicsLayer::sBoardViasTht);
+    GraphicsLayer* topStopMaskLayer = getLayer(GraphicsLayer::sTopStopMask);
+    GraphicsLayer* bottomStopMaskLayer = getLayer(GraphicsLayer::sBotStopMask);
+    for (int highlight = 0; highlight <= 1; ++highlight) {
+        painter->setPen(Qt::NoPen);
+        if (bottomStopMaskLayer && bottomStopMaskLayer->isVisible()) {
+            painter->setBrush(bottomStopMaskLayer->getColor(highlight));
+            painter->drawPath(mStopMaskPaths[highlight]);
+        }
+        if (viaLayer && viaLayer->isVisible()) {
+            painter->setBrush(viaLayer->getColor(highlight));
+            painter->drawPath(mViaPaths[highlight]);
+        }
+    }
+
+    // draw netsignal names of vias (only if they are readable)
+    if (viaLayer && viaLayer->isVisible()) {
+        foreach (const BGI_Via* item, mVias) {
+            const QFont& font = item->getFont();
+            if (lodPolicy.getTextMode(lod, font.pixelSize()) != LevelOfDetail::TextMode::Full) {
+                continue;
+            }
+            if (painter->font() != font) {
+                painter->setFont(font);
+            }
+            const NetSignal& netsignal = item->getVia().getNetSignalOfNetSegment();
+            bool highlight = item->getVia().isSelected() || netsignal.isHighlighted();
+            painter->setPen(viaLayer->getColor(highlight).lighter(150));
+            painter->drawText(item->sceneBoundingRect(), Qt::AlignCenter, netsignal.getName());
+        }
+    }
+
+    // draw top stop masks
+    if (topStopMaskLayer && topStopMaskLayer->isVisible()) {
+        painter->setPen(Qt::NoPen);
+        for (int highlight = 0; highlight <= 1; ++highlight) {
+            painter->setBrush(topStopMaskLayer->getColor(highlight));
+            painter->drawPath(mStopMaskPaths[highlight]);
+        }
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void BGI_Batch::updateCache() noexcept
+{
+    // group netlines by layer, highlight state and width to minimize pen changes
+    mLineGroups.clear();
+    QHash<QPair<const GraphicsLayer*, QPair<bool, LengthBase_t>>, int> groupIndices;
+    foreach (const BGI_NetLine* item, mNetLines) {
+        const BI_NetLine& netline = item->getNetLine();
+        bool highlight = netline.isSelected() || netline.getNetSignalOfNetSegment().isHighlighted();
+        auto key = qMakePair(static_cast<const GraphicsLayer*>(&netline.getLayer()),
+                             qMakePair(highlight, netline.getWidth().toNm()));
+        int index = groupIndices.value(key, -1);
+        if (index < 0) {
+            index = mLineGroups.count();
+            groupIndices.insert(key, index);
+            mLineGroups.append(LineGroup{&netline.getLayer(), highlight,
+                                         netline.getWidth().toPx(), QVector<QLineF>()});
+        }
+        mLineGroups[index].lines.append(item->getLineF());
+    }
+
+    // merge all vias into one path per highlight state, with odd-even fill rule to keep
+    // the holes (overlapping vias are united, otherwise they would cancel out each other)
+    QVector<QRectF> viaRects[2];
+    QVector<QRectF> stopMaskRects[2];
+    for (int i = 0; i <= 1; ++i) {
+        mViaPaths[i] = QPainterPath();
+        mViaPaths[i].setFillRule(Qt::OddEvenFill);
+        mStopMaskPaths[i] = QPainterPath();
+        mStopMaskPaths[i].setFillRule(Qt::OddEvenFill);
+    }
+    foreach (const BGI_Via* item, mVias) {
+        const BI_Via& via = item->getVia();
+        int highlight = (via.isSelected() || via.getNetSignalOfNetSegment().isHighlighted()) ? 1 : 0;
+        addToMergedPath(mViaPaths[highlight], viaRects[highlight],
+                        item->getViaPath().translated(item->pos()));
+        addToMergedPath(mStopMaskPaths[highlight], stopMaskRects[highlight],
+                        item->getStopMaskPath().translated(item->pos()));
+    }
+
+    mCacheOutdated = false;
+}
+
+void BGI_Batch::updateBoundingRect() noexcept
+{
+    QRectF rect;
+    foreach (const QRectF& itemRect, mItemRects) {
+        rect = rect.united(itemRect);
+    }
+    if (rect != mBoundingRect) {
+        prepareGeometryChange();
+        mBoundingRect = rect;
+    }
+}
+
+GraphicsLayer* BGI_Batch::getLayer(const QString& name) const noexcept
+{
+    return mBoard.getLayerStack().getLayer(name);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
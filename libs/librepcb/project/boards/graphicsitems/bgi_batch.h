@@ -0,0 +1,120 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BGI_BATCH_H
+#define LIBREPCB_PROJECT_BGI_BATCH_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include "bgi_base.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class GraphicsLayer;
+
+namespace project {
+
+class Board;
+class BGI_NetLine;
+class BGI_Via;
+
+/*****************************************************************************************
+ *  Class BGI_Batch
+ ****************************************************************************************/
+
+/**
+ * @brief The BGI_Batch class paints many netlines or vias of the same layer and area
+ *
+ * Batched items are not added to the scene, this item paints them instead with only
+ * one pen/brush change per layer, width and highlight state. See
+ * librepcb::project::BoardGraphicsBatcher for how items are assigned to batches.
+ *
+ * @note The bounding rects of all items are remembered, so the bounding rect of the
+ *       batch only needs to be recalculated if an item at its border changes.
+ */
+class BGI_Batch final : public BGI_Base
+{
+    public:
+
+        // Constructors / Destructor
+        explicit BGI_Batch(Board& board, qreal zValue) noexcept;
+        ~BGI_Batch() noexcept;
+
+        // Getters
+        bool isEmpty() const noexcept {return mNetLines.isEmpty() && mVias.isEmpty();}
+
+        // General Methods
+        void addItem(BGI_Base& item) noexcept;
+        void removeItem(BGI_Base& item) noexcept;
+        void itemChanged(BGI_Base& item) noexcept;
+
+        // Inherited from QGraphicsItem
+        QRectF boundingRect() const noexcept {return mBoundingRect;}
+        void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget);
+
+
+    private:
+
+        // make some methods inaccessible...
+        BGI_Batch() = delete;
+        BGI_Batch(const BGI_Batch& other) = delete;
+        BGI_Batch& operator=(const BGI_Batch& rhs) = delete;
+
+        // Types
+        struct LineGroup {
+            const GraphicsLayer* layer;
+            bool highlight;
+            qreal width;
+            QVector<QLineF> lines;
+        };
+
+        // Private Methods
+        void updateCache() noexcept;
+        void updateBoundingRect() noexcept;
+        GraphicsLayer* getLayer(const QString& name) const noexcept;
+
+
+        // General Attributes
+        Board& mBoard;
+        QSet<BGI_NetLine*> mNetLines;
+        QSet<BGI_Via*> mVias;
+        QHash<BGI_Base*, QRectF> mItemRects; ///< scene bounding rects of all items
+        QRectF mBoundingRect;
+
+        // Cached Attributes (rebuilt on the next paint after a change)
+        bool mCacheOutdated;
+        QVector<LineGroup> mLineGroups;
+        QPainterPath mViaPaths[2];      ///< index 0: normal, index 1: highlighted
+        QPainterPath mStopMaskPaths[2]; ///< index 0: normal, index 1: highlighted
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BGI_BATCH_H
@@ -31,6 +31,8 @@
 #include "../items/bi_device.h"
 #include "../boardlayerstack.h"
 #include <librepcb/common/attributes/attributesubstitutor.h>
+#include <librepcb/common/graphics/levelofdetail.h>
+#include <librepcb/common/graphics/textlayoutcache.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -111,52 +113,63 @@ void BGI_Footprint::updateCacheAndRepaint() noexcept
         mShape = mShape.united(polygonPath);
     }
 
+    // ellipses
+    for (const Ellipse& ellipse : mLibFootprint.getEllipses()) {
+        layer = getLayer(ellipse.getLayerName());
+        if (!layer) continue;
+        if (!layer->isVisible()) continue;
+
+        qreal rx = (ellipse.getRadiusX() + ellipse.getLineWidth() / 2).toPx();
+        qreal ry = (ellipse.getRadiusY() + ellipse.getLineWidth() / 2).toPx();
+        QRectF ellipseRect(-rx, -ry, 2*rx, 2*ry);
+        mBoundingRect = mBoundingRect.united(ellipseRect.translated(ellipse.getCenter().toPxQPointF()));
+    }
+
+    // holes
+    layer = getLayer(GraphicsLayer::sBoardDrillsNpth);
+    if (layer && layer->isVisible()) {
+        for (const Hole& hole : mLibFootprint.getHoles()) {
+            qreal radius = (hole.getDiameter() / 2).toPx();
+            QRectF holeRect(-radius, -radius, 2*radius, 2*radius);
+            mBoundingRect = mBoundingRect.united(holeRect.translated(hole.getPosition().toPxQPointF()));
+        }
+    }
+
     // texts
-    mCachedTextProperties.clear();
+    QHash<const Text*, CachedTextProperties_t> oldTextProperties;
+    oldTextProperties.swap(mCachedTextProperties);
     for (const Text& text : mLibFootprint.getTexts()) {
         layer = getLayer(text.getLayerName());
         if (!layer) continue;
         if (!layer->isVisible()) continue;
 
-        // create static text properties
+        // create text properties
         CachedTextProperties_t props;
 
-        // get the text to display
-        props.text = AttributeSubstitutor::substitute(text.getText(), &mFootprint);
-
-        // calculate font metrics
-        props.fontPixelSize = qCeil(text.getHeight().toPx());
-        mFont.setPixelSize(props.fontPixelSize);
-        QFontMetricsF metrics(mFont);
-        props.scaleFactor = text.getHeight().toPx() / metrics.height();
-        props.textRect = metrics.boundingRect(QRectF(), text.getAlign().toQtAlign() |
-                                              Qt::TextDontClip, props.text);
-        QRectF scaledTextRect = QRectF(props.textRect.topLeft() * props.scaleFactor,
-                                       props.textRect.bottomRight() * props.scaleFactor);
-
         // check rotation
         Angle absAngle = text.getRotation() + mFootprint.getRotation();
         absAngle.mapTo180deg();
         props.rotate180 = (absAngle <= -Angle::deg90() || absAngle > Angle::deg90());
 
-        // calculate text position
-        scaledTextRect.translate(text.getPosition().toPxQPointF());
-
-        // text alignment
-        if (props.rotate180)
-            props.flags = text.getAlign().mirrored().toQtAlign();
-        else
-            props.flags = text.getAlign().toQtAlign();
-
-        // calculate text bounding rect
-        mBoundingRect = mBoundingRect.united(scaledTextRect);
-        props.textRect = QRectF(scaledTextRect.topLeft() / props.scaleFactor,
-                                scaledTextRect.bottomRight() / props.scaleFactor);
-        if (props.rotate180)
-        {
-            props.textRect = QRectF(-props.textRect.x(), -props.textRect.y(),
-                                    -props.textRect.width(), -props.textRect.height()).normalized();
+        // get the layout of the substituted text (shared with all other instances), but
+        // only look it up again if the text, its size or its alignment has changed
+        QString str = AttributeSubstitutor::substitute(text.getText(), &mFootprint);
+        props.align = props.rotate180 ? text.getAlign().mirrored().toQtAlign()
+                                      : text.getAlign().toQtAlign();
+        props.pixelSize = qCeil(text.getHeight().toPx());
+        auto old = oldTextProperties.constFind(&text);
+        if ((old != oldTextProperties.constEnd()) && (old->layout->getText() == str)
+            && (old->pixelSize == props.pixelSize) && (old->align == props.align)) {
+            props.layout = old->layout;
+        } else {
+            mFont.setPixelSize(props.pixelSize);
+            props.layout = TextLayoutCache::instance().getLayout(str, mFont, props.align);
         }
+        props.scaleFactor = text.getHeight().toPx() / props.layout->getFontHeight();
+
+        // calculate text bounding rect (the text is rotated around its position)
+        QRectF textRect = getTextTransform(text, props).mapRect(props.layout->getBoundingRect());
+        mBoundingRect = mBoundingRect.united(textRect);
 
         // save properties
         mCachedTextProperties.insert(&text, props);
@@ -181,10 +194,15 @@ void BGI_Footprint::paint(QPainter* painter, const QStyleOptionGraphicsItem* opt
     const GraphicsLayer* layer = 0;
     const bool selected = mFootprint.isSelected();
     const bool deviceIsPrinter = (dynamic_cast<QPrinter*>(painter->device()) != 0);
-    const qreal lod = option->levelOfDetailFromTransform(painter->worldTransform());
+    const qreal lod = LevelOfDetail::getLod(*painter, *option);
+    const LevelOfDetail& lodPolicy = LevelOfDetail::instance();
 
     // draw all polygons
     for (const Polygon& polygon : mLibFootprint.getPolygons()) {
+        // skip polygons which are too small to be seen
+        const QPainterPath& path = polygon.getPath().toQPainterPathPx();
+        if (!lodPolicy.isShapeVisible(lod, path.boundingRect())) continue;
+
         // get layer
         layer = getLayer(polygon.getLayerName());
         if (!layer) continue;
@@ -213,11 +231,16 @@ void BGI_Footprint::paint(QPainter* painter, const QStyleOptionGraphicsItem* opt
         }
 
         // draw polygon
-        painter->drawPath(polygon.getPath().toQPainterPathPx());
+        painter->drawPath(path);
     }
 
     // draw all ellipses
     for (const Ellipse& ellipse : mLibFootprint.getEllipses()) {
+        // skip ellipses which are too small to be seen
+        qreal rx = ellipse.getRadiusX().toPx();
+        qreal ry = ellipse.getRadiusY().toPx();
+        if (!lodPolicy.isShapeVisible(lod, QRectF(-rx, -ry, 2*rx, 2*ry))) continue;
+
         // get layer
         layer = getLayer(ellipse.getLayerName());
         if (!layer) continue;
@@ -246,8 +269,7 @@ void BGI_Footprint::paint(QPainter* painter, const QStyleOptionGraphicsItem* opt
         }
 
         // draw ellipse
-        painter->drawEllipse(ellipse.getCenter().toPxQPointF(), ellipse.getRadiusX().toPx(),
-                             ellipse.getRadiusY().toPx());
+        painter->drawEllipse(ellipse.getCenter().toPxQPointF(), rx, ry);
         // TODO: rotation
     }
 
@@ -258,28 +280,27 @@ void BGI_Footprint::paint(QPainter* painter, const QStyleOptionGraphicsItem* opt
         if (!layer) continue;
         if (!layer->isVisible()) continue;
 
+        // skip texts which are too small to be seen
+        LevelOfDetail::TextMode textMode = lodPolicy.getTextMode(lod, text.getHeight().toPx());
+        if (textMode == LevelOfDetail::TextMode::Hidden) continue;
+
         // get cached text properties
         const CachedTextProperties_t& props = mCachedTextProperties.value(&text);
-        mFont.setPixelSize(props.fontPixelSize);
 
         // draw text or rect
         painter->save();
-        painter->translate(text.getPosition().toPxQPointF());
-        painter->rotate(-text.getRotation().toDeg());
-        painter->translate(-text.getPosition().toPxQPointF());
-        painter->scale(props.scaleFactor, props.scaleFactor);
-        if (props.rotate180) painter->rotate(180);
-        if ((deviceIsPrinter) || (lod * text.getHeight().toPx() > 8))
+        painter->setTransform(getTextTransform(text, props), true);
+        if (textMode == LevelOfDetail::TextMode::Full)
         {
-            // draw text
+            // draw text (replay the cached glyphs)
             painter->setPen(QPen(layer->getColor(selected), 0));
-            painter->setFont(mFont);
-            painter->drawText(props.textRect, props.flags, props.text);
+            props.layout->paint(*painter);
         }
         else
         {
             // fill rect
-            painter->fillRect(props.textRect, QBrush(layer->getColor(selected), Qt::Dense5Pattern));
+            painter->fillRect(props.layout->getBoundingRect(),
+                              QBrush(layer->getColor(selected), Qt::Dense5Pattern));
         }
 #ifdef QT_DEBUG
         layer = getLayer(GraphicsLayer::sDebugGraphicsItemsTextsBoundingRects);
@@ -288,7 +309,7 @@ void BGI_Footprint::paint(QPainter* painter, const QStyleOptionGraphicsItem* opt
                 // draw text bounding rect
                 painter->setPen(QPen(layer->getColor(selected), 0));
                 painter->setBrush(Qt::NoBrush);
-                painter->drawRect(props.textRect);
+                painter->drawRect(props.layout->getBoundingRect());
             }
         }
 #endif
@@ -306,8 +327,9 @@ void BGI_Footprint::paint(QPainter* painter, const QStyleOptionGraphicsItem* opt
         painter->setPen(Qt::NoPen);
         painter->setBrush(QBrush(layer->getColor(selected), Qt::SolidPattern));
 
-        // draw hole
+        // draw hole (if it's large enough to be seen)
         qreal radius = (hole.getDiameter() / 2).toPx();
+        if (!lodPolicy.isShapeVisible(lod, QRectF(-radius, -radius, 2*radius, 2*radius))) continue;
         painter->drawEllipse(hole.getPosition().toPxQPointF(), radius, radius);
     }
 
@@ -339,6 +361,17 @@ void BGI_Footprint::paint(QPainter* painter, const QStyleOptionGraphicsItem* opt
  *  Private Methods
  ****************************************************************************************/
 
+QTransform BGI_Footprint::getTextTransform(const Text& text,
+                                       const CachedTextProperties_t& props) noexcept
+{
+    QTransform t = QTransform::fromTranslate(text.getPosition().toPxQPointF().x(),
+                                             text.getPosition().toPxQPointF().y());
+    t.rotate(-text.getRotation().toDeg());
+    t.scale(props.scaleFactor, props.scaleFactor);
+    if (props.rotate180) t.rotate(180);
+    return t;
+}
+
 GraphicsLayer* BGI_Footprint::getLayer(QString name) const noexcept
 {
     if (mFootprint.getIsMirrored()) name = GraphicsLayer::getMirroredLayerName(name);
@@ -35,6 +35,7 @@
 #include <librepcb/library/pkg/package.h>
 #include "../boardlayerstack.h"
 #include "../../circuit/netsignal.h"
+#include <librepcb/common/graphics/levelofdetail.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -112,14 +113,15 @@ void BGI_FootprintPad::updateCacheAndRepaint() noexcept
     Length size = qMin(mLibPad.getWidth(), mLibPad.getHeight());
     mStopMaskClearance = mPad.getBoard().getDesignRules().calcStopMaskClearance(size);
     mCreamMaskClearance = -mPad.getBoard().getDesignRules().calcCreamMaskClearance(size);
+    mStopMaskPath = getMaskPath(mStopMaskClearance);
+    mCreamMaskPath = getMaskPath(mCreamMaskClearance);
 
-    // set shape and bounding rect
+    // set shape and bounding rect (the pad text is clipped to the pad area)
     mShape = QPainterPath();
     mShape.setFillRule(Qt::WindingFill);
-    qreal w = (mLibPad.getWidth() + mStopMaskClearance*2).toPx();
-    qreal h = (mLibPad.getHeight() + mStopMaskClearance*2).toPx();
     mShape.addRect(mLibPad.getBoundingRectPx());
-    mBoundingRect = QRectF(-w/2, -h/2, w, h);
+    mBoundingRect = mLibPad.getBoundingRectPx().united(mStopMaskPath.boundingRect())
+                                              .united(mCreamMaskPath.boundingRect());
 
     update();
 }
@@ -130,26 +132,33 @@ void BGI_FootprintPad::updateCacheAndRepaint() noexcept
 
 void BGI_FootprintPad::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
-    Q_UNUSED(option);
     Q_UNUSED(widget);
-    //const bool deviceIsPrinter = (dynamic_cast<QPrinter*>(painter->device()) != 0);
-    //const qreal lod = option->levelOfDetailFromTransform(painter->worldTransform());
+    const qreal lod = LevelOfDetail::getLod(*painter, *option);
+    const LevelOfDetail& lodPolicy = LevelOfDetail::instance();
 
     const NetSignal* netsignal = mPad.getCompSigInstNetSignal();
     bool highlight = mPad.isSelected() || (netsignal && netsignal->isHighlighted());
 
+    if (!lodPolicy.drawPadDetails(lod, mLibPad.getBoundingRectPx())) {
+        // the pad is too small to see any details, so just fill its area
+        if (mPadLayer && mPadLayer->isVisible()) {
+            painter->fillRect(mLibPad.getBoundingRectPx(), mPadLayer->getColor(highlight));
+        }
+        return;
+    }
+
     if (mBottomCreamMaskLayer && mBottomCreamMaskLayer->isVisible()) {
         // draw bottom cream mask
         painter->setPen(Qt::NoPen);
         painter->setBrush(mBottomCreamMaskLayer->getColor(highlight));
-        painter->drawPath(mLibPad.toMaskQPainterPathPx(mCreamMaskClearance));
+        painter->drawPath(mCreamMaskPath);
     }
 
     if (mBottomStopMaskLayer && mBottomStopMaskLayer->isVisible()) {
         // draw bottom stop mask
         painter->setPen(Qt::NoPen);
         painter->setBrush(mBottomStopMaskLayer->getColor(highlight));
-        painter->drawPath(mLibPad.toMaskQPainterPathPx(mStopMaskClearance));
+        painter->drawPath(mStopMaskPath);
     }
 
     if (mPadLayer && mPadLayer->isVisible()) {
@@ -158,23 +167,25 @@ void BGI_FootprintPad::paint(QPainter* painter, const QStyleOptionGraphicsItem*
         painter->setBrush(mPadLayer->getColor(highlight));
         painter->drawPath(mLibPad.toQPainterPathPx());
         // draw pad text
-        painter->setFont(mFont);
-        painter->setPen(mPadLayer->getColor(highlight).lighter(150));
-        painter->drawText(mLibPad.getBoundingRectPx(), Qt::AlignCenter, mPad.getDisplayText());
+        if (lodPolicy.getTextMode(lod, mFont.pixelSize()) == LevelOfDetail::TextMode::Full) {
+            painter->setFont(mFont);
+            painter->setPen(mPadLayer->getColor(highlight).lighter(150));
+            painter->drawText(mLibPad.getBoundingRectPx(), Qt::AlignCenter, mPad.getDisplayText());
+        }
     }
 
     if (mTopStopMaskLayer && mTopStopMaskLayer->isVisible()) {
         // draw top stop mask
         painter->setPen(Qt::NoPen);
         painter->setBrush(mTopStopMaskLayer->getColor(highlight));
-        painter->drawPath(mLibPad.toMaskQPainterPathPx(mStopMaskClearance));
+        painter->drawPath(mStopMaskPath);
     }
 
     if (mTopCreamMaskLayer && mTopCreamMaskLayer->isVisible()) {
         // draw top cream mask
         painter->setPen(Qt::NoPen);
         painter->setBrush(mTopCreamMaskLayer->getColor(highlight));
-        painter->drawPath(mLibPad.toMaskQPainterPathPx(mCreamMaskClearance));
+        painter->drawPath(mCreamMaskPath);
     }
 
 #ifdef QT_DEBUG
@@ -200,6 +211,26 @@ GraphicsLayer* BGI_FootprintPad::getLayer(QString name) const noexcept
     return mPad.getFootprint().getDeviceInstance().getBoard().getLayerStack().getLayer(name);
 }
 
+QPainterPath BGI_FootprintPad::getMaskPath(const Length& clearance) const noexcept
+{
+    // The mask shape only depends on the pad shape and the mask size, so identical pads
+    // (of all footprints) share the same (implicitly shared) painter path. The cache is
+    // bounded and shared between all boards, so it is guarded by a mutex.
+    typedef QPair<int, QPair<LengthBase_t, LengthBase_t>> Key;
+    static QCache<Key, QPainterPath> cache(256);
+    static QMutex mutex;
+    Length width = qMax(mLibPad.getWidth() + clearance*2, Length(0));
+    Length height = qMax(mLibPad.getHeight() + clearance*2, Length(0));
+    Key key(static_cast<int>(mLibPad.getShape()), qMakePair(width.toNm(), height.toNm()));
+    QMutexLocker lock(&mutex);
+    if (const QPainterPath* path = cache.object(key)) {
+        return *path;
+    }
+    QPainterPath path = mLibPad.toMaskQPainterPathPx(clearance);
+    cache.insert(key, new QPainterPath(path));
+    return path;
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -82,6 +82,7 @@ class BGI_FootprintPad final : public BGI_Base
 
         // Private Methods
         GraphicsLayer* getLayer(QString name) const noexcept;
+        QPainterPath getMaskPath(const Length& clearance) const noexcept;
 
 
         // General Attributes
@@ -96,6 +97,8 @@ class BGI_FootprintPad final : public BGI_Base
         GraphicsLayer* mBottomCreamMaskLayer;
         Length mStopMaskClearance;
         Length mCreamMaskClearance;
+        QPainterPath mStopMaskPath;
+        QPainterPath mCreamMaskPath;
         QRectF mBoundingRect;
         QPainterPath mShape;
         QFont mFont;
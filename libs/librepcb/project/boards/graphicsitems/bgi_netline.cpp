@@ -30,6 +30,7 @@
 #include "../boardlayerstack.h"
 #include "../../project.h"
 #include "../../circuit/netsignal.h"
+#include <librepcb/common/graphics/levelofdetail.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -81,33 +82,47 @@ void BGI_NetLine::updateCacheAndRepaint() noexcept
     mBoundingRect = QRectF(mLineF.p1(), mLineF.p2()).normalized();
     mBoundingRect.adjust(-mNetLine.getWidth().toPx()/2, -mNetLine.getWidth().toPx()/2,
                          mNetLine.getWidth().toPx()/2, mNetLine.getWidth().toPx()/2);
+    // stroking the shape is expensive and it's only needed for hit testing, so it is
+    // not rebuilt on every mouse move while dragging, but the next time it is needed
     mShape = QPainterPath();
-    mShape.moveTo(mNetLine.getStartPoint().getPosition().toPxQPointF());
-    mShape.lineTo(mNetLine.getEndPoint().getPosition().toPxQPointF());
-    QPainterPathStroker ps;
-    ps.setCapStyle(Qt::RoundCap);
-    Length width = (mNetLine.getWidth() > Length(100000) ? mNetLine.getWidth() : Length(100000));
-    ps.setWidth(width.toPx());
-    mShape = ps.createStroke(mShape);
-    update();
+    repaint();
 }
 
 /*****************************************************************************************
  *  Inherited from QGraphicsItem
  ****************************************************************************************/
 
+QPainterPath BGI_NetLine::shape() const noexcept
+{
+    if (mShape.isEmpty()) {
+        QPainterPath path;
+        path.moveTo(mLineF.p1());
+        path.lineTo(mLineF.p2());
+        QPainterPathStroker ps;
+        ps.setCapStyle(Qt::RoundCap);
+        Length width = (mNetLine.getWidth() > Length(100000) ? mNetLine.getWidth() : Length(100000));
+        ps.setWidth(width.toPx());
+        mShape = ps.createStroke(path);
+    }
+    return mShape;
+}
+
 void BGI_NetLine::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
-    Q_UNUSED(option);
     Q_UNUSED(widget);
+    const qreal lod = LevelOfDetail::getLod(*painter, *option);
 
     bool highlight = mNetLine.isSelected() || mNetLine.getNetSignalOfNetSegment().isHighlighted();
 
-    // draw line
+    // draw line (as a cheap cosmetic hairline if it's thinner than a pixel anyway)
     if (mLayer->isVisible())
     {
-        QPen pen(mLayer->getColor(highlight), mNetLine.getWidth().toPx(), Qt::SolidLine, Qt::RoundCap);
-        painter->setPen(pen);
+        qreal width = mNetLine.getWidth().toPx();
+        if (LevelOfDetail::instance().drawAsHairline(lod, width)) {
+            painter->setPen(QPen(mLayer->getColor(highlight), 0));
+        } else {
+            painter->setPen(QPen(mLayer->getColor(highlight), width, Qt::SolidLine, Qt::RoundCap));
+        }
         painter->drawLine(mLineF);
     }
 
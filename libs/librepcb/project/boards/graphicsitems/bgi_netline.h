@@ -26,6 +26,7 @@
 #include <QtCore>
 #include <QtWidgets>
 #include "bgi_base.h"
+#include <librepcb/common/memorypool.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -47,6 +48,8 @@ class BI_NetLine;
  */
 class BGI_NetLine final : public BGI_Base
 {
+        DECLARE_MEMORY_POOL(BGI_NetLine)
+
     public:
 
         // Constructors / Destructor
@@ -55,13 +58,15 @@ class BGI_NetLine final : public BGI_Base
 
         // Getters
         bool isSelectable() const noexcept;
+        const BI_NetLine& getNetLine() const noexcept {return mNetLine;}
+        const QLineF& getLineF() const noexcept {return mLineF;}
 
         // General Methods
         void updateCacheAndRepaint() noexcept;
 
         // Inherited from QGraphicsItem
         QRectF boundingRect() const {return mBoundingRect;}
-        QPainterPath shape() const {return mShape;}
+        QPainterPath shape() const noexcept;
         void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget);
 
 
@@ -82,7 +87,7 @@ class BGI_NetLine final : public BGI_Base
         // Cached Attributes
         QLineF mLineF;
         QRectF mBoundingRect;
-        QPainterPath mShape;
+        mutable QPainterPath mShape; ///< built lazily by #shape(), empty if outdated
 };
 
 /*****************************************************************************************
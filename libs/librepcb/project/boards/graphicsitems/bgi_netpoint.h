@@ -26,6 +26,7 @@
 #include <QtCore>
 #include <QtWidgets>
 #include "bgi_base.h"
+#include <librepcb/common/memorypool.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -47,6 +48,8 @@ class BI_NetPoint;
  */
 class BGI_NetPoint final : public BGI_Base
 {
+        DECLARE_MEMORY_POOL(BGI_NetPoint)
+
     public:
 
         // Constructors / Destructor
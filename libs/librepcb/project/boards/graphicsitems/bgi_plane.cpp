@@ -0,0 +1,105 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include "bgi_plane.h"
+#include "../items/bi_plane.h"
+#include "../board.h"
+#include "../boardlayerstack.h"
+#include "../../circuit/netsignal.h"
+#include <librepcb/common/graphics/graphicslayer.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BGI_Plane::BGI_Plane(BI_Plane& plane) noexcept :
+    BGI_Base(), mPlane(plane), mLayer(nullptr)
+{
+    // draw planes slightly below the traces of the same layer
+    setZValue(getZValueOfCopperLayer(mPlane.getLayerName()) - 0.005);
+    mLayer = mPlane.getBoard().getLayerStack().getLayer(mPlane.getLayerName());
+    Q_ASSERT(mLayer);
+
+    updateCacheAndRepaint();
+}
+
+BGI_Plane::~BGI_Plane() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void BGI_Plane::updateCacheAndRepaint() noexcept
+{
+    prepareGeometryChange();
+
+    Path outline = mPlane.getOutline();
+    outline.close();
+    mOutline = outline.toQPainterPathPx();
+    mFragments = QPainterPath();
+    mFragments.setFillRule(Qt::WindingFill);
+    foreach (const Path& fragment, mPlane.getFragments()) {
+        mFragments.addPath(fragment.toQPainterPathPx());
+    }
+    mBoundingRect = mOutline.boundingRect().united(mFragments.boundingRect());
+    mBoundingRect.adjust(-2, -2, 2, 2); // the outline is drawn with a cosmetic pen
+
+    update();
+}
+
+/*****************************************************************************************
+ *  Inherited from QGraphicsItem
+ ****************************************************************************************/
+
+void BGI_Plane::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    Q_UNUSED(option);
+    Q_UNUSED(widget);
+
+    if (mLayer && mLayer->isVisible()) {
+        bool highlight = mPlane.getNetSignal().isHighlighted();
+        // the outline is only a hint where the plane is, so it is drawn dashed
+        painter->setPen(QPen(mLayer->getColor(highlight), 0, Qt::DashLine));
+        painter->setBrush(Qt::NoBrush);
+        painter->drawPath(mOutline);
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(mLayer->getColor(highlight));
+        painter->drawPath(mFragments);
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -83,17 +83,22 @@ void BGI_Via::updateCacheAndRepaint() noexcept
     mBottomStopMaskLayer = getLayer(GraphicsLayer::sBotStopMask);
 
     // determine stop mask clearance
-    mDrawStopMask = mVia.getBoard().getDesignRules().doesViaRequireStopMask(mVia.getDrillDiameter());
-    mStopMaskClearance = mVia.getBoard().getDesignRules().calcStopMaskClearance(mVia.getSize());
+    bool drawStopMask = mVia.getBoard().getDesignRules().doesViaRequireStopMask(mVia.getDrillDiameter());
+    Length stopMaskClearance = mVia.getBoard().getDesignRules().calcStopMaskClearance(mVia.getSize());
+
+    // build paths
+    mViaPath = mVia.toQPainterPathPx(Length(0), true);
+    mStopMaskPath = drawStopMask ? mVia.toQPainterPathPx(stopMaskClearance, false) : QPainterPath();
 
     // set shape and bounding rect
     qreal shapeRadius = (mVia.getSize()/2).toPx();
-    qreal stopMaskRadius = ((mVia.getSize() + mStopMaskClearance*2) / 2).toPx();
-    mBoundingRect = QRectF(-stopMaskRadius, -stopMaskRadius, 2*stopMaskRadius, 2*stopMaskRadius);
+    qreal stopMaskRadius = ((mVia.getSize() + stopMaskClearance*2) / 2).toPx();
+    qreal radius = qMax(shapeRadius, stopMaskRadius); // the text is clipped to this area
+    mBoundingRect = QRectF(-radius, -radius, 2*radius, 2*radius);
     mShape = QPainterPath();
     mShape.addEllipse(QRectF(-shapeRadius, -shapeRadius, 2*shapeRadius, 2*shapeRadius));
 
-    update();
+    repaint();
 }
 
 /*****************************************************************************************
@@ -108,18 +113,18 @@ void BGI_Via::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, Q
     NetSignal& netsignal = mVia.getNetSignalOfNetSegment();
     bool highlight = mVia.isSelected() || (netsignal.isHighlighted());
 
-    if (mDrawStopMask && mBottomStopMaskLayer && mBottomStopMaskLayer->isVisible()) {
+    if ((!mStopMaskPath.isEmpty()) && mBottomStopMaskLayer && mBottomStopMaskLayer->isVisible()) {
         // draw bottom stop mask
         painter->setPen(Qt::NoPen);
         painter->setBrush(mBottomStopMaskLayer->getColor(highlight));
-        painter->drawPath(mVia.toQPainterPathPx(mStopMaskClearance, false));
+        painter->drawPath(mStopMaskPath);
     }
 
     if (mViaLayer && mViaLayer->isVisible()) {
         // draw via
         painter->setPen(Qt::NoPen);
         painter->setBrush(mViaLayer->getColor(highlight));
-        painter->drawPath(mVia.toQPainterPathPx(Length(0), true));
+        painter->drawPath(mViaPath);
 
         // draw netsignal name
         painter->setFont(mFont);
@@ -127,11 +132,11 @@ void BGI_Via::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, Q
         painter->drawText(mBoundingRect, Qt::AlignCenter, netsignal.getName());
     }
 
-    if (mDrawStopMask && mTopStopMaskLayer && mTopStopMaskLayer->isVisible()) {
+    if ((!mStopMaskPath.isEmpty()) && mTopStopMaskLayer && mTopStopMaskLayer->isVisible()) {
         // draw top stop mask
         painter->setPen(Qt::NoPen);
         painter->setBrush(mTopStopMaskLayer->getColor(highlight));
-        painter->drawPath(mVia.toQPainterPathPx(mStopMaskClearance, false));
+        painter->drawPath(mStopMaskPath);
     }
 
 #ifdef QT_DEBUG
@@ -26,6 +26,7 @@
 #include <QtCore>
 #include <QtWidgets>
 #include "bgi_base.h"
+#include <librepcb/common/memorypool.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -47,6 +48,8 @@ class BI_Via;
  */
 class BGI_Via final : public BGI_Base
 {
+        DECLARE_MEMORY_POOL(BGI_Via)
+
     public:
 
         // Constructors / Destructor
@@ -55,6 +58,10 @@ class BGI_Via final : public BGI_Base
 
         // Getters
         bool isSelectable() const noexcept;
+        const BI_Via& getVia() const noexcept {return mVia;}
+        const QPainterPath& getViaPath() const noexcept {return mViaPath;}
+        const QPainterPath& getStopMaskPath() const noexcept {return mStopMaskPath;} ///< empty if none
+        const QFont& getFont() const noexcept {return mFont;}
 
         // General Methods
         void updateCacheAndRepaint() noexcept;
@@ -83,8 +90,8 @@ class BGI_Via final : public BGI_Base
         GraphicsLayer* mBottomStopMaskLayer;
 
         // Cached Attributes
-        bool mDrawStopMask;
-        Length mStopMaskClearance;
+        QPainterPath mViaPath;
+        QPainterPath mStopMaskPath;
         QRectF mBoundingRect;
         QPainterPath mShape;
         QFont mFont;
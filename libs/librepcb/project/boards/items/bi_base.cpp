@@ -38,7 +38,7 @@ namespace project {
  ****************************************************************************************/
 
 BI_Base::BI_Base(Board& board) noexcept :
-    QObject(&board), mBoard(board), mIsAddedToBoard(false), mIsSelected(false)
+    mBoard(board), mIsAddedToBoard(false), mIsSelected(false)
 {
 }
 
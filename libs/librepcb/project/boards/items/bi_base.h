@@ -47,11 +47,12 @@ class BGI_Base;
 
 /**
  * @brief The Board Item Base (BI_Base) class
+ *
+ * This is not a QObject because some item types exist in very high numbers (e.g.
+ * net lines). Items which need signals or slots additionally derive from QObject.
  */
-class BI_Base : public QObject
+class BI_Base
 {
-        Q_OBJECT
-
     public:
 
         // Types
@@ -64,6 +65,8 @@ class BI_Base : public QObject
             Footprint,      ///< librepcb#project#BI_Footprint
             FootprintPad,   ///< librepcb#project#BI_FootprintPad
             Polygon,        ///< librepcb#project#BI_Polygon
+            AirWire,        ///< librepcb#project#BI_AirWire
+            Plane,          ///< librepcb#project#BI_Plane
         };
 
         // Constructors / Destructor
@@ -57,7 +57,7 @@ class BI_Footprint;
 /**
  * @brief The BI_Device class
  */
-class BI_Device final : public BI_Base, public AttributeProvider,
+class BI_Device final : public QObject, public BI_Base, public AttributeProvider,
                         public IF_ErcMsgProvider, public SerializableObject
 {
         Q_OBJECT
@@ -243,8 +243,8 @@ void BI_Footprint::deviceInstanceAttributesChanged()
 
 void BI_Footprint::deviceInstanceMoved(const Point& pos)
 {
+    // the cached graphics are in item coordinates, so moving doesn't invalidate them
     mGraphicsItem->setPos(pos.toPxQPointF());
-    mGraphicsItem->updateCacheAndRepaint();
     foreach (BI_FootprintPad* pad, mPads) {
         pad->updatePosition();
     }
@@ -267,6 +267,7 @@ void BI_Footprint::deviceInstanceMirrored(bool mirrored)
     mGraphicsItem->updateCacheAndRepaint();
     foreach (BI_FootprintPad* pad, mPads) {
         pad->updatePosition();
+        pad->updateGraphicsItem(); // the board side of the pad has changed
     }
 }
 
@@ -54,7 +54,7 @@ class BI_FootprintPad;
  * @author ubruhin
  * @date 2015-05-24
  */
-class BI_Footprint final : public BI_Base, public SerializableObject,
+class BI_Footprint final : public QObject, public BI_Base, public SerializableObject,
                            public AttributeProvider
 {
         Q_OBJECT
@@ -53,7 +53,7 @@ namespace project {
 
 BI_FootprintPad::BI_FootprintPad(BI_Footprint& footprint, const Uuid& padUuid) :
     BI_Base(footprint.getBoard()), mFootprint(footprint), mFootprintPad(nullptr),
-    mPackagePad(nullptr), mComponentSignalInstance(nullptr)
+    mPackagePad(nullptr), mComponentSignalInstance(nullptr), mAirWiresNetSignal(nullptr)
 {
     mFootprintPad = mFootprint.getLibFootprint().getPads().get(padUuid).get(); // can throw
     mPackagePad = mFootprint.getDeviceInstance().getLibPackage().getPads().get(padUuid).get(); // can throw
@@ -176,16 +176,23 @@ void BI_FootprintPad::unregisterNetPoint(BI_NetPoint& netpoint)
     netpoint.updateLines();
 }
 
+void BI_FootprintPad::updateGraphicsItem() noexcept
+{
+    mGraphicsItem->updateCacheAndRepaint();
+}
+
 void BI_FootprintPad::updatePosition() noexcept
 {
     mPosition = mFootprint.mapToScene(mFootprintPad->getPosition());
     mRotation = mFootprint.getRotation() + mFootprintPad->getRotation();
     mGraphicsItem->setPos(mPosition.toPxQPointF());
     updateGraphicsItemTransform();
-    mGraphicsItem->updateCacheAndRepaint();
     foreach (BI_NetPoint* netpoint, mRegisteredNetPoints) {
         netpoint->setPosition(mPosition);
     }
+    if (isAddedToBoard() && mAirWiresNetSignal) {
+        mBoard.scheduleAirWiresRebuild(mAirWiresNetSignal);
+    }
 }
 
 /*****************************************************************************************
@@ -231,6 +238,14 @@ void BI_FootprintPad::componentSignalInstanceNetSignalChanged(NetSignal* netsign
         mHighlightChangedConnection = connect(netsignal, &NetSignal::highlightedChanged,
                                               [this](){mGraphicsItem->update();});
     }
+    // the airwires of both the old and the new netsignal need to be updated
+    if (mAirWiresNetSignal) {
+        mBoard.scheduleAirWiresRebuild(mAirWiresNetSignal);
+    }
+    if (netsignal) {
+        mBoard.scheduleAirWiresRebuild(netsignal);
+    }
+    mAirWiresNetSignal = netsignal;
 }
 
 /*****************************************************************************************
@@ -34,6 +34,7 @@ namespace librepcb {
 
 namespace library {
 class FootprintPad;
+class PackagePad;
 class ComponentSignal;
 }
 
@@ -51,7 +52,7 @@ class ComponentSignalInstance;
 /**
  * @brief The BI_FootprintPad class
  */
-class BI_FootprintPad final : public BI_Base
+class BI_FootprintPad final : public QObject, public BI_Base
 {
         Q_OBJECT
 
@@ -73,6 +74,7 @@ class BI_FootprintPad final : public BI_Base
         QString getLayerName() const noexcept;
         bool isOnLayer(const QString& layerName) const noexcept;
         const library::FootprintPad& getLibPad() const noexcept {return *mFootprintPad;}
+        const library::PackagePad& getLibPackagePad() const noexcept {return *mPackagePad;}
         ComponentSignalInstance* getComponentSignalInstance() const noexcept {return mComponentSignalInstance;}
         NetSignal* getCompSigInstNetSignal() const noexcept;
         bool isUsed() const noexcept {return (mRegisteredNetPoints.count() > 0);}
@@ -84,6 +86,7 @@ class BI_FootprintPad final : public BI_Base
         void registerNetPoint(BI_NetPoint& netpoint);
         void unregisterNetPoint(BI_NetPoint& netpoint);
         void updatePosition() noexcept;
+        void updateGraphicsItem() noexcept;
 
 
         // Inherited from BI_Base
@@ -114,6 +117,7 @@ class BI_FootprintPad final : public BI_Base
         const library::PackagePad* mPackagePad;
         ComponentSignalInstance* mComponentSignalInstance;
         QMetaObject::Connection mHighlightChangedConnection;
+        NetSignal* mAirWiresNetSignal; ///< the netsignal whose airwires contain this pad
 
         // Misc
         Point mPosition;
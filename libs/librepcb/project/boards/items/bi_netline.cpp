@@ -29,6 +29,7 @@
 #include "../../circuit/netsignal.h"
 #include "bi_footprint.h"
 #include "bi_footprintpad.h"
+#include "../boardgraphicsbatcher.h"
 #include <librepcb/common/graphics/graphicsscene.h>
 #include <librepcb/common/scopeguard.h>
 
@@ -196,10 +197,9 @@ void BI_NetLine::addToBoard()
     auto sg = scopeGuard([&](){mStartPoint->unregisterNetLine(*this);});
     mEndPoint->registerNetLine(*this); // can throw
 
-    mHighlightChangedConnection = connect(&getNetSignalOfNetSegment(),
-                                              &NetSignal::highlightedChanged,
-                                              [this](){mGraphicsItem->update();});
-    BI_Base::addToBoard(mGraphicsItem.data());
+    BI_Base::addToBoard(nullptr);
+    mBoard.getGraphicsBatcher().addItem(*mGraphicsItem, !isSelected());
+    mBoard.scheduleAirWiresRebuild(&getNetSignalOfNetSegment());
     sg.dismiss();
 }
 
@@ -216,8 +216,9 @@ void BI_NetLine::removeFromBoard()
     auto sg = scopeGuard([&](){mEndPoint->registerNetLine(*this);});
     mEndPoint->unregisterNetLine(*this); // can throw
 
-    disconnect(mHighlightChangedConnection);
-    BI_Base::removeFromBoard(mGraphicsItem.data());
+    mBoard.getGraphicsBatcher().removeItem(*mGraphicsItem);
+    BI_Base::removeFromBoard(nullptr);
+    mBoard.scheduleAirWiresRebuild(&getNetSignalOfNetSegment());
     sg.dismiss();
 }
 
@@ -227,6 +228,11 @@ void BI_NetLine::updateLine() noexcept
     mGraphicsItem->updateCacheAndRepaint();
 }
 
+void BI_NetLine::netSignalHighlightedChanged() noexcept
+{
+    mGraphicsItem->repaint();
+}
+
 void BI_NetLine::serialize(SExpression& root) const
 {
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
@@ -254,7 +260,11 @@ bool BI_NetLine::isSelectable() const noexcept
 void BI_NetLine::setSelected(bool selected) noexcept
 {
     BI_Base::setSelected(selected);
-    mGraphicsItem->update();
+    if (isAddedToBoard()) {
+        // selected items are painted individually to allow fast dragging
+        mBoard.getGraphicsBatcher().setBatchable(*mGraphicsItem, !selected);
+    }
+    mGraphicsItem->repaint();
 }
 
 /*****************************************************************************************
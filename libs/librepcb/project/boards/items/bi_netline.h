@@ -26,6 +26,7 @@
 #include <QtCore>
 #include "bi_base.h"
 #include <librepcb/common/fileio/serializableobject.h>
+#include <librepcb/common/memorypool.h>
 #include <librepcb/common/uuid.h>
 #include "../graphicsitems/bgi_netline.h"
 
@@ -51,7 +52,8 @@ class BI_NetSegment;
  */
 class BI_NetLine final : public BI_Base, public SerializableObject
 {
-        Q_OBJECT
+        Q_DECLARE_TR_FUNCTIONS(BI_NetLine)
+        DECLARE_MEMORY_POOL(BI_NetLine)
 
     public:
 
@@ -84,6 +86,7 @@ class BI_NetLine final : public BI_Base, public SerializableObject
         void addToBoard() override;
         void removeFromBoard() override;
         void updateLine() noexcept;
+        void netSignalHighlightedChanged() noexcept; ///< called by BI_NetSegment
 
         /// @copydoc librepcb::SerializableObject::serialize()
         void serialize(SExpression& root) const override;
@@ -109,7 +112,6 @@ class BI_NetLine final : public BI_Base, public SerializableObject
         // General
         QScopedPointer<BGI_NetLine> mGraphicsItem;
         Point mPosition; ///< the center of startpoint and endpoint
-        QMetaObject::Connection mHighlightChangedConnection;
 
         // Attributes
         Uuid mUuid;
@@ -230,6 +230,7 @@ void BI_NetPoint::setPadToAttach(BI_FootprintPad* pad)
             setPosition(pad->getPosition());
         }
         sgl.dismiss();
+        mBoard.scheduleAirWiresRebuild(&getNetSignalOfNetSegment());
     }
     mFootprintPad = pad;
     mGraphicsItem->updateCacheAndRepaint();
@@ -260,6 +261,7 @@ void BI_NetPoint::setViaToAttach(BI_Via* via)
             setPosition(via->getPosition());
         }
         sgl.dismiss();
+        mBoard.scheduleAirWiresRebuild(&getNetSignalOfNetSegment());
     }
     mVia = via;
     mGraphicsItem->updateCacheAndRepaint();
@@ -271,6 +273,9 @@ void BI_NetPoint::setPosition(const Point& position) noexcept
         mPosition = position;
         mGraphicsItem->setPos(mPosition.toPxQPointF());
         updateLines();
+        if (isAddedToBoard()) {
+            mBoard.scheduleAirWiresRebuild(&getNetSignalOfNetSegment());
+        }
     }
 }
 
@@ -296,11 +301,9 @@ void BI_NetPoint::addToBoard()
         }
         mVia->registerNetPoint(*this); // can throw
     }
-    mHighlightChangedConnection = connect(&getNetSignalOfNetSegment(),
-                                          &NetSignal::highlightedChanged,
-                                          [this](){mGraphicsItem->update();});
     mErcMsgDeadNetPoint->setVisible(true);
     BI_Base::addToBoard(mGraphicsItem.data());
+    mBoard.scheduleAirWiresRebuild(&getNetSignalOfNetSegment());
 }
 
 void BI_NetPoint::removeFromBoard()
@@ -321,9 +324,9 @@ void BI_NetPoint::removeFromBoard()
         }
         mVia->unregisterNetPoint(*this); // can throw
     }
-    disconnect(mHighlightChangedConnection);
     mErcMsgDeadNetPoint->setVisible(false);
     BI_Base::removeFromBoard(mGraphicsItem.data());
+    mBoard.scheduleAirWiresRebuild(&getNetSignalOfNetSegment());
 }
 
 void BI_NetPoint::registerNetLine(BI_NetLine& netline)
@@ -357,6 +360,11 @@ void BI_NetPoint::updateLines() const noexcept
     }
 }
 
+void BI_NetPoint::netSignalHighlightedChanged() noexcept
+{
+    mGraphicsItem->update();
+}
+
 void BI_NetPoint::serialize(SExpression& root) const
 {
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
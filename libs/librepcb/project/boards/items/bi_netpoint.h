@@ -26,6 +26,7 @@
 #include <QtCore>
 #include "bi_base.h"
 #include <librepcb/common/fileio/serializableobject.h>
+#include <librepcb/common/memorypool.h>
 #include <librepcb/common/uuid.h>
 #include "../../erc/if_ercmsgprovider.h"
 #include "../graphicsitems/bgi_netpoint.h"
@@ -59,8 +60,9 @@ class ErcMsg;
 class BI_NetPoint final : public BI_Base, public SerializableObject,
                           public IF_ErcMsgProvider
 {
-        Q_OBJECT
+        Q_DECLARE_TR_FUNCTIONS(BI_NetPoint)
         DECLARE_ERC_MSG_CLASS_NAME(BI_NetPoint)
+        DECLARE_MEMORY_POOL(BI_NetPoint)
 
     public:
 
@@ -102,6 +104,7 @@ class BI_NetPoint final : public BI_Base, public SerializableObject,
         void registerNetLine(BI_NetLine& netline);
         void unregisterNetLine(BI_NetLine& netline);
         void updateLines() const noexcept;
+        void netSignalHighlightedChanged() noexcept; ///< called by BI_NetSegment
 
 
         /// @copydoc librepcb::SerializableObject::serialize()
@@ -129,7 +132,6 @@ class BI_NetPoint final : public BI_Base, public SerializableObject,
 
         // General
         QScopedPointer<BGI_NetPoint> mGraphicsItem;
-        QMetaObject::Connection mHighlightChangedConnection;
 
         // Attributes
         BI_NetSegment& mNetSegment;
@@ -49,6 +49,8 @@ BI_NetSegment::BI_NetSegment(Board& board, const BI_NetSegment& other,
                              const QHash<const BI_Device*, BI_Device*>& devMap) :
     BI_Base(board), mUuid(Uuid::createRandom()), mNetSignal(&other.getNetSignal())
 {
+    init();
+
     // copy vias
     QHash<const BI_Via*, BI_Via*> viaMap;
     foreach (const BI_Via* via, other.mVias) {
@@ -85,6 +87,8 @@ BI_NetSegment::BI_NetSegment(Board& board, const BI_NetSegment& other,
 BI_NetSegment::BI_NetSegment(Board& board, const SExpression& node) :
     BI_Base(board), mUuid(), mNetSignal(nullptr)
 {
+    init();
+
     try
     {
         mUuid = node.getChildByIndex(0).getValue<Uuid>(true);
@@ -156,6 +160,14 @@ BI_NetSegment::BI_NetSegment(Board& board, const SExpression& node) :
 BI_NetSegment::BI_NetSegment(Board& board, NetSignal& signal) :
     BI_Base(board), mUuid(Uuid::createRandom()), mNetSignal(&signal)
 {
+    init();
+}
+
+void BI_NetSegment::init() noexcept
+{
+    // update the vias when the board attributes have changed
+    connect(&mBoard, &Board::attributesChanged,
+            this, &BI_NetSegment::boardAttributesChanged);
 }
 
 BI_NetSegment::~BI_NetSegment() noexcept
@@ -235,6 +247,11 @@ void BI_NetSegment::setNetSignal(NetSignal& netsignal)
             auto sg = scopeGuard([&](){mNetSignal->registerBoardNetSegment(*this);});
             netsignal.registerBoardNetSegment(*this); // can throw
             sg.dismiss();
+            mBoard.scheduleAirWiresRebuild(mNetSignal);
+            mBoard.scheduleAirWiresRebuild(&netsignal);
+            disconnect(mHighlightChangedConnection);
+            mHighlightChangedConnection = connect(&netsignal, &NetSignal::highlightedChanged,
+                                                  this, &BI_NetSegment::netSignalHighlightedChanged);
         }
         mNetSignal = &netsignal;
     }
@@ -419,6 +436,8 @@ void BI_NetSegment::addToBoard()
         sgl.add([netline](){netline->removeFromBoard();});
     }
 
+    mHighlightChangedConnection = connect(mNetSignal, &NetSignal::highlightedChanged,
+                                          this, &BI_NetSegment::netSignalHighlightedChanged);
     BI_Base::addToBoard(nullptr);
     sgl.dismiss();
 }
@@ -445,6 +464,7 @@ void BI_NetSegment::removeFromBoard()
     mNetSignal->unregisterBoardNetSegment(*this); // can throw
     sgl.add([&](){mNetSignal->registerBoardNetSegment(*this);});
 
+    disconnect(mHighlightChangedConnection);
     BI_Base::removeFromBoard(nullptr);
     sgl.dismiss();
 }
@@ -507,6 +527,26 @@ void BI_NetSegment::setSelected(bool selected) noexcept
  *  Private Methods
  ****************************************************************************************/
 
+void BI_NetSegment::netSignalHighlightedChanged() noexcept
+{
+    foreach (BI_Via* via, mVias) {
+        if (via->isAddedToBoard()) via->netSignalHighlightedChanged();
+    }
+    foreach (BI_NetPoint* netpoint, mNetPoints) {
+        if (netpoint->isAddedToBoard()) netpoint->netSignalHighlightedChanged();
+    }
+    foreach (BI_NetLine* netline, mNetLines) {
+        if (netline->isAddedToBoard()) netline->netSignalHighlightedChanged();
+    }
+}
+
+void BI_NetSegment::boardAttributesChanged() noexcept
+{
+    foreach (BI_Via* via, mVias) {
+        via->boardAttributesChanged();
+    }
+}
+
 bool BI_NetSegment::checkAttributesValidity() const noexcept
 {
     if (mUuid.isNull())                         return false;
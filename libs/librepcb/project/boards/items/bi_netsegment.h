@@ -50,9 +50,12 @@ class BI_NetLine;
 /**
  * @brief The BI_NetSegment class
  *
+ * Vias, net points and net lines are not QObjects, so the netsegment forwards the
+ * relevant signals (e.g. net signal highlighting) to all of its items.
+ *
  * @todo Do not allow to create empty netsegments!
  */
-class BI_NetSegment final : public BI_Base, public SerializableObject
+class BI_NetSegment final : public QObject, public BI_Base, public SerializableObject
 {
         Q_OBJECT
 
@@ -123,11 +126,17 @@ class BI_NetSegment final : public BI_Base, public SerializableObject
 
 
     private:
+        void init() noexcept;
+        void netSignalHighlightedChanged() noexcept;
+        void boardAttributesChanged() noexcept;
         bool checkAttributesValidity() const noexcept;
         bool areAllNetPointsConnectedTogether() const noexcept;
         void findAllConnectedNetPoints(const BI_NetPoint& p, QList<const BI_NetPoint*>& points) const noexcept;
 
 
+        // General
+        QMetaObject::Connection mHighlightChangedConnection;
+
         // Attributes
         Uuid mUuid;
         NetSignal* mNetSignal;
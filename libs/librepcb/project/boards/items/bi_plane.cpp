@@ -0,0 +1,186 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "bi_plane.h"
+#include "../board.h"
+#include "../../project.h"
+#include "../../circuit/circuit.h"
+#include "../../circuit/netsignal.h"
+#include <librepcb/common/graphics/graphicslayer.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BI_Plane::BI_Plane(Board& board, const BI_Plane& other) :
+    BI_Base(board), mUuid(Uuid::createRandom()), mLayerName(other.mLayerName),
+    mNetSignal(other.mNetSignal), mOutline(other.mOutline),
+    mMinClearance(other.mMinClearance), mSpokeWidth(other.mSpokeWidth),
+    mConnectStyle(other.mConnectStyle), mKeepOrphans(other.mKeepOrphans),
+    mFragments(other.mFragments), mFragmentsInputHash(other.mFragmentsInputHash)
+{
+    init();
+}
+
+BI_Plane::BI_Plane(Board& board, const SExpression& node) :
+    BI_Base(board), mNetSignal(nullptr)
+{
+    mUuid = node.getChildByIndex(0).getValue<Uuid>(true);
+    mLayerName = node.getValueByPath<QString>("layer", true);
+    Uuid netSignalUuid = node.getValueByPath<Uuid>("net", true);
+    mNetSignal = mBoard.getProject().getCircuit().getNetSignalByUuid(netSignalUuid);
+    if (!mNetSignal) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("Invalid net signal UUID: \"%1\"")).arg(netSignalUuid.toStr()));
+    }
+    mMinClearance = node.getValueByPath<Length>("min_clearance", true);
+    mSpokeWidth = node.getValueByPath<Length>("spoke_width", true);
+    QString connectStyleStr = node.getValueByPath<QString>("connect_style", true);
+    if (connectStyleStr == "none") {
+        mConnectStyle = ConnectStyle::None;
+    } else if (connectStyleStr == "thermal") {
+        mConnectStyle = ConnectStyle::Thermal;
+    } else if (connectStyleStr == "solid") {
+        mConnectStyle = ConnectStyle::Solid;
+    } else {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("Invalid plane connect style: \"%1\"")).arg(connectStyleStr));
+    }
+    mKeepOrphans = node.getValueByPath<bool>("keep_orphans", true);
+    mOutline = Path(node); // can throw
+
+    if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
+    init();
+}
+
+BI_Plane::BI_Plane(Board& board, const Uuid& uuid, const QString& layerName,
+                   NetSignal& netsignal, const Path& outline) :
+    BI_Base(board), mUuid(uuid), mLayerName(layerName), mNetSignal(&netsignal),
+    mOutline(outline), mMinClearance(300000), mSpokeWidth(300000),
+    mConnectStyle(ConnectStyle::Thermal), mKeepOrphans(false)
+{
+    if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
+    init();
+}
+
+void BI_Plane::init()
+{
+    mGraphicsItem.reset(new BGI_Plane(*this));
+}
+
+BI_Plane::~BI_Plane() noexcept
+{
+    mGraphicsItem.reset();
+}
+
+/*****************************************************************************************
+ *  Setters
+ ****************************************************************************************/
+
+void BI_Plane::setFragments(const QVector<Path>& fragments, const QByteArray& inputHash) noexcept
+{
+    mFragments = fragments;
+    mFragmentsInputHash = inputHash;
+    mGraphicsItem->updateCacheAndRepaint();
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void BI_Plane::addToBoard()
+{
+    if (isAddedToBoard()) {
+        throw LogicError(__FILE__, __LINE__);
+    }
+    mNetSignal->registerBoardPlane(*this); // can throw
+    mHighlightChangedConnection = connect(mNetSignal, &NetSignal::highlightedChanged,
+                                          [this](){mGraphicsItem->update();});
+    BI_Base::addToBoard(mGraphicsItem.data());
+}
+
+void BI_Plane::removeFromBoard()
+{
+    if (!isAddedToBoard()) {
+        throw LogicError(__FILE__, __LINE__);
+    }
+    mNetSignal->unregisterBoardPlane(*this); // can throw
+    disconnect(mHighlightChangedConnection);
+    BI_Base::removeFromBoard(mGraphicsItem.data());
+}
+
+void BI_Plane::serialize(SExpression& root) const
+{
+    if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
+
+    root.appendToken(mUuid);
+    root.appendTokenChild("layer", mLayerName, false);
+    root.appendTokenChild("net", mNetSignal->getUuid(), true);
+    root.appendTokenChild("min_clearance", mMinClearance, false);
+    root.appendTokenChild("spoke_width", mSpokeWidth, false);
+    switch (mConnectStyle) {
+        case ConnectStyle::None:    root.appendTokenChild<QString>("connect_style", "none", false); break;
+        case ConnectStyle::Thermal: root.appendTokenChild<QString>("connect_style", "thermal", false); break;
+        case ConnectStyle::Solid:   root.appendTokenChild<QString>("connect_style", "solid", false); break;
+        default: throw LogicError(__FILE__, __LINE__);
+    }
+    root.appendTokenChild("keep_orphans", mKeepOrphans, false);
+    mOutline.serialize(root);
+}
+
+/*****************************************************************************************
+ *  Inherited from BI_Base
+ ****************************************************************************************/
+
+QPainterPath BI_Plane::getGrabAreaScenePx() const noexcept
+{
+    return QPainterPath();
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+bool BI_Plane::checkAttributesValidity() const noexcept
+{
+    if (mUuid.isNull())                                 return false;
+    if (!GraphicsLayer::isCopperLayer(mLayerName))      return false;
+    if (mNetSignal == nullptr)                          return false;
+    if (mOutline.getVertices().count() < 3)             return false;
+    if (mMinClearance < 0)                              return false;
+    if (mSpokeWidth <= 0)                               return false;
+    return true;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,142 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BI_PLANE_H
+#define LIBREPCB_PROJECT_BI_PLANE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "bi_base.h"
+#include "../graphicsitems/bgi_plane.h"
+#include <librepcb/common/uuid.h>
+#include <librepcb/common/geometry/path.h>
+#include <librepcb/common/fileio/serializableobject.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class NetSignal;
+
+/*****************************************************************************************
+ *  Class BI_Plane
+ ****************************************************************************************/
+
+/**
+ * @brief The BI_Plane class represents a copper area (pour) connected to a net
+ *
+ * A plane fills its outline with copper, keeping the clearance to all copper objects
+ * of other nets. The resulting fragments are calculated by
+ * librepcb::project::BoardPlaneFragmentsBuilder when calling
+ * librepcb::project::Board::rebuildAllPlanes(). They are not serialized, but the hash
+ * of the inputs they were calculated from is kept to skip unnecessary refills.
+ */
+class BI_Plane final : public QObject, public BI_Base, public SerializableObject
+{
+        Q_OBJECT
+
+    public:
+
+        // Types
+
+        /// How pads of the plane's net are connected to the plane
+        enum class ConnectStyle {
+            None,       ///< no connection, pads are isolated like foreign pads
+            Thermal,    ///< clearance around the pads, bridged with four spokes
+            Solid,      ///< pads are fully covered by the plane
+        };
+
+        // Constructors / Destructor
+        BI_Plane() = delete;
+        BI_Plane(const BI_Plane& other) = delete;
+        BI_Plane(Board& board, const BI_Plane& other);
+        BI_Plane(Board& board, const SExpression& node);
+        BI_Plane(Board& board, const Uuid& uuid, const QString& layerName,
+                 NetSignal& netsignal, const Path& outline);
+        ~BI_Plane() noexcept;
+
+        // Getters
+        const Uuid& getUuid() const noexcept {return mUuid;}
+        const QString& getLayerName() const noexcept {return mLayerName;}
+        NetSignal& getNetSignal() const noexcept {return *mNetSignal;}
+        const Path& getOutline() const noexcept {return mOutline;}
+        const Length& getMinClearance() const noexcept {return mMinClearance;}
+        const Length& getSpokeWidth() const noexcept {return mSpokeWidth;}
+        ConnectStyle getConnectStyle() const noexcept {return mConnectStyle;}
+        bool getKeepOrphans() const noexcept {return mKeepOrphans;}
+        const QVector<Path>& getFragments() const noexcept {return mFragments;}
+        const QByteArray& getFragmentsInputHash() const noexcept {return mFragmentsInputHash;}
+
+        // Setters
+        void setFragments(const QVector<Path>& fragments, const QByteArray& inputHash) noexcept;
+
+        // General Methods
+        void addToBoard() override;
+        void removeFromBoard() override;
+
+        /// @copydoc librepcb::SerializableObject::serialize()
+        void serialize(SExpression& root) const override;
+
+        // Inherited from BI_Base
+        Type_t getType() const noexcept override {return BI_Base::Type_t::Plane;}
+        const Point& getPosition() const noexcept override {static Point p(0, 0); return p;}
+        bool getIsMirrored() const noexcept override {return false;}
+        QPainterPath getGrabAreaScenePx() const noexcept override;
+        bool isSelectable() const noexcept override {return false;}
+
+        // Operator Overloadings
+        BI_Plane& operator=(const BI_Plane& rhs) = delete;
+
+
+    private:
+        void init();
+        bool checkAttributesValidity() const noexcept;
+
+
+        // General
+        QScopedPointer<BGI_Plane> mGraphicsItem;
+        QMetaObject::Connection mHighlightChangedConnection;
+
+        // Attributes
+        Uuid mUuid;
+        QString mLayerName;
+        NetSignal* mNetSignal;
+        Path mOutline;
+        Length mMinClearance;
+        Length mSpokeWidth;
+        ConnectStyle mConnectStyle;
+        bool mKeepOrphans; ///< keep islands which are not connected to the net
+
+        // Calculated Fragments
+        QVector<Path> mFragments;
+        QByteArray mFragmentsInputHash;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BI_PLANE_H
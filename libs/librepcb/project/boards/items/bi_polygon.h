@@ -53,7 +53,7 @@ class BGI_Polygon;
  * @author ubruhin
  * @date 2016-01-12
  */
-class BI_Polygon final : public BI_Base, public SerializableObject
+class BI_Polygon final : public QObject, public BI_Base, public SerializableObject
 {
         Q_OBJECT
 
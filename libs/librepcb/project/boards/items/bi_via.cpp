@@ -30,6 +30,7 @@
 #include "../../project.h"
 #include "../../circuit/circuit.h"
 #include "../../circuit/netsignal.h"
+#include "../boardgraphicsbatcher.h"
 #include <librepcb/common/graphics/graphicsscene.h>
 
 /*****************************************************************************************
@@ -87,10 +88,6 @@ void BI_Via::init()
     mGraphicsItem.reset(new BGI_Via(*this));
     mGraphicsItem->setPos(mPosition.toPxQPointF());
 
-    // connect to the "attributes changed" signal of the board
-    connect(&mBoard, &Board::attributesChanged,
-            this, &BI_Via::boardAttributesChanged);
-
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
 }
 
@@ -162,7 +159,11 @@ void BI_Via::setPosition(const Point& position) noexcept
     if (position != mPosition) {
         mPosition = position;
         mGraphicsItem->setPos(mPosition.toPxQPointF());
+        mGraphicsItem->repaint();
         updateNetPoints();
+        if (isAddedToBoard()) {
+            mBoard.scheduleAirWiresRebuild(&getNetSignalOfNetSegment());
+        }
     }
 }
 
@@ -199,10 +200,9 @@ void BI_Via::addToBoard()
     if (isAddedToBoard() || isUsed()) {
         throw LogicError(__FILE__, __LINE__);
     }
-    mHighlightChangedConnection = connect(&getNetSignalOfNetSegment(),
-                                          &NetSignal::highlightedChanged,
-                                          [this](){mGraphicsItem->update();});
-    BI_Base::addToBoard(mGraphicsItem.data());
+    BI_Base::addToBoard(nullptr);
+    mBoard.getGraphicsBatcher().addItem(*mGraphicsItem, !isSelected());
+    mBoard.scheduleAirWiresRebuild(&getNetSignalOfNetSegment());
 }
 
 void BI_Via::removeFromBoard()
@@ -210,8 +210,9 @@ void BI_Via::removeFromBoard()
     if ((!isAddedToBoard()) || isUsed()) {
         throw LogicError(__FILE__, __LINE__);
     }
-    disconnect(mHighlightChangedConnection);
-    BI_Base::removeFromBoard(mGraphicsItem.data());
+    mBoard.getGraphicsBatcher().removeItem(*mGraphicsItem);
+    BI_Base::removeFromBoard(nullptr);
+    mBoard.scheduleAirWiresRebuild(&getNetSignalOfNetSegment());
 }
 
 void BI_Via::registerNetPoint(BI_NetPoint& netpoint)
@@ -243,6 +244,16 @@ void BI_Via::updateNetPoints() const noexcept
     }
 }
 
+void BI_Via::netSignalHighlightedChanged() noexcept
+{
+    mGraphicsItem->repaint();
+}
+
+void BI_Via::boardAttributesChanged() noexcept
+{
+    mGraphicsItem->updateCacheAndRepaint();
+}
+
 void BI_Via::serialize(SExpression& root) const
 {
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
@@ -276,18 +287,17 @@ bool BI_Via::isSelectable() const noexcept
 void BI_Via::setSelected(bool selected) noexcept
 {
     BI_Base::setSelected(selected);
-    mGraphicsItem->update();
+    if (isAddedToBoard()) {
+        // selected items are painted individually to allow fast dragging
+        mBoard.getGraphicsBatcher().setBatchable(*mGraphicsItem, !selected);
+    }
+    mGraphicsItem->repaint();
 }
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
-void BI_Via::boardAttributesChanged()
-{
-    mGraphicsItem->updateCacheAndRepaint();
-}
-
 bool BI_Via::checkAttributesValidity() const noexcept
 {
     if (mUuid.isNull())                             return false;
@@ -26,6 +26,7 @@
 #include <QtCore>
 #include "bi_base.h"
 #include <librepcb/common/fileio/serializableobject.h>
+#include <librepcb/common/memorypool.h>
 #include <librepcb/common/uuid.h>
 #include "../graphicsitems/bgi_via.h"
 
@@ -53,7 +54,8 @@ class ErcMsg;
  */
 class BI_Via final : public BI_Base, public SerializableObject
 {
-        Q_OBJECT
+        Q_DECLARE_TR_FUNCTIONS(BI_Via)
+        DECLARE_MEMORY_POOL(BI_Via)
 
     public:
 
@@ -95,6 +97,8 @@ class BI_Via final : public BI_Base, public SerializableObject
         void registerNetPoint(BI_NetPoint& netpoint);
         void unregisterNetPoint(BI_NetPoint& netpoint);
         void updateNetPoints() const noexcept;
+        void netSignalHighlightedChanged() noexcept; ///< called by BI_NetSegment
+        void boardAttributesChanged() noexcept; ///< called by BI_NetSegment
 
         /// @copydoc librepcb::SerializableObject::serialize()
         void serialize(SExpression& root) const override;
@@ -116,14 +120,12 @@ class BI_Via final : public BI_Base, public SerializableObject
     private:
 
         void init();
-        void boardAttributesChanged();
         bool checkAttributesValidity() const noexcept;
 
 
         // General
         BI_NetSegment& mNetSegment;
         QScopedPointer<BGI_Via> mGraphicsItem;
-        QMetaObject::Connection mHighlightChangedConnection;
 
         // Attributes
         Uuid mUuid;
@@ -75,6 +75,7 @@ class ComponentSignalInstance final : public QObject, public IF_ErcMsgProvider,
 
         // Getters
         Circuit& getCircuit() const noexcept {return mCircuit;}
+        ComponentInstance& getComponentInstance() const noexcept {return mComponentInstance;}
         const library::ComponentSignal& getCompSignal() const noexcept {return *mComponentSignal;}
         NetSignal* getNetSignal() const noexcept {return mNetSignal;}
         bool isNetSignalNameForced() const noexcept;
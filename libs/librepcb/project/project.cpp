@@ -21,7 +21,7 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
-#include <QPrinter>
+#include <QtConcurrent>
 #include <librepcb/common/exceptions.h>
 #include <librepcb/common/fileio/directorylock.h>
 #include <librepcb/common/fileio/smarttextfile.h>
@@ -29,6 +29,8 @@
 #include <librepcb/common/fileio/smartversionfile.h>
 #include <librepcb/common/fileio/sexpression.h>
 #include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/graphics/graphicsexport.h>
+#include <librepcb/common/graphics/graphicspagecache.h>
 #include "project.h"
 #include "library/projectlibrary.h"
 #include "circuit/circuit.h"
@@ -39,6 +41,7 @@
 #include "boards/board.h"
 #include <librepcb/common/application.h>
 #include "schematics/schematiclayerprovider.h"
+#include "schematics/schematicpainter.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -53,7 +56,7 @@ namespace project {
 Project::Project(const FilePath& filepath, bool create, bool readOnly) :
     QObject(nullptr), AttributeProvider(), mPath(filepath.getParentDir()),
     mFilepath(filepath), mLock(filepath.getParentDir()), mIsRestored(false),
-    mIsReadOnly(readOnly)
+    mIsReadOnly(readOnly), mSchematicPageCache(new GraphicsPageCache())
 {
     qDebug() << (create ? "create project:" : "open project:") << filepath.toNative();
 
@@ -120,6 +123,11 @@ Project::Project(const FilePath& filepath, bool create, bool readOnly) :
             break;
         }
         case DirectoryLock::LockStatus::StaleLock: {
+            if (mIsReadOnly) {
+                // the lock is not touched in read-only mode, so don't ask for restoring
+                // the backup (this also allows to open projects without user interaction)
+                break;
+            }
             // the application crashed while this project was open! ask the user what to do
             QMessageBox::StandardButton btn = QMessageBox::question(0, tr("Restore Project?"),
                 tr("It seems that the application was crashed while this project was open. "
@@ -358,22 +366,31 @@ void Project::removeSchematic(Schematic& schematic, bool deleteSchematic)
     }
 }
 
-void Project::exportSchematicsAsPdf(const FilePath& filepath)
+QFuture<void> Project::startSchematicsPdfExport(const FilePath& filepath) const
 {
-    QPrinter printer(QPrinter::HighResolution);
-    printer.setPaperSize(QPrinter::A4);
-    printer.setOrientation(QPrinter::Landscape);
-    printer.setOutputFormat(QPrinter::PdfFormat);
-    printer.setCreator(QString("LibrePCB %1").arg(qApp->applicationVersion()));
-    printer.setOutputFileName(filepath.toStr());
-
-    QList<int> pages;
-    for (int i = 0; i < mSchematics.count(); i++)
-        pages.append(i);
-
-    printSchematicPages(printer, pages);
+    if (mSchematics.isEmpty()) {
+        throw RuntimeError(__FILE__, __LINE__, tr("No schematic pages selected."));
+    }
 
-    QDesktopServices::openUrl(QUrl::fromLocalFile(filepath.toStr()));
+    // only snapshots of the schematics are taken here, the primitives are built from
+    // them in the thread pool, and only for pages which are not cached yet
+    QList<GraphicsExport::PdfPage> pages;
+    foreach (const Schematic* schematic, mSchematics) {
+        QSharedPointer<const SchematicPainter> painter(new SchematicPainter(*schematic));
+        pages.append(GraphicsExport::PdfPage{painter->getContentHash(), [painter](){
+            return GraphicsExport(painter->createPrimitives());
+        }});
+    }
+
+    // the job holds a reference to the cache, so it is kept alive even if the project
+    // is closed in the meantime
+    QSharedPointer<GraphicsPageCache> cache = mSchematicPageCache;
+    return QtConcurrent::run([pages, filepath, cache](){
+        QPageLayout layout(QPageSize(QPageSize::A4), QPageLayout::Landscape,
+                           QMarginsF(0, 0, 0, 0));
+        GraphicsExport::exportPdf(pages, filepath, cache.data(), layout); // can throw
+        cache->removeUnusedPages(); // keeps only the pages of this export
+    });
 }
 
 /*****************************************************************************************
@@ -697,35 +714,6 @@ bool Project::save(bool toOriginal, QStringList& errors) noexcept
     return success;
 }
 
-void Project::printSchematicPages(QPrinter& printer, QList<int>& pages)
-{
-    if (pages.isEmpty())
-        throw RuntimeError(__FILE__, __LINE__, tr("No schematic pages selected."));
-
-    QPainter painter(&printer);
-
-    for (int i = 0; i < pages.count(); i++)
-    {
-        Schematic* schematic = getSchematicByIndex(pages[i]);
-        if (!schematic)
-        {
-            throw RuntimeError(__FILE__, __LINE__,
-                QString(tr("No schematic page with the index %1 found.")).arg(pages[i]));
-        }
-        schematic->clearSelection();
-        schematic->renderToQPainter(painter);
-
-        if (i != pages.count() - 1)
-        {
-            if (!printer.newPage())
-            {
-                throw RuntimeError(__FILE__, __LINE__,
-                    tr("Unknown error while printing."));
-            }
-        }
-    }
-}
-
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
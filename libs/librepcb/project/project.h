@@ -34,10 +34,10 @@
 /*****************************************************************************************
  *  Namespace / Forward Declarations
  ****************************************************************************************/
-class QPrinter;
 
 namespace librepcb {
 
+class GraphicsPageCache;
 class SmartTextFile;
 class SmartSExprFile;
 class SmartVersionFile;
@@ -253,16 +253,22 @@ class Project final : public QObject, public AttributeProvider
         void removeSchematic(Schematic& schematic, bool deleteSchematic = false);
 
         /**
-         * @brief Export the schematic pages as a PDF
+         * @brief Start exporting the schematic pages as a PDF in the global thread pool
+         *
+         * Only snapshots of the schematics are taken in this method (see
+         * librepcb::project::SchematicPainter). The returned future then builds and
+         * records the pages in parallel and writes them into the PDF in order (A4
+         * landscape), without accessing the project anymore. Recorded pages are cached
+         * by the hash of their snapshot, so exporting again after a modification only
+         * renders the modified pages. QFuture::waitForFinished() rethrows errors of the
+         * export.
          *
          * @param filepath  The filepath where the PDF should be saved. If the file exists
          *                  already, it will be overwritten.
          *
-         * @throw Exception     On error
-         *
-         * @todo add more parameters (paper size, orientation, pages to print, ...)
+         * @throw Exception     If the project has no schematics
          */
-        void exportSchematicsAsPdf(const FilePath& filepath);
+        QFuture<void> startSchematicsPdfExport(const FilePath& filepath) const;
 
 
         // Board Methods
@@ -454,16 +460,6 @@ class Project final : public QObject, public AttributeProvider
          */
         bool save(bool toOriginal, QStringList& errors) noexcept;
 
-        /**
-         * @brief Print some schematics to a QPrinter (printer or file)
-         *
-         * @param printer   The QPrinter where to print the schematic pages
-         * @param pages     A list with all schematic page indexes which should be printed
-         *
-         * @throw Exception     On error
-         */
-        void printSchematicPages(QPrinter& printer, QList<int>& pages);
-
 
         // Project File (*.lpp)
         FilePath mPath; ///< the path to the project directory
@@ -490,6 +486,7 @@ class Project final : public QObject, public AttributeProvider
         QList<Board*> mBoards; ///< All boards of this project
         QList<Board*> mRemovedBoards; ///< All removed boards of this project
         QScopedPointer<AttributeList> mAttributes; ///< all attributes in a specific order
+        QSharedPointer<GraphicsPageCache> mSchematicPageCache; ///< recorded pages of the PDF export
 };
 
 /*****************************************************************************************
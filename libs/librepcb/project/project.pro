@@ -13,7 +13,7 @@ GENERATED_DIR = ../../../generated
 # Use common project definitions
 include(../../../common.pri)
 
-QT += core widgets xml sql printsupport
+QT += core widgets xml sql printsupport concurrent
 
 CONFIG += staticlib
 
@@ -22,8 +22,13 @@ INCLUDEPATH += \
 
 SOURCES += \
     boards/board.cpp \
+    boards/boardairwiresbuilder.cpp \
+    boards/boarddesignrulecheck.cpp \
     boards/boardgerberexport.cpp \
+    boards/boardgraphicsbatcher.cpp \
     boards/boardlayerstack.cpp \
+    boards/boardpainter.cpp \
+    boards/boardplanefragmentsbuilder.cpp \
     boards/boardselectionquery.cpp \
     boards/boardusersettings.cpp \
     boards/cmd/cmdboardadd.cpp \
@@ -42,12 +47,16 @@ SOURCES += \
     boards/cmd/cmddeviceinstanceadd.cpp \
     boards/cmd/cmddeviceinstanceedit.cpp \
     boards/cmd/cmddeviceinstanceremove.cpp \
+    boards/graphicsitems/bgi_airwire.cpp \
     boards/graphicsitems/bgi_base.cpp \
+    boards/graphicsitems/bgi_batch.cpp \
     boards/graphicsitems/bgi_footprint.cpp \
     boards/graphicsitems/bgi_footprintpad.cpp \
     boards/graphicsitems/bgi_netline.cpp \
     boards/graphicsitems/bgi_netpoint.cpp \
+    boards/graphicsitems/bgi_plane.cpp \
     boards/graphicsitems/bgi_via.cpp \
+    boards/items/bi_airwire.cpp \
     boards/items/bi_base.cpp \
     boards/items/bi_device.cpp \
     boards/items/bi_footprint.cpp \
@@ -55,6 +64,7 @@ SOURCES += \
     boards/items/bi_netline.cpp \
     boards/items/bi_netpoint.cpp \
     boards/items/bi_netsegment.cpp \
+    boards/items/bi_plane.cpp \
     boards/items/bi_polygon.cpp \
     boards/items/bi_via.cpp \
     circuit/circuit.cpp \
@@ -109,14 +119,20 @@ SOURCES += \
     schematics/items/si_symbolpin.cpp \
     schematics/schematic.cpp \
     schematics/schematiclayerprovider.cpp \
+    schematics/schematicpainter.cpp \
     schematics/schematicselectionquery.cpp \
     settings/cmd/cmdprojectsettingschange.cpp \
     settings/projectsettings.cpp \
 
 HEADERS += \
     boards/board.h \
+    boards/boardairwiresbuilder.h \
+    boards/boarddesignrulecheck.h \
     boards/boardgerberexport.h \
+    boards/boardgraphicsbatcher.h \
     boards/boardlayerstack.h \
+    boards/boardpainter.h \
+    boards/boardplanefragmentsbuilder.h \
     boards/boardselectionquery.h \
     boards/boardusersettings.h \
     boards/cmd/cmdboardadd.h \
@@ -135,12 +151,16 @@ HEADERS += \
     boards/cmd/cmddeviceinstanceadd.h \
     boards/cmd/cmddeviceinstanceedit.h \
     boards/cmd/cmddeviceinstanceremove.h \
+    boards/graphicsitems/bgi_airwire.h \
     boards/graphicsitems/bgi_base.h \
+    boards/graphicsitems/bgi_batch.h \
     boards/graphicsitems/bgi_footprint.h \
     boards/graphicsitems/bgi_footprintpad.h \
     boards/graphicsitems/bgi_netline.h \
     boards/graphicsitems/bgi_netpoint.h \
+    boards/graphicsitems/bgi_plane.h \
     boards/graphicsitems/bgi_via.h \
+    boards/items/bi_airwire.h \
     boards/items/bi_base.h \
     boards/items/bi_device.h \
     boards/items/bi_footprint.h \
@@ -148,6 +168,7 @@ HEADERS += \
     boards/items/bi_netline.h \
     boards/items/bi_netpoint.h \
     boards/items/bi_netsegment.h \
+    boards/items/bi_plane.h \
     boards/items/bi_polygon.h \
     boards/items/bi_via.h \
     circuit/circuit.h \
@@ -203,6 +224,7 @@ HEADERS += \
     schematics/items/si_symbolpin.h \
     schematics/schematic.h \
     schematics/schematiclayerprovider.h \
+    schematics/schematicpainter.h \
     schematics/schematicselectionquery.h \
     settings/cmd/cmdprojectsettingschange.h \
     settings/projectsettings.h \
@@ -93,7 +93,8 @@ void SGI_NetLabel::updateCacheAndRepaint() noexcept
     mStaticText.prepare(QTransform().rotate(mRotate180 ? 180 : 0)
                               .translate(mTextOrigin.x(), mTextOrigin.y()), mFont);
 
-    QRectF rect = QRectF(0, 0, mStaticText.size().width(), -mStaticText.size().height()).normalized();
+    // the text is drawn 0.5px above the origin if it is not rotated
+    QRectF rect = QRectF(0, 0, mStaticText.size().width(), -0.5-mStaticText.size().height()).normalized();
     qreal len = sOriginCrossLines[0].length();
     mBoundingRect = rect.united(QRectF(-len/2, -len/2, len, len)).normalized();
 
@@ -26,6 +26,7 @@
 #include <QtCore>
 #include <QtWidgets>
 #include "sgi_base.h"
+#include <librepcb/common/memorypool.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -47,6 +48,8 @@ class SI_NetLine;
  */
 class SGI_NetLine final : public SGI_Base
 {
+        DECLARE_MEMORY_POOL(SGI_NetLine)
+
     public:
 
         // Constructors / Destructor
@@ -30,6 +30,8 @@
 #include "../../project.h"
 #include "../../circuit/componentinstance.h"
 #include <librepcb/common/attributes/attributesubstitutor.h>
+#include <librepcb/common/graphics/levelofdetail.h>
+#include <librepcb/common/graphics/textlayoutcache.h>
 #include <librepcb/library/sym/symbol.h>
 #include <librepcb/library/cmp/component.h>
 
@@ -84,48 +86,45 @@ void SGI_Symbol::updateCacheAndRepaint() noexcept
         if (polygon.isGrabArea()) mShape = mShape.united(polygonPath);
     }
 
+    // ellipses
+    for (const Ellipse& ellipse : mLibSymbol.getEllipses()) {
+        qreal rx = (ellipse.getRadiusX() + ellipse.getLineWidth() / 2).toPx();
+        qreal ry = (ellipse.getRadiusY() + ellipse.getLineWidth() / 2).toPx();
+        QRectF ellipseRect(-rx, -ry, 2*rx, 2*ry);
+        mBoundingRect = mBoundingRect.united(ellipseRect.translated(ellipse.getCenter().toPxQPointF()));
+    }
+
     // texts
-    mCachedTextProperties.clear();
+    QHash<const Text*, CachedTextProperties_t> oldTextProperties;
+    oldTextProperties.swap(mCachedTextProperties);
     for (const Text& text : mLibSymbol.getTexts()) {
-        // create static text properties
+        // create text properties
         CachedTextProperties_t props;
 
-        // get the text to display
-        props.text = AttributeSubstitutor::substitute(text.getText(), &mSymbol);
-
-        // calculate font metrics
-        props.fontPixelSize = qCeil(text.getHeight().toPx());
-        mFont.setPixelSize(props.fontPixelSize);
-        QFontMetricsF metrics(mFont);
-        props.scaleFactor = text.getHeight().toPx() / metrics.height();
-        props.textRect = metrics.boundingRect(QRectF(), text.getAlign().toQtAlign() |
-                                              Qt::TextDontClip, props.text);
-        QRectF scaledTextRect = QRectF(props.textRect.topLeft() * props.scaleFactor,
-                                       props.textRect.bottomRight() * props.scaleFactor);
-
         // check rotation
         Angle absAngle = text.getRotation() + mSymbol.getRotation();
         absAngle.mapTo180deg();
         props.rotate180 = (absAngle <= -Angle::deg90() || absAngle > Angle::deg90());
 
-        // calculate text position
-        scaledTextRect.translate(text.getPosition().toPxQPointF());
-
-        // text alignment
-        if (props.rotate180)
-            props.flags = text.getAlign().mirrored().toQtAlign();
-        else
-            props.flags = text.getAlign().toQtAlign();
-
-        // calculate text bounding rect
-        mBoundingRect = mBoundingRect.united(scaledTextRect);
-        props.textRect = QRectF(scaledTextRect.topLeft() / props.scaleFactor,
-                                scaledTextRect.bottomRight() / props.scaleFactor);
-        if (props.rotate180)
-        {
-            props.textRect = QRectF(-props.textRect.x(), -props.textRect.y(),
-                                    -props.textRect.width(), -props.textRect.height()).normalized();
+        // get the layout of the substituted text (shared with all other instances), but
+        // only look it up again if the text, its size or its alignment has changed
+        QString str = AttributeSubstitutor::substitute(text.getText(), &mSymbol);
+        props.align = props.rotate180 ? text.getAlign().mirrored().toQtAlign()
+                                      : text.getAlign().toQtAlign();
+        props.pixelSize = qCeil(text.getHeight().toPx());
+        auto old = oldTextProperties.constFind(&text);
+        if ((old != oldTextProperties.constEnd()) && (old->layout->getText() == str)
+            && (old->pixelSize == props.pixelSize) && (old->align == props.align)) {
+            props.layout = old->layout;
+        } else {
+            mFont.setPixelSize(props.pixelSize);
+            props.layout = TextLayoutCache::instance().getLayout(str, mFont, props.align);
         }
+        props.scaleFactor = text.getHeight().toPx() / props.layout->getFontHeight();
+
+        // calculate text bounding rect (the text is rotated around its position)
+        QRectF textRect = getTextTransform(text, props).mapRect(props.layout->getBoundingRect());
+        mBoundingRect = mBoundingRect.united(textRect);
 
         // save properties
         mCachedTextProperties.insert(&text, props);
@@ -145,10 +144,15 @@ void SGI_Symbol::paint(QPainter* painter, const QStyleOptionGraphicsItem* option
     const GraphicsLayer* layer = 0;
     const bool selected = mSymbol.isSelected();
     const bool deviceIsPrinter = (dynamic_cast<QPrinter*>(painter->device()) != 0);
-    const qreal lod = option->levelOfDetailFromTransform(painter->worldTransform());
+    const qreal lod = LevelOfDetail::getLod(*painter, *option);
+    const LevelOfDetail& lodPolicy = LevelOfDetail::instance();
 
     // draw all polygons
     for (const Polygon& polygon : mLibSymbol.getPolygons()) {
+        // skip polygons which are too small to be seen
+        const QPainterPath& path = polygon.getPath().toQPainterPathPx();
+        if (!lodPolicy.isShapeVisible(lod, path.boundingRect())) continue;
+
         // set colors
         layer = getLayer(polygon.getLayerName());
         if (layer) {if (!layer->isVisible()) layer = nullptr;}
@@ -166,11 +170,16 @@ void SGI_Symbol::paint(QPainter* painter, const QStyleOptionGraphicsItem* option
         painter->setBrush(layer ? QBrush(layer->getColor(selected), Qt::SolidPattern) : Qt::NoBrush);
 
         // draw polygon
-        painter->drawPath(polygon.getPath().toQPainterPathPx());
+        painter->drawPath(path);
     }
 
     // draw all ellipses
     for (const Ellipse& ellipse : mLibSymbol.getEllipses()) {
+        // skip ellipses which are too small to be seen
+        qreal rx = ellipse.getRadiusX().toPx();
+        qreal ry = ellipse.getRadiusY().toPx();
+        if (!lodPolicy.isShapeVisible(lod, QRectF(-rx, -ry, 2*rx, 2*ry))) continue;
+
         // set colors
         layer = getLayer(ellipse.getLayerName());
         if (layer) {if (!layer->isVisible()) layer = nullptr;}
@@ -188,8 +197,7 @@ void SGI_Symbol::paint(QPainter* painter, const QStyleOptionGraphicsItem* option
         painter->setBrush(layer ? QBrush(layer->getColor(selected), Qt::SolidPattern) : Qt::NoBrush);
 
         // draw ellipse
-        painter->drawEllipse(ellipse.getCenter().toPxQPointF(), ellipse.getRadiusX().toPx(),
-                             ellipse.getRadiusY().toPx());
+        painter->drawEllipse(ellipse.getCenter().toPxQPointF(), rx, ry);
         // TODO: rotation
     }
 
@@ -200,28 +208,27 @@ void SGI_Symbol::paint(QPainter* painter, const QStyleOptionGraphicsItem* option
         if (!layer) continue;
         if (!layer->isVisible()) continue;
 
+        // skip texts which are too small to be seen
+        LevelOfDetail::TextMode textMode = lodPolicy.getTextMode(lod, text.getHeight().toPx());
+        if (textMode == LevelOfDetail::TextMode::Hidden) continue;
+
         // get cached text properties
         const CachedTextProperties_t& props = mCachedTextProperties.value(&text);
-        mFont.setPixelSize(props.fontPixelSize);
 
         // draw text or rect
         painter->save();
-        painter->translate(text.getPosition().toPxQPointF());
-        painter->rotate(-text.getRotation().toDeg());
-        painter->translate(-text.getPosition().toPxQPointF());
-        painter->scale(props.scaleFactor, props.scaleFactor);
-        if (props.rotate180) painter->rotate(180);
-        if ((deviceIsPrinter) || (lod * text.getHeight().toPx() > 8))
+        painter->setTransform(getTextTransform(text, props), true);
+        if (textMode == LevelOfDetail::TextMode::Full)
         {
-            // draw text
+            // draw text (replay the cached glyphs)
             painter->setPen(QPen(layer->getColor(selected), 0));
-            painter->setFont(mFont);
-            painter->drawText(props.textRect, props.flags, props.text);
+            props.layout->paint(*painter);
         }
         else
         {
             // fill rect
-            painter->fillRect(props.textRect, QBrush(layer->getColor(selected), Qt::Dense5Pattern));
+            painter->fillRect(props.layout->getBoundingRect(),
+                              QBrush(layer->getColor(selected), Qt::Dense5Pattern));
         }
 #ifdef QT_DEBUG
         layer = getLayer(GraphicsLayer::sDebugGraphicsItemsTextsBoundingRects); Q_ASSERT(layer);
@@ -230,7 +237,7 @@ void SGI_Symbol::paint(QPainter* painter, const QStyleOptionGraphicsItem* option
             // draw text bounding rect
             painter->setPen(QPen(layer->getColor(selected), 0));
             painter->setBrush(Qt::NoBrush);
-            painter->drawRect(props.textRect);
+            painter->drawRect(props.layout->getBoundingRect());
         }
 #endif
         painter->restore();
@@ -277,6 +284,17 @@ void SGI_Symbol::paint(QPainter* painter, const QStyleOptionGraphicsItem* option
  *  Private Methods
  ****************************************************************************************/
 
+QTransform SGI_Symbol::getTextTransform(const Text& text,
+                                    const CachedTextProperties_t& props) noexcept
+{
+    QTransform t = QTransform::fromTranslate(text.getPosition().toPxQPointF().x(),
+                                             text.getPosition().toPxQPointF().y());
+    t.rotate(-text.getRotation().toDeg());
+    t.scale(props.scaleFactor, props.scaleFactor);
+    if (props.rotate180) t.rotate(180);
+    return t;
+}
+
 GraphicsLayer* SGI_Symbol::getLayer(const QString& name) const noexcept
 {
     return mSymbol.getProject().getLayers().getLayer(name);
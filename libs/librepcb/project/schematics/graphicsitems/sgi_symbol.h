@@ -33,6 +33,7 @@
 namespace librepcb {
 
 class Text;
+class TextLayout;
 class GraphicsLayer;
 
 namespace library {
@@ -85,14 +86,17 @@ class SGI_Symbol final : public SGI_Base
         // Types
 
         struct CachedTextProperties_t {
-            QString text;
-            int fontPixelSize;
+            QSharedPointer<const TextLayout> layout; ///< shared, see librepcb::TextLayoutCache
+            int pixelSize;          ///< font size of the layout
+            Qt::Alignment align;    ///< alignment of the layout
             qreal scaleFactor;
             bool rotate180;
-            int flags;
-            QRectF textRect;    // not scaled
         };
 
+        // Static Methods
+        static QTransform getTextTransform(const Text& text,
+                                           const CachedTextProperties_t& props) noexcept;
+
 
         // General Attributes
         SI_Symbol& mSymbol;
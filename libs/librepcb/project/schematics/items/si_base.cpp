@@ -38,7 +38,7 @@ namespace project {
  ****************************************************************************************/
 
 SI_Base::SI_Base(Schematic& schematic) noexcept :
-    QObject(&schematic), mSchematic(schematic),
+    mSchematic(schematic),
     mIsAddedToSchematic(false), mIsSelected(false)
 {
 }
@@ -47,11 +47,12 @@ class SGI_Base;
 
 /**
  * @brief The Schematic Item Base (SI_Base) class
+ *
+ * Like librepcb::project::BI_Base, this is not a QObject. Items which need signals or
+ * slots additionally derive from QObject.
  */
-class SI_Base : public QObject
+class SI_Base
 {
-        Q_OBJECT
-
     public:
 
         // Types
@@ -46,7 +46,7 @@ class SI_NetSegment;
 /**
  * @brief The SI_NetLabel class
  */
-class SI_NetLabel final : public SI_Base, public SerializableObject
+class SI_NetLabel final : public QObject, public SI_Base, public SerializableObject
 {
         Q_OBJECT
 
@@ -165,9 +165,6 @@ void SI_NetLine::addToSchematic()
     auto sg = scopeGuard([&](){mStartPoint->unregisterNetLine(*this);});
     mEndPoint->registerNetLine(*this); // can throw
 
-    mHighlightChangedConnection = connect(&getNetSignalOfNetSegment(),
-                                          &NetSignal::highlightedChanged,
-                                          [this](){mGraphicsItem->update();});
     SI_Base::addToSchematic(mGraphicsItem.data());
     sg.dismiss();
 }
@@ -182,7 +179,6 @@ void SI_NetLine::removeFromSchematic()
     auto sg = scopeGuard([&](){mEndPoint->registerNetLine(*this);});
     mStartPoint->unregisterNetLine(*this); // can throw
 
-    disconnect(mHighlightChangedConnection);
     SI_Base::removeFromSchematic(mGraphicsItem.data());
     sg.dismiss();
 }
@@ -193,6 +189,11 @@ void SI_NetLine::updateLine() noexcept
     mGraphicsItem->updateCacheAndRepaint();
 }
 
+void SI_NetLine::netSignalHighlightedChanged() noexcept
+{
+    mGraphicsItem->update();
+}
+
 void SI_NetLine::serialize(SExpression& root) const
 {
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
@@ -26,6 +26,7 @@
 #include <QtCore>
 #include "si_base.h"
 #include <librepcb/common/fileio/serializableobject.h>
+#include <librepcb/common/memorypool.h>
 #include "../graphicsitems/sgi_netline.h"
 
 /*****************************************************************************************
@@ -47,7 +48,8 @@ class SI_NetSegment;
  */
 class SI_NetLine final : public SI_Base, public SerializableObject
 {
-        Q_OBJECT
+        Q_DECLARE_TR_FUNCTIONS(SI_NetLine)
+        DECLARE_MEMORY_POOL(SI_NetLine)
 
     public:
 
@@ -76,6 +78,7 @@ class SI_NetLine final : public SI_Base, public SerializableObject
         void addToSchematic() override;
         void removeFromSchematic() override;
         void updateLine() noexcept;
+        void netSignalHighlightedChanged() noexcept; ///< called by SI_NetSegment
 
         /// @copydoc librepcb::SerializableObject::serialize()
         void serialize(SExpression& root) const override;
@@ -100,7 +103,6 @@ class SI_NetLine final : public SI_Base, public SerializableObject
         // General
         QScopedPointer<SGI_NetLine> mGraphicsItem;
         Point mPosition; ///< the center of startpoint and endpoint
-        QMetaObject::Connection mHighlightChangedConnection;
 
         // Attributes
         Uuid mUuid;
@@ -198,9 +198,6 @@ void SI_NetPoint::addToSchematic()
         mSymbolPin->registerNetPoint(*this); // can throw
     }
 
-    mHighlightChangedConnection = connect(&getNetSignalOfNetSegment(),
-                                          &NetSignal::highlightedChanged,
-                                          [this](){mGraphicsItem->update();});
     mErcMsgDeadNetPoint->setVisible(true);
     SI_Base::addToSchematic(mGraphicsItem.data());
 }
@@ -219,7 +216,6 @@ void SI_NetPoint::removeFromSchematic()
         mSymbolPin->unregisterNetPoint(*this); // can throw
     }
 
-    disconnect(mHighlightChangedConnection);
     mErcMsgDeadNetPoint->setVisible(false);
     SI_Base::removeFromSchematic(mGraphicsItem.data());
 }
@@ -255,6 +251,11 @@ void SI_NetPoint::updateLines() const noexcept
     }
 }
 
+void SI_NetPoint::netSignalHighlightedChanged() noexcept
+{
+    mGraphicsItem->update();
+}
+
 void SI_NetPoint::serialize(SExpression& root) const
 {
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
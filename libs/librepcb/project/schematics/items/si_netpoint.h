@@ -26,6 +26,7 @@
 #include <QtCore>
 #include "si_base.h"
 #include <librepcb/common/fileio/serializableobject.h>
+#include <librepcb/common/memorypool.h>
 #include "../../erc/if_ercmsgprovider.h"
 #include "../graphicsitems/sgi_netpoint.h"
 
@@ -54,8 +55,9 @@ class ErcMsg;
 class SI_NetPoint final : public SI_Base, public SerializableObject,
                           public IF_ErcMsgProvider
 {
-        Q_OBJECT
+        Q_DECLARE_TR_FUNCTIONS(SI_NetPoint)
         DECLARE_ERC_MSG_CLASS_NAME(SI_NetPoint)
+        DECLARE_MEMORY_POOL(SI_NetPoint)
 
     public:
 
@@ -88,6 +90,7 @@ class SI_NetPoint final : public SI_Base, public SerializableObject,
         void registerNetLine(SI_NetLine& netline);
         void unregisterNetLine(SI_NetLine& netline);
         void updateLines() const noexcept;
+        void netSignalHighlightedChanged() noexcept; ///< called by SI_NetSegment
 
         /// @copydoc librepcb::SerializableObject::serialize()
         void serialize(SExpression& root) const override;
@@ -113,7 +116,6 @@ class SI_NetPoint final : public SI_Base, public SerializableObject,
 
         // General
         QScopedPointer<SGI_NetPoint> mGraphicsItem;
-        QMetaObject::Connection mHighlightChangedConnection;
 
         // Attributes
         SI_NetSegment& mNetSegment;
@@ -230,6 +230,9 @@ void SI_NetSegment::setNetSignal(NetSignal& netsignal)
             auto sg = scopeGuard([&](){mNetSignal->registerSchematicNetSegment(*this);});
             netsignal.registerSchematicNetSegment(*this); // can throw
             sg.dismiss();
+            disconnect(mHighlightChangedConnection);
+            mHighlightChangedConnection = connect(&netsignal, &NetSignal::highlightedChanged,
+                                                  this, &SI_NetSegment::netSignalHighlightedChanged);
         }
         mNetSignal = &netsignal;
     }
@@ -427,6 +430,8 @@ void SI_NetSegment::addToSchematic()
         sgl.add([netlabel](){netlabel->removeFromSchematic();});
     }
 
+    mHighlightChangedConnection = connect(mNetSignal, &NetSignal::highlightedChanged,
+                                          this, &SI_NetSegment::netSignalHighlightedChanged);
     SI_Base::addToSchematic(nullptr);
     sgl.dismiss();
 }
@@ -453,6 +458,7 @@ void SI_NetSegment::removeFromSchematic()
     mNetSignal->unregisterSchematicNetSegment(*this); // can throw
     sgl.add([&](){mNetSignal->registerSchematicNetSegment(*this);});
 
+    disconnect(mHighlightChangedConnection);
     SI_Base::removeFromSchematic(nullptr);
     sgl.dismiss();
 }
@@ -515,6 +521,16 @@ void SI_NetSegment::setSelected(bool selected) noexcept
  *  Private Methods
  ****************************************************************************************/
 
+void SI_NetSegment::netSignalHighlightedChanged() noexcept
+{
+    foreach (SI_NetPoint* netpoint, mNetPoints) {
+        if (netpoint->isAddedToSchematic()) netpoint->netSignalHighlightedChanged();
+    }
+    foreach (SI_NetLine* netline, mNetLines) {
+        if (netline->isAddedToSchematic()) netline->netSignalHighlightedChanged();
+    }
+}
+
 bool SI_NetSegment::checkAttributesValidity() const noexcept
 {
     if (mUuid.isNull())                         return false;
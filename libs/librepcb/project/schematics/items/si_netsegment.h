@@ -46,9 +46,12 @@ class SI_NetLabel;
 /**
  * @brief The SI_NetSegment class
  *
+ * Net points and net lines are not QObjects, so the netsegment forwards the
+ * highlighting of its net signal to them.
+ *
  * @todo Do not allow to create empty netsegments!
  */
-class SI_NetSegment final : public SI_Base, public SerializableObject
+class SI_NetSegment final : public QObject, public SI_Base, public SerializableObject
 {
         Q_OBJECT
 
@@ -119,11 +122,15 @@ class SI_NetSegment final : public SI_Base, public SerializableObject
 
 
     private:
+        void netSignalHighlightedChanged() noexcept;
         bool checkAttributesValidity() const noexcept;
         bool areAllNetPointsConnectedTogether() const noexcept;
         void findAllConnectedNetPoints(const SI_NetPoint& p, QList<const SI_NetPoint*>& points) const noexcept;
 
 
+        // General
+        QMetaObject::Connection mHighlightChangedConnection;
+
         // Attributes
         Uuid mUuid;
         NetSignal* mNetSignal;
@@ -55,7 +55,7 @@ class SI_SymbolPin;
  * @author ubruhin
  * @date 2014-08-23
  */
-class SI_Symbol final : public SI_Base, public SerializableObject,
+class SI_Symbol final : public QObject, public SI_Base, public SerializableObject,
                         public AttributeProvider
 {
         Q_OBJECT
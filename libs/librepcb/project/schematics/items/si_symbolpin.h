@@ -55,7 +55,7 @@ class ErcMsg;
 /**
  * @brief The SI_SymbolPin class
  */
-class SI_SymbolPin final : public SI_Base, public IF_ErcMsgProvider
+class SI_SymbolPin final : public QObject, public SI_Base, public IF_ErcMsgProvider
 {
         Q_OBJECT
         DECLARE_ERC_MSG_CLASS_NAME(SI_SymbolPin)
@@ -132,11 +132,13 @@ class Schematic final : public QObject, public AttributeProvider,
         const QIcon& getIcon() const noexcept {return mIcon;}
 
         // Symbol Methods
+        const QList<SI_Symbol*>& getSymbols() const noexcept {return mSymbols;}
         SI_Symbol* getSymbolByUuid(const Uuid& uuid) const noexcept;
         void addSymbol(SI_Symbol& symbol);
         void removeSymbol(SI_Symbol& symbol);
 
         // NetSegment Methods
+        const QList<SI_NetSegment*>& getNetSegments() const noexcept {return mNetSegments;}
         SI_NetSegment* getNetSegmentByUuid(const Uuid& uuid) const noexcept;
         void addNetSegment(SI_NetSegment& netsegment);
         void removeNetSegment(SI_NetSegment& netsegment);
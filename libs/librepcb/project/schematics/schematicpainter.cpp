@@ -0,0 +1,308 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include "schematicpainter.h"
+#include <librepcb/common/alignment.h>
+#include <librepcb/common/attributes/attributesubstitutor.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/library/sym/symbol.h>
+#include <librepcb/library/sym/symbolpin.h>
+#include "../project.h"
+#include "../circuit/netsignal.h"
+#include "schematic.h"
+#include "schematiclayerprovider.h"
+#include "items/si_netlabel.h"
+#include "items/si_netline.h"
+#include "items/si_netpoint.h"
+#include "items/si_netsegment.h"
+#include "items/si_symbol.h"
+#include "items/si_symbolpin.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+SchematicPainter::SchematicPainter(const Schematic& schematic) noexcept
+{
+    // same fonts as used by librepcb::project::SGI_Symbol and SGI_NetLabel
+    mSymbolFont.setStyleStrategy(QFont::StyleStrategy(QFont::OpenGLCompatible | QFont::PreferQuality));
+    mSymbolFont.setStyleHint(QFont::SansSerif);
+    mSymbolFont.setFamily("Nimbus Sans L");
+    mSymbolFont.setPixelSize(5);
+    mPinNameHeight = Length::fromPx(QFontMetricsF(mSymbolFont).height()); // can't throw
+
+    mNetLabelFont.setStyleStrategy(QFont::StyleStrategy(QFont::OpenGLCompatible | QFont::PreferQuality));
+    mNetLabelFont.setStyleHint(QFont::TypeWriter);
+    mNetLabelFont.setFamily("Monospace");
+    mNetLabelFont.setPixelSize(4);
+    mNetLabelHeight = Length::fromPx(QFontMetricsF(mNetLabelFont).height()); // can't throw
+
+    // take the snapshot
+    foreach (const GraphicsLayer* layer, schematic.getProject().getLayers().getAllLayers()) {
+        if (layer->isVisible()) {
+            mLayerColors.insert(layer->getName(), layer->getColor(false));
+        }
+    }
+    foreach (const SI_Symbol* symbol, schematic.getSymbols()) {
+        addSymbol(*symbol);
+    }
+    foreach (const SI_NetSegment* netsegment, schematic.getNetSegments()) {
+        addNetSegment(*netsegment);
+    }
+    mContentHash = calcContentHash();
+}
+
+SchematicPainter::~SchematicPainter() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+GraphicsPrimitives SchematicPainter::createPrimitives() const noexcept
+{
+    GraphicsPrimitives primitives;
+    foreach (const Symbol& symbol, mSymbols) {
+        paintSymbol(primitives, symbol);
+    }
+
+    if (const QColor* color = getLayerColor(GraphicsLayer::sSchematicNetLines)) {
+        foreach (const NetLine& netline, mNetLines) {
+            QPainterPath path;
+            path.moveTo(netline.startPosition.toPxQPointF());
+            path.lineTo(netline.endPosition.toPxQPointF());
+            primitives.addStroke(Schematic::ZValue_NetLines, *color, path,
+                                 netline.width.toPx());
+        }
+        qreal radius = Length(600000).toPx();
+        foreach (const Point& junction, mJunctions) {
+            QPainterPath path;
+            path.addEllipse(junction.toPxQPointF(), radius, radius);
+            primitives.addFill(Schematic::ZValue_VisibleNetPoints, *color, path);
+        }
+    }
+
+    if (const QColor* color = getLayerColor(GraphicsLayer::sSchematicNetLabels)) {
+        foreach (const NetLabel& netlabel, mNetLabels) {
+            Angle rotation = netlabel.rotation.mappedTo180deg();
+            bool rotate180 = (rotation <= -Angle::deg90() || rotation > Angle::deg90());
+            QPainterPath path = GraphicsPrimitives::createTextPath(
+                netlabel.text, mNetLabelFont, mNetLabelHeight,
+                Alignment(HAlign::left(), VAlign::bottom()), netlabel.position,
+                netlabel.rotation, rotate180);
+            primitives.addFill(Schematic::ZValue_NetLabels, *color, path);
+        }
+    }
+    return primitives;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void SchematicPainter::addSymbol(const SI_Symbol& symbol) noexcept
+{
+    // the geometry of library symbols is shared by all their instances
+    const library::Symbol& libSymbol = symbol.getLibSymbol();
+    if (!mLibSymbols.contains(libSymbol.getUuid())) {
+        LibSymbol& lib = mLibSymbols[libSymbol.getUuid()];
+        for (const Polygon& polygon : libSymbol.getPolygons()) lib.polygons.append(polygon);
+        for (const Ellipse& ellipse : libSymbol.getEllipses()) lib.ellipses.append(ellipse);
+        for (const Text& text : libSymbol.getTexts()) lib.texts.append(text);
+        mLibSymbolVersions.append(libSymbol.getUuid().toStr() % QChar(' ')
+                                  % libSymbol.getVersion().toStr());
+    }
+
+    Symbol s{libSymbol.getUuid(), symbol.getPosition(), symbol.getRotation(),
+             QStringList(), QVector<Pin>()};
+    for (const Text& text : libSymbol.getTexts()) {
+        s.texts.append(AttributeSubstitutor::substitute(text.getText(), &symbol));
+    }
+    for (const library::SymbolPin& libPin : libSymbol.getPins()) {
+        if (const SI_SymbolPin* pin = symbol.getPin(libPin.getUuid())) {
+            s.pins.append(Pin{pin->getPosition(), symbol.getRotation() + libPin.getRotation(),
+                              libPin.getLength(), pin->getDisplayText()});
+        }
+    }
+    mSymbols.append(s);
+}
+
+void SchematicPainter::addNetSegment(const SI_NetSegment& netsegment) noexcept
+{
+    foreach (const SI_NetLine* netline, netsegment.getNetLines()) {
+        mNetLines.append(NetLine{netline->getStartPoint().getPosition(),
+                                 netline->getEndPoint().getPosition(), netline->getWidth()});
+    }
+    foreach (const SI_NetPoint* netpoint, netsegment.getNetPoints()) {
+        if (netpoint->isVisibleJunction()) {
+            mJunctions.append(netpoint->getPosition());
+        }
+    }
+    foreach (const SI_NetLabel* netlabel, netsegment.getNetLabels()) {
+        mNetLabels.append(NetLabel{netlabel->getPosition(), netlabel->getRotation(),
+                                   netsegment.getNetSignal().getName()});
+    }
+}
+
+QByteArray SchematicPainter::calcContentHash() const noexcept
+{
+    // library symbols are identified by their uuid and version, so only the (small)
+    // instance specific data needs to be serialized
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    QStringList layers = mLayerColors.keys();
+    layers.sort();
+    foreach (const QString& layer, layers) {
+        stream << layer << mLayerColors.value(layer);
+    }
+    QStringList libSymbols = mLibSymbolVersions;
+    libSymbols.sort();
+    stream << libSymbols;
+    auto streamPoint = [&stream](const Point& p){stream << p.getX().toNm() << p.getY().toNm();};
+    foreach (const Symbol& symbol, mSymbols) {
+        stream << symbol.libSymbolUuid << symbol.rotation.toMicroDeg() << symbol.texts;
+        streamPoint(symbol.position);
+        foreach (const Pin& pin, symbol.pins) {
+            streamPoint(pin.position);
+            stream << pin.rotation.toMicroDeg() << pin.length.toNm() << pin.name;
+        }
+    }
+    foreach (const NetLine& netline, mNetLines) {
+        streamPoint(netline.startPosition);
+        streamPoint(netline.endPosition);
+        stream << netline.width.toNm();
+    }
+    foreach (const Point& junction, mJunctions) {
+        streamPoint(junction);
+    }
+    foreach (const NetLabel& netlabel, mNetLabels) {
+        streamPoint(netlabel.position);
+        stream << netlabel.rotation.toMicroDeg() << netlabel.text;
+    }
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+}
+
+void SchematicPainter::paintSymbol(GraphicsPrimitives& primitives,
+                                   const Symbol& symbol) const noexcept
+{
+    const LibSymbol& libSymbol = *mLibSymbols.find(symbol.libSymbolUuid);
+    const qreal z = Schematic::ZValue_Symbols;
+
+    // same transformation as the graphics item, see SI_Symbol
+    QTransform transform = QTransform::fromTranslate(symbol.position.toPxQPointF().x(),
+                                                     symbol.position.toPxQPointF().y());
+    transform.rotate(-symbol.rotation.toDeg());
+
+    // polygons (outlines are always drawn, with a cosmetic pen if the width is zero)
+    foreach (const Polygon& polygon, libSymbol.polygons) {
+        QPainterPath path = transform.map(polygon.getPath().toQPainterPathPx());
+        const QColor* color = getLayerColor(polygon.getLayerName());
+        const QColor* fillColor = nullptr;
+        if (polygon.isFilled()) {
+            fillColor = color;
+        } else if (polygon.isGrabArea()) {
+            fillColor = getLayerColor(GraphicsLayer::sSymbolGrabAreas);
+        }
+        if (fillColor) primitives.addFill(z, *fillColor, path);
+        if (color) primitives.addStroke(z, *color, path, polygon.getLineWidth().toPx());
+    }
+
+    // ellipses
+    foreach (const Ellipse& ellipse, libSymbol.ellipses) {
+        QTransform t = QTransform::fromTranslate(ellipse.getCenter().toPxQPointF().x(),
+                                                 ellipse.getCenter().toPxQPointF().y());
+        t.rotate(-ellipse.getRotation().toDeg());
+        QPainterPath path;
+        path.addEllipse(QPointF(0, 0), ellipse.getRadiusX().toPx(), ellipse.getRadiusY().toPx());
+        path = (t * transform).map(path);
+        const QColor* color = getLayerColor(ellipse.getLayerName());
+        const QColor* fillColor = nullptr;
+        if (ellipse.isFilled()) {
+            fillColor = color;
+        } else if (ellipse.isGrabArea()) {
+            fillColor = getLayerColor(GraphicsLayer::sSymbolGrabAreas);
+        }
+        if (fillColor) primitives.addFill(z, *fillColor, path);
+        if (color) primitives.addStroke(z, *color, path, ellipse.getLineWidth().toPx());
+    }
+
+    // texts
+    for (int i = 0; (i < libSymbol.texts.count()) && (i < symbol.texts.count()); ++i) {
+        const Text& text = libSymbol.texts.at(i);
+        const QColor* color = getLayerColor(text.getLayerName());
+        if (!color) continue;
+        Angle absAngle = text.getRotation() + symbol.rotation;
+        absAngle.mapTo180deg();
+        bool rotate180 = (absAngle <= -Angle::deg90() || absAngle > Angle::deg90());
+        QPainterPath path = GraphicsPrimitives::createTextPath(
+            symbol.texts.at(i), mSymbolFont, text.getHeight(), text.getAlign(),
+            text.getPosition(), text.getRotation(), rotate180);
+        primitives.addFill(z, *color, transform.map(path));
+    }
+
+    // pins
+    const QColor* lineColor = getLayerColor(GraphicsLayer::sSymbolOutlines);
+    const QColor* nameColor = getLayerColor(GraphicsLayer::sSymbolPinNames);
+    foreach (const Pin& pin, symbol.pins) {
+        Angle rotation = pin.rotation;
+        QTransform t = QTransform::fromTranslate(pin.position.toPxQPointF().x(),
+                                                 pin.position.toPxQPointF().y());
+        t.rotate(-rotation.toDeg());
+        if (lineColor) {
+            QPainterPath path;
+            path.moveTo(0, 0);
+            path.lineTo(pin.length.toPx(), 0);
+            primitives.addStroke(z, *lineColor, t.map(path), Length(158750).toPx());
+        }
+        if (nameColor && (!pin.name.isEmpty())) {
+            rotation.mapTo180deg();
+            bool rotate180 = (rotation <= -Angle::deg90() || rotation > Angle::deg90());
+            Point pos(pin.length + Length(1411111), Length(0)); // +4px
+            QPainterPath path = GraphicsPrimitives::createTextPath(
+                pin.name, mSymbolFont, mPinNameHeight, Alignment(HAlign::left(), VAlign::center()),
+                pos, Angle::deg0(), rotate180);
+            primitives.addFill(z, *nameColor, t.map(path));
+        }
+    }
+}
+
+const QColor* SchematicPainter::getLayerColor(const QString& name) const noexcept
+{
+    auto it = mLayerColors.constFind(name);
+    return (it != mLayerColors.constEnd()) ? &(*it) : nullptr;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
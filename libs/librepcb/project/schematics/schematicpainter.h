@@ -0,0 +1,152 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_SCHEMATICPAINTER_H
+#define LIBREPCB_PROJECT_SCHEMATICPAINTER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include <librepcb/common/geometry/ellipse.h>
+#include <librepcb/common/geometry/polygon.h>
+#include <librepcb/common/geometry/text.h>
+#include <librepcb/common/graphics/graphicsprimitives.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Schematic;
+class SI_Symbol;
+class SI_NetSegment;
+
+/*****************************************************************************************
+ *  Class SchematicPainter
+ ****************************************************************************************/
+
+/**
+ * @brief The SchematicPainter class converts a schematic to librepcb::GraphicsPrimitives
+ *
+ * The primitives show the schematic as it should look on paper, i.e. without origin
+ * crosses, pin circles and open line ends, and are built directly from the schematic
+ * items instead of the graphics scene.
+ *
+ * The constructor takes a snapshot of all data needed to paint the schematic (positions,
+ * substituted texts, library geometry, layer colors). Building the primitives from this
+ * snapshot is the expensive part (paths, text layouts), but doesn't access the
+ * schematic anymore, so #createPrimitives() can be called in any thread.
+ *
+ * @note The constructor must be called in the thread which owns the schematic.
+ *
+ * @see librepcb::project::BoardPainter
+ */
+class SchematicPainter final
+{
+    public:
+
+        // Constructors / Destructor
+        SchematicPainter() = delete;
+        SchematicPainter(const SchematicPainter& other) = delete;
+        explicit SchematicPainter(const Schematic& schematic) noexcept;
+        ~SchematicPainter() noexcept;
+
+        // Getters
+
+        /**
+         * @brief Get a hash over the snapshot (i.e. over everything which affects the
+         *        primitives), calculated without building the primitives
+         */
+        const QByteArray& getContentHash() const noexcept {return mContentHash;}
+
+        // General Methods
+        GraphicsPrimitives createPrimitives() const noexcept;
+
+        // Operator Overloadings
+        SchematicPainter& operator=(const SchematicPainter& rhs) = delete;
+
+
+    private:
+
+        // Types
+        struct LibSymbol {
+            QList<Polygon> polygons;
+            QList<Ellipse> ellipses;
+            QList<Text> texts;
+        };
+        struct Pin {
+            Point position;
+            Angle rotation;
+            Length length;
+            QString name;
+        };
+        struct Symbol {
+            Uuid libSymbolUuid;
+            Point position;
+            Angle rotation;
+            QStringList texts;  ///< substituted texts, same order as LibSymbol::texts
+            QVector<Pin> pins;
+        };
+        struct NetLine {
+            Point startPosition;
+            Point endPosition;
+            Length width;
+        };
+        struct NetLabel {
+            Point position;
+            Angle rotation;
+            QString text;
+        };
+
+        // Private Methods
+        void addSymbol(const SI_Symbol& symbol) noexcept;
+        void addNetSegment(const SI_NetSegment& netsegment) noexcept;
+        QByteArray calcContentHash() const noexcept;
+        void paintSymbol(GraphicsPrimitives& primitives, const Symbol& symbol) const noexcept;
+        const QColor* getLayerColor(const QString& name) const noexcept;
+
+
+        // Snapshot
+        QHash<QString, QColor> mLayerColors; ///< colors of all visible layers
+        QHash<Uuid, LibSymbol> mLibSymbols;
+        QStringList mLibSymbolVersions; ///< uuid and version of all library symbols
+        QVector<Symbol> mSymbols;
+        QVector<NetLine> mNetLines;
+        QVector<Point> mJunctions;
+        QVector<NetLabel> mNetLabels;
+        QByteArray mContentHash;
+
+        // Fonts
+        QFont mSymbolFont;
+        QFont mNetLabelFont;
+        Length mPinNameHeight;  ///< height of the pin name font used in the editor
+        Length mNetLabelHeight; ///< height of the net label font used in the editor
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_SCHEMATICPAINTER_H
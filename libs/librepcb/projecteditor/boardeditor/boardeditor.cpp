@@ -32,16 +32,21 @@
 #include <librepcb/common/utils/undostackactiongroup.h>
 #include <librepcb/common/utils/exclusiveactiongroup.h>
 #include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardlayerstack.h>
+#include <librepcb/project/boards/boardgraphicsbatcher.h>
+#include <librepcb/project/boards/boardpainter.h>
 #include <librepcb/project/circuit/circuit.h>
 #include <librepcb/common/dialogs/gridsettingsdialog.h>
 #include <librepcb/common/dialogs/boarddesignrulesdialog.h>
 #include "../dialogs/projectpropertieseditordialog.h"
 #include <librepcb/project/settings/projectsettings.h>
 #include <librepcb/common/graphics/graphicsview.h>
+#include <librepcb/common/graphics/graphicsexport.h>
 #include <librepcb/common/gridproperties.h>
 #include <librepcb/project/boards/cmd/cmdboardadd.h>
 #include <librepcb/project/boards/cmd/cmdboardremove.h>
 #include <librepcb/project/boards/cmd/cmdboarddesignrulesmodify.h>
+#include <librepcb/project/boards/boarddesignrulecheck.h>
 #include "../docks/ercmsgdock.h"
 #include "unplacedcomponentsdock.h"
 #include "fsm/bes_fsm.h"
@@ -93,6 +98,7 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project) :
     // add graphics view as central widget
     mGraphicsView = new GraphicsView(nullptr, this);
     mGraphicsView->setUseOpenGl(mProjectEditor.getWorkspace().getSettings().getAppearance().getUseOpenGl());
+    mGraphicsView->setTileCacheEnabled(mProjectEditor.getWorkspace().getSettings().getAppearance().getUseTileCache());
     mGraphicsView->setBackgroundBrush(Qt::black);
     mGraphicsView->setForegroundBrush(Qt::white);
     //setCentralWidget(mGraphicsView);
@@ -106,6 +112,13 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project) :
     connect(&mBoardListActionGroup, &QActionGroup::triggered,
             this, &BoardEditor::boardListActionGroupTriggered);
 
+    // update the boards shortly after modifications (e.g. not on every mouse move)
+    mBoardsModifiedTimer.setSingleShot(true);
+    mBoardsModifiedTimer.setInterval(300);
+    connect(&mProjectEditor.getUndoStack(), &UndoStack::stateModified,
+            &mBoardsModifiedTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
+    connect(&mBoardsModifiedTimer, &QTimer::timeout, this, &BoardEditor::boardsModified);
+
     // connect some actions which are created with the Qt Designer
     connect(mUi->actionProjectSave, &QAction::triggered, &mProjectEditor, &ProjectEditor::saveProject);
     connect(mUi->actionQuit, &QAction::triggered, this, &BoardEditor::close);
@@ -113,6 +126,8 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project) :
     connect(mUi->actionZoomIn, &QAction::triggered, mGraphicsView, &GraphicsView::zoomIn);
     connect(mUi->actionZoomOut, &QAction::triggered, mGraphicsView, &GraphicsView::zoomOut);
     connect(mUi->actionZoomAll, &QAction::triggered, mGraphicsView, &GraphicsView::zoomAll);
+    connect(mUi->actionShowRenderStatistics, &QAction::toggled,
+            mGraphicsView, &GraphicsView::setRenderStatisticsEnabled);
     connect(mUi->actionShowControlPanel, &QAction::triggered,
             &mProjectEditor, &ProjectEditor::showControlPanelClicked);
     connect(mUi->actionShowSchematicEditor, &QAction::triggered,
@@ -232,6 +247,7 @@ bool BoardEditor::setActiveBoardIndex(int index) noexcept
     {
         // save current view scene rect
         board->saveViewSceneRect(mGraphicsView->getVisibleSceneRect());
+        disconnect(mActiveBoardAttributesConnection);
         // uncheck QAction
         QAction* action = mBoardListActions.value(mActiveBoardIndex); Q_ASSERT(action);
         if (action) action->setChecked(false);
@@ -240,9 +256,13 @@ bool BoardEditor::setActiveBoardIndex(int index) noexcept
     if (board)
     {
         // show scene, restore view scene rect, set grid properties
+        board->getGraphicsBatcher().setEnabled(
+            mProjectEditor.getWorkspace().getSettings().getAppearance().getUseBatchedRendering());
         board->showInView(*mGraphicsView);
         mGraphicsView->setVisibleSceneRect(board->restoreViewSceneRect());
         mGraphicsView->setGridProperties(board->getGridProperties());
+        mActiveBoardAttributesConnection = connect(board, &Board::attributesChanged,
+            this, &BoardEditor::activeBoardAttributesChanged);
         // check QAction
         QAction* action = mBoardListActions.value(index); Q_ASSERT(action);
         if (action) action->setChecked(true);
@@ -258,6 +278,7 @@ bool BoardEditor::setActiveBoardIndex(int index) noexcept
     mUnplacedComponentsDock->setBoard(board);
     mBoardLayersDock->setActiveBoard(board);
     mUi->tabBar->setCurrentIndex(index);
+    activeBoardAttributesChanged();
     emit activeBoardChanged(oldIndex, index);
     return true;
 }
@@ -407,14 +428,31 @@ void BoardEditor::on_actionGrid_triggered()
 
 void BoardEditor::on_actionExportAsPdf_triggered()
 {
+    Board* board = getActiveBoard();
+    if (!board) return;
+
     try
     {
-        QString filename = QFileDialog::getSaveFileName(this, tr("PDF Export"),
-                                                        QDir::homePath(), "*.pdf");
+        QString filename = QFileDialog::getSaveFileName(this, tr("Export Board"),
+            QDir::homePath(), tr("PDF (*.pdf);;SVG (*.svg);;PNG (*.png)"));
         if (filename.isEmpty()) return;
-        if (!filename.endsWith(".pdf")) filename.append(".pdf");
-        //FilePath filepath(filename);
-        //mProject.exportSchematicsAsPdf(filepath); // this method can throw an exception
+        FilePath filepath(filename);
+        QString suffix = filepath.getSuffix().toLower();
+        if ((suffix != "svg") && (suffix != "png")) {
+            suffix = "pdf";
+            if (!filename.endsWith(".pdf")) filepath.setPath(filename + ".pdf");
+        }
+
+        // the board is drawn in the same colors as in the editor
+        GraphicsExport exporter(BoardPainter(*board).createPrimitives());
+        exporter.setBackground(Qt::black);
+        if (suffix == "svg") {
+            exporter.exportSvg(filepath); // can throw
+        } else if (suffix == "png") {
+            exporter.exportImage(filepath); // can throw
+        } else {
+            exporter.exportPdf(filepath); // can throw
+        }
     }
     catch (Exception& e)
     {
@@ -475,6 +513,34 @@ void BoardEditor::on_actionModifyDesignRules_triggered()
     }
 }
 
+void BoardEditor::on_actionRunDesignRuleCheck_triggered()
+{
+    Board* board = getActiveBoard();
+    if (!board) return;
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    board->getDesignRuleCheck().execute();
+    QApplication::restoreOverrideCursor();
+    mErcMsgDock->show();
+    mErcMsgDock->raise();
+}
+
+void BoardEditor::on_actionRebuildPlanes_triggered()
+{
+    Board* board = getActiveBoard();
+    if (!board) return;
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    board->rebuildAllPlanes();
+    QApplication::restoreOverrideCursor();
+}
+
+void BoardEditor::on_actionRecordRenderTrace_toggled(bool checked)
+{
+    // unchecks the action again if the trace was not started
+    mUi->actionRecordRenderTrace->setChecked(mGraphicsView->toggleRenderTrace(checked));
+}
+
 void BoardEditor::on_tabBar_currentChanged(int index)
 {
     setActiveBoardIndex(index);
@@ -485,6 +551,32 @@ void BoardEditor::boardListActionGroupTriggered(QAction* action)
     setActiveBoardIndex(mBoardListActions.indexOf(action));
 }
 
+void BoardEditor::activeBoardAttributesChanged() noexcept
+{
+    // cached tiles are outdated if layers or design rules have changed
+    mGraphicsView->invalidateTileCache();
+
+#ifdef QT_DEBUG
+    Board* board = getActiveBoard();
+    GraphicsLayer* layer = board ? board->getLayerStack().getLayer(GraphicsLayer::sDebugRepaintedRegions) : nullptr;
+    mGraphicsView->setRepaintFlashingEnabled(layer && layer->isVisible());
+#endif
+}
+
+void BoardEditor::boardsModified() noexcept
+{
+    foreach (Board* board, mProject.getBoards()) {
+        // only planes whose surroundings have changed are refilled
+        board->rebuildAllPlanes();
+
+        // the design rule check runs automatically once it was started by the user
+        BoardDesignRuleCheck& drc = board->getDesignRuleCheck();
+        if (drc.isExecuted()) {
+            drc.executeIncremental();
+        }
+    }
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
@@ -110,8 +110,13 @@ class BoardEditor final : public QMainWindow, public IF_GraphicsViewEventHandler
         void on_actionProjectProperties_triggered();
         void on_actionLayerStackSetup_triggered();
         void on_actionModifyDesignRules_triggered();
+        void on_actionRunDesignRuleCheck_triggered();
+        void on_actionRebuildPlanes_triggered();
+        void on_actionRecordRenderTrace_toggled(bool checked);
         void on_tabBar_currentChanged(int index);
         void boardListActionGroupTriggered(QAction* action);
+        void activeBoardAttributesChanged() noexcept;
+        void boardsModified() noexcept;
 
 
     signals:
@@ -140,8 +145,10 @@ class BoardEditor final : public QMainWindow, public IF_GraphicsViewEventHandler
 
         // Misc
         int mActiveBoardIndex;
+        QMetaObject::Connection mActiveBoardAttributesConnection;
         QList<QAction*> mBoardListActions;
         QActionGroup mBoardListActionGroup;
+        QTimer mBoardsModifiedTimer; ///< delays the checks after modifications
 
         // Docks
         ErcMsgDock* mErcMsgDock;
@@ -50,10 +50,25 @@ FabricationOutputDialog::FabricationOutputDialog(Board& board, QWidget *parent)
     QString outputDir = QString("output/%1/gerber").arg(version);
     FilePath gerberDir = mProject.getPath().getPathTo(outputDir);
     mUi->edtOutputDirPath->setText(gerberDir.toNative());
+
+    mUi->progressBar->setVisible(false);
+    mUi->btnCancel->setVisible(false);
+    connect(&mExportWatcher, &QFutureWatcher<void>::progressRangeChanged,
+            mUi->progressBar, &QProgressBar::setRange);
+    connect(&mExportWatcher, &QFutureWatcher<void>::progressValueChanged,
+            mUi->progressBar, &QProgressBar::setValue);
+    connect(&mExportWatcher, &QFutureWatcher<void>::finished,
+            this, &FabricationOutputDialog::exportFinished);
+    connect(mUi->btnCancel, &QPushButton::clicked,
+            &mExportWatcher, &QFutureWatcher<void>::cancel);
 }
 
 FabricationOutputDialog::~FabricationOutputDialog()
 {
+    // already running jobs can't be aborted, so wait until they are finished
+    mExportWatcher.disconnect(this);
+    mExportWatcher.cancel();
+    mExportWatcher.waitForFinished();
     delete mUi;     mUi = nullptr;
 }
 
@@ -74,14 +89,25 @@ void FabricationOutputDialog::on_btnGenerate_clicked()
 {
     try
     {
+        if (mExportWatcher.isRunning()) return;
         FilePath filepath(mUi->edtOutputDirPath->text());
+        mBoard.rebuildAllPlanes(); // only refills planes which are outdated
         BoardGerberExport grbExport(mBoard, filepath);
-        grbExport.exportAllLayers();
+        mExportWatcher.setFuture(grbExport.startExport()); // files are written in background
+        mUi->btnGenerate->setEnabled(false);
+        mUi->progressBar->setValue(0);
+        mUi->progressBar->setVisible(true);
+        mUi->btnCancel->setVisible(true);
     }
     catch (Exception& e)
     {
         QMessageBox::warning(this, tr("Error"), e.getMsg());
     }
+    catch (...)
+    {
+        // e.g. QUnhandledException if a job threw something else than an Exception
+        QMessageBox::warning(this, tr("Error"), tr("Unknown error while exporting."));
+    }
 }
 
 void FabricationOutputDialog::on_btnBrowseOutputDir_clicked()
@@ -94,6 +120,23 @@ void FabricationOutputDialog::on_btnBrowseOutputDir_clicked()
     }
 }
 
+void FabricationOutputDialog::exportFinished() noexcept
+{
+    mUi->btnGenerate->setEnabled(true);
+    mUi->progressBar->setVisible(false);
+    mUi->btnCancel->setVisible(false);
+
+    if (mExportWatcher.isCanceled()) return;
+    try
+    {
+        mExportWatcher.waitForFinished(); // rethrows the exception of a failed job
+    }
+    catch (Exception& e)
+    {
+        QMessageBox::warning(this, tr("Error"), e.getMsg());
+    }
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -69,6 +69,7 @@ class FabricationOutputDialog final : public QDialog
         void on_btnSelectDir_clicked();
         void on_btnGenerate_clicked();
         void on_btnBrowseOutputDir_clicked();
+        void exportFinished() noexcept;
 
 
     private:
@@ -76,6 +77,7 @@ class FabricationOutputDialog final : public QDialog
         Project& mProject;
         Board& mBoard;
         Ui::FabricationOutputDialog* mUi;
+        QFutureWatcher<void> mExportWatcher; ///< watches the running export (if any)
 };
 
 /*****************************************************************************************
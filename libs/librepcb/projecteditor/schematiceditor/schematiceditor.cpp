@@ -92,10 +92,14 @@ SchematicEditor::SchematicEditor(ProjectEditor& projectEditor, Project& project)
     connect(mUi->actionZoom_In, &QAction::triggered, mGraphicsView, &GraphicsView::zoomIn);
     connect(mUi->actionZoom_Out, &QAction::triggered, mGraphicsView, &GraphicsView::zoomOut);
     connect(mUi->actionZoom_All, &QAction::triggered, mGraphicsView, &GraphicsView::zoomAll);
+    connect(mUi->actionShowRenderStatistics, &QAction::toggled,
+            mGraphicsView, &GraphicsView::setRenderStatisticsEnabled);
     connect(mUi->actionShow_Control_Panel, &QAction::triggered,
             &mProjectEditor, &ProjectEditor::showControlPanelClicked);
     connect(mUi->actionShow_Board_Editor, &QAction::triggered,
             &mProjectEditor, &ProjectEditor::showBoardEditor);
+    connect(&mPdfExportWatcher, &QFutureWatcher<void>::finished,
+            this, &SchematicEditor::pdfExportFinished);
     connect(mUi->actionEditNetclasses, &QAction::triggered,
             [this](){mProjectEditor.execNetClassesEditorDialog(this);});
     connect(mUi->actionProjectSettings, &QAction::triggered,
@@ -170,6 +174,11 @@ SchematicEditor::SchematicEditor(ProjectEditor& projectEditor, Project& project)
 
 SchematicEditor::~SchematicEditor()
 {
+    // a running PDF export doesn't access the project anymore, but its file must be
+    // written completely
+    mPdfExportWatcher.disconnect(this);
+    mPdfExportWatcher.waitForFinished();
+
     // Save Window Geometry
     QSettings clientSettings;
     clientSettings.setValue("schematic_editor/window_geometry", saveGeometry());
@@ -306,6 +315,7 @@ void SchematicEditor::on_actionPDF_Export_triggered()
 {
     try
     {
+        if (mPdfExportWatcher.isRunning()) return;
         QString projectName = FilePath::cleanFileName(mProject.getMetadata().getName(),
                               FilePath::ReplaceSpaces | FilePath::KeepCase);
         QString projectVersion = FilePath::cleanFileName(mProject.getMetadata().getVersion(),
@@ -319,12 +329,34 @@ void SchematicEditor::on_actionPDF_Export_triggered()
         if (filename.isEmpty()) return;
         if (!filename.endsWith(".pdf")) filename.append(".pdf");
         FilePath filepath(filename);
-        mProject.exportSchematicsAsPdf(filepath); // this method can throw an exception
+        // the pages are rendered and written in background, without blocking the editor
+        mPdfExportFilePath = filepath;
+        mPdfExportWatcher.setFuture(mProject.startSchematicsPdfExport(filepath)); // can throw
+        mUi->actionPDF_Export->setEnabled(false);
+    }
+    catch (Exception& e)
+    {
+        QMessageBox::warning(this, tr("Error"), e.getMsg());
+    }
+}
+
+void SchematicEditor::pdfExportFinished() noexcept
+{
+    mUi->actionPDF_Export->setEnabled(true);
+    try
+    {
+        mPdfExportWatcher.waitForFinished(); // rethrows the exception of a failed export
+        QDesktopServices::openUrl(QUrl::fromLocalFile(mPdfExportFilePath.toStr()));
     }
     catch (Exception& e)
     {
         QMessageBox::warning(this, tr("Error"), e.getMsg());
     }
+    catch (...)
+    {
+        // e.g. QUnhandledException if the export threw something else than an Exception
+        QMessageBox::warning(this, tr("Error"), tr("Unknown error while exporting."));
+    }
 }
 
 void SchematicEditor::on_actionAddComp_Resistor_triggered()
@@ -382,6 +414,12 @@ void SchematicEditor::on_actionProjectProperties_triggered()
     dialog.exec();
 }
 
+void SchematicEditor::on_actionRecordRenderTrace_toggled(bool checked)
+{
+    // unchecks the action again if the trace was not started
+    mUi->actionRecordRenderTrace->setChecked(mGraphicsView->toggleRenderTrace(checked));
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
@@ -26,6 +26,7 @@
 #include <QtCore>
 #include <QtWidgets>
 #include <librepcb/common/graphics/if_graphicsvieweventhandler.h>
+#include <librepcb/common/fileio/filepath.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -101,6 +102,7 @@ class SchematicEditor final : public QMainWindow, public IF_GraphicsViewEventHan
         void on_actionAddComp_gnd_triggered();
         void on_actionAddComp_vcc_triggered();
         void on_actionProjectProperties_triggered();
+        void on_actionRecordRenderTrace_toggled(bool checked);
 
 
     signals:
@@ -118,6 +120,7 @@ class SchematicEditor final : public QMainWindow, public IF_GraphicsViewEventHan
         // Private Methods
         bool graphicsViewEventHandler(QEvent* event);
         void toolActionGroupChangeTriggered(const QVariant& newTool) noexcept;
+        void pdfExportFinished() noexcept;
 
         // General Attributes
         ProjectEditor& mProjectEditor;
@@ -136,6 +139,10 @@ class SchematicEditor final : public QMainWindow, public IF_GraphicsViewEventHan
 
         // Finite State Machine
         SES_FSM* mFsm;
+
+        // PDF Export
+        QFutureWatcher<void> mPdfExportWatcher; ///< watches the running export (if any)
+        FilePath mPdfExportFilePath;            ///< the file written by the running export
 };
 
 /*****************************************************************************************
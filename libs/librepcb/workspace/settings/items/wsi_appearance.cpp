@@ -35,11 +35,18 @@ namespace workspace {
  ****************************************************************************************/
 
 WSI_Appearance::WSI_Appearance(const SExpression& node) :
-    WSI_Base(), mUseOpenGl(false)
+    WSI_Base(), mUseOpenGl(false), mUseTileCache(false),
+    mUseBatchedRendering(false)
 {
     if (const SExpression* child = node.tryGetChildByPath("use_opengl")) {
         mUseOpenGl = child->getValueOfFirstChild<bool>(true);
     }
+    if (const SExpression* child = node.tryGetChildByPath("use_tile_cache")) {
+        mUseTileCache = child->getValueOfFirstChild<bool>(true);
+    }
+    if (const SExpression* child = node.tryGetChildByPath("use_batched_rendering")) {
+        mUseBatchedRendering = child->getValueOfFirstChild<bool>(true);
+    }
 
     // create widgets
     mUseOpenGlWidget.reset(new QWidget());
@@ -48,6 +55,12 @@ WSI_Appearance::WSI_Appearance(const SExpression& node) :
     mUseOpenGlCheckBox.reset(new QCheckBox(tr("Use OpenGL Hardware Acceleration")));
     mUseOpenGlCheckBox->setChecked(mUseOpenGl);
     openGlLayout->addWidget(mUseOpenGlCheckBox.data(), openGlLayout->rowCount(), 0);
+    mUseTileCacheCheckBox.reset(new QCheckBox(tr("Cache Rendered Tiles of the Board")));
+    mUseTileCacheCheckBox->setChecked(mUseTileCache);
+    openGlLayout->addWidget(mUseTileCacheCheckBox.data(), openGlLayout->rowCount(), 0);
+    mUseBatchedRenderingCheckBox.reset(new QCheckBox(tr("Batch Rendering of Traces and Vias")));
+    mUseBatchedRenderingCheckBox->setChecked(mUseBatchedRendering);
+    openGlLayout->addWidget(mUseBatchedRenderingCheckBox.data(), openGlLayout->rowCount(), 0);
     openGlLayout->addWidget(new QLabel(tr("This setting will be applied only to newly "
                             "opened windows.")), openGlLayout->rowCount(), 0);
 }
@@ -63,16 +76,22 @@ WSI_Appearance::~WSI_Appearance() noexcept
 void WSI_Appearance::restoreDefault() noexcept
 {
     mUseOpenGlCheckBox->setChecked(false);
+    mUseTileCacheCheckBox->setChecked(false);
+    mUseBatchedRenderingCheckBox->setChecked(false);
 }
 
 void WSI_Appearance::apply() noexcept
 {
     mUseOpenGl = mUseOpenGlCheckBox->isChecked();
+    mUseTileCache = mUseTileCacheCheckBox->isChecked();
+    mUseBatchedRendering = mUseBatchedRenderingCheckBox->isChecked();
 }
 
 void WSI_Appearance::revert() noexcept
 {
     mUseOpenGlCheckBox->setChecked(mUseOpenGl);
+    mUseTileCacheCheckBox->setChecked(mUseTileCache);
+    mUseBatchedRenderingCheckBox->setChecked(mUseBatchedRendering);
 }
 
 /*****************************************************************************************
@@ -82,6 +101,8 @@ void WSI_Appearance::revert() noexcept
 void WSI_Appearance::serialize(SExpression& root) const
 {
     root.appendTokenChild("use_opengl", mUseOpenGlCheckBox->isChecked(), true);
+    root.appendTokenChild("use_tile_cache", mUseTileCacheCheckBox->isChecked(), true);
+    root.appendTokenChild("use_batched_rendering", mUseBatchedRenderingCheckBox->isChecked(), true);
 }
 
 /*****************************************************************************************
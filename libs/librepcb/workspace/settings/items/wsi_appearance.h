@@ -55,6 +55,8 @@ class WSI_Appearance final : public WSI_Base
 
         // Getters
         bool getUseOpenGl() const noexcept {return mUseOpenGlCheckBox->isChecked();}
+        bool getUseTileCache() const noexcept {return mUseTileCacheCheckBox->isChecked();}
+        bool getUseBatchedRendering() const noexcept {return mUseBatchedRenderingCheckBox->isChecked();}
 
         // Getters: Widgets
         QString getUseOpenGlLabelText() const noexcept {return tr("Rendering Method:");}
@@ -75,10 +77,14 @@ class WSI_Appearance final : public WSI_Base
     private: // Data
 
         bool mUseOpenGl;
+        bool mUseTileCache;
+        bool mUseBatchedRendering;
 
         // Widgets
         QScopedPointer<QWidget> mUseOpenGlWidget;
         QScopedPointer<QCheckBox> mUseOpenGlCheckBox;
+        QScopedPointer<QCheckBox> mUseTileCacheCheckBox;
+        QScopedPointer<QCheckBox> mUseBatchedRenderingCheckBox;
 };
 
 /*****************************************************************************************
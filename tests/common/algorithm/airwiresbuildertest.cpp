@@ -0,0 +1,136 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/algorithm/airwiresbuilder.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class AirWiresBuilderTest : public ::testing::Test
+{
+    protected:
+        static qreal getTotalLength(const AirWiresBuilder::AirWires& airwires) noexcept {
+            qreal length = 0;
+            foreach (const auto& airwire, airwires) {
+                length += (airwire.second - airwire.first).getLength().toMm();
+            }
+            return length;
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(AirWiresBuilderTest, testNoPoints)
+{
+    AirWiresBuilder builder;
+    EXPECT_EQ(0, builder.buildAirWires().count());
+}
+
+TEST_F(AirWiresBuilderTest, testSinglePoint)
+{
+    AirWiresBuilder builder;
+    builder.addPoint(Point(100, 200));
+    EXPECT_EQ(0, builder.buildAirWires().count());
+}
+
+TEST_F(AirWiresBuilderTest, testAlreadyConnectedPoints)
+{
+    AirWiresBuilder builder;
+    int p1 = builder.addPoint(Point(0, 0));
+    int p2 = builder.addPoint(Point(1000000, 0));
+    int p3 = builder.addPoint(Point(0, 1000000));
+    builder.addEdge(p1, p2);
+    builder.addEdge(p2, p3);
+    EXPECT_EQ(0, builder.buildAirWires().count());
+}
+
+TEST_F(AirWiresBuilderTest, testCollinearPoints)
+{
+    AirWiresBuilder builder;
+    builder.addPoint(Point(3000000, 0));
+    builder.addPoint(Point(0, 0));
+    builder.addPoint(Point(1000000, 0));
+    builder.addPoint(Point(2000000, 0));
+    AirWiresBuilder::AirWires airwires = builder.buildAirWires();
+    EXPECT_EQ(3, airwires.count());
+    EXPECT_DOUBLE_EQ(3.0, getTotalLength(airwires));
+}
+
+TEST_F(AirWiresBuilderTest, testDuplicatePoints)
+{
+    AirWiresBuilder builder;
+    builder.addPoint(Point(0, 0));
+    builder.addPoint(Point(0, 0));
+    builder.addPoint(Point(1000000, 0));
+    AirWiresBuilder::AirWires airwires = builder.buildAirWires();
+    EXPECT_EQ(2, airwires.count());
+    EXPECT_DOUBLE_EQ(1.0, getTotalLength(airwires));
+}
+
+TEST_F(AirWiresBuilderTest, testShortestConnectionBetweenIslands)
+{
+    // two islands which are connected by copper, the shortest airwire between them is
+    // between (1mm, 0) and (3mm, 0)
+    AirWiresBuilder builder;
+    int a1 = builder.addPoint(Point(0, 0));
+    int a2 = builder.addPoint(Point(1000000, 0));
+    int b1 = builder.addPoint(Point(3000000, 0));
+    int b2 = builder.addPoint(Point(3000000, 5000000));
+    builder.addEdge(a1, a2);
+    builder.addEdge(b1, b2);
+    AirWiresBuilder::AirWires airwires = builder.buildAirWires();
+    ASSERT_EQ(1, airwires.count());
+    EXPECT_DOUBLE_EQ(2.0, getTotalLength(airwires));
+}
+
+TEST_F(AirWiresBuilderTest, testGrid)
+{
+    // a 10x10 grid with a pitch of 1mm needs exactly 99 airwires of 1mm each
+    AirWiresBuilder builder;
+    for (int x = 0; x < 10; ++x) {
+        for (int y = 0; y < 10; ++y) {
+            builder.addPoint(Point(x * 1000000, y * 1000000));
+        }
+    }
+    AirWiresBuilder::AirWires airwires = builder.buildAirWires();
+    EXPECT_EQ(99, airwires.count());
+    EXPECT_NEAR(99.0, getTotalLength(airwires), 1e-6);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,108 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <random>
+#include <gtest/gtest.h>
+#include <librepcb/common/algorithm/drillpathoptimizer.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class DrillPathOptimizerTest : public ::testing::Test
+{
+    protected:
+        static QVector<Point> sorted(QVector<Point> points) noexcept {
+            std::sort(points.begin(), points.end(), [](const Point& a, const Point& b){
+                return qMakePair(a.getX(), a.getY()) < qMakePair(b.getX(), b.getY());
+            });
+            return points;
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(DrillPathOptimizerTest, testNoHoles)
+{
+    DrillPathOptimizer optimizer(QVector<Point>(), Point(0, 0));
+    EXPECT_EQ(0, optimizer.optimize().count());
+}
+
+TEST_F(DrillPathOptimizerTest, testDuplicateHoles)
+{
+    QVector<Point> holes{Point(100, 100), Point(100, 100), Point(100, 100)};
+    DrillPathOptimizer optimizer(holes, Point(0, 0));
+    EXPECT_EQ(holes, optimizer.optimize());
+}
+
+TEST_F(DrillPathOptimizerTest, testCollinearHoles)
+{
+    QVector<Point> holes{Point(3000000, 0), Point(1000000, 0), Point(4000000, 0),
+                         Point(2000000, 0)};
+    DrillPathOptimizer optimizer(holes, Point(0, 0));
+    QVector<Point> expected{Point(1000000, 0), Point(2000000, 0), Point(3000000, 0),
+                            Point(4000000, 0)};
+    EXPECT_EQ(expected, optimizer.optimize());
+}
+
+TEST_F(DrillPathOptimizerTest, testCalcPathLength)
+{
+    QVector<Point> path{Point(3000000, 4000000), Point(3000000, 0)};
+    EXPECT_DOUBLE_EQ(9000000, DrillPathOptimizer::calcPathLength(path, Point(0, 0)));
+}
+
+TEST_F(DrillPathOptimizerTest, testGrid)
+{
+    // holes of a 20x20 grid in random order, the optimal path meanders through the grid
+    QVector<Point> holes;
+    for (int x = 0; x < 20; ++x) {
+        for (int y = 0; y < 20; ++y) {
+            holes.append(Point(x * 1000000, y * 1000000));
+        }
+    }
+    std::mt19937 random(42);
+    std::shuffle(holes.begin(), holes.end(), random);
+    DrillPathOptimizer optimizer(holes, Point(0, 0));
+    QVector<Point> path = optimizer.optimize();
+    EXPECT_EQ(sorted(holes), sorted(path));
+    qreal length = DrillPathOptimizer::calcPathLength(path, Point(0, 0));
+    EXPECT_GE(length, 399 * 1000000);
+    EXPECT_LE(length, 399 * 1000000 * 1.1);
+    EXPECT_LT(length, DrillPathOptimizer::calcPathLength(holes, Point(0, 0)) / 10);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,196 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <librepcb/common/algorithm/polygonclipper.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class PolygonClipperTest : public ::testing::Test
+{
+    protected:
+        static QVector<Point> square(LengthBase_t x, LengthBase_t y, LengthBase_t size) noexcept {
+            return {Point(x, y), Point(x + size, y), Point(x + size, y + size),
+                    Point(x, y + size)};
+        }
+
+        static qreal getArea(const QVector<PolygonClipper::Trapezoid>& trapezoids) noexcept {
+            qreal area = 0;
+            foreach (const PolygonClipper::Trapezoid& t, trapezoids) {
+                area += (t.top - t.bottom) * ((t.bottomRight - t.bottomLeft)
+                                              + (t.topRight - t.topLeft)) / 2.0;
+            }
+            return area;
+        }
+
+        static qreal getArea(const QVector<QVector<Point>>& contours) noexcept {
+            qreal area = 0;
+            foreach (const QVector<Point>& contour, contours) {
+                for (int i = 0; i < contour.count(); ++i) {
+                    const Point& a = contour.at(i);
+                    const Point& b = contour.at((i + 1) % contour.count());
+                    area += ((qreal)a.getX().toNm() * b.getY().toNm()
+                           - (qreal)b.getX().toNm() * a.getY().toNm()) / 2;
+                }
+            }
+            return qAbs(area);
+        }
+
+        static bool contains(const QVector<PolygonClipper::Trapezoid>& trapezoids,
+                             const Point& p) noexcept {
+            foreach (const PolygonClipper::Trapezoid& t, trapezoids) {
+                if (t.contains(p)) return true;
+            }
+            return false;
+        }
+
+        static bool isUnion(const bool* inside) noexcept {return inside[0];}
+        static bool isDifference(const bool* inside) noexcept {return inside[0] && (!inside[1]);}
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(PolygonClipperTest, testEmpty)
+{
+    PolygonClipper clipper;
+    int islands = -1;
+    EXPECT_EQ(0, clipper.execute(isUnion, &islands).count());
+    EXPECT_EQ(0, islands);
+}
+
+TEST_F(PolygonClipperTest, testUnionOfOverlappingSquares)
+{
+    PolygonClipper clipper;
+    clipper.addPolygon(square(0, 0, 100), 0);
+    QVector<Point> reversed = square(50, 50, 100);
+    std::reverse(reversed.begin(), reversed.end());
+    clipper.addPolygon(reversed, 0); // orientation must not matter
+    int islands = -1;
+    QVector<PolygonClipper::Trapezoid> result = clipper.execute(isUnion, &islands);
+    EXPECT_EQ(1, islands);
+    EXPECT_DOUBLE_EQ(17500, getArea(result));
+    EXPECT_TRUE(contains(result, Point(75, 75)));
+    EXPECT_FALSE(contains(result, Point(125, 25)));
+}
+
+TEST_F(PolygonClipperTest, testDifferenceWithHole)
+{
+    PolygonClipper clipper;
+    clipper.addPolygon(square(0, 0, 300), 0);
+    clipper.addPolygon(square(100, 100, 100), 1);
+    int islands = -1;
+    QVector<PolygonClipper::Trapezoid> result = clipper.execute(isDifference, &islands);
+    EXPECT_EQ(1, islands);
+    EXPECT_DOUBLE_EQ(80000, getArea(result));
+    EXPECT_FALSE(contains(result, Point(150, 150)));
+}
+
+TEST_F(PolygonClipperTest, testDifferenceSplitsIntoIslands)
+{
+    PolygonClipper clipper;
+    clipper.addPolygon(square(0, 0, 300), 0);
+    clipper.addPolygon({Point(100, -10), Point(200, -10), Point(200, 310), Point(100, 310)}, 1);
+    int islands = -1;
+    QVector<PolygonClipper::Trapezoid> result = clipper.execute(isDifference, &islands);
+    EXPECT_EQ(2, islands);
+    EXPECT_DOUBLE_EQ(60000, getArea(result));
+}
+
+TEST_F(PolygonClipperTest, testTouchingCornersAreNotConnected)
+{
+    PolygonClipper clipper;
+    clipper.addPolygon(square(0, 0, 100), 0);
+    clipper.addPolygon(square(100, 100, 100), 0);
+    int islands = -1;
+    clipper.execute(isUnion, &islands);
+    EXPECT_EQ(2, islands);
+}
+
+TEST_F(PolygonClipperTest, testCrossingEdges)
+{
+    // two triangles forming a star, their edges cross each other within a scanline slab
+    PolygonClipper clipper;
+    clipper.addPolygon({Point(0, 0), Point(1000, 0), Point(500, 900)}, 0);
+    clipper.addPolygon({Point(0, 600), Point(500, -300), Point(1000, 600)}, 0);
+    int islands = -1;
+    QVector<PolygonClipper::Trapezoid> result = clipper.execute(isUnion, &islands);
+    EXPECT_EQ(1, islands);
+    EXPECT_TRUE(contains(result, Point(500, 300)));
+    EXPECT_TRUE(contains(result, Point(500, -200)));
+    EXPECT_TRUE(contains(result, Point(100, 500)));
+    EXPECT_FALSE(contains(result, Point(20, 500)));
+}
+
+TEST_F(PolygonClipperTest, testMergeTrapezoids)
+{
+    PolygonClipper clipper;
+    clipper.addPolygon(square(0, 0, 100), 0);
+    clipper.addPolygon(square(50, 50, 100), 0);
+    QVector<QVector<Point>> contours = PolygonClipper::mergeTrapezoids(clipper.execute(isUnion));
+    ASSERT_EQ(1, contours.count());
+    EXPECT_EQ(8, contours.first().count());
+    EXPECT_DOUBLE_EQ(17500, getArea(contours));
+}
+
+TEST_F(PolygonClipperTest, testMergeTrapezoidsWithHoles)
+{
+    // holes are connected to the outline with cut-ins, so the area is still correct
+    PolygonClipper clipper;
+    clipper.addPolygon(square(0, 0, 500), 0);
+    clipper.addPolygon(square(100, 100, 100), 1);
+    clipper.addPolygon(square(300, 250, 100), 1);
+    clipper.addPolygon({Point(150, 300), Point(250, 300), Point(200, 400)}, 1);
+    QVector<PolygonClipper::Trapezoid> trapezoids = clipper.execute(isDifference);
+    QVector<QVector<Point>> contours = PolygonClipper::mergeTrapezoids(trapezoids);
+    ASSERT_EQ(1, contours.count());
+    EXPECT_DOUBLE_EQ(getArea(trapezoids), getArea(contours));
+    EXPECT_DOUBLE_EQ(250000 - 20000 - 5000, getArea(contours));
+}
+
+TEST_F(PolygonClipperTest, testMergeTrapezoidsKeepsIslands)
+{
+    PolygonClipper clipper;
+    clipper.addPolygon(square(0, 0, 300), 0);
+    clipper.addPolygon({Point(100, -10), Point(200, -10), Point(200, 310), Point(100, 310)}, 1);
+    QVector<QVector<Point>> contours = PolygonClipper::mergeTrapezoids(clipper.execute(isDifference));
+    EXPECT_EQ(2, contours.count());
+    EXPECT_DOUBLE_EQ(60000, getArea(contours));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,111 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/algorithm/rtree.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class RTreeTest : public ::testing::Test
+{
+    protected:
+        typedef RTree<int>::Box Box;
+
+        static QSet<int> query(const RTree<int>& tree, const Box& box) noexcept {
+            QSet<int> result;
+            tree.query(box, [&result](int value){result.insert(value);});
+            return result;
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(RTreeTest, testEmptyTree)
+{
+    RTree<int> tree;
+    tree.build(QVector<QPair<Box, int>>());
+    EXPECT_TRUE(tree.isEmpty());
+    EXPECT_TRUE(query(tree, Box(Point(-100, -100), Point(100, 100))).isEmpty());
+}
+
+TEST_F(RTreeTest, testInvalidBoxesAreIgnored)
+{
+    RTree<int> tree;
+    tree.build(QVector<QPair<Box, int>>{qMakePair(Box(), 1),
+                                       qMakePair(Box(Point(0, 0), Point(10, 10)), 2)});
+    EXPECT_EQ(1, tree.getCount());
+    EXPECT_EQ(QSet<int>{2}, query(tree, Box(Point(-100, -100), Point(100, 100))));
+}
+
+TEST_F(RTreeTest, testTouchingBoxesIntersect)
+{
+    RTree<int> tree;
+    tree.build(QVector<QPair<Box, int>>{qMakePair(Box(Point(0, 0), Point(10, 10)), 1)});
+    EXPECT_EQ(QSet<int>{1}, query(tree, Box(Point(10, 10), Point(20, 20))));
+    EXPECT_TRUE(query(tree, Box(Point(11, 0), Point(20, 20))).isEmpty());
+}
+
+TEST_F(RTreeTest, testQueryMatchesBruteForce)
+{
+    // a grid of 100x100 small boxes, which results in a tree with several levels
+    QVector<QPair<Box, int>> entries;
+    for (int x = 0; x < 100; ++x) {
+        for (int y = 0; y < 100; ++y) {
+            Point p(x * 1000, y * 1000);
+            entries.append(qMakePair(Box(p, p + Point(500, 500)), x * 100 + y));
+        }
+    }
+    RTree<int> tree;
+    tree.build(entries);
+    EXPECT_EQ(10000, tree.getCount());
+
+    QVector<Box> queries = {Box(Point(0, 0), Point(0, 0)),
+                            Box(Point(600, 600), Point(900, 900)),
+                            Box(Point(12345, 23456), Point(45678, 34567)),
+                            Box(Point(-5000, -5000), Point(200000, 200000))};
+    foreach (const Box& box, queries) {
+        QSet<int> expected;
+        foreach (const auto& entry, entries) {
+            if (entry.first.intersects(box)) expected.insert(entry.second);
+        }
+        EXPECT_EQ(expected, query(tree, box));
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
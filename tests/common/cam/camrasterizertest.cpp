@@ -0,0 +1,111 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/cam/camrasterizer.h>
+#include <librepcb/common/exceptions.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class CamRasterizerTest : public ::testing::Test
+{
+    protected:
+
+        static QVector<Point> rect(qint64 x1, qint64 y1, qint64 x2, qint64 y2)
+        {
+            return QVector<Point>{Point(Length(x1), Length(y1)), Point(Length(x2), Length(y1)),
+                                  Point(Length(x2), Length(y2)), Point(Length(x1), Length(y2))};
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(CamRasterizerTest, testPixelCentersAreSampled)
+{
+    // 1um pixels, a pixel is dark if its center is within the polygon
+    CamRasterizer rasterizer(Point(Length(0), Length(0)), Length(1000), 100, 100);
+    rasterizer.draw(CamRasterizer::Object{{{rect(10000, 20000, 30000, 50000), true}}, true});
+    EXPECT_EQ(20 * 30, rasterizer.getDarkPixelCount());
+    EXPECT_TRUE(rasterizer.isDark(10, 20));
+    EXPECT_TRUE(rasterizer.isDark(29, 49));
+    EXPECT_FALSE(rasterizer.isDark(9, 20));
+    EXPECT_FALSE(rasterizer.isDark(30, 49));
+    EXPECT_FALSE(rasterizer.isDark(10, 50));
+}
+
+TEST_F(CamRasterizerTest, testPolarityAndMask)
+{
+    CamRasterizer rasterizer(Point(Length(0), Length(0)), Length(1000), 100, 100);
+    rasterizer.draw(CamRasterizer::Object{{{rect(0, 0, 50000, 50000), true}}, true});
+    rasterizer.draw(CamRasterizer::Object{{{rect(0, 0, 10000, 10000), true}}, false});
+    EXPECT_EQ(50 * 50 - 10 * 10, rasterizer.getDarkPixelCount());
+
+    // a clear contour only clears within its object (e.g. the hole of an aperture)
+    rasterizer.draw(CamRasterizer::Object{{{rect(60000, 60000, 80000, 80000), true},
+                                           {rect(65000, 65000, 75000, 75000), false}}, true});
+    EXPECT_EQ(50 * 50 - 10 * 10 + 20 * 20 - 10 * 10, rasterizer.getDarkPixelCount());
+    EXPECT_FALSE(rasterizer.isDark(70, 70));
+}
+
+TEST_F(CamRasterizerTest, testClippingAndWideSpans)
+{
+    CamRasterizer rasterizer(Point(Length(-100), Length(-100)), Length(1), 300, 3);
+    rasterizer.draw(CamRasterizer::Object{{{rect(-1000, -1000, 1000, -98), true}}, true});
+    EXPECT_EQ(2 * 300, rasterizer.getDarkPixelCount());
+}
+
+TEST_F(CamRasterizerTest, testDifferentPixelCount)
+{
+    CamRasterizer a(Point(Length(0), Length(0)), Length(1000), 100, 100);
+    CamRasterizer b(Point(Length(0), Length(0)), Length(1000), 100, 100);
+    a.draw(CamRasterizer::Object{{{rect(0, 0, 20000, 20000), true}}, true});
+    b.draw(CamRasterizer::Object{{{rect(10000, 0, 30000, 20000), true}}, true});
+    EXPECT_EQ(2 * 10 * 20, a.getDifferentPixelCount(b));
+    EXPECT_EQ(0, a.getDifferentPixelCount(a));
+    CamRasterizer c(Point(Length(0), Length(0)), Length(1000), 100, 101);
+    EXPECT_THROW(a.getDifferentPixelCount(c), Exception);
+}
+
+TEST_F(CamRasterizerTest, testInvalidSizeThrows)
+{
+    EXPECT_THROW(CamRasterizer(Point(), Length(0), 10, 10), Exception);
+    EXPECT_THROW(CamRasterizer(Point(), Length(1), 0, 10), Exception);
+    EXPECT_THROW(CamRasterizer(Point(), Length(1), 100000, 100000), Exception);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
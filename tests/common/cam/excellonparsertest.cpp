@@ -0,0 +1,160 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/cam/excellongenerator.h>
+#include <librepcb/common/cam/excellonparser.h>
+#include <librepcb/common/exceptions.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class ExcellonParserTest : public ::testing::Test
+{
+    protected:
+
+        static qint64 countDarkPixels(const QVector<CamRasterizer::Object>& objects)
+        {
+            // area from (-10mm, -10mm) to (10mm, 10mm) with 10um pixels
+            CamRasterizer rasterizer(Point(Length(-10000000), Length(-10000000)),
+                                     Length(10000), 2000, 2000);
+            rasterizer.draw(objects);
+            return rasterizer.getDarkPixelCount();
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(ExcellonParserTest, testParseGeneratedFile)
+{
+    ExcellonGenerator gen;
+    gen.drill(Point(Length(-5000000), Length(0)), Length(1000000));
+    gen.drill(Point(Length(5000000), Length(2500000)), Length(1000000));
+    gen.drill(Point(Length(0), Length(-5000000)), Length(500000));
+    gen.generate();
+    QVector<CamRasterizer::Object> objects =
+        ExcellonParser(Length(100)).parse(gen.toStr().toUtf8());
+    ASSERT_EQ(3, objects.count());
+    Point bottomLeft, topRight;
+    EXPECT_TRUE(CamRasterizer::calcBoundingRect(objects, bottomLeft, topRight));
+    EXPECT_EQ(Point(Length(-5500000), Length(-5250000)), bottomLeft);
+    EXPECT_EQ(Point(Length(5500000), Length(3000000)), topRight);
+    qint64 area = qRound64(M_PI * (2 * 50 * 50 + 25 * 25));
+    EXPECT_NEAR(area, countDarkPixels(objects), area / 100);
+}
+
+TEST_F(ExcellonParserTest, testGenerateTwice)
+{
+    // the second generation must not measure the already optimized order again
+    ExcellonGenerator gen;
+    for (int i = 0; i < 10; ++i) {
+        gen.drill(Point(Length((i % 2) ? -5000000 : 5000000), Length(i * 100000)),
+                  Length(1000000));
+    }
+    gen.generate();
+    QString output = gen.toStr();
+    Length unoptimized = gen.getUnoptimizedPathLength();
+    Length optimized = gen.getOptimizedPathLength();
+    EXPECT_LT(optimized, unoptimized);
+    gen.generate();
+    EXPECT_EQ(unoptimized, gen.getUnoptimizedPathLength());
+    EXPECT_EQ(optimized, gen.getOptimizedPathLength());
+    // everything after the creation date must be equal
+    EXPECT_EQ(output.mid(output.indexOf(";Drill Path")),
+              gen.toStr().mid(gen.toStr().indexOf(";Drill Path")));
+}
+
+TEST_F(ExcellonParserTest, testCoordinatesWithoutDecimalPoint)
+{
+    // inch units with leading zeros, metric units with omitted leading zeros
+    QByteArray inch = "M48\nINCH,LZ\nT1C0.04\n%\nT1\nX01Y-0005\nM30\n";
+    QByteArray metric = "M48\nMETRIC,TZ\nT1C1.016\n%\nT1\nX25400Y-1270\nM30\n";
+    QVector<CamRasterizer::Object> inchObjects = ExcellonParser(Length(100)).parse(inch);
+    QVector<CamRasterizer::Object> metricObjects = ExcellonParser(Length(100)).parse(metric);
+    ASSERT_EQ(1, inchObjects.count());
+    ASSERT_EQ(1, metricObjects.count());
+    Point inchMin, inchMax, metricMin, metricMax;
+    CamRasterizer::calcBoundingRect(inchObjects, inchMin, inchMax);
+    CamRasterizer::calcBoundingRect(metricObjects, metricMin, metricMax);
+    EXPECT_EQ(Point(Length(25400000 - 508000), Length(-1270000 - 508000)), inchMin);
+    EXPECT_EQ(inchMin, metricMin);
+    EXPECT_EQ(inchMax, metricMax);
+}
+
+TEST_F(ExcellonParserTest, testStepAndRepeat)
+{
+    ExcellonGenerator single;
+    single.drill(Point(Length(0), Length(0)), Length(1000000));
+    single.drill(Point(Length(1000000), Length(0)), Length(1000000));
+    single.drill(Point(Length(0), Length(1000000)), Length(500000));
+    single.generate();
+
+    ExcellonGenerator panel;
+    panel.setStepAndRepeat(3, 2, Point(Length(3000000), Length(4000000)));
+    panel.drill(Point(Length(0), Length(0)), Length(1000000));
+    panel.drill(Point(Length(1000000), Length(0)), Length(1000000));
+    panel.drill(Point(Length(0), Length(1000000)), Length(500000));
+    panel.generate();
+
+    // every hole is written only once
+    EXPECT_EQ(single.toStr().count(QRegularExpression("^X", QRegularExpression::MultilineOption)),
+              panel.toStr().count(QRegularExpression("^X", QRegularExpression::MultilineOption)));
+
+    QVector<CamRasterizer::Object> objects =
+        ExcellonParser(Length(100)).parse(panel.toStr().toUtf8());
+    ASSERT_EQ(6 * 3, objects.count());
+    Point bottomLeft, topRight;
+    EXPECT_TRUE(CamRasterizer::calcBoundingRect(objects, bottomLeft, topRight));
+    EXPECT_EQ(Point(Length(-500000), Length(-500000)), bottomLeft);
+    EXPECT_EQ(Point(Length(7500000), Length(5250000)), topRight);
+    qint64 area = qRound64(6 * M_PI * (2 * 50 * 50 + 25 * 25));
+    EXPECT_NEAR(area, countDarkPixels(objects), area / 100);
+
+    EXPECT_THROW(ExcellonParser(Length(100)).parse("M48\nMETRIC\nT1C1.0\n%\nT1\nM25\n"
+                                                   "X1.0Y1.0\nM30\n"), Exception);
+}
+
+TEST_F(ExcellonParserTest, testInvalidFilesThrow)
+{
+    ExcellonParser parser(Length(100));
+    EXPECT_THROW(parser.parse("M48\nMETRIC\nT1C1.0\n%\nT1\nX1.0Y1.0\n"), Exception);
+    EXPECT_THROW(parser.parse("M48\nMETRIC\n%\nT1\nM30\n"), Exception);
+    EXPECT_THROW(parser.parse("M48\nMETRIC\nT1C1.0\n%\nX1.0Y1.0\nM30\n"), Exception);
+    EXPECT_THROW(parser.parse("M48\nMETRIC\nT1C1.0\n%\nT1\nX0Y0G85X1Y0\nM30\n"), Exception);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,76 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/cam/gerberaperturelist.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class GerberApertureListTest : public ::testing::Test
+{
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST(GerberApertureListTest, testEqualAperturesAreReused)
+{
+    GerberApertureList list;
+    EXPECT_EQ(10, list.setCircle(Length(100000), Length(0)));
+    EXPECT_EQ(11, list.setCircle(Length(200000), Length(0)));
+    EXPECT_EQ(12, list.setRect(Length(100000), Length(200000), Angle::deg0(), Length(0)));
+    EXPECT_EQ(10, list.setCircle(Length(100000), Length(-1))); // negative hole is ignored
+    EXPECT_EQ(12, list.setRect(Length(200000), Length(100000), Angle::deg90(), Length(0)));
+    EXPECT_EQ(13, list.setRect(Length(100000), Length(200000), Angle::deg45(), Length(0)));
+    EXPECT_EQ(13, list.setRect(Length(100000), Length(200000), Angle::deg45(), Length(0)));
+}
+
+TEST(GerberApertureListTest, testGenerateString)
+{
+    GerberApertureList list;
+    list.setCircle(Length(100000), Length(0));
+    list.setObround(Length(1000000), Length(500000), Angle::deg45(), Length(0));
+    list.setCircle(Length(100000), Length(0));
+    list.setRegularPolygon(Length(1000000), 6, Angle::deg0(), Length(0));
+    QString str = list.generateString();
+    EXPECT_EQ(1, str.count("%AMROTATEDOBROUND*"));
+    EXPECT_TRUE(str.contains("%ADD10C,0.1*%\n%ADD11ROTATEDOBROUND,"));
+    EXPECT_TRUE(str.contains("%ADD12P,1.0X6X30.0*%\n"));
+    EXPECT_FALSE(str.contains("%ADD13"));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
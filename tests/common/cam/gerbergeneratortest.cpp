@@ -0,0 +1,189 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/cam/gerbergenerator.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/geometry/path.h>
+#if defined(Q_OS_UNIX)
+#include <csignal>
+#include <sys/resource.h>
+#endif
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class GerberGeneratorTest : public ::testing::Test
+{
+    protected:
+
+        virtual void SetUp() override
+        {
+            mTempDir = FilePath::getApplicationTempPath().getPathTo("GerberGeneratorTest");
+            mFilePath = mTempDir.getPathTo("test.gbr");
+            if (mTempDir.isExistingDir()) {
+                FileUtils::removeDirRecursively(mTempDir); // can throw
+            }
+        }
+
+        virtual void TearDown() override
+        {
+            FileUtils::removeDirRecursively(mTempDir); // can throw
+        }
+
+        QByteArray generate(GerberGenerator& gen) const
+        {
+            gen.generate();
+            gen.saveToFile(mFilePath);
+            return FileUtils::readFile(mFilePath);
+        }
+
+        static QByteArray calcChecksum(QByteArray content)
+        {
+            content.truncate(content.indexOf("%TF.MD5,"));
+            content.replace('\n', QByteArray());
+            return QCryptographicHash::hash(content, QCryptographicHash::Md5).toHex();
+        }
+
+        static QByteArray readChecksum(const QByteArray& content)
+        {
+            int start = content.indexOf("%TF.MD5,") + 8;
+            return content.mid(start, content.indexOf('*', start) - start);
+        }
+
+        FilePath mTempDir;
+        FilePath mFilePath;
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(GerberGeneratorTest, testCoordinatesInNanometers)
+{
+    GerberGenerator gen("Project", Uuid::createRandom(), "v1");
+    gen.drawLine(Point(Length(1000000), Length(-2500000)), Point(Length(0), Length(123)),
+                 Length(200000));
+    QByteArray content = generate(gen);
+    EXPECT_TRUE(content.contains("X1000000Y-2500000D02*\nX0Y123D01*\n"));
+    QByteArray footer = "G04 --- BOARD END --- *\n%TF.MD5," + readChecksum(content) +
+                        "*%\nM02*\n";
+    EXPECT_TRUE(content.endsWith(footer));
+}
+
+TEST_F(GerberGeneratorTest, testChecksum)
+{
+    GerberGenerator gen("Project", Uuid::createRandom(), "v1");
+    gen.flashCircle(Point(Length(-1), Length(1)), Length(500000), Length(0));
+    QByteArray content = generate(gen);
+    EXPECT_EQ(calcChecksum(content), readChecksum(content));
+}
+
+TEST_F(GerberGeneratorTest, testLargeOutput)
+{
+    // generates much more data than the content buffer can hold
+    GerberGenerator gen("Project", Uuid::createRandom(), "v1");
+    for (int i = 0; i < 100000; ++i) {
+        gen.drawLine(Point(Length(i), Length(-i)), Point(Length(i + 1), Length(i)),
+                     Length(100000 + (i % 2)));
+    }
+    QByteArray content = generate(gen);
+    EXPECT_TRUE(content.contains("X0Y0D02*\nX1D01*\n"));
+    EXPECT_TRUE(content.contains("\nY-99999D02*\nX100000Y99999D01*\n"));
+    EXPECT_EQ(100000, content.count("D02*\n"));
+    EXPECT_EQ(calcChecksum(content), readChecksum(content));
+}
+
+#if defined(Q_OS_UNIX)
+TEST_F(GerberGeneratorTest, testFailedSpillIsNotSaved)
+{
+    // limit the file size so that spilling the content buffer fails
+    struct rlimit oldLimit;
+    ASSERT_EQ(0, getrlimit(RLIMIT_FSIZE, &oldLimit));
+    struct rlimit limit = oldLimit;
+    limit.rlim_cur = 100000;
+    void (*oldHandler)(int) = std::signal(SIGXFSZ, SIG_IGN);
+    ASSERT_EQ(0, setrlimit(RLIMIT_FSIZE, &limit));
+    GerberGenerator gen("Project", Uuid::createRandom(), "v1");
+    for (int i = 0; i < 100000; ++i) {
+        gen.drawLine(Point(Length(i), Length(-i)), Point(Length(i + 1), Length(i)),
+                     Length(100000));
+    }
+    EXPECT_EQ(0, setrlimit(RLIMIT_FSIZE, &oldLimit));
+    std::signal(SIGXFSZ, oldHandler);
+
+    EXPECT_THROW(gen.generate(), RuntimeError);
+    EXPECT_THROW(gen.saveToFile(mFilePath), RuntimeError);
+    EXPECT_FALSE(mFilePath.isExistingFile());
+}
+#endif
+
+TEST_F(GerberGeneratorTest, testUnchangedCoordinatesOmitted)
+{
+    GerberGenerator gen("Project", Uuid::createRandom(), "v1");
+    gen.drawLine(Point(Length(0), Length(0)), Point(Length(1000), Length(0)), Length(100));
+    gen.flashCircle(Point(Length(1000), Length(5000)), Length(500), Length(0));
+    gen.flashCircle(Point(Length(1000), Length(5000)), Length(500), Length(0));
+    QByteArray content = generate(gen);
+    EXPECT_TRUE(content.contains("X0Y0D02*\nX1000D01*\nD11*\nY5000D03*\nD03*\n"));
+}
+
+TEST_F(GerberGeneratorTest, testCollinearLinesMerged)
+{
+    GerberGenerator gen("Project", Uuid::createRandom(), "v1");
+    gen.drawLine(Point(Length(0), Length(0)), Point(Length(1000), Length(0)), Length(100));
+    gen.drawLine(Point(Length(1000), Length(0)), Point(Length(3000), Length(0)), Length(100));
+    gen.drawLine(Point(Length(3000), Length(0)), Point(Length(3000), Length(10)), Length(100));
+    gen.drawLine(Point(Length(3000), Length(10)), Point(Length(3000), Length(0)), Length(100));
+    QByteArray content = generate(gen);
+    EXPECT_TRUE(content.contains("D10*\nX0Y0D02*\nX3000D01*\nY10D01*\nY0D01*\nG04"));
+    EXPECT_EQ(1, content.count("D02*"));
+}
+
+TEST_F(GerberGeneratorTest, testAreasMergedIntoOneRegion)
+{
+    GerberGenerator gen("Project", Uuid::createRandom(), "v1");
+    gen.drawPathArea(Path::rect(Point(Length(0), Length(0)), Point(Length(10), Length(10))));
+    gen.drawPathArea(Path::rect(Point(Length(20), Length(0)), Point(Length(30), Length(10))));
+    gen.flashCircle(Point(Length(0), Length(0)), Length(500), Length(0));
+    gen.drawPathArea(Path::rect(Point(Length(0), Length(0)), Point(Length(10), Length(10))));
+    QByteArray content = generate(gen);
+    EXPECT_EQ(2, content.count("G36*"));
+    EXPECT_EQ(2, content.count("G37*"));
+    EXPECT_EQ(3, content.count("D02*"));
+    EXPECT_TRUE(content.contains("G37*\nD11*\nX0D03*\nD10*\nG36*\nD02*\n"));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
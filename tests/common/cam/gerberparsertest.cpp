@@ -0,0 +1,224 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/cam/gerbergenerator.h>
+#include <librepcb/common/cam/gerberparser.h>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/geometry/path.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class GerberParserTest : public ::testing::Test
+{
+    protected:
+
+        virtual void SetUp() override
+        {
+            mTempDir = FilePath::getApplicationTempPath().getPathTo("GerberParserTest");
+            if (mTempDir.isExistingDir()) {
+                FileUtils::removeDirRecursively(mTempDir); // can throw
+            }
+        }
+
+        virtual void TearDown() override
+        {
+            FileUtils::removeDirRecursively(mTempDir); // can throw
+        }
+
+        QByteArray generate(GerberGenerator& gen) const
+        {
+            FilePath filepath = mTempDir.getPathTo("test.gbr");
+            gen.generate();
+            gen.saveToFile(filepath);
+            return FileUtils::readFile(filepath);
+        }
+
+        static QVector<CamRasterizer::Object> parse(const QByteArray& content)
+        {
+            return GerberParser(Length(100)).parse(content);
+        }
+
+        static QByteArray wrap(const QByteArray& commands)
+        {
+            return "%FSLAX66Y66*%\n%MOMM*%\n" + commands + "M02*\n";
+        }
+
+        /**
+         * @brief Rasterize the area from (-10mm, -10mm) to (10mm, 10mm) with 10um pixels
+         */
+        static QSharedPointer<CamRasterizer> rasterize(const QByteArray& content)
+        {
+            QSharedPointer<CamRasterizer> rasterizer(new CamRasterizer(
+                Point(Length(-10000000), Length(-10000000)), Length(10000), 2000, 2000));
+            rasterizer->draw(parse(content));
+            return rasterizer;
+        }
+
+        FilePath mTempDir;
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(GerberParserTest, testFlashRect)
+{
+    QByteArray content = wrap("%ADD10R,1X2*%\nD10*\nX500000Y0D03*\n");
+    QVector<CamRasterizer::Object> objects = parse(content);
+    ASSERT_EQ(1, objects.count());
+    Point bottomLeft, topRight;
+    EXPECT_TRUE(CamRasterizer::calcBoundingRect(objects, bottomLeft, topRight));
+    EXPECT_EQ(Point(Length(0), Length(-1000000)), bottomLeft);
+    EXPECT_EQ(Point(Length(1000000), Length(1000000)), topRight);
+    EXPECT_EQ(100 * 200, rasterize(content)->getDarkPixelCount());
+}
+
+TEST_F(GerberParserTest, testFlashWithHole)
+{
+    QByteArray content = wrap("%ADD10R,1X1X0.5*%\nD10*\nX0Y0D03*\n");
+    qint64 hole = rasterize(wrap("%ADD10C,0.5*%\nD10*\nX0Y0D03*\n"))->getDarkPixelCount();
+    EXPECT_EQ(100 * 100 - hole, rasterize(content)->getDarkPixelCount());
+}
+
+TEST_F(GerberParserTest, testRegionAndClearPolarity)
+{
+    QByteArray content = wrap("G36*\nX0Y0D02*\nX2000000D01*\nY2000000D01*\nX0D01*\n"
+                              "Y0D01*\nG37*\n%LPC*%\nG36*\nX0Y0D02*\nX1000000D01*\n"
+                              "Y1000000D01*\nX0D01*\nY0D01*\nG37*\n");
+    EXPECT_EQ(2, parse(content).count());
+    EXPECT_EQ(200 * 200 - 100 * 100, rasterize(content)->getDarkPixelCount());
+}
+
+TEST_F(GerberParserTest, testArcs)
+{
+    // a full circle in multi quadrant mode and a quarter circle in single quadrant mode
+    QByteArray full = wrap("G75*\nG36*\nX1000000Y0D02*\nG03*\nX1000000Y0I-1000000J0D01*\n"
+                           "G37*\n");
+    QByteArray quarter = wrap("G74*\nG36*\nX0Y0D02*\nX1000000D01*\nG03*\n"
+                              "X0Y1000000I1000000J0D01*\nG01*\nX0Y0D01*\nG37*\n");
+    qint64 area = qRound64(M_PI * 100 * 100);
+    EXPECT_NEAR(area, rasterize(full)->getDarkPixelCount(), area / 100);
+    EXPECT_NEAR(area / 4, rasterize(quarter)->getDarkPixelCount(), area / 100);
+}
+
+TEST_F(GerberParserTest, testApertureMacros)
+{
+    // rotated rectangles and obrounds are generated with aperture macros
+    GerberGenerator gen("Project", Uuid::createRandom(), "v1");
+    gen.flashRect(Point(Length(-5000000), Length(0)), Length(2000000), Length(1000000),
+                  Angle::deg45(), Length(0));
+    gen.flashObround(Point(Length(5000000), Length(0)), Length(3000000), Length(1000000),
+                     Angle::deg45(), Length(500000));
+    QByteArray content = generate(gen);
+    ASSERT_TRUE(content.contains("%AMROTATEDRECT*"));
+    ASSERT_TRUE(content.contains("%AMROTATEDOBROUNDWITHHOLE*"));
+    qint64 rect = 200 * 100;
+    qint64 obround = qRound64(200 * 100 + M_PI * 50 * 50 - M_PI * 25 * 25);
+    EXPECT_NEAR(rect + obround, rasterize(content)->getDarkPixelCount(), 200);
+}
+
+TEST_F(GerberParserTest, testOptimizedOutputIsEquivalent)
+{
+    // the generator merges collinear lines and regions and omits coordinates, which
+    // must not change the image compared to the straightforward commands
+    GerberGenerator gen("Project", Uuid::createRandom(), "v1");
+    gen.drawLine(Point(Length(0), Length(0)), Point(Length(1000000), Length(0)),
+                 Length(200000));
+    gen.drawLine(Point(Length(1000000), Length(0)), Point(Length(3000000), Length(0)),
+                 Length(200000));
+    gen.drawPathArea(Path::centeredRect(Length(1000000), Length(2000000)));
+    gen.drawPathArea(Path::circle(Length(1000000)));
+    QByteArray optimized = generate(gen);
+
+    QByteArray reference = wrap(
+        "%ADD10C,0.2*%\nD10*\nX0Y0D02*\nX1000000Y0D01*\nX1000000Y0D02*\nX3000000Y0D01*\n"
+        "G36*\nX-500000Y1000000D02*\nX500000Y1000000D01*\nX500000Y-1000000D01*\n"
+        "X-500000Y-1000000D01*\nX-500000Y1000000D01*\nG37*\n"
+        "G75*\nG36*\nX500000Y0D02*\nG02*\nX-500000Y0I-500000J0D01*\n"
+        "X500000Y0I500000J0D01*\nG01*\nG37*\n");
+    EXPECT_EQ(0, rasterize(optimized)->getDifferentPixelCount(*rasterize(reference)));
+    EXPECT_LT(0, rasterize(reference)->getDarkPixelCount());
+}
+
+TEST_F(GerberParserTest, testDifferencesAreDetected)
+{
+    QByteArray a = wrap("%ADD10C,0.2*%\nD10*\nX0Y0D02*\nX1000000Y0D01*\n");
+    QByteArray b = wrap("%ADD10C,0.2*%\nD10*\nX0Y0D02*\nX1010000Y0D01*\n");
+    EXPECT_EQ(20, rasterize(a)->getDifferentPixelCount(*rasterize(b)));
+}
+
+TEST_F(GerberParserTest, testStepAndRepeat)
+{
+    GerberGenerator single("test", Uuid::createRandom(), "1.0");
+    single.flashRect(Point(0, 0), Length(1000000), Length(1000000), Angle::deg0(), Length(0));
+    single.drawLine(Point(0, 0), Point(1000000, 0), Length(200000));
+    QByteArray singleContent = generate(single);
+
+    GerberGenerator panel("test", Uuid::createRandom(), "1.0");
+    panel.beginStepAndRepeat(3, 2, Point(Length(2000000), Length(3000000)));
+    panel.flashRect(Point(0, 0), Length(1000000), Length(1000000), Angle::deg0(), Length(0));
+    panel.drawLine(Point(0, 0), Point(1000000, 0), Length(200000));
+    panel.endStepAndRepeat();
+    panel.flashCircle(Point(Length(-5000000), 0), Length(1000000), Length(0));
+    QByteArray panelContent = generate(panel);
+
+    // the panel is only slightly larger than a single board
+    EXPECT_LT(panelContent.size(), singleContent.size() + 100);
+
+    // six copies, the circle after the block is not repeated
+    QVector<CamRasterizer::Object> objects = parse(panelContent);
+    EXPECT_EQ(6 * parse(singleContent).count() + 1, objects.count());
+    Point bottomLeft, topRight;
+    EXPECT_TRUE(CamRasterizer::calcBoundingRect(objects, bottomLeft, topRight));
+    EXPECT_EQ(Point(Length(-5500000), Length(-500000)), bottomLeft);
+    EXPECT_EQ(Point(Length(5100000), Length(3500000)), topRight);
+    qint64 circle = rasterize(wrap("%ADD10C,1*%\nD10*\nX0Y0D03*\n"))->getDarkPixelCount();
+    EXPECT_EQ(6 * rasterize(singleContent)->getDarkPixelCount() + circle,
+              rasterize(panelContent)->getDarkPixelCount());
+}
+
+TEST_F(GerberParserTest, testInvalidFilesThrow)
+{
+    EXPECT_THROW(parse("%FSLAX66Y66*%\n%MOMM*%\n"), Exception); // no M02
+    EXPECT_THROW(parse(wrap("%SRX0Y2I1J1*%\n")), Exception);    // no columns
+    EXPECT_THROW(parse(wrap("D11*\n")), Exception);             // undefined aperture
+    EXPECT_THROW(parse(wrap("G36*\nX0Y0D02*\n")), Exception);   // unclosed region
+    EXPECT_THROW(parse("%MOMM*%\nX0Y0D02*\nM02*\n"), Exception); // no format
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
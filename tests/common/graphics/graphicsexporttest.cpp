@@ -0,0 +1,149 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include <gtest/gtest.h>
+#include <librepcb/common/graphics/graphicsexport.h>
+#include <librepcb/common/graphics/graphicsprimitives.h>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/fileio/fileutils.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class GraphicsExportTest : public ::testing::Test
+{
+    protected:
+
+        GraphicsExportTest() noexcept :
+            mTmpDir(FilePath::getRandomTempPath())
+        {
+        }
+
+        ~GraphicsExportTest() noexcept
+        {
+            QDir(mTmpDir.toStr()).removeRecursively();
+        }
+
+        static GraphicsPrimitives createPrimitives() noexcept
+        {
+            QPainterPath rect;
+            rect.addRect(0, 0, 72, 36); // 1x0.5 inch
+            QPainterPath line;
+            line.moveTo(10, 10);
+            line.lineTo(60, 30);
+            GraphicsPrimitives primitives;
+            primitives.addStroke(1, Qt::red, line, 4);  // above the rect
+            primitives.addFill(0, Qt::blue, rect);
+            return primitives;
+        }
+
+        FilePath mTmpDir;
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(GraphicsExportTest, testPrimitivesBoundingRect)
+{
+    GraphicsPrimitives primitives = createPrimitives();
+    EXPECT_EQ(2, primitives.getCount());
+    EXPECT_EQ(QRectF(0, 0, 72, 36), primitives.getBoundingRectPx());
+}
+
+TEST_F(GraphicsExportTest, testImageSize)
+{
+    GraphicsExport exporter(createPrimitives());
+    exporter.setMargin(Length(0));
+    exporter.setResolution(144);
+    EXPECT_EQ(QSize(144, 72), exporter.getImageSize());
+}
+
+TEST_F(GraphicsExportTest, testZOrder)
+{
+    GraphicsExport exporter(createPrimitives());
+    exporter.setMargin(Length(0));
+    exporter.setResolution(72);
+    QImage image = exporter.renderImage();
+    EXPECT_EQ(QColor(Qt::blue).rgb(), image.pixel(70, 2));
+    EXPECT_EQ(QColor(Qt::red).rgb(), image.pixel(35, 20)); // on the line
+}
+
+TEST_F(GraphicsExportTest, testTilesEqualSingleImage)
+{
+    GraphicsExport exporter(createPrimitives());
+    exporter.setResolution(600);
+    exporter.setTileSize(4096);
+    QImage single = exporter.renderImage();
+    exporter.setTileSize(32);
+    QImage tiled = exporter.renderImage();
+    ASSERT_EQ(single.size(), tiled.size());
+    int maxDiff = 0; // rounding at tile borders may slightly change antialiased pixels
+    for (int y = 0; y < single.height(); ++y) {
+        for (int x = 0; x < single.width(); ++x) {
+            QRgb a = single.pixel(x, y), b = tiled.pixel(x, y);
+            maxDiff = qMax(maxDiff, qAbs(qRed(a) - qRed(b)));
+            maxDiff = qMax(maxDiff, qAbs(qGreen(a) - qGreen(b)));
+            maxDiff = qMax(maxDiff, qAbs(qBlue(a) - qBlue(b)));
+        }
+    }
+    EXPECT_LE(maxDiff, 2);
+}
+
+TEST_F(GraphicsExportTest, testExportImageTiles)
+{
+    GraphicsExport exporter(createPrimitives());
+    exporter.setMargin(Length(0));
+    exporter.setResolution(144);
+    exporter.setTileSize(64);
+    QSize count = exporter.exportImageTiles(mTmpDir);
+    EXPECT_EQ(QSize(3, 2), count);
+    EXPECT_TRUE(mTmpDir.getPathTo("tile_1_2.png").isExistingFile());
+    EXPECT_EQ(QSize(16, 8), QImage(mTmpDir.getPathTo("tile_1_2.png").toStr()).size());
+}
+
+TEST_F(GraphicsExportTest, testExportVectorFormats)
+{
+    GraphicsExport exporter(createPrimitives());
+    exporter.exportSvg(mTmpDir.getPathTo("out.svg"));
+    exporter.exportPdf(mTmpDir.getPathTo("out.pdf"));
+    GraphicsExport::exportPdf(QList<GraphicsExport>{exporter, exporter}, mTmpDir.getPathTo("pages.pdf"));
+    EXPECT_TRUE(FileUtils::readFile(mTmpDir.getPathTo("out.svg")).contains("<svg"));
+    EXPECT_TRUE(FileUtils::readFile(mTmpDir.getPathTo("out.pdf")).startsWith("%PDF"));
+    EXPECT_TRUE(FileUtils::readFile(mTmpDir.getPathTo("pages.pdf")).startsWith("%PDF"));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,139 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include <gtest/gtest.h>
+#include <librepcb/common/graphics/graphicsexport.h>
+#include <librepcb/common/graphics/graphicspagecache.h>
+#include <librepcb/common/graphics/graphicsprimitives.h>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/fileio/fileutils.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class GraphicsPageCacheTest : public ::testing::Test
+{
+    protected:
+
+        GraphicsPageCacheTest() noexcept :
+            mTmpDir(FilePath::getRandomTempPath()), mBuildCount(0)
+        {
+        }
+
+        ~GraphicsPageCacheTest() noexcept
+        {
+            QDir(mTmpDir.toStr()).removeRecursively();
+        }
+
+        static GraphicsExport createPage(const QColor& color) noexcept
+        {
+            QPainterPath rect;
+            rect.addRect(0, 0, 72, 36);
+            GraphicsPrimitives primitives;
+            primitives.addFill(0, color, rect);
+            return GraphicsExport(primitives);
+        }
+
+        GraphicsExport::PdfPage createPdfPage(const QColor& color) noexcept
+        {
+            QAtomicInt* buildCount = &mBuildCount;
+            return GraphicsExport::PdfPage{color.name().toUtf8(), [color, buildCount](){
+                buildCount->ref(); // pages may be built concurrently
+                return createPage(color);
+            }};
+        }
+
+        FilePath mTmpDir;
+        QAtomicInt mBuildCount;
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(GraphicsPageCacheTest, testUnchangedPagesAreBuiltOnce)
+{
+    GraphicsPageCache cache;
+    GraphicsExport::PdfPage page = createPdfPage(Qt::blue);
+    GraphicsExport::Recording recording = cache.getPage(page.key, page.build);
+    cache.getPage(page.key, page.build);
+    EXPECT_EQ(1, mBuildCount.load());
+    EXPECT_EQ(1, cache.getPageCount());
+    EXPECT_EQ(1, cache.getRecordedPageCount());
+    EXPECT_EQ(createPage(Qt::blue).getSceneRectPx(), recording.sceneRect);
+
+    // a modified page needs a new recording
+    page = createPdfPage(Qt::red);
+    cache.getPage(page.key, page.build);
+    EXPECT_EQ(2, mBuildCount.load());
+    EXPECT_EQ(2, cache.getPageCount());
+    EXPECT_EQ(2, cache.getRecordedPageCount());
+}
+
+TEST_F(GraphicsPageCacheTest, testRemoveUnusedPages)
+{
+    GraphicsPageCache cache;
+    GraphicsExport::PdfPage blue = createPdfPage(Qt::blue);
+    GraphicsExport::PdfPage red = createPdfPage(Qt::red);
+    cache.getPage(blue.key, blue.build);
+    cache.getPage(red.key, red.build);
+    cache.removeUnusedPages(); // both pages were used since the cache was created
+    EXPECT_EQ(2, cache.getPageCount());
+    cache.getPage(red.key, red.build);
+    cache.removeUnusedPages();
+    EXPECT_EQ(1, cache.getPageCount());
+    cache.getPage(red.key, red.build);
+    EXPECT_EQ(2, cache.getRecordedPageCount());
+    cache.clear();
+    EXPECT_EQ(0, cache.getPageCount());
+}
+
+TEST_F(GraphicsPageCacheTest, testExportPdfWithCache)
+{
+    GraphicsPageCache cache;
+    QList<GraphicsExport::PdfPage> pages;
+    pages.append(createPdfPage(Qt::blue));
+    pages.append(createPdfPage(Qt::red));
+    GraphicsExport::exportPdf(pages, mTmpDir.getPathTo("first.pdf"), &cache);
+    EXPECT_EQ(2, cache.getRecordedPageCount());
+    QPageLayout a4(QPageSize(QPageSize::A4), QPageLayout::Landscape, QMarginsF(0, 0, 0, 0));
+    GraphicsExport::exportPdf(pages, mTmpDir.getPathTo("second.pdf"), &cache, a4);
+    EXPECT_EQ(2, cache.getRecordedPageCount());
+    EXPECT_TRUE(FileUtils::readFile(mTmpDir.getPathTo("first.pdf")).startsWith("%PDF"));
+    EXPECT_TRUE(FileUtils::readFile(mTmpDir.getPathTo("second.pdf")).startsWith("%PDF"));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
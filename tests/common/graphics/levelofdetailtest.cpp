@@ -0,0 +1,110 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include <gtest/gtest.h>
+#include <librepcb/common/graphics/levelofdetail.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class LevelOfDetailTest : public ::testing::Test
+{
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(LevelOfDetailTest, testTextMode)
+{
+    LevelOfDetail policy;
+    policy.setTextMinHeight(8);
+    policy.setTextBoxMinHeight(2);
+    EXPECT_EQ(LevelOfDetail::TextMode::Full, policy.getTextMode(1, 10));
+    EXPECT_EQ(LevelOfDetail::TextMode::Box, policy.getTextMode(0.5, 10));
+    EXPECT_EQ(LevelOfDetail::TextMode::Hidden, policy.getTextMode(0.1, 10));
+}
+
+TEST_F(LevelOfDetailTest, testShapeVisible)
+{
+    LevelOfDetail policy;
+    policy.setShapeMinSize(2);
+    EXPECT_TRUE(policy.isShapeVisible(1, QRectF(0, 0, 3, 0)));
+    EXPECT_TRUE(policy.isShapeVisible(0.5, QRectF(0, 0, 4, 1)));
+    EXPECT_FALSE(policy.isShapeVisible(0.1, QRectF(0, 0, 4, 1)));
+}
+
+TEST_F(LevelOfDetailTest, testPadDetails)
+{
+    LevelOfDetail policy;
+    policy.setPadDetailsMinSize(6);
+    EXPECT_TRUE(policy.drawPadDetails(1, QRectF(0, 0, 10, 6)));
+    EXPECT_FALSE(policy.drawPadDetails(1, QRectF(0, 0, 10, 5))); // smaller side counts
+}
+
+TEST_F(LevelOfDetailTest, testHairline)
+{
+    LevelOfDetail policy;
+    policy.setHairlineMaxWidth(1);
+    EXPECT_FALSE(policy.drawAsHairline(1, 2));
+    EXPECT_TRUE(policy.drawAsHairline(0.25, 2));
+}
+
+TEST_F(LevelOfDetailTest, testLodOfScreenDevice)
+{
+    QImage image(10, 10, QImage::Format_ARGB32);
+    QPainter painter(&image);
+    painter.scale(0.25, 0.25);
+    QStyleOptionGraphicsItem option;
+    EXPECT_DOUBLE_EQ(0.25, LevelOfDetail::getLod(painter, option));
+}
+
+TEST_F(LevelOfDetailTest, testFullDetailOnNonScreenDevice)
+{
+    QPicture picture;
+    QPainter painter(&picture);
+    painter.scale(0.001, 0.001);
+    QStyleOptionGraphicsItem option;
+    qreal lod = LevelOfDetail::getLod(painter, option);
+    LevelOfDetail policy;
+    EXPECT_EQ(LevelOfDetail::TextMode::Full, policy.getTextMode(lod, 0.1));
+    EXPECT_TRUE(policy.isShapeVisible(lod, QRectF(0, 0, 0.1, 0.1)));
+    EXPECT_TRUE(policy.drawPadDetails(lod, QRectF(0, 0, 0.1, 0.1)));
+    EXPECT_FALSE(policy.drawAsHairline(lod, 0.1));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
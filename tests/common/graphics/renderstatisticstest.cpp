@@ -0,0 +1,142 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include <gtest/gtest.h>
+#include <librepcb/common/graphics/renderstatistics.h>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/fileio/fileutils.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class RenderStatisticsTest : public ::testing::Test
+{
+    protected:
+
+        static RenderStatistics::Frame createFrame(qint64 timestamp, qreal ms) noexcept
+        {
+            RenderStatistics::Frame frame = RenderStatistics::Frame();
+            frame.timestamp = timestamp;
+            frame.nsecs = qRound64(ms * 1e6);
+            return frame;
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(RenderStatisticsTest, testPercentiles)
+{
+    RenderStatistics stats;
+    EXPECT_EQ(0, stats.getFrameTimePercentile(50));
+    for (int i = 100; i > 0; --i) {
+        stats.addFrame(createFrame(0, i));
+    }
+    EXPECT_DOUBLE_EQ(50, stats.getFrameTimePercentile(50));
+    EXPECT_DOUBLE_EQ(90, stats.getFrameTimePercentile(90));
+    EXPECT_DOUBLE_EQ(100, stats.getFrameTimePercentile(100));
+    EXPECT_DOUBLE_EQ(1, stats.getFrameTimePercentile(0));
+}
+
+TEST_F(RenderStatisticsTest, testFramesPerSecond)
+{
+    RenderStatistics stats;
+    qint64 now = stats.getElapsedTime();
+    stats.addFrame(createFrame(now - 5000, 1)); // too old
+    stats.addFrame(createFrame(now - 500, 1));
+    stats.addFrame(createFrame(now, 1));
+    EXPECT_EQ(2, stats.getFramesPerSecond());
+}
+
+TEST_F(RenderStatisticsTest, testFrameHistoryIsLimited)
+{
+    RenderStatistics stats;
+    for (int i = 0; i < 1000; ++i) {
+        stats.addFrame(createFrame(i, 1));
+    }
+    EXPECT_EQ(500, stats.getFrames().count());
+    EXPECT_EQ(999, stats.getFrames().last().timestamp);
+}
+
+TEST_F(RenderStatisticsTest, testPhasesAndItems)
+{
+    RenderStatistics stats;
+    stats.addItem("Foo", 1000); // ignored, no frame active
+    stats.beginFrame();
+    stats.endPhase(RenderStatistics::Phase::Background);
+    stats.addItem("Foo", 1000);
+    stats.addItem("Foo", 2000);
+    stats.addItem("Bar", 500);
+    stats.endPhase(RenderStatistics::Phase::Items);
+    stats.endFrame();
+    ASSERT_EQ(1, stats.getFrames().count());
+    const RenderStatistics::Frame& frame = stats.getFrames().first();
+    EXPECT_EQ(3, frame.itemCount);
+    EXPECT_EQ(2, frame.itemTypes.value("Foo").count);
+    EXPECT_EQ(3000, frame.itemTypes.value("Foo").nsecs);
+    EXPECT_EQ(500, frame.itemTypes.value("Bar").nsecs);
+    EXPECT_GE(frame.nsecs, frame.phaseNsecs[0] + frame.phaseNsecs[2]);
+    EXPECT_FALSE(stats.isFrameActive());
+}
+
+TEST_F(RenderStatisticsTest, testItemTypeName)
+{
+    QGraphicsRectItem item;
+    EXPECT_EQ(QString("QGraphicsRectItem"), RenderStatistics::getItemTypeName(item));
+}
+
+TEST_F(RenderStatisticsTest, testTrace)
+{
+    FilePath fp = FilePath::getApplicationTempPath().getPathTo("RenderStatisticsTest.csv");
+    RenderStatistics stats;
+    stats.addFrame(createFrame(1, 1)); // not traced
+    stats.startTrace(fp);
+    EXPECT_TRUE(stats.isTracing());
+    RenderStatistics::Frame frame = createFrame(2, 1.5);
+    frame.itemCount = 2;
+    frame.itemTypes.insert("Foo", RenderStatistics::ItemType{2, 1000000});
+    stats.addFrame(frame);
+    stats.stopTrace();
+    EXPECT_FALSE(stats.isTracing());
+    QStringList lines = QString(FileUtils::readFile(fp)).split("\n", QString::SkipEmptyParts);
+    ASSERT_EQ(2, lines.count());
+    EXPECT_EQ(QString("2,1.500,0.000,0.000,0.000,0.000,2,Foo:2:1.000"), lines.at(1));
+    QFile::remove(fp.toStr());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,128 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include <QtConcurrent>
+#include <gtest/gtest.h>
+#include <librepcb/common/graphics/textlayoutcache.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class TextLayoutCacheTest : public ::testing::Test
+{
+    protected:
+        TextLayoutCacheTest() noexcept {
+            mFont.setPixelSize(10);
+        }
+
+        QFont mFont;
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(TextLayoutCacheTest, testSharedLayouts)
+{
+    TextLayoutCache cache;
+    QSharedPointer<const TextLayout> a = cache.getLayout("R1", mFont, Qt::AlignLeft);
+    QSharedPointer<const TextLayout> b = cache.getLayout("R1", mFont, Qt::AlignLeft);
+    QSharedPointer<const TextLayout> c = cache.getLayout("R2", mFont, Qt::AlignLeft);
+    EXPECT_EQ(a.data(), b.data());
+    EXPECT_NE(a.data(), c.data());
+    EXPECT_EQ(2, cache.getCount());
+    EXPECT_EQ(1, cache.getHits());
+    EXPECT_EQ(2, cache.getMisses());
+}
+
+TEST_F(TextLayoutCacheTest, testKeyContainsFontAndAlignment)
+{
+    TextLayoutCache cache;
+    QFont bigFont = mFont;
+    bigFont.setPixelSize(20);
+    QSharedPointer<const TextLayout> a = cache.getLayout("R1", mFont, Qt::AlignLeft);
+    QSharedPointer<const TextLayout> b = cache.getLayout("R1", bigFont, Qt::AlignLeft);
+    QSharedPointer<const TextLayout> c = cache.getLayout("R1", mFont, Qt::AlignRight);
+    EXPECT_NE(a.data(), b.data());
+    EXPECT_NE(a.data(), c.data());
+    EXPECT_EQ(3, cache.getCount());
+    EXPECT_GT(b->getFontHeight(), a->getFontHeight());
+}
+
+TEST_F(TextLayoutCacheTest, testAlignment)
+{
+    TextLayoutCache cache;
+    QRectF left = cache.getLayout("text", mFont, Qt::AlignLeft | Qt::AlignBottom)->getBoundingRect();
+    QRectF right = cache.getLayout("text", mFont, Qt::AlignRight | Qt::AlignTop)->getBoundingRect();
+    EXPECT_NEAR(0, left.left(), 0.001);
+    EXPECT_NEAR(0, left.bottom(), 0.001);
+    EXPECT_NEAR(0, right.right(), 0.001);
+    EXPECT_NEAR(0, right.top(), 0.001);
+    EXPECT_NEAR(left.width(), right.width(), 0.001);
+}
+
+TEST_F(TextLayoutCacheTest, testMultipleLines)
+{
+    TextLayoutCache cache;
+    QSharedPointer<const TextLayout> one = cache.getLayout("A", mFont, Qt::AlignLeft);
+    QSharedPointer<const TextLayout> two = cache.getLayout("A\nB", mFont, Qt::AlignLeft);
+    EXPECT_GT(two->getBoundingRect().height(), one->getBoundingRect().height());
+    EXPECT_FALSE(two->toPainterPath().isEmpty());
+}
+
+TEST_F(TextLayoutCacheTest, testMaxCount)
+{
+    TextLayoutCache cache;
+    cache.setMaxCount(2);
+    QSharedPointer<const TextLayout> a = cache.getLayout("A", mFont, Qt::AlignLeft);
+    cache.getLayout("B", mFont, Qt::AlignLeft);
+    cache.getLayout("C", mFont, Qt::AlignLeft);
+    EXPECT_LE(cache.getCount(), 2);
+    EXPECT_EQ("A", a->getText()); // still valid after eviction
+}
+
+TEST_F(TextLayoutCacheTest, testOtherThreadsAreNotCached)
+{
+    TextLayoutCache cache;
+    QString text = QtConcurrent::run([&]() {
+        return cache.getLayout("R1", mFont, Qt::AlignLeft)->getText();
+    }).result();
+    EXPECT_EQ("R1", text);
+    EXPECT_EQ(0, cache.getCount());
+    EXPECT_EQ(0, cache.getMisses());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,110 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/memorypool.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class MemoryPoolTest : public ::testing::Test
+{
+    protected:
+        class PooledObject final
+        {
+                DECLARE_MEMORY_POOL(PooledObject)
+
+            public:
+                explicit PooledObject(int value) noexcept : mValue(value) {}
+                int getValue() const noexcept {return mValue;}
+
+            private:
+                int mValue;
+        };
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(MemoryPoolTest, testBlockSizeIsAligned)
+{
+    MemoryPool pool(3);
+    EXPECT_GE(pool.getBlockSize(), sizeof(void*));
+    EXPECT_EQ(0U, pool.getBlockSize() % alignof(std::max_align_t));
+}
+
+TEST_F(MemoryPoolTest, testAllocateAndRelease)
+{
+    MemoryPool pool(24, 4);
+    QSet<void*> blocks;
+    for (int i = 0; i < 10; ++i) {
+        void* block = pool.allocate();
+        EXPECT_FALSE(blocks.contains(block));
+        blocks.insert(block);
+    }
+    EXPECT_EQ(10, pool.getUsedBlockCount());
+    EXPECT_EQ(3, pool.getChunkCount());
+    foreach (void* block, blocks) {
+        pool.release(block);
+    }
+    EXPECT_EQ(0, pool.getUsedBlockCount());
+}
+
+TEST_F(MemoryPoolTest, testReleasedBlocksAreReused)
+{
+    MemoryPool pool(24, 4);
+    void* block = pool.allocate();
+    pool.release(block);
+    EXPECT_EQ(block, pool.allocate());
+    EXPECT_EQ(1, pool.getChunkCount());
+    pool.release(block);
+}
+
+TEST_F(MemoryPoolTest, testDeclareMemoryPool)
+{
+    MemoryPool& pool = PooledObject::getMemoryPool();
+    int usedBefore = pool.getUsedBlockCount();
+    PooledObject* a = new PooledObject(1);
+    PooledObject* b = new PooledObject(2);
+    EXPECT_EQ(usedBefore + 2, pool.getUsedBlockCount());
+    EXPECT_EQ(1, a->getValue());
+    EXPECT_EQ(2, b->getValue());
+    delete a;
+    delete b;
+    EXPECT_EQ(usedBefore, pool.getUsedBlockCount());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -23,6 +23,7 @@
 #include <QtCore>
 #include <gtest/gtest.h>
 #include <librepcb/common/toolbox.h>
+#include <librepcb/common/geometry/path.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -66,6 +67,32 @@ TEST(ToolboxTest, testStringOrNumberToQVariant_mixed)
     EXPECT_EQ(QVariant("l33t"), variant);
 }
 
+TEST(ToolboxTest, testConvexHull)
+{
+    QVector<Point> points = {Point(0, 0), Point(10, 10), Point(10, 0), Point(5, 5),
+                             Point(0, 10), Point(5, 0), Point(10, 10)};
+    QVector<Point> expected = {Point(0, 0), Point(10, 0), Point(10, 10), Point(0, 10)};
+    EXPECT_EQ(expected, Toolbox::convexHull(points));
+    EXPECT_EQ(QVector<Point>{Point(3, 4)}, Toolbox::convexHull({Point(3, 4), Point(3, 4)}));
+}
+
+TEST(ToolboxTest, testFlattenedPath)
+{
+    Path path;
+    path.addVertex(Point(0, 0));
+    path.addVertex(Point(1000000, 0));
+    path.addVertex(Point(-1000000, 0), Angle::deg180());
+    QVector<Point> points = Toolbox::flattenedPath(path, 5000);
+    ASSERT_GT(points.count(), 4);
+    EXPECT_EQ(Point(0, 0), points.first());
+    EXPECT_EQ(Point(1000000, 0), points.at(1));
+    EXPECT_EQ(Point(-1000000, 0), points.last());
+    for (int i = 2; i < points.count() - 1; ++i) {
+        // all points of the flattened arc lie on the circle (with rounding errors)
+        EXPECT_NEAR(1000000, points.at(i).getLength().toNm(), 10);
+    }
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
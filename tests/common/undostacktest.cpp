@@ -0,0 +1,234 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/undostack.h>
+#include <librepcb/common/undocommand.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class UndoStackTest : public ::testing::Test
+{
+    protected:
+
+        /**
+         * @brief Command which sets an integer value and can be merged if it modifies
+         *        the same value
+         */
+        class CmdSetValue final : public UndoCommand
+        {
+            public:
+                CmdSetValue(int& value, int newValue, int payload = 0) noexcept :
+                    UndoCommand("Set Value"), mValue(value), mOldValue(value),
+                    mNewValue(newValue), mPayload(payload) {}
+                qint64 getSizeEstimate() const noexcept override {
+                    return UndoCommand::getSizeEstimate() + mPayload;
+                }
+            private:
+                bool performExecute() override {performRedo(); return true;}
+                void performUndo() override {mValue = mOldValue;}
+                void performRedo() override {mValue = mNewValue;}
+                bool canMergeWith(const UndoCommand& other) const noexcept override {
+                    const CmdSetValue& cmd = static_cast<const CmdSetValue&>(other);
+                    return (&cmd.mValue == &mValue) && (cmd.mOldValue == mNewValue);
+                }
+                void performMergeWith(const UndoCommand& other) noexcept override {
+                    mNewValue = static_cast<const CmdSetValue&>(other).mNewValue;
+                }
+                int& mValue;
+                int mOldValue;
+                int mNewValue;
+                int mPayload; ///< additional "memory" to report in the size estimate
+        };
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(UndoStackTest, testMaxCommandCountDropsOldestCommands)
+{
+    int value = 0;
+    UndoStack stack;
+    stack.setMergeInterval(0);
+    stack.setMaxCommandCount(10);
+    for (int i = 1; i <= 25; ++i) {
+        stack.execCmd(new CmdSetValue(value, i));
+    }
+    EXPECT_EQ(25, value);
+    EXPECT_EQ(10, stack.getCommandCount());
+    EXPECT_EQ(15, stack.getDroppedCommandCount());
+    while (stack.canUndo()) {
+        stack.undo();
+    }
+    EXPECT_EQ(15, value); // older commands were dropped
+    while (stack.canRedo()) {
+        stack.redo();
+    }
+    EXPECT_EQ(25, value);
+}
+
+TEST_F(UndoStackTest, testMaxMemoryUsageDropsOldestCommands)
+{
+    int value = 0;
+    UndoStack stack;
+    stack.setMergeInterval(0);
+    stack.setMaxCommandCount(0);
+    stack.setMaxMemoryUsage(10000);
+    for (int i = 1; i <= 100; ++i) {
+        stack.execCmd(new CmdSetValue(value, i, 1000));
+        EXPECT_LE(stack.getMemoryUsage(), 10000);
+    }
+    EXPECT_GT(stack.getCommandCount(), 1);
+    EXPECT_LT(stack.getCommandCount(), 10);
+    EXPECT_EQ(100 - stack.getCommandCount(), stack.getDroppedCommandCount());
+}
+
+TEST_F(UndoStackTest, testLastCommandIsNeverDropped)
+{
+    int value = 0;
+    UndoStack stack;
+    stack.setMergeInterval(0);
+    stack.setMaxMemoryUsage(1);
+    stack.execCmd(new CmdSetValue(value, 1, 1000));
+    stack.execCmd(new CmdSetValue(value, 2, 1000));
+    EXPECT_EQ(1, stack.getCommandCount());
+    stack.undo();
+    EXPECT_EQ(1, value);
+}
+
+TEST_F(UndoStackTest, testDroppingCleanStateKeepsStackDirty)
+{
+    int value = 0;
+    UndoStack stack;
+    stack.setMergeInterval(0);
+    stack.setMaxCommandCount(2);
+    stack.execCmd(new CmdSetValue(value, 1));
+    stack.setClean();
+    stack.execCmd(new CmdSetValue(value, 2));
+    stack.execCmd(new CmdSetValue(value, 3));
+    stack.execCmd(new CmdSetValue(value, 4));
+    while (stack.canUndo()) {
+        stack.undo();
+        EXPECT_FALSE(stack.isClean());
+    }
+}
+
+TEST_F(UndoStackTest, testMemoryUsageIsTracked)
+{
+    int value = 0;
+    UndoStack stack;
+    stack.setMergeInterval(0);
+    EXPECT_EQ(0, stack.getMemoryUsage());
+    stack.execCmd(new CmdSetValue(value, 1, 1000));
+    stack.execCmd(new CmdSetValue(value, 2, 1000));
+    EXPECT_GT(stack.getMemoryUsage(), 2000);
+    stack.undo();
+    stack.execCmd(new CmdSetValue(value, 3, 0)); // drops the redoable command
+    EXPECT_GT(stack.getMemoryUsage(), 1000);
+    EXPECT_LT(stack.getMemoryUsage(), 2000);
+    stack.clear();
+    EXPECT_EQ(0, stack.getMemoryUsage());
+}
+
+TEST_F(UndoStackTest, testMergeSubsequentCommands)
+{
+    int value = 0;
+    UndoStack stack;
+    stack.setMergeInterval(60000);
+    stack.execCmd(new CmdSetValue(value, 1));
+    stack.execCmd(new CmdSetValue(value, 2));
+    stack.execCmd(new CmdSetValue(value, 3));
+    EXPECT_EQ(3, value);
+    EXPECT_EQ(1, stack.getCommandCount());
+    stack.undo();
+    EXPECT_EQ(0, value);
+    stack.redo();
+    EXPECT_EQ(3, value);
+}
+
+TEST_F(UndoStackTest, testDoNotMergeCommandsOfDifferentTargets)
+{
+    int value1 = 0;
+    int value2 = 0;
+    UndoStack stack;
+    stack.setMergeInterval(60000);
+    stack.execCmd(new CmdSetValue(value1, 1));
+    stack.execCmd(new CmdSetValue(value2, 2));
+    EXPECT_EQ(2, stack.getCommandCount());
+}
+
+TEST_F(UndoStackTest, testDoNotMergeIfDisabled)
+{
+    int value = 0;
+    UndoStack stack;
+    stack.setMergeInterval(0);
+    stack.execCmd(new CmdSetValue(value, 1));
+    stack.execCmd(new CmdSetValue(value, 2));
+    EXPECT_EQ(2, stack.getCommandCount());
+}
+
+TEST_F(UndoStackTest, testDoNotMergeIntoCleanState)
+{
+    int value = 0;
+    UndoStack stack;
+    stack.setMergeInterval(60000);
+    stack.execCmd(new CmdSetValue(value, 1));
+    stack.setClean();
+    stack.execCmd(new CmdSetValue(value, 2));
+    EXPECT_EQ(2, stack.getCommandCount());
+    stack.undo();
+    EXPECT_EQ(1, value);
+    EXPECT_TRUE(stack.isClean());
+}
+
+TEST_F(UndoStackTest, testDoNotMergeAfterUndo)
+{
+    int value1 = 0;
+    int value2 = 0;
+    UndoStack stack;
+    stack.setMergeInterval(60000);
+    stack.execCmd(new CmdSetValue(value1, 1));
+    stack.execCmd(new CmdSetValue(value2, 1));
+    stack.undo();
+    stack.execCmd(new CmdSetValue(value1, 2));
+    EXPECT_EQ(2, stack.getCommandCount());
+    stack.undo();
+    EXPECT_EQ(1, value1);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,152 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/geometry/polygon.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/project/project.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boarddesignrulecheck.h>
+#include <librepcb/project/boards/items/bi_polygon.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class BoardDesignRuleCheckTest : public ::testing::Test
+{
+    protected:
+
+        BoardDesignRuleCheckTest()
+        {
+            // the board gets the default design rules and a 160x100mm board outline
+            mProjectDir = FilePath::getRandomTempPath().getPathTo("project");
+            mProject.reset(Project::create(mProjectDir.getPathTo("project.lpp")));
+            mBoard = mProject->createBoard("board");
+            mProject->addBoard(*mBoard);
+        }
+
+        virtual ~BoardDesignRuleCheckTest()
+        {
+            mProject.reset();
+            QDir(mProjectDir.getParentDir().toStr()).removeRecursively();
+        }
+
+        /**
+         * @brief Add a rectangular copper polygon (coordinates in millimeters)
+         */
+        BI_Polygon* addRect(qreal x1, qreal y1, qreal x2, qreal y2, bool filled = false)
+        {
+            BI_Polygon* polygon = new BI_Polygon(*mBoard, Uuid::createRandom(),
+                GraphicsLayer::sTopCopper, Length(200000), filled, false, createRect(x1, y1, x2, y2));
+            mBoard->addPolygon(*polygon);
+            return polygon;
+        }
+
+        static Path createRect(qreal x1, qreal y1, qreal x2, qreal y2)
+        {
+            return Path::rect(Point::fromMm(x1, y1), Point::fromMm(x2, y2));
+        }
+
+        FilePath mProjectDir;
+        QScopedPointer<Project> mProject;
+        Board* mBoard;
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(BoardDesignRuleCheckTest, testCopperClearance)
+{
+    // 0.3mm between the centers of the 0.2mm wide outlines, i.e. a clearance of 0.1mm
+    addRect(10, 10, 20, 20);
+    addRect(20.3, 10, 30, 20);
+    addRect(40, 10, 50, 20); // far away
+    BoardDesignRuleCheck& drc = mBoard->getDesignRuleCheck();
+    drc.execute();
+    ASSERT_EQ(1, drc.getViolationCount());
+    EXPECT_TRUE(drc.getViolationMessages().first().contains("0.1mm < 0.2mm"));
+}
+
+TEST_F(BoardDesignRuleCheckTest, testFilledPolygonInterior)
+{
+    // the small polygon is far away from the outline of the large one, but inside of it
+    BI_Polygon* large = addRect(10, 10, 30, 30);
+    addRect(18, 18, 22, 22);
+    BoardDesignRuleCheck& drc = mBoard->getDesignRuleCheck();
+    drc.execute();
+    EXPECT_EQ(0, drc.getViolationCount());
+    large->getPolygon().setIsFilled(true);
+    drc.execute();
+    EXPECT_EQ(1, drc.getViolationCount());
+}
+
+TEST_F(BoardDesignRuleCheckTest, testBoardOutlineClearance)
+{
+    addRect(0.2, 10, 10, 20);
+    BoardDesignRuleCheck& drc = mBoard->getDesignRuleCheck();
+    drc.execute();
+    ASSERT_EQ(1, drc.getViolationCount());
+    EXPECT_TRUE(drc.getViolationMessages().first().contains("board outline"));
+}
+
+TEST_F(BoardDesignRuleCheckTest, testIncrementalEqualsFullCheck)
+{
+    BI_Polygon* moved = addRect(10, 10, 20, 20);
+    BI_Polygon* removed = addRect(20.3, 10, 30, 20);
+    addRect(10, 20.1, 20, 30);
+    addRect(40, 10, 50, 20);
+    BoardDesignRuleCheck& drc = mBoard->getDesignRuleCheck();
+    drc.execute();
+    EXPECT_EQ(3, drc.getViolationCount());
+
+    // modify, add and remove polygons
+    moved->getPolygon().setPath(createRect(30.1, 10, 39.95, 20));
+    addRect(60, 10, 70, 20, true);
+    addRect(65, 15, 66, 16);
+    mBoard->removePolygon(*removed);
+    delete removed;
+    drc.executeIncremental();
+    QStringList incremental = drc.getViolationMessages();
+
+    drc.clear();
+    drc.execute();
+    EXPECT_EQ(drc.getViolationMessages(), incremental);
+    EXPECT_EQ(2, incremental.count());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace project
+} // namespace librepcb
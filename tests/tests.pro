@@ -16,7 +16,7 @@ include(../common.pri)
 # Set preprocessor defines
 DEFINES += TEST_DATA_DIR=\\\"$${PWD}/data\\\"
 
-QT += core widgets network printsupport xml opengl sql concurrent
+QT += core widgets network printsupport xml opengl sql concurrent svg
 
 CONFIG += console
 CONFIG -= app_bundle
@@ -60,12 +60,27 @@ PRE_TARGETDEPS += \
     $${DESTDIR}/libsexpresso.a \
 
 SOURCES += \
+    common/algorithm/airwiresbuildertest.cpp \
+    common/algorithm/drillpathoptimizertest.cpp \
+    common/algorithm/polygonclippertest.cpp \
+    common/algorithm/rtreetest.cpp \
     common/applicationtest.cpp \
     common/attributes/attributesubstitutortest.cpp \
+    common/cam/camrasterizertest.cpp \
+    common/cam/excellonparsertest.cpp \
+    common/cam/gerberaperturelisttest.cpp \
+    common/cam/gerbergeneratortest.cpp \
+    common/cam/gerberparsertest.cpp \
     common/directorylocktest.cpp \
     common/filedownloadtest.cpp \
     common/fileio/serializableobjectlisttest.cpp \
     common/filepathtest.cpp \
+    common/graphics/graphicsexporttest.cpp \
+    common/graphics/graphicspagecachetest.cpp \
+    common/graphics/levelofdetailtest.cpp \
+    common/graphics/renderstatisticstest.cpp \
+    common/graphics/textlayoutcachetest.cpp \
+    common/memorypooltest.cpp \
     common/networkrequesttest.cpp \
     common/pointtest.cpp \
     common/ratiotest.cpp \
@@ -73,6 +88,7 @@ SOURCES += \
     common/sqlitedatabasetest.cpp \
     common/systeminfotest.cpp \
     common/toolboxtest.cpp \
+    common/undostacktest.cpp \
     common/uuidtest.cpp \
     common/versiontest.cpp \
     eagleimport/deviceconvertertest.cpp \
@@ -80,6 +96,7 @@ SOURCES += \
     eagleimport/packageconvertertest.cpp \
     eagleimport/symbolconvertertest.cpp \
     main.cpp \
+    project/boards/boarddesignrulechecktest.cpp \
     project/projecttest.cpp \
     workspace/workspacetest.cpp \
 